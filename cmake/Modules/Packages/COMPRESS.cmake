@@ -6,6 +6,12 @@ if(NOT ZLIB_FOUND)
 endif()
 target_link_libraries(lammps PRIVATE ZLIB::ZLIB)
 
+# background writer thread for "dump_modify async yes"
+find_package(Threads QUIET)
+if(Threads_FOUND)
+  target_link_libraries(lammps PRIVATE Threads::Threads)
+endif()
+
 find_package(PkgConfig QUIET)
 if(PkgConfig_FOUND)
   pkg_check_modules(Zstd IMPORTED_TARGET libzstd>=1.4)
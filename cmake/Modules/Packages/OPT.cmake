@@ -7,5 +7,10 @@
 
   get_property(OPT_SOURCES GLOBAL PROPERTY OPT_SOURCES)
 
+  # manually add styles from OPT that are not variants of an existing style
+
+  AddStyleHeader(${OPT_SOURCES_DIR}/pair_lj_cut_cluster.h PAIR)
+  list(APPEND OPT_SOURCES ${OPT_SOURCES_DIR}/pair_lj_cut_cluster.cpp)
+
   target_sources(lammps PRIVATE ${OPT_SOURCES})
   target_include_directories(lammps PRIVATE ${OPT_SOURCES_DIR})
@@ -284,6 +284,13 @@ class lammps(object):
       [c_void_p,c_char_p,c_int,c_int,c_int,POINTER(c_int),c_void_p]
     self.lib.lammps_gather_atoms_subset.restype = None
 
+    self.lib.lammps_gather_atoms_root.argtypes = [c_void_p,c_char_p,c_int,c_int,c_void_p]
+    self.lib.lammps_gather_atoms_root.restype = None
+
+    self.lib.lammps_gather_atoms_subset_root.argtypes = \
+      [c_void_p,c_char_p,c_int,c_int,c_int,POINTER(c_int),c_void_p]
+    self.lib.lammps_gather_atoms_subset_root.restype = None
+
     self.lib.lammps_scatter_atoms.argtypes = [c_void_p,c_char_p,c_int,c_int,c_void_p]
     self.lib.lammps_scatter_atoms.restype = None
 
@@ -1762,6 +1769,45 @@ class lammps(object):
 
   # -------------------------------------------------------------------------
 
+  # root-only variants of gather_atoms() and gather_atoms_subset()
+  # must be called on all MPI ranks, but only rank 0 receives the data
+  # all other ranks return None
+
+  def gather_atoms_root(self,name,dtype,count):
+    if name: newname = name.encode()
+    else: newname = None
+    natoms = self.get_natoms()
+    if self.extract_setting('world_rank') == 0: size = count*natoms
+    else: size = 0
+    with ExceptionCheck(self):
+      if dtype == 0:
+        data = (size*c_int)()
+      elif dtype == 1:
+        data = (size*c_double)()
+      else:
+        return None
+      self.lib.lammps_gather_atoms_root(self.lmp,newname,dtype,count,data)
+    if size: return data
+    return None
+
+  def gather_atoms_subset_root(self,name,dtype,count,ndata,ids):
+    if name: newname = name.encode()
+    else: newname = None
+    if self.extract_setting('world_rank') == 0: size = count*ndata
+    else: size = 0
+    with ExceptionCheck(self):
+      if dtype == 0:
+        data = (size*c_int)()
+      elif dtype == 1:
+        data = (size*c_double)()
+      else:
+        return None
+      self.lib.lammps_gather_atoms_subset_root(self.lmp,newname,dtype,count,ndata,ids,data)
+    if size: return data
+    return None
+
+  # -------------------------------------------------------------------------
+
   # scatter vector of atom properties across procs
   # 2 variants to match src/library.cpp
   # name = atom property recognized by LAMMPS in atom->extract()
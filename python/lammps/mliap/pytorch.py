@@ -15,7 +15,6 @@
 #   Contributing author: Nicholas Lubbers (LANL)
 # -------------------------------------------------------------------------
 
-import numpy as np
 import torch
 
 def calc_n_params(model):
@@ -142,14 +141,15 @@ class TorchWrapper(torch.nn.Module):
                 energy_nn[:] = self.model(descriptors, elems).flatten()
             else:
                 energy_nn = self.model(descriptors, elems).flatten()
-                energy[:] = energy_nn.detach().cpu().numpy().astype(np.float64)
+                # write directly into the LAMMPS per-atom energy array
+                torch.from_numpy(energy).copy_(energy_nn.detach())
 
         if (use_gpu_data):
             beta_nn = torch.as_tensor(beta,dtype=self.dtype, device=device)
             beta_nn[:] = torch.autograd.grad(energy_nn.sum(), descriptors)[0]
         else:
             beta_nn = torch.autograd.grad(energy_nn.sum(), descriptors)[0]
-            beta[:] = beta_nn.detach().cpu().numpy().astype(np.float64)
+            torch.from_numpy(beta).copy_(beta_nn.detach())
 
 
 class IgnoreElems(torch.nn.Module):
@@ -24,6 +24,7 @@ from .constants import  LAMMPS_AUTODETECT, LAMMPS_INT, LAMMPS_INT_2D, LAMMPS_DOU
   LMP_SIZE_COLS, LMP_VAR_EQUAL, LMP_VAR_ATOM
 
 from .data import NeighList
+from .core import ExceptionCheck
 
 class numpy_wrapper:
   """lammps API NumPy Wrapper
@@ -302,6 +303,106 @@ class numpy_wrapper:
 
     # -------------------------------------------------------------------------
 
+  def gather_atoms_root(self, name, dtype, count, out=None):
+    """Gather a per-atom property of all atoms on MPI rank 0 into a NumPy array
+
+    .. versionadded:: TBD
+
+    This is a wrapper around the :cpp:func:`lammps_gather_atoms_root`
+    function of the C-library interface.  It must be called on all MPI
+    ranks, but only MPI rank 0 receives the data, ordered by atom ID.
+    The data is written directly into the memory of the NumPy array
+    without an intermediate copy.  If *out* is provided, it is used as
+    destination on MPI rank 0 and can be reused across calls to avoid
+    allocating a new array every time.  It must be a C-contiguous array
+    of ``numpy.intc`` (*dtype* = 0) or ``numpy.double`` (*dtype* = 1)
+    elements with at least *count* times *natoms* elements.
+
+    :param name: name of the per-atom property (e.g. "x", "q", "type")
+    :type  name: string
+    :param dtype: 0 for integer values, 1 for double values
+    :type  dtype: int
+    :param count: number of per-atom values, e.g. 1 for "q" or 3 for "x"
+    :type  count: int
+    :param out: optional pre-allocated destination array on MPI rank 0
+    :type  out: numpy.array
+    :return: on MPI rank 0 the destination array, with shape (natoms, count)
+             if it was allocated here, None on all other ranks
+    :rtype: numpy.array or None
+    """
+    natoms = self.lmp.get_natoms()
+    out = self._gather_root_buffer(dtype, count, natoms, out)
+    if name: newname = name.encode()
+    else: newname = None
+    ptr = None if out is None else out.ctypes.data_as(c_void_p)
+    with ExceptionCheck(self.lmp):
+      self.lmp.lib.lammps_gather_atoms_root(self.lmp.lmp, newname, dtype, count, ptr)
+    return out
+
+    # -------------------------------------------------------------------------
+
+  def gather_atoms_subset_root(self, name, dtype, count, ids, out=None):
+    """Gather a per-atom property of a subset of atoms on MPI rank 0 into a NumPy array
+
+    .. versionadded:: TBD
+
+    This is a wrapper around the :cpp:func:`lammps_gather_atoms_subset_root`
+    function of the C-library interface.  It behaves like
+    :py:meth:`gather_atoms_root() <lammps.numpy_wrapper.numpy_wrapper.gather_atoms_root()>`,
+    but only collects data for the atoms with the IDs in *ids*, in the same
+    order.  The list of IDs must be the same on all MPI ranks.
+
+    :param name: name of the per-atom property (e.g. "x", "q", "type")
+    :type  name: string
+    :param dtype: 0 for integer values, 1 for double values
+    :type  dtype: int
+    :param count: number of per-atom values, e.g. 1 for "q" or 3 for "x"
+    :type  count: int
+    :param ids: list or array of atom IDs
+    :type  ids: list or numpy.array
+    :param out: optional pre-allocated destination array on MPI rank 0
+    :type  out: numpy.array
+    :return: on MPI rank 0 the destination array, with shape (len(ids), count)
+             if it was allocated here, None on all other ranks
+    :rtype: numpy.array or None
+    """
+    import numpy as np
+    ids = np.ascontiguousarray(ids, dtype=np.intc)
+    ndata = len(ids)
+    out = self._gather_root_buffer(dtype, count, ndata, out)
+    if name: newname = name.encode()
+    else: newname = None
+    ptr = None if out is None else out.ctypes.data_as(c_void_p)
+    with ExceptionCheck(self.lmp):
+      self.lmp.lib.lammps_gather_atoms_subset_root(self.lmp.lmp, newname, dtype, count, ndata,
+                                                   ids.ctypes.data_as(POINTER(c_int)), ptr)
+    return out
+
+    # -------------------------------------------------------------------------
+
+  def _gather_root_buffer(self, dtype, count, ndata, out):
+    import numpy as np
+    if self.lmp.extract_setting('world_rank') != 0:
+      return None
+    if dtype == 0:
+      nptype = np.intc
+    elif dtype == 1:
+      nptype = np.double
+    else:
+      raise ValueError("Unsupported data type {}".format(dtype))
+    if out is None:
+      if count == 1:
+        return np.empty(ndata, dtype=nptype)
+      return np.empty((ndata, count), dtype=nptype)
+    if out.dtype != nptype or not out.flags['C_CONTIGUOUS'] or not out.flags['WRITEABLE']:
+      raise ValueError("Destination array must be a writeable, C-contiguous array of type {}"
+                       .format(np.dtype(nptype).name))
+    if out.size < count*ndata:
+      raise ValueError("Destination array is too small: {} < {}".format(out.size, count*ndata))
+    return out
+
+    # -------------------------------------------------------------------------
+
   def fix_external_get_force(self, fix_id):
     """Get access to the array with per-atom forces of a fix external instance with a given fix ID.
 
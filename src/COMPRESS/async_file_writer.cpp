@@ -0,0 +1,283 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "async_file_writer.h"
+
+#include "error.h"
+#include "lammps.h"
+#include "utils.h"
+
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+// size of a block handed to the background thread
+// max # of blocks waiting to be written before the caller blocks
+
+static constexpr size_t BLOCKSIZE = 4 * 1024 * 1024;
+static constexpr size_t MAXQUEUE = 2;
+
+/* ---------------------------------------------------------------------- */
+
+AsyncFileWriter::AsyncFileWriter() : async(false), stopping(false), busy(false) {}
+
+/* ----------------------------------------------------------------------
+   derived classes must call close() in their destructor, so the
+   background thread has stopped before their data is destroyed
+------------------------------------------------------------------------- */
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+  if (worker.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    cond.notify_all();
+    worker.join();
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void AsyncFileWriter::open(const std::string &path, bool append)
+{
+  if (isopen()) return;
+
+  open_file(path, append);
+  if (async) {
+    stopping = false;
+    busy = false;
+    errmsg.clear();
+    worker = std::thread(&AsyncFileWriter::run, this);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   write all pending data, stop background thread, close file
+   the file is closed even if the background thread failed,
+     its error is raised afterwards
+------------------------------------------------------------------------- */
+
+void AsyncFileWriter::close()
+{
+  if (!isopen()) return;
+
+  if (worker.joinable()) {
+    if (!current.empty()) commit(false);
+    wait_idle();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    cond.notify_all();
+    worker.join();
+    close_file();
+    check_error();
+  } else close_file();
+}
+
+/* ----------------------------------------------------------------------
+   in async mode, queue pending data followed by a flush and return
+------------------------------------------------------------------------- */
+
+void AsyncFileWriter::flush()
+{
+  if (!isopen()) return;
+
+  if (worker.joinable()) {
+    check_error();
+    commit(true);
+  } else flush_file();
+}
+
+/* ---------------------------------------------------------------------- */
+
+size_t AsyncFileWriter::write(const void *buffer, size_t length)
+{
+  if (!isopen()) return 0;
+  if (!worker.joinable()) return write_file(buffer, length);
+
+  check_error();
+  current.append((const char *) buffer, length);
+  if (current.size() >= BLOCKSIZE) commit(false);
+  return length;
+}
+
+/* ----------------------------------------------------------------------
+   switch async mode, takes effect with the next open()
+------------------------------------------------------------------------- */
+
+void AsyncFileWriter::setAsync(bool enabled)
+{
+  if (isopen()) throw FileWriterException("Async mode can not be changed while file is open");
+  async = enabled;
+}
+
+/* ----------------------------------------------------------------------
+   wait until background thread has written all data queued so far
+------------------------------------------------------------------------- */
+
+void AsyncFileWriter::sync()
+{
+  if (!worker.joinable()) return;
+
+  if (!current.empty()) commit(false);
+  wait_idle();
+  check_error();
+}
+
+/* ----------------------------------------------------------------------
+   process dump_modify keywords shared by all compressed dump styles
+   return # of args consumed, 0 if keyword is not handled here
+------------------------------------------------------------------------- */
+
+int AsyncFileWriter::modify_param(int narg, char **arg, LAMMPS *lmp)
+{
+  try {
+    if (strcmp(arg[0], "async") == 0) {
+      if (narg < 2) lmp->error->all(FLERR, "Illegal dump_modify command");
+      setAsync(utils::logical(FLERR, arg[1], false, lmp) == 1);
+      return 2;
+    } else if (hasChecksum() && (strcmp(arg[0], "checksum") == 0)) {
+      if (narg < 2) lmp->error->all(FLERR, "Illegal dump_modify command");
+      setChecksum(utils::logical(FLERR, arg[1], false, lmp) == 1);
+      return 2;
+    } else if (strcmp(arg[0], "compression_level") == 0) {
+      if (narg < 2) lmp->error->all(FLERR, "Illegal dump_modify command");
+      setCompressionLevel(utils::inumeric(FLERR, arg[1], false, lmp));
+      return 2;
+    }
+  } catch (FileWriterException &e) {
+    lmp->error->one(FLERR, "Illegal dump_modify command: {}", e.what());
+  }
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   write one snapshot of a compressed dump style with write_dump()
+   then the file writer closes the file for one file per snapshot,
+     else it flushes the file if requested
+------------------------------------------------------------------------- */
+
+void AsyncFileWriter::write_snapshot(const std::function<void()> &write_dump, bool filewriter,
+                                     bool closeflag, bool flushflag, LAMMPS *lmp)
+{
+  try {
+    write_dump();
+    if (filewriter) {
+      if (closeflag) {
+        close();
+      } else {
+        if (flushflag && isopen()) flush();
+      }
+    }
+  } catch (FileWriterException &e) {
+    lmp->error->one(FLERR, e.what());
+  }
+}
+
+/* ----------------------------------------------------------------------
+   wait for output queued for the background thread, e.g. at the end of a run
+------------------------------------------------------------------------- */
+
+void AsyncFileWriter::sync(LAMMPS *lmp)
+{
+  try {
+    sync();
+  } catch (FileWriterException &e) {
+    lmp->error->one(FLERR, e.what());
+  }
+}
+
+/* ----------------------------------------------------------------------
+   hand current block to background thread
+   block the caller while MAXQUEUE blocks are still waiting
+------------------------------------------------------------------------- */
+
+void AsyncFileWriter::commit(bool flush)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  cond.wait(lock, [this] { return queue.size() < MAXQUEUE; });
+  queue.push_back({std::move(current), flush});
+  current.clear();
+  lock.unlock();
+  cond.notify_all();
+}
+
+/* ----------------------------------------------------------------------
+   wait until the background thread has no more queued blocks
+------------------------------------------------------------------------- */
+
+void AsyncFileWriter::wait_idle()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  cond.wait(lock, [this] { return queue.empty() && !busy; });
+}
+
+/* ----------------------------------------------------------------------
+   raise a pending error of the background thread in the calling thread
+   the error is reported only once
+------------------------------------------------------------------------- */
+
+void AsyncFileWriter::check_error()
+{
+  std::string msg;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    msg.swap(errmsg);
+  }
+  if (!msg.empty()) throw FileWriterException(msg);
+}
+
+/* ----------------------------------------------------------------------
+   background thread: write queued blocks in order until stopped
+   exceptions must not escape the thread, so they are stored and
+     raised by the next call from the caller, later blocks are discarded
+------------------------------------------------------------------------- */
+
+void AsyncFileWriter::run()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  bool failed = false;
+  while (true) {
+    cond.wait(lock, [this] { return !queue.empty() || stopping; });
+    if (queue.empty()) break;
+
+    Block block = std::move(queue.front());
+    queue.pop_front();
+    busy = true;
+    lock.unlock();
+    cond.notify_all();
+
+    std::string msg;
+    if (!failed) {
+      try {
+        if (!block.data.empty()) write_file(block.data.data(), block.data.size());
+        if (block.flush) flush_file();
+      } catch (std::exception &e) {
+        msg = e.what();
+      } catch (...) {
+        msg = "Unknown error in background file writer";
+      }
+    }
+
+    lock.lock();
+    if (!msg.empty()) {
+      failed = true;
+      errmsg = msg;
+    }
+    busy = false;
+    cond.notify_all();
+  }
+}
@@ -0,0 +1,85 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_ASYNC_FILE_WRITER_H
+#define LMP_ASYNC_FILE_WRITER_H
+
+#include "file_writer.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace LAMMPS_NS {
+
+// file writer that can hand data to a background thread, which
+// compresses and writes it while the caller continues
+// derived classes implement the synchronous *_file() methods
+
+class LAMMPS;
+
+class AsyncFileWriter : public FileWriter {
+ public:
+  AsyncFileWriter();
+  ~AsyncFileWriter() override;
+  void open(const std::string &path, bool append = false) override;
+  void close() override;
+  void flush() override;
+  size_t write(const void *buffer, size_t length) override;
+
+  void setAsync(bool enabled);
+  void sync();
+  virtual void setCompressionLevel(int level) = 0;
+  virtual bool hasChecksum() const { return false; }
+  virtual void setChecksum(bool) {}
+
+  // helpers for the compressed dump styles, writer errors become LAMMPS errors
+
+  int modify_param(int narg, char **arg, LAMMPS *lmp);
+  void write_snapshot(const std::function<void()> &write_dump, bool filewriter, bool closeflag,
+                      bool flushflag, LAMMPS *lmp);
+  void sync(LAMMPS *lmp);
+
+ protected:
+  virtual void open_file(const std::string &path, bool append) = 0;
+  virtual void close_file() = 0;
+  virtual void flush_file() = 0;
+  virtual size_t write_file(const void *buffer, size_t length) = 0;
+
+ private:
+  struct Block {
+    std::string data;
+    bool flush;
+  };
+
+  bool async;            // true if writes are done by the background thread
+  bool stopping;         // true if background thread should exit
+  bool busy;             // true while background thread writes a block
+  std::string errmsg;    // first error of the background thread, if any
+  std::string current;   // block currently being filled by the caller
+  std::deque<Block> queue;
+  std::mutex mutex;
+  std::condition_variable cond;
+  std::thread worker;
+
+  void commit(bool flush);
+  void wait_idle();
+  void check_error();
+  void run();
+};
+}    // namespace LAMMPS_NS
+
+#endif
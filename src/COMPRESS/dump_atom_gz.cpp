@@ -18,8 +18,6 @@
 #include "file_writer.h"
 #include "update.h"
 
-#include <cstring>
-
 using namespace LAMMPS_NS;
 
 DumpAtomGZ::DumpAtomGZ(LAMMPS *lmp, int narg, char **arg) : DumpAtom(lmp, narg, arg)
@@ -147,14 +145,16 @@ void DumpAtomGZ::write_data(int n, double *mybuf)
 
 void DumpAtomGZ::write()
 {
-  DumpAtom::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
-    }
-  }
+  writer.write_snapshot([this] { DumpAtom::write(); }, filewriter, multifile, flush_flag, lmp);
+}
+
+/* ----------------------------------------------------------------------
+   wait for output queued for the background thread at the end of a run
+------------------------------------------------------------------------- */
+
+void DumpAtomGZ::post_run()
+{
+  if (filewriter) writer.sync(lmp);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -162,17 +162,6 @@ void DumpAtomGZ::write()
 int DumpAtomGZ::modify_param(int narg, char **arg)
 {
   int consumed = DumpAtom::modify_param(narg, arg);
-  if (consumed == 0) {
-    try {
-      if (strcmp(arg[0], "compression_level") == 0) {
-        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
-        int compression_level = utils::inumeric(FLERR, arg[1], false, lmp);
-        writer.setCompressionLevel(compression_level);
-        return 2;
-      }
-    } catch (FileWriterException &e) {
-      error->one(FLERR, "Illegal dump_modify command: {}", e.what());
-    }
-  }
+  if (consumed == 0) consumed = writer.modify_param(narg, arg, lmp);
   return consumed;
 }
@@ -36,6 +36,7 @@ class DumpAtomGZ : public DumpAtom {
   void write_header(bigint) override;
   void write_data(int, double *) override;
   void write() override;
+  void post_run() override;
 
   int modify_param(int, char **) override;
 };
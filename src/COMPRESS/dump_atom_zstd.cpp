@@ -24,8 +24,6 @@
 #include "file_writer.h"
 #include "update.h"
 
-#include <cstring>
-
 using namespace LAMMPS_NS;
 
 DumpAtomZstd::DumpAtomZstd(LAMMPS *lmp, int narg, char **arg) : DumpAtom(lmp, narg, arg)
@@ -153,14 +151,16 @@ void DumpAtomZstd::write_data(int n, double *mybuf)
 
 void DumpAtomZstd::write()
 {
-  DumpAtom::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
-    }
-  }
+  writer.write_snapshot([this] { DumpAtom::write(); }, filewriter, multifile, flush_flag, lmp);
+}
+
+/* ----------------------------------------------------------------------
+   wait for output queued for the background thread at the end of a run
+------------------------------------------------------------------------- */
+
+void DumpAtomZstd::post_run()
+{
+  if (filewriter) writer.sync(lmp);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -168,21 +168,7 @@ void DumpAtomZstd::write()
 int DumpAtomZstd::modify_param(int narg, char **arg)
 {
   int consumed = DumpAtom::modify_param(narg, arg);
-  if (consumed == 0) {
-    try {
-      if (strcmp(arg[0], "checksum") == 0) {
-        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
-        writer.setChecksum(utils::logical(FLERR, arg[1], false, lmp) == 1);
-        return 2;
-      } else if (strcmp(arg[0], "compression_level") == 0) {
-        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
-        writer.setCompressionLevel(utils::inumeric(FLERR, arg[1], false, lmp));
-        return 2;
-      }
-    } catch (FileWriterException &e) {
-      error->one(FLERR, "Illegal dump_modify command: {}", e.what());
-    }
-  }
+  if (consumed == 0) consumed = writer.modify_param(narg, arg, lmp);
   return consumed;
 }
 
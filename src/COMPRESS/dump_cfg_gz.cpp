@@ -19,8 +19,6 @@
 #include "file_writer.h"
 #include "update.h"
 
-#include <cstring>
-
 using namespace LAMMPS_NS;
 static constexpr double UNWRAPEXPAND = 10.0;
 
@@ -190,14 +188,16 @@ void DumpCFGGZ::write_data(int n, double *mybuf)
 
 void DumpCFGGZ::write()
 {
-  DumpCFG::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
-    }
-  }
+  writer.write_snapshot([this] { DumpCFG::write(); }, filewriter, multifile, flush_flag, lmp);
+}
+
+/* ----------------------------------------------------------------------
+   wait for output queued for the background thread at the end of a run
+------------------------------------------------------------------------- */
+
+void DumpCFGGZ::post_run()
+{
+  if (filewriter) writer.sync(lmp);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -205,17 +205,6 @@ void DumpCFGGZ::write()
 int DumpCFGGZ::modify_param(int narg, char **arg)
 {
   int consumed = DumpCFG::modify_param(narg, arg);
-  if (consumed == 0) {
-    try {
-      if (strcmp(arg[0], "compression_level") == 0) {
-        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
-        int compression_level = utils::inumeric(FLERR, arg[1], false, lmp);
-        writer.setCompressionLevel(compression_level);
-        return 2;
-      }
-    } catch (FileWriterException &e) {
-      error->one(FLERR, "Illegal dump_modify command: {}", e.what());
-    }
-  }
+  if (consumed == 0) consumed = writer.modify_param(narg, arg, lmp);
   return consumed;
 }
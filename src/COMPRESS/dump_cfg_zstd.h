@@ -41,6 +41,7 @@ class DumpCFGZstd : public DumpCFG {
   void write_header(bigint) override;
   void write_data(int, double *) override;
   void write() override;
+  void post_run() override;
 
   int modify_param(int, char **) override;
 };
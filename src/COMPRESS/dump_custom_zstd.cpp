@@ -25,7 +25,6 @@
 #include "error.h"
 #include "update.h"
 
-#include <cstring>
 
 
 using namespace LAMMPS_NS;
@@ -165,16 +164,16 @@ void DumpCustomZstd::write_data(int n, double *mybuf)
 
 void DumpCustomZstd::write()
 {
-  DumpCustom::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) {
-        writer.flush();
-      }
-    }
-  }
+  writer.write_snapshot([this] { DumpCustom::write(); }, filewriter, multifile, flush_flag, lmp);
+}
+
+/* ----------------------------------------------------------------------
+   wait for output queued for the background thread at the end of a run
+------------------------------------------------------------------------- */
+
+void DumpCustomZstd::post_run()
+{
+  if (filewriter) writer.sync(lmp);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -182,21 +181,7 @@ void DumpCustomZstd::write()
 int DumpCustomZstd::modify_param(int narg, char **arg)
 {
   int consumed = DumpCustom::modify_param(narg, arg);
-  if (consumed == 0) {
-    try {
-      if (strcmp(arg[0], "checksum") == 0) {
-        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
-        writer.setChecksum(utils::logical(FLERR, arg[1], false, lmp) == 1);
-        return 2;
-      } else if (strcmp(arg[0], "compression_level") == 0) {
-        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
-        writer.setCompressionLevel(utils::inumeric(FLERR, arg[1], false, lmp));
-        return 2;
-      }
-    } catch (FileWriterException &e) {
-      error->one(FLERR,"Illegal dump_modify command: {}", e.what());
-    }
-  }
+  if (consumed == 0) consumed = writer.modify_param(narg, arg, lmp);
   return consumed;
 }
 
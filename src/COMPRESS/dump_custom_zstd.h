@@ -42,6 +42,7 @@ class DumpCustomZstd : public DumpCustom {
   void write_header(bigint) override;
   void write_data(int, double *) override;
   void write() override;
+  void post_run() override;
 
   int modify_param(int, char **) override;
 };
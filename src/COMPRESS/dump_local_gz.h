@@ -36,6 +36,7 @@ class DumpLocalGZ : public DumpLocal {
   void write_header(bigint) override;
   void write_data(int, double *) override;
   void write() override;
+  void post_run() override;
 
   int modify_param(int, char **) override;
 };
@@ -24,8 +24,6 @@
 #include "file_writer.h"
 #include "update.h"
 
-#include <cstring>
-
 using namespace LAMMPS_NS;
 
 DumpLocalZstd::DumpLocalZstd(LAMMPS *lmp, int narg, char **arg) : DumpLocal(lmp, narg, arg)
@@ -155,14 +153,16 @@ void DumpLocalZstd::write_data(int n, double *mybuf)
 
 void DumpLocalZstd::write()
 {
-  DumpLocal::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
-    }
-  }
+  writer.write_snapshot([this] { DumpLocal::write(); }, filewriter, multifile, flush_flag, lmp);
+}
+
+/* ----------------------------------------------------------------------
+   wait for output queued for the background thread at the end of a run
+------------------------------------------------------------------------- */
+
+void DumpLocalZstd::post_run()
+{
+  if (filewriter) writer.sync(lmp);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -170,21 +170,7 @@ void DumpLocalZstd::write()
 int DumpLocalZstd::modify_param(int narg, char **arg)
 {
   int consumed = DumpLocal::modify_param(narg, arg);
-  if (consumed == 0) {
-    try {
-      if (strcmp(arg[0], "checksum") == 0) {
-        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
-        writer.setChecksum(utils::logical(FLERR, arg[1], false, lmp) == 1);
-        return 2;
-      } else if (strcmp(arg[0], "compression_level") == 0) {
-        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
-        writer.setCompressionLevel(utils::inumeric(FLERR, arg[1], false, lmp));
-        return 2;
-      }
-    } catch (FileWriterException &e) {
-      error->one(FLERR, "Illegal dump_modify command: {}", e.what());
-    }
-  }
+  if (consumed == 0) consumed = writer.modify_param(narg, arg, lmp);
   return consumed;
 }
 
@@ -42,6 +42,7 @@ class DumpXYZZstd : public DumpXYZ {
   void write_header(bigint) override;
   void write_data(int, double *) override;
   void write() override;
+  void post_run() override;
 
   int modify_param(int, char **) override;
 };
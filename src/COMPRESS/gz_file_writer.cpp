@@ -27,12 +27,17 @@ GzFileWriter::GzFileWriter() : compression_level(Z_BEST_COMPRESSION), gzFp(nullp
 
 GzFileWriter::~GzFileWriter()
 {
-  GzFileWriter::close();
+  // a destructor must not throw, errors of pending output are lost here
+
+  try {
+    GzFileWriter::close();
+  } catch (FileWriterException &) {
+  }
 }
 
 /* ---------------------------------------------------------------------- */
 
-void GzFileWriter::open(const std::string &path, bool append)
+void GzFileWriter::open_file(const std::string &path, bool append)
 {
   if (isopen()) return;
 
@@ -50,25 +55,33 @@ void GzFileWriter::open(const std::string &path, bool append)
 
 /* ---------------------------------------------------------------------- */
 
-size_t GzFileWriter::write(const void *buffer, size_t length)
+size_t GzFileWriter::write_file(const void *buffer, size_t length)
 {
   if (!isopen()) return 0;
+  if (length == 0) return 0;
 
-  return gzwrite(gzFp, buffer, length);
+  int errnum;
+  if (gzwrite(gzFp, buffer, length) == 0)
+    throw FileWriterException(
+        fmt::format("Error writing compressed file: {}", gzerror(gzFp, &errnum)));
+  return length;
 }
 
 /* ---------------------------------------------------------------------- */
 
-void GzFileWriter::flush()
+void GzFileWriter::flush_file()
 {
   if (!isopen()) return;
 
-  gzflush(gzFp, Z_SYNC_FLUSH);
+  int errnum;
+  if (gzflush(gzFp, Z_SYNC_FLUSH) != Z_OK)
+    throw FileWriterException(
+        fmt::format("Error writing compressed file: {}", gzerror(gzFp, &errnum)));
 }
 
 /* ---------------------------------------------------------------------- */
 
-void GzFileWriter::close()
+void GzFileWriter::close_file()
 {
   if (!GzFileWriter::isopen()) return;
 
@@ -18,27 +18,29 @@
 #ifndef LMP_GZ_FILE_WRITER_H
 #define LMP_GZ_FILE_WRITER_H
 
-#include "file_writer.h"
+#include "async_file_writer.h"
 
 #include <string>
 #include <zlib.h>
 
 namespace LAMMPS_NS {
 
-class GzFileWriter : public FileWriter {
+class GzFileWriter : public AsyncFileWriter {
   int compression_level;
 
   gzFile gzFp;    // file pointer for the compressed output stream
  public:
   GzFileWriter();
   ~GzFileWriter() override;
-  void open(const std::string &path, bool append = false) override;
-  void close() override;
-  void flush() override;
-  size_t write(const void *buffer, size_t length) override;
   bool isopen() const override;
 
-  void setCompressionLevel(int level);
+  void setCompressionLevel(int level) override;
+
+ protected:
+  void open_file(const std::string &path, bool append) override;
+  void close_file() override;
+  void flush_file() override;
+  size_t write_file(const void *buffer, size_t length) override;
 };
 }    // namespace LAMMPS_NS
 
@@ -34,7 +34,12 @@ ZstdFileWriter::ZstdFileWriter() :
 
 ZstdFileWriter::~ZstdFileWriter()
 {
-  ZstdFileWriter::close();
+  // a destructor must not throw, errors of pending output are lost here
+
+  try {
+    ZstdFileWriter::close();
+  } catch (FileWriterException &) {
+  }
 
   delete[] out_buffer;
   out_buffer = nullptr;
@@ -43,7 +48,7 @@ ZstdFileWriter::~ZstdFileWriter()
 
 /* ---------------------------------------------------------------------- */
 
-void ZstdFileWriter::open(const std::string &path, bool append)
+void ZstdFileWriter::open_file(const std::string &path, bool append)
 {
   if (isopen()) return;
 
@@ -69,7 +74,7 @@ void ZstdFileWriter::open(const std::string &path, bool append)
 
 /* ---------------------------------------------------------------------- */
 
-size_t ZstdFileWriter::write(const void *buffer, size_t length)
+size_t ZstdFileWriter::write_file(const void *buffer, size_t length)
 {
   if (!isopen()) return 0;
 
@@ -78,8 +83,12 @@ size_t ZstdFileWriter::write(const void *buffer, size_t length)
 
   do {
     ZSTD_outBuffer output = {out_buffer, out_buffer_size, 0};
-    ZSTD_compressStream2(cctx, &output, &input, mode);
-    fwrite(out_buffer, sizeof(char), output.pos, fp);
+    size_t ret = ZSTD_compressStream2(cctx, &output, &input, mode);
+    if (ZSTD_isError(ret))
+      throw FileWriterException(
+          fmt::format("Error compressing zstd output: {}", ZSTD_getErrorName(ret)));
+    if (fwrite(out_buffer, sizeof(char), output.pos, fp) != output.pos)
+      throw FileWriterException("Error writing compressed file");
   } while (input.pos < input.size);
 
   return length;
@@ -87,7 +96,7 @@ size_t ZstdFileWriter::write(const void *buffer, size_t length)
 
 /* ---------------------------------------------------------------------- */
 
-void ZstdFileWriter::flush()
+void ZstdFileWriter::flush_file()
 {
   if (!isopen()) return;
 
@@ -98,15 +107,19 @@ void ZstdFileWriter::flush()
   do {
     ZSTD_outBuffer output = {out_buffer, out_buffer_size, 0};
     remaining = ZSTD_compressStream2(cctx, &output, &input, mode);
-    fwrite(out_buffer, sizeof(char), output.pos, fp);
+    if (ZSTD_isError(remaining))
+      throw FileWriterException(
+          fmt::format("Error compressing zstd output: {}", ZSTD_getErrorName(remaining)));
+    if (fwrite(out_buffer, sizeof(char), output.pos, fp) != output.pos)
+      throw FileWriterException("Error writing compressed file");
   } while (remaining);
 
-  fflush(fp);
+  if (fflush(fp) != 0) throw FileWriterException("Error writing compressed file");
 }
 
 /* ---------------------------------------------------------------------- */
 
-void ZstdFileWriter::close()
+void ZstdFileWriter::close_file()
 {
   if (!ZstdFileWriter::isopen()) return;
 
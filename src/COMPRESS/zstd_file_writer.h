@@ -20,7 +20,7 @@
 #ifndef LMP_ZSTD_FILE_WRITER_H
 #define LMP_ZSTD_FILE_WRITER_H
 
-#include "file_writer.h"
+#include "async_file_writer.h"
 
 #include <string>
 #include <zstd.h>
@@ -31,7 +31,7 @@
 
 namespace LAMMPS_NS {
 
-class ZstdFileWriter : public FileWriter {
+class ZstdFileWriter : public AsyncFileWriter {
   int compression_level;
   int checksum_flag;
 
@@ -43,14 +43,17 @@ class ZstdFileWriter : public FileWriter {
  public:
   ZstdFileWriter();
   ~ZstdFileWriter() override;
-  void open(const std::string &path, bool append = false) override;
-  void close() override;
-  void flush() override;
-  size_t write(const void *buffer, size_t length) override;
   bool isopen() const override;
 
-  void setCompressionLevel(int level);
-  void setChecksum(bool enabled);
+  void setCompressionLevel(int level) override;
+  bool hasChecksum() const override { return true; }
+  void setChecksum(bool enabled) override;
+
+ protected:
+  void open_file(const std::string &path, bool append) override;
+  void close_file() override;
+  void flush_file() override;
+  size_t write_file(const void *buffer, size_t length) override;
 };
 }    // namespace LAMMPS_NS
 
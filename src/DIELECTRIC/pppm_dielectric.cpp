@@ -43,6 +43,7 @@ static constexpr FFT_SCALAR ZEROF = 0.0;
 PPPMDielectric::PPPMDielectric(LAMMPS *_lmp) : PPPM(_lmp), efield(nullptr)
 {
   group_group_enable = 0;
+  split_enable = 0;
 
   use_qscaled = true;
 
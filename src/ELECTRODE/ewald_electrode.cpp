@@ -42,6 +42,7 @@ using namespace MathConst;
 EwaldElectrode::EwaldElectrode(LAMMPS *lmp) : Ewald(lmp), boundcorr(nullptr)
 {
   eikr_step = -1;
+  mc_energy_enable = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -72,6 +72,8 @@ PPPMElectrode::PPPMElectrode(LAMMPS *lmp) :
   if (lmp->citeme) lmp->citeme->add(cite_pppm_electrode);
 
   group_group_enable = 0;
+  split_enable = 0;
+  fft_tune_enable = 0;
   electrolyte_density_brick = nullptr;
   electrolyte_density_fft = nullptr;
   compute_vector_called = false;
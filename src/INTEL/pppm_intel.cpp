@@ -59,6 +59,7 @@ PPPMIntel::PPPMIntel(LAMMPS *lmp) : PPPM(lmp)
   rho_points = 0;
 
   _use_table = _use_lrt = 0;
+  split_enable = 0;
 }
 
 PPPMIntel::~PPPMIntel()
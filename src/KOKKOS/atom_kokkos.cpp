@@ -202,6 +202,13 @@ void AtomKokkos::sort()
 {
   // check if all fixes with atom-based arrays support sort on device
 
+  if (!sort_classic && (sortorder != SORT_XYZ)) {
+    if (comm->me == 0)
+      error->warning(FLERR,"Kokkos sorting on device requires 'atom_modify sort/order xyz', "
+                     "switching to classic host sorting");
+    sort_classic = true;
+  }
+
   if (!sort_classic) {
     int flag = 1;
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++) {
@@ -35,6 +35,7 @@ ComputeTempKokkos<DeviceType>::ComputeTempKokkos(LAMMPS *lmp, int narg, char **a
 
   datamask_read = V_MASK | MASK_MASK | RMASS_MASK | TYPE_MASK;
   datamask_modify = EMPTY_MASK;
+  npartial_scalar = npartial_vector = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -62,6 +62,9 @@ FixQEqReaxFFKokkos(LAMMPS *lmp, int narg, char **arg) :
   datamask_read = X_MASK | V_MASK | F_MASK | Q_MASK | MASK_MASK | TYPE_MASK | TAG_MASK;
   datamask_modify = X_MASK;
 
+  if ((precond_style != PRECOND_JACOBI) || (extrap_style != EXTRAP_DEFAULT))
+    error->all(FLERR, "Precond and extrap keywords are not supported with fix {}", style);
+
   nmax = 0;
   m_cap_big = 0;
   allocated_flag = 0;
@@ -33,6 +33,7 @@ template<class DeviceType>
 PairLJCutKokkos<DeviceType>::PairLJCutKokkos(LAMMPS *lmp) : PairLJCut(lmp)
 {
   respa_enable = 0;
+  overlap_enable = 0;
 
   kokkosable = 1;
   atomKK = (AtomKokkos *) atom;
@@ -57,6 +57,8 @@ PPPMKokkos<DeviceType>::PPPMKokkos(LAMMPS *lmp) : PPPM(lmp)
   datamask_modify = F_MASK;
 
   group_group_enable = 0;
+  split_enable = 0;
+  fft_tune_enable = 0;
   triclinic_support = 1;
 
   peratom_allocate_flag = 0;
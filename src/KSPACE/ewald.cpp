@@ -44,12 +44,14 @@ Ewald::Ewald(LAMMPS *lmp) : KSpace(lmp),
   ek(nullptr), sfacrl(nullptr), sfacim(nullptr), sfacrl_all(nullptr), sfacim_all(nullptr),
   cs(nullptr), sn(nullptr), sfacrl_A(nullptr), sfacim_A(nullptr), sfacrl_A_all(nullptr),
   sfacim_A_all(nullptr), sfacrl_B(nullptr), sfacim_B(nullptr), sfacrl_B_all(nullptr),
-  sfacim_B_all(nullptr)
+  sfacim_B_all(nullptr), sfacrl_mc(nullptr), sfacim_mc(nullptr), dsfac_mc(nullptr),
+  dsfac_mc_all(nullptr)
 {
   group_allocate_flag = 0;
   kmax_created = 0;
   ewaldflag = 1;
   group_group_enable = 1;
+  mc_energy_enable = 1;
 
   accuracy_relative = 0.0;
 
@@ -64,6 +66,9 @@ Ewald::Ewald(LAMMPS *lmp) : KSpace(lmp),
   cs = sn = nullptr;
 
   kcount = 0;
+
+  kmax3d_mc = 0;
+  qsum_mc = qsqsum_mc = energy_mc = energy_mc_trial = 0.0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -89,6 +94,10 @@ Ewald::~Ewald()
   memory->destroy(ek);
   memory->destroy3d_offset(cs,-kmax_created);
   memory->destroy3d_offset(sn,-kmax_created);
+  memory->destroy(sfacrl_mc);
+  memory->destroy(sfacim_mc);
+  memory->destroy(dsfac_mc);
+  memory->destroy(dsfac_mc_all);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -1238,9 +1247,189 @@ double Ewald::memory_usage()
   bytes += (double)4 * kmax3d * sizeof(double);
   bytes += (double)nmax*3 * sizeof(double);
   bytes += (double)2 * (2*kmax+1)*3*nmax * sizeof(double);
+  bytes += (double)(10*kmax3d_mc + 8) * sizeof(double);
   return bytes;
 }
 
+/* ----------------------------------------------------------------------
+   incremental Monte Carlo energies
+   cache the total structure factor and charge sums of the current config,
+   so the energy change of a trial move only requires the structure factor
+   contributions of the charges that were removed or added
+------------------------------------------------------------------------- */
+
+double Ewald::mc_energy_setup()
+{
+  if (slabflag)
+    error->all(FLERR,"Kspace style {} does not support incremental energies with slab correction",
+               force->kspace_style);
+
+  if (kmax3d > kmax3d_mc) {
+    memory->destroy(sfacrl_mc);
+    memory->destroy(sfacim_mc);
+    memory->destroy(dsfac_mc);
+    memory->destroy(dsfac_mc_all);
+    kmax3d_mc = kmax3d;
+    memory->create(sfacrl_mc,kmax3d_mc,"ewald:sfacrl_mc");
+    memory->create(sfacim_mc,kmax3d_mc,"ewald:sfacim_mc");
+    memory->create(dsfac_mc,4*kmax3d_mc+4,"ewald:dsfac_mc");
+    memory->create(dsfac_mc_all,4*kmax3d_mc+4,"ewald:dsfac_mc_all");
+  }
+
+  if (atom->nmax > nmax) {
+    memory->destroy(ek);
+    memory->destroy3d_offset(cs,-kmax_created);
+    memory->destroy3d_offset(sn,-kmax_created);
+    nmax = atom->nmax;
+    memory->create(ek,nmax,3,"ewald:ek");
+    memory->create3d_offset(cs,-kmax,kmax,3,nmax,"ewald:cs");
+    memory->create3d_offset(sn,-kmax,kmax,3,nmax,"ewald:sn");
+    kmax_created = kmax;
+  }
+
+  qsum_qsq(0);
+  natoms_original = atom->natoms;
+  qsum_mc = qsum;
+  qsqsum_mc = qsqsum;
+
+  if (triclinic == 0)
+    eik_dot_r();
+  else
+    eik_dot_r_triclinic();
+
+  MPI_Allreduce(sfacrl,sfacrl_mc,kcount,MPI_DOUBLE,MPI_SUM,world);
+  MPI_Allreduce(sfacim,sfacim_mc,kcount,MPI_DOUBLE,MPI_SUM,world);
+
+  double sum = 0.0;
+  for (int k = 0; k < kcount; k++)
+    sum += ug[k] * (sfacrl_mc[k]*sfacrl_mc[k] + sfacim_mc[k]*sfacim_mc[k]);
+
+  energy_mc = qqrd2e * scale * (sum - g_ewald*qsqsum_mc/MY_PIS -
+                                MY_PI2*qsum_mc*qsum_mc / (g_ewald*g_ewald*volume));
+  return energy_mc;
+}
+
+/* ----------------------------------------------------------------------
+   energy change for removing nold charges qold at xold and adding
+   nnew charges qnew at xnew, each proc passes its own lists
+   a displacement is a removal at the old and an addition at the new position
+   selfflag = 0 excludes the interaction of the changed charges with
+     themselves and their periodic images and their Ewald self energy
+------------------------------------------------------------------------- */
+
+double Ewald::mc_energy_delta(int nold, double *qold, double **xold,
+                              int nnew, double *qnew, double **xnew, int selfflag)
+{
+  int i,k;
+  double kv[3],arg;
+
+  // local structure factors of removed and added charges and their charge sums
+
+  const int n2 = 2*kcount;
+  double *sold = dsfac_mc;
+  double *snew = dsfac_mc + n2;
+  double *qsums = dsfac_mc + 2*n2;
+
+  for (k = 0; k < kcount; k++) {
+    mc_kvec(k,kv);
+    sold[2*k] = sold[2*k+1] = 0.0;
+    for (i = 0; i < nold; i++) {
+      arg = kv[0]*xold[i][0] + kv[1]*xold[i][1] + kv[2]*xold[i][2];
+      sold[2*k] += qold[i]*cos(arg);
+      sold[2*k+1] += qold[i]*sin(arg);
+    }
+    snew[2*k] = snew[2*k+1] = 0.0;
+    for (i = 0; i < nnew; i++) {
+      arg = kv[0]*xnew[i][0] + kv[1]*xnew[i][1] + kv[2]*xnew[i][2];
+      snew[2*k] += qnew[i]*cos(arg);
+      snew[2*k+1] += qnew[i]*sin(arg);
+    }
+  }
+
+  qsums[0] = qsums[1] = qsums[2] = qsums[3] = 0.0;
+  for (i = 0; i < nold; i++) {
+    qsums[0] += qold[i];
+    qsums[1] += qold[i]*qold[i];
+  }
+  for (i = 0; i < nnew; i++) {
+    qsums[2] += qnew[i];
+    qsums[3] += qnew[i]*qnew[i];
+  }
+
+  MPI_Allreduce(dsfac_mc,dsfac_mc_all,2*n2+4,MPI_DOUBLE,MPI_SUM,world);
+
+  sold = dsfac_mc_all;
+  snew = dsfac_mc_all + n2;
+  qsums = dsfac_mc_all + 2*n2;
+
+  // energy of new config and, if requested, self energy of changed charges
+
+  double sum = 0.0;
+  double sumold = 0.0;
+  double sumnew = 0.0;
+  double srl,sim;
+  for (k = 0; k < kcount; k++) {
+    srl = sfacrl_mc[k] + snew[2*k] - sold[2*k];
+    sim = sfacim_mc[k] + snew[2*k+1] - sold[2*k+1];
+    sum += ug[k] * (srl*srl + sim*sim);
+    if (!selfflag) {
+      sumold += ug[k] * (sold[2*k]*sold[2*k] + sold[2*k+1]*sold[2*k+1]);
+      sumnew += ug[k] * (snew[2*k]*snew[2*k] + snew[2*k+1]*snew[2*k+1]);
+    }
+  }
+
+  const double qscale = qqrd2e * scale;
+  const double gvol = g_ewald*g_ewald*volume;
+  const double qs = qsum_mc + qsums[2] - qsums[0];
+  const double qsq = qsqsum_mc + qsums[3] - qsums[1];
+  energy_mc_trial = qscale * (sum - g_ewald*qsq/MY_PIS - MY_PI2*qs*qs/gvol);
+
+  double delta = energy_mc_trial - energy_mc;
+  if (!selfflag) {
+    delta -= qscale * (sumnew - g_ewald*qsums[3]/MY_PIS - MY_PI2*qsums[2]*qsums[2]/gvol);
+    delta += qscale * (sumold - g_ewald*qsums[1]/MY_PIS - MY_PI2*qsums[0]*qsums[0]/gvol);
+  }
+  return delta;
+}
+
+/* ----------------------------------------------------------------------
+   make the last trial change part of the cached state
+------------------------------------------------------------------------- */
+
+void Ewald::mc_energy_accept()
+{
+  const int n2 = 2*kcount;
+  const double *sold = dsfac_mc_all;
+  const double *snew = dsfac_mc_all + n2;
+  const double *qsums = dsfac_mc_all + 2*n2;
+
+  for (int k = 0; k < kcount; k++) {
+    sfacrl_mc[k] += snew[2*k] - sold[2*k];
+    sfacim_mc[k] += snew[2*k+1] - sold[2*k+1];
+  }
+  qsum_mc += qsums[2] - qsums[0];
+  qsqsum_mc += qsums[3] - qsums[1];
+  energy_mc = energy_mc_trial;
+}
+
+/* ----------------------------------------------------------------------
+   Cartesian wave vector of K-vector k, consistent with eik_dot_r()
+------------------------------------------------------------------------- */
+
+void Ewald::mc_kvec(int k, double *kv)
+{
+  if (triclinic == 0) {
+    kv[0] = kxvecs[k]*unitk[0];
+    kv[1] = kyvecs[k]*unitk[1];
+    kv[2] = kzvecs[k]*unitk[2];
+  } else {
+    kv[0] = 2.0*MY_PI*kxvecs[k];
+    kv[1] = 2.0*MY_PI*kyvecs[k];
+    kv[2] = 2.0*MY_PI*kzvecs[k];
+    x2lamdaT(kv,kv);
+  }
+}
+
 /* ----------------------------------------------------------------------
    group-group interactions
  ------------------------------------------------------------------------- */
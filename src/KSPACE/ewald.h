@@ -36,6 +36,10 @@ class Ewald : public KSpace {
 
   void compute_group_group(int, int, int) override;
 
+  double mc_energy_setup() override;
+  double mc_energy_delta(int, double *, double **, int, double *, double **, int) override;
+  void mc_energy_accept() override;
+
  protected:
   int kxmax, kymax, kzmax;
   int kcount, kmax, kmax3d, kmax_created;
@@ -75,6 +79,16 @@ class Ewald : public KSpace {
   void slabcorr_groups(int, int, int);
   void allocate_groups();
   void deallocate_groups();
+
+  // incremental Monte Carlo energies
+
+  int kmax3d_mc;
+  double *sfacrl_mc, *sfacim_mc;      // cached structure factor of current config
+  double *dsfac_mc, *dsfac_mc_all;    // structure factors and charge sums of changed charges
+  double qsum_mc, qsqsum_mc;          // cached charge sums of current config
+  double energy_mc, energy_mc_trial;
+
+  void mc_kvec(int, double *);
 };
 
 }    // namespace LAMMPS_NS
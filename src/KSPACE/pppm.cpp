@@ -36,6 +36,7 @@
 #include "pair.h"
 #include "remap_wrap.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 
@@ -49,6 +50,8 @@ static constexpr double LARGE = 10000.0;
 static constexpr double SMALL = 0.00001;
 static constexpr double EPS_HOC = 1.0e-7;
 static constexpr FFT_SCALAR ZEROF = 0.0;
+static constexpr int NTUNE = 5;
+static constexpr int MAXLINE = 256;
 
 /* ---------------------------------------------------------------------- */
 
@@ -69,6 +72,8 @@ PPPM::PPPM(LAMMPS *lmp) : KSpace(lmp),
 
   pppmflag = 1;
   group_group_enable = 1;
+  split_enable = 1;
+  fft_tune_enable = 1;
   triclinic = domain->triclinic;
 
   nfactors = 3;
@@ -81,6 +86,8 @@ PPPM::PPPM(LAMMPS *lmp) : KSpace(lmp),
   MPI_Comm_size(world,&nprocs);
 
   nfft_both = 0;
+  npey_tune = npez_tune = 0;
+  tune_grid[0] = tune_grid[1] = tune_grid[2] = 0;
   nxhi_in = nxlo_in = nxhi_out = nxlo_out = 0;
   nyhi_in = nylo_in = nyhi_out = nylo_out = 0;
   nzhi_in = nzlo_in = nzhi_out = nzlo_out = 0;
@@ -329,6 +336,10 @@ void PPPM::init()
 
   double estimated_accuracy = final_accuracy();
 
+  // optionally pick FFT decomposition and remap mode by timing candidates
+
+  if (fft_tune_flag) tune_fft();
+
   // allocate K-space dependent memory
   // don't invoke allocate peratom() or group(), will be allocated when needed
 
@@ -587,8 +598,18 @@ void PPPM::reset_grid()
 
 void PPPM::compute(int eflag, int vflag)
 {
-  int i,j;
+  compute_grid(eflag,vflag);
+  compute_force();
+}
 
+/* ----------------------------------------------------------------------
+   grid part of compute(): map charges to grid, solve Poisson equation,
+   and communicate electric field to ghost cells
+   does not change forces, so it can run concurrently with the pair style
+------------------------------------------------------------------------- */
+
+void PPPM::compute_grid(int eflag, int vflag)
+{
   // set energy/virial flags
   // invoke allocate_peratom() if needed for first time
 
@@ -664,6 +685,20 @@ void PPPM::compute(int eflag, int vflag)
       gc->forward_comm(Grid3d::KSPACE,this,FORWARD_IK_PERATOM,7,sizeof(FFT_SCALAR),
                        gc_buf1,gc_buf2,MPI_FFT_SCALAR);
   }
+}
+
+/* ----------------------------------------------------------------------
+   force part of compute(): interpolate forces from the grid and
+   sum energy and virial, must follow compute_grid()
+------------------------------------------------------------------------- */
+
+void PPPM::compute_force()
+{
+  int i,j;
+
+  // return if there are no charges
+
+  if (qsqsum == 0.0) return;
 
   // calculate the force on my particles
 
@@ -1395,7 +1430,13 @@ void PPPM::set_grid_local()
   //  npez_fft = nprocs;
   //} else procs2grid2d(nprocs,ny_pppm,nz_pppm,&npey_fft,&npez_fft);
 
-  procs2grid2d(nprocs,ny_pppm,nz_pppm,&npey_fft,&npez_fft);
+  // use autotuned decomposition if it was determined for the current grid
+
+  if (npey_tune && (tune_grid[0] == nx_pppm) && (tune_grid[1] == ny_pppm) &&
+      (tune_grid[2] == nz_pppm)) {
+    npey_fft = npey_tune;
+    npez_fft = npez_tune;
+  } else procs2grid2d(nprocs,ny_pppm,nz_pppm,&npey_fft,&npez_fft);
 
   int me_y = me % npey_fft;
   int me_z = me / npey_fft;
@@ -2738,6 +2779,206 @@ void PPPM::procs2grid2d(int nprocs, int nx, int ny, int *px, int *py)
   }
 }
 
+/* ----------------------------------------------------------------------
+   autotune x-pencil FFT decomposition and remap mode for current grid
+   time all factorizations of nprocs into npey x npez columns with
+     point-to-point and collective remaps and keep the fastest
+   results are kept in memory, so a later init() with the same grid size,
+     # of procs, and FFT library reuses them without timing
+   if a wisdom file is set, reuse its last entry matching the grid size,
+     # of procs, and FFT library, or else append the new result to it
+------------------------------------------------------------------------- */
+
+void PPPM::tune_fft()
+{
+  if (nprocs == 1) return;
+
+  std::string fftlib = LMP_FFT_LIB;
+  std::replace(fftlib.begin(),fftlib.end(),' ','_');
+  std::string key = fmt::format("{} {} {} {} {} {}",nx_pppm,ny_pppm,nz_pppm,nprocs,
+                                LMP_FFT_PREC,fftlib);
+
+  // best = npey, npez, collective flag of fastest layout
+
+  int best[3] = {0, 0, collective_flag};
+
+  // the key is the same on all procs, so all procs take the same branch
+
+  auto cached = tune_cache.find(key);
+  const bool incache = (cached != tune_cache.end());
+  if (incache) std::copy(cached->second.begin(), cached->second.end(), best);
+
+  if (!incache && (me == 0) && !fft_wisdom.empty()) {
+    FILE *fp = fopen(fft_wisdom.c_str(),"r");
+    if (fp) {
+      char line[MAXLINE];
+      while (fgets(line,MAXLINE,fp)) {
+        auto words = utils::split_words(utils::trim_comment(line));
+        if (words.size() < 9) continue;
+        if (fmt::format("{} {} {} {} {} {}",words[0],words[1],words[2],words[3],
+                        words[4],words[5]) != key) continue;
+        if (!utils::is_integer(words[6]) || !utils::is_integer(words[7]) ||
+            !utils::is_integer(words[8])) continue;
+        int npey = std::stoi(words[6]);
+        int npez = std::stoi(words[7]);
+        if ((npey < 1) || (npez < 1) || (npey*npez != nprocs)) continue;
+        best[0] = npey;
+        best[1] = npez;
+        best[2] = std::stoi(words[8]) ? 1 : 0;
+      }
+      fclose(fp);
+    }
+  }
+  if (!incache) MPI_Bcast(best,3,MPI_INT,0,world);
+
+  if (incache) {
+    if (me == 0)
+      utils::logmesg(lmp,"  FFT layout {}x{} with {} remap from previous autotune\n",
+                     best[0],best[1],best[2] ? "collective" : "point-to-point");
+  } else if (best[0] > 0) {
+    if (me == 0)
+      utils::logmesg(lmp,"  FFT layout {}x{} with {} remap from wisdom file {}\n",
+                     best[0],best[1],best[2] ? "collective" : "point-to-point",fft_wisdom);
+  } else {
+
+    // brick decomposition of grid, same as in allocate()
+
+    auto *gtmp = new Grid3d(lmp,world,nx_pppm,ny_pppm,nz_pppm);
+    gtmp->set_distance(0.5*neighbor->skin + qdist);
+    gtmp->set_stencil_atom(-nlower,nupper);
+    gtmp->set_shift_atom(shiftatom_lo,shiftatom_hi);
+    gtmp->set_zfactor(slab_volfactor);
+    gtmp->setup_grid(nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                     nxlo_out,nxhi_out,nylo_out,nyhi_out,nzlo_out,nzhi_out);
+    delete gtmp;
+
+    // default layout is the reference
+
+    int npey_def,npez_def;
+    procs2grid2d(nprocs,ny_pppm,nz_pppm,&npey_def,&npez_def);
+    double time_def = time_fft_layout(npey_def,npez_def,collective_flag);
+    double time_best = time_def;
+    best[0] = npey_def;
+    best[1] = npez_def;
+
+    for (int npey = 1; npey <= nprocs; npey++) {
+      if (nprocs % npey) continue;
+      int npez = nprocs/npey;
+      if ((npey > ny_pppm) || (npez > nz_pppm)) continue;
+      for (int collective = 0; collective < 2; collective++) {
+        if ((npey == npey_def) && (collective == collective_flag)) continue;
+        double time = time_fft_layout(npey,npez,collective);
+        if (time < time_best) {
+          time_best = time;
+          best[0] = npey;
+          best[1] = npez;
+          best[2] = collective;
+        }
+      }
+    }
+
+    if (me == 0) {
+      utils::logmesg(lmp,"  FFT autotune: layout {}x{} with {} remap = {:.4g} ms/step, "
+                     "default {}x{} with {} remap = {:.4g} ms/step\n",
+                     best[0],best[1],best[2] ? "collective" : "point-to-point",1000.0*time_best,
+                     npey_def,npez_def,collective_flag ? "collective" : "point-to-point",
+                     1000.0*time_def);
+
+      if (!fft_wisdom.empty()) {
+        FILE *fp = fopen(fft_wisdom.c_str(),"a");
+        if (fp == nullptr) {
+          error->warning(FLERR,"Cannot open FFT wisdom file {}: {}",fft_wisdom,
+                         utils::getsyserror());
+        } else {
+          if (platform::ftell(fp) == 0)
+            fputs("# LAMMPS PPPM FFT wisdom\n# nx ny nz nprocs precision fftlib "
+                  "npey npez collective ms/step\n",fp);
+          utils::print(fp,"{} {} {} {} {:.6g}\n",key,best[0],best[1],best[2],1000.0*time_best);
+          fclose(fp);
+        }
+      }
+    }
+  }
+
+  tune_cache[key] = {best[0], best[1], best[2]};
+  npey_tune = best[0];
+  npez_tune = best[1];
+  collective_flag = best[2];
+  tune_grid[0] = nx_pppm;
+  tune_grid[1] = ny_pppm;
+  tune_grid[2] = nz_pppm;
+  set_grid_local();
+}
+
+/* ----------------------------------------------------------------------
+   time one Poisson solve worth of remap and 3d FFTs for FFT layout
+     with npey x npez columns and remap mode collective
+   uses current brick decomposition nlo_in,nhi_in
+   returns time per step of proc 0, so all procs make the same choice
+------------------------------------------------------------------------- */
+
+double PPPM::time_fft_layout(int npey, int npez, int collective)
+{
+  int me_y = me % npey;
+  int me_z = me / npey;
+  int ylo = me_y*ny_pppm/npey;
+  int yhi = (me_y+1)*ny_pppm/npey - 1;
+  int zlo = me_z*nz_pppm/npez;
+  int zhi = (me_z+1)*nz_pppm/npez - 1;
+
+  int nfft_tune = nx_pppm * (yhi-ylo+1) * (zhi-zlo+1);
+  int nbrick = (nxhi_in-nxlo_in+1) * (nyhi_in-nylo_in+1) * (nzhi_in-nzlo_in+1);
+  int nboth = MAX(nfft_tune,nbrick);
+
+  FFT_SCALAR *data,*work;
+  memory->create(data,nboth,"pppm:tune_data");
+  memory->create(work,2*nboth,"pppm:tune_work");
+  for (int i = 0; i < nboth; i++) data[i] = ZEROF;
+  for (int i = 0; i < 2*nboth; i++) work[i] = ZEROF;
+
+  int tmp;
+  auto *fft_fwd = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                            0,nx_pppm-1,ylo,yhi,zlo,zhi,
+                            0,nx_pppm-1,ylo,yhi,zlo,zhi,
+                            0,0,&tmp,collective);
+  auto *fft_bwd = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                            0,nx_pppm-1,ylo,yhi,zlo,zhi,
+                            nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                            0,0,&tmp,collective);
+  auto *rmp = new Remap(lmp,world,
+                        nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                        0,nx_pppm-1,ylo,yhi,zlo,zhi,
+                        1,0,0,FFT_PRECISION,collective);
+
+  // one step = remap of density + forward FFT + backward FFT(s) as in poisson()
+  // first step is not timed to exclude one-time setup costs
+
+  int nbackward = (differentiation_flag == 1) ? 1 : 3;
+  double time = 0.0;
+
+  for (int istep = 0; istep <= NTUNE; istep++) {
+    if (istep == 1) {
+      MPI_Barrier(world);
+      time = platform::walltime();
+    }
+    rmp->perform(data,data,work);
+    fft_fwd->compute(work,work,FFT3d::FORWARD);
+    for (int i = 0; i < nbackward; i++) fft_bwd->compute(work,work,FFT3d::BACKWARD);
+  }
+
+  MPI_Barrier(world);
+  time = (platform::walltime() - time) / NTUNE;
+  MPI_Bcast(&time,1,MPI_DOUBLE,0,world);
+
+  delete fft_fwd;
+  delete fft_bwd;
+  delete rmp;
+  memory->destroy(data);
+  memory->destroy(work);
+
+  return time;
+}
+
 /* ----------------------------------------------------------------------
    charge assignment into rho1d
    dx,dy,dz = distance of particle from "lower left" grid point
@@ -23,6 +23,9 @@ KSpaceStyle(pppm,PPPM);
 #include "kspace.h"
 #include "lmpfftsettings.h" // IWYU pragma: export
 
+#include <array>
+#include <map>
+
 namespace LAMMPS_NS {
 
 class PPPM : public KSpace {
@@ -34,6 +37,8 @@ class PPPM : public KSpace {
   void setup() override;
   void reset_grid() override;
   void compute(int, int) override;
+  void compute_grid(int, int) override;
+  void compute_force() override;
   int timing_1d(int, double &) override;
   int timing_3d(int, double &) override;
   double memory_usage() override;
@@ -57,6 +62,9 @@ class PPPM : public KSpace {
   int nxlo_fft, nylo_fft, nzlo_fft, nxhi_fft, nyhi_fft, nzhi_fft;
   int nlower, nupper;
   int ngrid, nfft_brick, nfft, nfft_both;
+  int npey_tune, npez_tune;    // autotuned FFT decomposition, 0 if not set
+  int tune_grid[3];            // FFT grid for which npey_tune,npez_tune apply
+  std::map<std::string, std::array<int, 3>> tune_cache;    // tuned layouts by grid/procs/FFT
 
   FFT_SCALAR ***density_brick;
   FFT_SCALAR ***vdx_brick, ***vdy_brick, ***vdz_brick;
@@ -135,6 +143,8 @@ class PPPM : public KSpace {
   virtual void poisson_peratom();
   virtual void fieldforce_peratom();
   void procs2grid2d(int, int, int, int *, int *);
+  void tune_fft();
+  double time_fft_layout(int, int, int);
   void compute_rho1d(const FFT_SCALAR &, const FFT_SCALAR &, const FFT_SCALAR &);
   void compute_drho1d(const FFT_SCALAR &, const FFT_SCALAR &, const FFT_SCALAR &);
   void compute_rho_coeff();
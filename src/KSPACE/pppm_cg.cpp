@@ -44,6 +44,7 @@ PPPMCG::PPPMCG(LAMMPS *lmp) : PPPM(lmp),
 {
   num_charged = -1;
   group_group_enable = 1;
+  split_enable = 0;
 }
 
 /* ---------------------------------------------------------------------- */
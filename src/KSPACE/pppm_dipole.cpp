@@ -66,6 +66,8 @@ PPPMDipole::PPPMDipole(LAMMPS *lmp) : PPPM(lmp),
 {
   dipoleflag = 1;
   group_group_enable = 0;
+  split_enable = 0;
+  fft_tune_enable = 0;
 
   gc_dipole = nullptr;
 }
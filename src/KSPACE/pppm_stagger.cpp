@@ -45,6 +45,7 @@ PPPMStagger::PPPMStagger(LAMMPS *lmp) :
 {
   stagger_flag = 1;
   group_group_enable = 0;
+  split_enable = 0;
 
   memory->create(gf_b2,8,7,"pppm_stagger:gf_b2");
   gf_b2[1][0] = 1.0;
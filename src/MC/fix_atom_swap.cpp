@@ -33,6 +33,7 @@
 #include "kspace.h"
 #include "memory.h"
 #include "modify.h"
+#include "neigh_list.h"
 #include "neighbor.h"
 #include "pair.h"
 #include "pair_hybrid.h"
@@ -44,17 +45,20 @@
 #include <cfloat>
 #include <cmath>
 #include <cstring>
+#include <utility>
 
 using namespace LAMMPS_NS;
 using namespace FixConst;
 
+static constexpr double BIG = 1.0e20;
+
 /* ---------------------------------------------------------------------- */
 
 FixAtomSwap::FixAtomSwap(LAMMPS *lmp, int narg, char **arg) :
     Fix(lmp, narg, arg), region(nullptr), idregion(nullptr), type_list(nullptr), mu(nullptr),
     qtype(nullptr), sqrt_mass_ratio(nullptr), local_swap_iatom_list(nullptr),
     local_swap_jatom_list(nullptr), local_swap_atom_list(nullptr), random_equal(nullptr),
-    random_unequal(nullptr), c_pe(nullptr)
+    random_unequal(nullptr), c_pe(nullptr), list(nullptr), random_parallel(nullptr)
 {
   if (narg < 10) error->all(FLERR, "Illegal fix atom/swap command");
 
@@ -97,6 +101,11 @@ FixAtomSwap::FixAtomSwap(LAMMPS *lmp, int narg, char **arg) :
 
   random_unequal = new RanPark(lmp, seed);
 
+  // random number generator for parallel sweeps, different on each proc
+
+  if (parallel_flag) random_parallel = new RanPark(lmp, seed + comm->me);
+  nsector = (domain->dimension == 3) ? 8 : 4;
+
   // set up reneighboring
 
   force_reneighbor = 1;
@@ -132,9 +141,11 @@ FixAtomSwap::~FixAtomSwap()
   memory->destroy(sqrt_mass_ratio);
   memory->destroy(local_swap_iatom_list);
   memory->destroy(local_swap_jatom_list);
+  memory->destroy(local_swap_atom_list);
   delete[] idregion;
   delete random_equal;
   delete random_unequal;
+  delete random_parallel;
 }
 
 /* ----------------------------------------------------------------------
@@ -147,6 +158,7 @@ void FixAtomSwap::options(int narg, char **arg)
 
   ke_flag = 1;
   semi_grand_flag = 0;
+  parallel_flag = 0;
   nswaptypes = 0;
   nmutypes = 0;
 
@@ -166,6 +178,10 @@ void FixAtomSwap::options(int narg, char **arg)
       if (iarg + 2 > narg) error->all(FLERR, "Illegal fix atom/swap command");
       semi_grand_flag = utils::logical(FLERR, arg[iarg + 1], false, lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg], "parallel") == 0) {
+      if (iarg + 2 > narg) error->all(FLERR, "Illegal fix atom/swap command");
+      parallel_flag = utils::logical(FLERR, arg[iarg + 1], false, lmp);
+      iarg += 2;
     } else if (strcmp(arg[iarg], "types") == 0) {
       if (iarg + 3 > narg) error->all(FLERR, "Illegal fix atom/swap command");
       iarg++;
@@ -305,6 +321,25 @@ void FixAtomSwap::init()
         if (cutsq[type_list[iswaptype]][ktype] != cutsq[type_list[jswaptype]][ktype])
           unequal_cutoffs = true;
 
+  // parallel sweeps compute energy changes from pairwise interactions
+  //   with the neighbors of the swapped atoms only
+  // type exclusions are applied when the neighbor list is built
+  //   and would no longer match after atoms change their type
+
+  if (parallel_flag) {
+    if (!force->pair->single_enable || force->pair->manybody_flag)
+      error->all(FLERR, "Fix atom/swap parallel yes requires a pair style with a single() "
+                 "function and no many-body terms");
+    if (force->kspace) error->all(FLERR, "Fix atom/swap parallel yes cannot be used with kspace");
+    if (domain->triclinic)
+      error->all(FLERR, "Fix atom/swap parallel yes cannot be used with triclinic boxes");
+    if (unequal_cutoffs)
+      error->all(FLERR, "Fix atom/swap parallel yes requires equal cutoffs for all swap types");
+    if (neighbor->nex_type)
+      error->all(FLERR, "Fix atom/swap parallel yes cannot be used with neigh_modify exclude type");
+    neighbor->add_request(this, NeighConst::REQ_FULL | NeighConst::REQ_OCCASIONAL);
+  }
+
   // check that no swappable atoms are in atom->firstgroup
   // swapping such an atom might not leave firstgroup atoms first
 
@@ -323,6 +358,13 @@ void FixAtomSwap::init()
   }
 }
 
+/* ---------------------------------------------------------------------- */
+
+void FixAtomSwap::init_list(int /*id*/, NeighList *ptr)
+{
+  list = ptr;
+}
+
 /* ----------------------------------------------------------------------
    attempt Monte Carlo swaps
 ------------------------------------------------------------------------- */
@@ -345,6 +387,24 @@ void FixAtomSwap::pre_exchange()
   if (modify->n_pre_neighbor) modify->pre_neighbor();
   neighbor->build(1);
 
+  // parallel mode: one checkerboard sweep over sectors of all sub-domains
+  //   with local energy differences, no global energy is needed
+
+  if (parallel_flag) {
+    neighbor->build_one(list);
+
+    int ncount[2], ncount_all[2];
+    ncount[1] = sweep_parallel(ncount[0]);
+    MPI_Allreduce(ncount, ncount_all, 2, MPI_INT, MPI_SUM, world);
+
+    nswap_attempts += ncount_all[0];
+    nswap_successes += ncount_all[1];
+
+    next_reneighbor = update->ntimestep + nevery;
+    mc_active = 0;
+    return;
+  }
+
   // energy_stored = energy of current state
   // will be updated after accepted swaps
 
@@ -573,6 +633,265 @@ double FixAtomSwap::energy_full()
   return total_energy;
 }
 
+/* ----------------------------------------------------------------------
+   perform one checkerboard sweep over the sectors of each sub-domain
+   sectors are the 2^dim octants (quadrants in 2d) of a sub-domain
+   all procs work on the sector with the same index at the same time
+   atoms in such sectors are more than the pair cutoff apart, so swaps
+     on different procs do not interact and use local energy differences
+   sector order is random, ghost atoms are updated after each sector
+   return # of accepted swaps on this proc, nattempt = # of attempts
+------------------------------------------------------------------------- */
+
+int FixAtomSwap::sweep_parallel(int &nattempt)
+{
+  double *sublo = domain->sublo;
+  double *subhi = domain->subhi;
+  double cut = force->pair->cutforce;
+
+  int flag = 0;
+  for (int idim = 0; idim < domain->dimension; idim++)
+    if (0.5 * (subhi[idim] - sublo[idim]) < cut) flag = 1;
+  int flagall;
+  MPI_Allreduce(&flag, &flagall, 1, MPI_INT, MPI_MAX, world);
+  if (flagall)
+    error->all(FLERR, "Fix atom/swap parallel yes requires all sub-domains to be "
+               "at least twice the pair cutoff {} wide", cut);
+
+  // random sector order, same on all procs
+
+  int order[8];
+  for (int m = 0; m < nsector; m++) order[m] = m;
+  for (int m = nsector - 1; m > 0; m--)
+    std::swap(order[m], order[static_cast<int>((m + 1) * random_equal->uniform())]);
+
+  // distribute Ncycle attempts per proc across the sectors
+
+  int nsuccess = 0;
+  nattempt = 0;
+
+  for (int m = 0; m < nsector; m++) {
+    update_sector_atoms_list(order[m]);
+    int ntrial = ncycles / nsector + ((m < ncycles % nsector) ? 1 : 0);
+
+    for (int n = 0; n < ntrial; n++) {
+      if (semi_grand_flag) {
+        if (nswap_local == 0) break;
+        nsuccess += attempt_semi_grand_local();
+      } else {
+        if ((niswap_local == 0) || (njswap_local == 0)) break;
+        nsuccess += attempt_swap_local();
+      }
+      nattempt++;
+    }
+
+    comm->forward_comm(this);
+  }
+
+  return nsuccess;
+}
+
+/* ----------------------------------------------------------------------
+   attempt a semi-grand swap of a single atom in the current sector
+   energy change only includes pairwise interactions of the atom
+------------------------------------------------------------------------- */
+
+int FixAtomSwap::attempt_semi_grand_local()
+{
+  int *type = atom->type;
+
+  int i = local_swap_atom_list[static_cast<int>(nswap_local * random_parallel->uniform())];
+  int itype = type[i];
+  int jtype = itype;
+  while (jtype == itype)
+    jtype = type_list[static_cast<int>(nswaptypes * random_parallel->uniform())];
+
+  double energy_before = energy_local(i, -1);
+  type[i] = jtype;
+  double energy_after = energy_local(i, -1);
+
+  if (random_parallel->uniform() <
+      exp(beta * (energy_before - energy_after + mu[jtype] - mu[itype]))) {
+    if (ke_flag) {
+      atom->v[i][0] *= sqrt_mass_ratio[itype][jtype];
+      atom->v[i][1] *= sqrt_mass_ratio[itype][jtype];
+      atom->v[i][2] *= sqrt_mass_ratio[itype][jtype];
+    }
+    return 1;
+  }
+
+  type[i] = itype;
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   attempt a swap of a pair of atoms in the current sector
+   energy change only includes pairwise interactions of the two atoms
+------------------------------------------------------------------------- */
+
+int FixAtomSwap::attempt_swap_local()
+{
+  int *type = atom->type;
+  double *q = atom->q;
+
+  int iwhich = static_cast<int>(niswap_local * random_parallel->uniform());
+  int jwhich = static_cast<int>(njswap_local * random_parallel->uniform());
+  int i = local_swap_iatom_list[iwhich];
+  int j = local_swap_jatom_list[jwhich];
+  int itype = type_list[0];
+  int jtype = type_list[1];
+
+  double energy_before = energy_local(i, j);
+
+  type[i] = jtype;
+  type[j] = itype;
+  if (atom->q_flag) {
+    q[i] = qtype[1];
+    q[j] = qtype[0];
+  }
+
+  double energy_after = energy_local(i, j);
+
+  // swap accepted, i and j trade places in the candidate lists
+
+  if (random_parallel->uniform() < exp(beta * (energy_before - energy_after))) {
+    local_swap_iatom_list[iwhich] = j;
+    local_swap_jatom_list[jwhich] = i;
+    if (ke_flag) {
+      atom->v[i][0] *= sqrt_mass_ratio[itype][jtype];
+      atom->v[i][1] *= sqrt_mass_ratio[itype][jtype];
+      atom->v[i][2] *= sqrt_mass_ratio[itype][jtype];
+      atom->v[j][0] *= sqrt_mass_ratio[jtype][itype];
+      atom->v[j][1] *= sqrt_mass_ratio[jtype][itype];
+      atom->v[j][2] *= sqrt_mass_ratio[jtype][itype];
+    }
+    return 1;
+  }
+
+  type[i] = itype;
+  type[j] = jtype;
+  if (atom->q_flag) {
+    q[i] = qtype[0];
+    q[j] = qtype[1];
+  }
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   compute pairwise energy of local atom i and optional local atom j
+     with all their neighbors, the i,j interaction is counted once
+   uses the full neighbor list and the pair style single() function
+------------------------------------------------------------------------- */
+
+double FixAtomSwap::energy_local(int i, int j)
+{
+  double delx, dely, delz, rsq, fpair, factor_lj, factor_coul;
+
+  double **x = atom->x;
+  int *type = atom->type;
+  double *special_lj = force->special_lj;
+  double *special_coul = force->special_coul;
+  double **cutsq = force->pair->cutsq;
+  int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+
+  double energy = 0.0;
+  int ilist[2] = {i, j};
+
+  for (int m = 0; m < 2; m++) {
+    int n = ilist[m];
+    if (n < 0) continue;
+    int ntype = type[n];
+    int *jlist = firstneigh[n];
+    int jnum = numneigh[n];
+
+    for (int jj = 0; jj < jnum; jj++) {
+      int k = jlist[jj];
+      factor_lj = special_lj[sbmask(k)];
+      factor_coul = special_coul[sbmask(k)];
+      k &= NEIGHMASK;
+      if ((m == 1) && (k == i)) continue;
+
+      delx = x[n][0] - x[k][0];
+      dely = x[n][1] - x[k][1];
+      delz = x[n][2] - x[k][2];
+      rsq = delx * delx + dely * dely + delz * delz;
+      int ktype = type[k];
+
+      if (rsq < cutsq[ntype][ktype])
+        energy += force->pair->single(n, k, ntype, ktype, rsq, factor_coul, factor_lj, fpair);
+    }
+  }
+
+  return energy;
+}
+
+/* ----------------------------------------------------------------------
+   update the lists of local swap candidates inside sector isector
+   bit idim of isector selects lower or upper half of the sub-domain
+------------------------------------------------------------------------- */
+
+void FixAtomSwap::update_sector_atoms_list(int isector)
+{
+  int nlocal = atom->nlocal;
+  int *type = atom->type;
+  int *mask = atom->mask;
+  double **x = atom->x;
+
+  if (atom->nmax > atom_swap_nmax) {
+    memory->sfree(local_swap_atom_list);
+    memory->sfree(local_swap_iatom_list);
+    memory->sfree(local_swap_jatom_list);
+    atom_swap_nmax = atom->nmax;
+    local_swap_atom_list =
+        (int *) memory->smalloc(atom_swap_nmax * sizeof(int), "MCSWAP:local_swap_atom_list");
+    local_swap_iatom_list =
+        (int *) memory->smalloc(atom_swap_nmax * sizeof(int), "MCSWAP:local_swap_iatom_list");
+    local_swap_jatom_list =
+        (int *) memory->smalloc(atom_swap_nmax * sizeof(int), "MCSWAP:local_swap_jatom_list");
+  }
+
+  double lo[3], hi[3];
+  for (int idim = 0; idim < 3; idim++) {
+    double mid = 0.5 * (domain->sublo[idim] + domain->subhi[idim]);
+    if ((idim == 2) && (domain->dimension == 2)) {
+      lo[idim] = -BIG;
+      hi[idim] = BIG;
+    } else if ((isector >> idim) & 1) {
+      lo[idim] = mid;
+      hi[idim] = BIG;
+    } else {
+      lo[idim] = -BIG;
+      hi[idim] = mid;
+    }
+  }
+
+  nswap_local = 0;
+  niswap_local = 0;
+  njswap_local = 0;
+
+  for (int i = 0; i < nlocal; i++) {
+    if (!(mask[i] & groupbit)) continue;
+    if ((x[i][0] < lo[0]) || (x[i][0] >= hi[0]) || (x[i][1] < lo[1]) || (x[i][1] >= hi[1]) ||
+        (x[i][2] < lo[2]) || (x[i][2] >= hi[2]))
+      continue;
+    if (region && (region->match(x[i][0], x[i][1], x[i][2]) != 1)) continue;
+
+    if (semi_grand_flag) {
+      int iswaptype;
+      for (iswaptype = 0; iswaptype < nswaptypes; iswaptype++)
+        if (type[i] == type_list[iswaptype]) break;
+      if (iswaptype == nswaptypes) continue;
+      local_swap_atom_list[nswap_local++] = i;
+    } else {
+      if (type[i] == type_list[0])
+        local_swap_iatom_list[niswap_local++] = i;
+      else if (type[i] == type_list[1])
+        local_swap_jatom_list[njswap_local++] = i;
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
 ------------------------------------------------------------------------- */
 
@@ -30,6 +30,7 @@ class FixAtomSwap : public Fix {
   ~FixAtomSwap() override;
   int setmask() override;
   void init() override;
+  void init_list(int, class NeighList *) override;
   void pre_exchange() override;
   int pack_forward_comm(int, int *, double *, int, int *) override;
   void unpack_forward_comm(int, int, double *) override;
@@ -43,6 +44,7 @@ class FixAtomSwap : public Fix {
   int nevery, seed;
   int ke_flag;            // yes = conserve ke, no = do not conserve ke
   int semi_grand_flag;    // yes = semi-grand canonical, no = constant composition
+  int parallel_flag;      // yes = checkerboard sweep with local energies, no = serial
   int ncycles;
   int niswap, njswap;                  // # of i,j swap atoms on all procs
   int niswap_local, njswap_local;      // # of swap atoms on this proc
@@ -77,16 +79,27 @@ class FixAtomSwap : public Fix {
   class RanPark *random_unequal;
 
   class Compute *c_pe;
+  class NeighList *list;
+  class RanPark *random_parallel;
+
+  int nsector;    // # of sectors per sub-domain in parallel mode
 
   void options(int, char **);
   int attempt_semi_grand();
   int attempt_swap();
   double energy_full();
+  int sweep_parallel(int &);
+  int attempt_semi_grand_local();
+  int attempt_swap_local();
+  double energy_local(int, int);
+  void update_sector_atoms_list(int);
   int pick_semi_grand_atom();
   int pick_i_swap_atom();
   int pick_j_swap_atom();
   void update_semi_grand_atoms_list();
   void update_swap_atoms_list();
+
+  inline int sbmask(int j) const { return j >> SBBITS & 3; }
 };
 
 }    // namespace LAMMPS_NS
@@ -46,6 +46,7 @@
 #include <cmath>
 #include <cstring>
 #include <exception>
+#include <vector>
 
 using namespace LAMMPS_NS;
 using namespace FixConst;
@@ -69,6 +70,7 @@ enum { NONE, MOVEATOM, MOVEMOL };    // movemode
 
 FixGCMC::FixGCMC(LAMMPS *lmp, int narg, char **arg) :
     Fix(lmp, narg, arg), region(nullptr), idregion(nullptr), full_flag(false),
+    incremental_flag(false),
     groupstrings(nullptr), grouptypestrings(nullptr), grouptypebits(nullptr), grouptypes(nullptr),
     local_gas_list(nullptr), molcoords(nullptr), molq(nullptr), molimage(nullptr),
     random_equal(nullptr), random_unequal(nullptr), fixrigid(nullptr), fixshake(nullptr),
@@ -256,6 +258,7 @@ void FixGCMC::options(int narg, char **arg)
   charge = 0.0;
   charge_flag = false;
   full_flag = false;
+  incremental_flag = false;
   ngroups = 0;
   int ngroupsmax = 0;
   groupstrings = nullptr;
@@ -336,6 +339,9 @@ void FixGCMC::options(int narg, char **arg)
     } else if (strcmp(arg[iarg],"full_energy") == 0) {
       full_flag = true;
       iarg += 1;
+    } else if (strcmp(arg[iarg],"incremental") == 0) {
+      incremental_flag = true;
+      iarg += 1;
     } else if (strcmp(arg[iarg],"group") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal fix gcmc command");
       if (ngroups >= ngroupsmax) {
@@ -530,9 +536,35 @@ void FixGCMC::init()
     }
   } else movemode = NONE;
 
+  // incremental energies require pairwise energies from Pair::single()
+  //   and a kspace style that can update its energy for moved charges
+  // hybrid pair styles still need full energies, as without incremental
+
+  kspace_mc = 0;
+  if (incremental_flag) {
+    if (full_flag)
+      error->all(FLERR,"Fix gcmc keywords full_energy and incremental cannot be used together");
+    if ((force->pair == nullptr) || (force->pair->single_enable == 0) ||
+        force->pair->manybody_flag)
+      error->all(FLERR,"Fix gcmc incremental requires a pair style with a single() function");
+    if (force->pair->tail_flag)
+      error->all(FLERR,"Fix gcmc incremental does not support pair tail corrections");
+    if (force->pair_match("^hybrid",0)) {
+      full_flag = true;
+      if (comm->me == 0)
+        error->warning(FLERR,"Fix gcmc using full_energy option instead of incremental "
+                       "for pair style {}",force->pair_style);
+    } else if (force->kspace) {
+      if (!force->kspace->mc_energy_enable)
+        error->all(FLERR,"Fix gcmc incremental is not supported by kspace style {}",
+                   force->kspace_style);
+      if (atom->q_flag) kspace_mc = 1;
+    }
+  }
+
   // decide whether to switch to the full_energy option
 
-  if (!full_flag) {
+  if (!full_flag && !incremental_flag) {
     if ((force->kspace) ||
         (force->pair == nullptr) ||
         (force->pair->single_enable == 0) ||
@@ -821,6 +853,10 @@ void FixGCMC::pre_exchange()
 
   } else {
 
+    // cache kspace structure factors for incremental energy changes
+
+    if (kspace_mc) force->kspace->mc_energy_setup();
+
     for (int i = 0; i < ncycles; i++) {
       int ixm = static_cast<int>(random_equal->uniform()*ncycles) + 1;
       if (ixm <= nmcmoves) {
@@ -839,6 +875,7 @@ void FixGCMC::pre_exchange()
         }
       }
     }
+    if (kspace_mc) force->kspace->qsum_qsq();
   }
 
   next_reneighbor = update->ntimestep + nevery;
@@ -858,6 +895,13 @@ void FixGCMC::attempt_atomic_translation()
   int i = pick_random_gas_atom();
 
   int success = 0;
+  int nmove = 0;
+  double energy_change = 0.0;
+  double qmove = 0.0;
+  double coord[3];
+  double *xold[1] = {nullptr};
+  double *xnew[1] = {nullptr};
+
   if (i >= 0) {
     double **x = atom->x;
     double energy_before = energy(i,ngcmc_type,-1,x[i]);
@@ -866,7 +910,6 @@ void FixGCMC::attempt_atomic_translation()
     double rsq = 1.1;
     double rx,ry,rz;
     rx = ry = rz = 0.0;
-    double coord[3];
     while (rsq > 1.0) {
       rx = 2*random_unequal->uniform() - 1.0;
       ry = 2*random_unequal->uniform() - 1.0;
@@ -895,7 +938,13 @@ void FixGCMC::attempt_atomic_translation()
 
     double energy_after = energy(i,ngcmc_type,-1,coord);
 
-    if (energy_after < MAXENERGYTEST &&
+    if (kspace_mc) {
+      energy_change = energy_after - energy_before;
+      nmove = 1;
+      xold[0] = x[i];
+      xnew[0] = coord;
+      qmove = atom->q[i];
+    } else if (energy_after < MAXENERGYTEST &&
         random_unequal->uniform() <
         exp(beta*(energy_before - energy_after))) {
       x[i][0] = coord[0];
@@ -905,6 +954,22 @@ void FixGCMC::attempt_atomic_translation()
     }
   }
 
+  // with incremental kspace energies all procs take part in the decision
+
+  if (kspace_mc) {
+    energy_change = energy_delta(energy_change,nmove,&qmove,xold,nmove,&qmove,xnew,1);
+    if (energy_change < MAXENERGYTEST &&
+        random_equal->uniform() < exp(-beta*energy_change)) {
+      if (i >= 0) {
+        atom->x[i][0] = coord[0];
+        atom->x[i][1] = coord[1];
+        atom->x[i][2] = coord[2];
+      }
+      force->kspace->mc_energy_accept();
+      success = 1;
+    }
+  }
+
   int success_all = 0;
   MPI_Allreduce(&success,&success_all,1,MPI_INT,MPI_MAX,world);
 
@@ -932,9 +997,10 @@ void FixGCMC::attempt_atomic_deletion()
   int i = pick_random_gas_atom();
 
   int success = 0;
+  double deletion_energy = 0.0;
   if (i >= 0) {
-    double deletion_energy = energy(i,ngcmc_type,-1,atom->x[i]);
-    if (random_unequal->uniform() <
+    deletion_energy = energy(i,ngcmc_type,-1,atom->x[i]);
+    if (!kspace_mc && random_unequal->uniform() <
         ngas*exp(beta*deletion_energy)/(zz*volume)) {
       atom->avec->copy(atom->nlocal-1,i,1);
       atom->nlocal--;
@@ -942,6 +1008,23 @@ void FixGCMC::attempt_atomic_deletion()
     }
   }
 
+  // with incremental kspace energies all procs take part in the decision
+
+  if (kspace_mc) {
+    int nold = (i >= 0) ? 1 : 0;
+    double qold = (i >= 0) ? atom->q[i] : 0.0;
+    double *xold[1] = {(i >= 0) ? atom->x[i] : nullptr};
+    double energy_change = energy_delta(-deletion_energy,nold,&qold,xold,0,nullptr,nullptr,1);
+    if (random_equal->uniform() < ngas*exp(-beta*energy_change)/(zz*volume)) {
+      if (i >= 0) {
+        atom->avec->copy(atom->nlocal-1,i,1);
+        atom->nlocal--;
+      }
+      force->kspace->mc_energy_accept();
+      success = 1;
+    }
+  }
+
   int success_all = 0;
   MPI_Allreduce(&success,&success_all,1,MPI_INT,MPI_MAX,world);
 
@@ -1021,6 +1104,7 @@ void FixGCMC::attempt_atomic_insertion()
   }
 
   int success = 0;
+  double insertion_energy = 0.0;
   if (proc_flag) {
     int ii = -1;
     if (charge_flag) {
@@ -1028,30 +1112,45 @@ void FixGCMC::attempt_atomic_insertion()
       if (ii >= atom->nmax) atom->avec->grow(0);
       atom->q[ii] = charge;
     }
-    double insertion_energy = energy(ii,ngcmc_type,-1,coord);
+    insertion_energy = energy(ii,ngcmc_type,-1,coord);
 
-    if (insertion_energy < MAXENERGYTEST &&
+    if (!kspace_mc && insertion_energy < MAXENERGYTEST &&
         random_unequal->uniform() <
-        zz*volume*exp(-beta*insertion_energy)/(ngas+1)) {
-      atom->avec->create_atom(ngcmc_type,coord);
-      int m = atom->nlocal - 1;
+        zz*volume*exp(-beta*insertion_energy)/(ngas+1)) success = 1;
+  }
 
-      // add to groups
-      // optionally add to type-based groups
+  // with incremental kspace energies all procs take part in the decision
 
-      atom->mask[m] = groupbitall;
-      for (int igroup = 0; igroup < ngrouptypes; igroup++) {
-        if (ngcmc_type == grouptypes[igroup])
-          atom->mask[m] |= grouptypebits[igroup];
-      }
+  if (kspace_mc) {
+    int nnew = proc_flag ? 1 : 0;
+    double qnew = charge_flag ? charge : 0.0;
+    double *xnew[1] = {coord};
+    double energy_change = energy_delta(insertion_energy,0,nullptr,nullptr,nnew,&qnew,xnew,1);
+    if (energy_change < MAXENERGYTEST &&
+        random_equal->uniform() < zz*volume*exp(-beta*energy_change)/(ngas+1)) {
+      force->kspace->mc_energy_accept();
+      success = 1;
+    }
+  }
 
-      atom->v[m][0] = random_unequal->gaussian()*sigma;
-      atom->v[m][1] = random_unequal->gaussian()*sigma;
-      atom->v[m][2] = random_unequal->gaussian()*sigma;
-      modify->create_attribute(m);
+  if (success && proc_flag) {
+    atom->avec->create_atom(ngcmc_type,coord);
+    int m = atom->nlocal - 1;
 
-      success = 1;
+    // add to groups
+    // optionally add to type-based groups
+
+    atom->mask[m] = groupbitall;
+    for (int igroup = 0; igroup < ngrouptypes; igroup++) {
+      if (ngcmc_type == grouptypes[igroup])
+        atom->mask[m] |= grouptypebits[igroup];
     }
+
+    atom->v[m][0] = random_unequal->gaussian()*sigma;
+    atom->v[m][1] = random_unequal->gaussian()*sigma;
+    atom->v[m][2] = random_unequal->gaussian()*sigma;
+    if (charge_flag) atom->q[m] = charge;
+    modify->create_attribute(m);
   }
 
   int success_all = 0;
@@ -1135,6 +1234,16 @@ void FixGCMC::attempt_molecule_translation()
     com_displace[2] = displace*rz;
   }
 
+  // store old and new positions of local molecule atoms for kspace
+
+  std::vector<double *> xold;
+  if (kspace_mc) {
+    int nmolcoords = 0;
+    for (int i = 0; i < atom->nlocal; i++)
+      if (atom->molecule[i] == translation_molecule) nmolcoords++;
+    if (nmolcoords > nmaxmolatoms) grow_molecule_arrays(nmolcoords);
+  }
+
   double energy_after = 0.0;
   for (int i = 0; i < atom->nlocal; i++) {
     if (atom->molecule[i] == translation_molecule) {
@@ -1144,15 +1253,30 @@ void FixGCMC::attempt_molecule_translation()
       if (!domain->inside_nonperiodic(coord))
         error->one(FLERR,"Fix gcmc put atom outside box");
       energy_after += energy(i,atom->type[i],translation_molecule,coord);
+      if (kspace_mc) {
+        const int n = xold.size();
+        molcoords[n][0] = coord[0];
+        molcoords[n][1] = coord[1];
+        molcoords[n][2] = coord[2];
+        molq[n] = atom->q[i];
+        xold.push_back(x[i]);
+      }
     }
   }
 
   double energy_after_sum = 0.0;
   MPI_Allreduce(&energy_after,&energy_after_sum,1,MPI_DOUBLE,MPI_SUM,world);
 
+  if (kspace_mc) {
+    const int n = xold.size();
+    energy_after_sum +=
+      force->kspace->mc_energy_delta(n,molq,xold.data(),n,molq,molcoords,0);
+  }
+
   if (energy_after_sum < MAXENERGYTEST &&
       random_equal->uniform() <
       exp(beta*(energy_before_sum - energy_after_sum))) {
+    if (kspace_mc) force->kspace->mc_energy_accept();
     for (int i = 0; i < atom->nlocal; i++) {
       if (atom->molecule[i] == translation_molecule) {
         x[i][0] += com_displace[0];
@@ -1226,6 +1350,7 @@ void FixGCMC::attempt_molecule_rotation()
   double **x = atom->x;
   imageint *image = atom->image;
   double energy_after = 0.0;
+  std::vector<double *> xold;
   int n = 0;
   for (int i = 0; i < atom->nlocal; i++) {
     if (mask[i] & molecule_group_bit) {
@@ -1245,6 +1370,10 @@ void FixGCMC::attempt_molecule_rotation()
       if (!domain->inside(xtmp))
         error->one(FLERR,"Fix gcmc put atom outside box");
       energy_after += energy(i,atom->type[i],rotation_molecule,xtmp);
+      if (kspace_mc) {
+        molq[n] = atom->q[i];
+        xold.push_back(x[i]);
+      }
       n++;
     }
   }
@@ -1252,9 +1381,14 @@ void FixGCMC::attempt_molecule_rotation()
   double energy_after_sum = 0.0;
   MPI_Allreduce(&energy_after,&energy_after_sum,1,MPI_DOUBLE,MPI_SUM,world);
 
+  if (kspace_mc)
+    energy_after_sum +=
+      force->kspace->mc_energy_delta(n,molq,xold.data(),n,molq,molcoords,0);
+
   if (energy_after_sum < MAXENERGYTEST &&
       random_equal->uniform() <
       exp(beta*(energy_before_sum - energy_after_sum))) {
+    if (kspace_mc) force->kspace->mc_energy_accept();
     int n = 0;
     for (int i = 0; i < atom->nlocal; i++) {
       if (mask[i] & molecule_group_bit) {
@@ -1295,8 +1429,22 @@ void FixGCMC::attempt_molecule_deletion()
 
   double deletion_energy_sum = molecule_energy(deletion_molecule);
 
+  if (kspace_mc) {
+    std::vector<double *> xold;
+    std::vector<double> qold;
+    for (int i = 0; i < atom->nlocal; i++) {
+      if (atom->molecule[i] == deletion_molecule) {
+        xold.push_back(atom->x[i]);
+        qold.push_back(atom->q[i]);
+      }
+    }
+    deletion_energy_sum -= force->kspace->mc_energy_delta(xold.size(),qold.data(),xold.data(),
+                                                          0,nullptr,nullptr,0);
+  }
+
   if (random_equal->uniform() <
       ngas*exp(beta*deletion_energy_sum)/(zz*volume*natoms_per_molecule)) {
+    if (kspace_mc) force->kspace->mc_energy_accept();
     int i = 0;
     while (i < atom->nlocal) {
       if (atom->molecule[i] == deletion_molecule) {
@@ -1430,9 +1578,23 @@ void FixGCMC::attempt_molecule_insertion()
   MPI_Allreduce(&insertion_energy,&insertion_energy_sum,1,
                 MPI_DOUBLE,MPI_SUM,world);
 
+  if (kspace_mc) {
+    std::vector<double *> xnew;
+    std::vector<double> qnew;
+    for (int i = 0; i < natoms_per_molecule; i++) {
+      if (procflag[i]) {
+        xnew.push_back(molcoords[i]);
+        qnew.push_back(onemols[imol]->qflag ? onemols[imol]->q[i] : 0.0);
+      }
+    }
+    insertion_energy_sum += force->kspace->mc_energy_delta(0,nullptr,nullptr,xnew.size(),
+                                                           qnew.data(),xnew.data(),0);
+  }
+
   if (insertion_energy_sum < MAXENERGYTEST &&
       random_equal->uniform() < zz*volume*natoms_per_molecule*
       exp(-beta*insertion_energy_sum)/(ngas + natoms_per_molecule)) {
+    if (kspace_mc) force->kspace->mc_energy_accept();
 
     tagint maxmol = 0;
     for (int i = 0; i < atom->nlocal; i++) maxmol = MAX(maxmol,atom->molecule[i]);
@@ -2299,6 +2461,22 @@ double FixGCMC::molecule_energy(tagint gas_molecule_id)
   return mol_energy_sum;
 }
 
+/* ----------------------------------------------------------------------
+   total energy change of a trial with incremental kspace energies
+   sum local pair energy change across procs and add the kspace energy
+   change for removing local charges qold at xold and adding qnew at xnew
+------------------------------------------------------------------------- */
+
+double FixGCMC::energy_delta(double energy_local, int nold, double *qold, double **xold,
+                             int nnew, double *qnew, double **xnew, int selfflag)
+{
+  double energy_change = 0.0;
+  MPI_Allreduce(&energy_local,&energy_change,1,MPI_DOUBLE,MPI_SUM,world);
+
+  energy_change += force->kspace->mc_energy_delta(nold,qold,xold,nnew,qnew,xnew,selfflag);
+  return energy_change;
+}
+
 /* ----------------------------------------------------------------------
    compute system potential energy
 ------------------------------------------------------------------------- */
@@ -54,6 +54,8 @@ class FixGCMC : public Fix {
   bool pressure_flag;      // true if user specified reservoir pressure
   bool charge_flag;        // true if user specified atomic charge
   bool full_flag;          // true if doing full system energy calculations
+  bool incremental_flag;   // true if doing incremental energy calculations
+  int kspace_mc;           // 1 if kspace energy changes are computed incrementally
 
   int natoms_per_molecule;    // number of atoms in each inserted molecule
   int nmaxmolatoms;           // number of atoms allocated for molecule arrays
@@ -142,6 +144,7 @@ class FixGCMC : public Fix {
   double energy(int, int, tagint, double *);
   double energy_full();
   double molecule_energy(tagint);
+  double energy_delta(double, int, double *, double **, int, double *, double **, int);
 
   int pick_random_gas_atom();
   tagint pick_random_gas_molecule();
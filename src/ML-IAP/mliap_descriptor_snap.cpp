@@ -123,69 +123,114 @@ void MLIAPDescriptorSNAP::compute_forces(class MLIAPData *data)
   double fij[3];
   double **f = atom->f;
 
-  int ij = 0;
-  for (int ii = 0; ii < data->nlistatoms; ii++) {
-    const int i = data->iatoms[ii];
-    const int ielem = data->ielems[ii];
-
-    // ensure rij, inside, wj, and rcutij are of size jnum
+  // with batchsize > 1, Ui of a batch of atoms is computed first and
+  // then Yi of all atoms of the batch in one vectorizable pass
 
-    const int jnum = data->numneighs[ii];
-    snaptr->grow_rij(jnum);
-
-    int ninside = 0;
-    for (int jj = 0; jj < jnum; jj++) {
-      const int j = data->jatoms[ij];
-      const int jelem = data->jelems[ij];
-      const double *delr = data->rij[ij];
+  const int nlistatoms = data->nlistatoms;
+  if (batchsize > 1) snaptr->grow_batch(batchsize);
 
-      snaptr->rij[ninside][0] = delr[0];
-      snaptr->rij[ninside][1] = delr[1];
-      snaptr->rij[ninside][2] = delr[2];
-      snaptr->inside[ninside] = j;
-      snaptr->wj[ninside] = wjelem[jelem];
-      snaptr->rcutij[ninside] = sqrt(cutsq[ielem][jelem]);
-      if (switchinnerflag) {
-        snaptr->sinnerij[ninside] = 0.5 * (sinnerelem[ielem] + sinnerelem[jelem]);
-        snaptr->dinnerij[ninside] = 0.5 * (dinnerelem[ielem] + dinnerelem[jelem]);
+  int ij = 0;
+  for (int iibatch = 0; iibatch < nlistatoms; iibatch += batchsize) {
+    const int nbatch = MIN(batchsize, nlistatoms - iibatch);
+
+    if (batchsize > 1) {
+      int ijbatch = ij;
+      for (int ib = 0; ib < nbatch; ib++) {
+        const int ii = iibatch + ib;
+        const int ninside = build_short_list(data, ii, ijbatch);
+        ijbatch += data->numneighs[ii];
+        if (chemflag)
+          snaptr->compute_ui(ninside, data->ielems[ii]);
+        else
+          snaptr->compute_ui(ninside, 0);
+        snaptr->store_batch(ib, ninside);
       }
-      if (chemflag) snaptr->element[ninside] = jelem;
-      ninside++;
-      ij++;
+      snaptr->compute_yi_batch(nbatch, &data->betas[iibatch]);
     }
 
-    // compute Ui, Yi for atom I
+    for (int ib = 0; ib < nbatch; ib++) {
+      const int ii = iibatch + ib;
+      const int i = data->iatoms[ii];
+      const int ielem = data->ielems[ii];
+
+      // compute Ui, Yi for atom I
+      // with batches, the short neighbor list is restored with Yi
+
+      int ninside;
+      if (batchsize > 1) {
+        ninside = snaptr->load_batch(ib);
+      } else {
+        ninside = build_short_list(data, ii, ij);
+        if (chemflag)
+          snaptr->compute_ui(ninside, ielem);
+        else
+          snaptr->compute_ui(ninside, 0);
+        snaptr->compute_yi(data->betas[ii]);
+      }
+      ij += data->numneighs[ii];
 
-    if (chemflag)
-      snaptr->compute_ui(ninside, ielem);
-    else
-      snaptr->compute_ui(ninside, 0);
+      // for neighbors of I within cutoff:
+      // compute Fij = dEi/dRj = -dEi/dRi
+      // add to Fi, subtract from Fj
 
-    // for neighbors of I within cutoff:
-    // compute Fij = dEi/dRj = -dEi/dRi
-    // add to Fi, subtract from Fj
+      for (int jj = 0; jj < ninside; jj++) {
+        int j = snaptr->inside[jj];
+        snaptr->compute_duidrj(jj);
 
-    snaptr->compute_yi(data->betas[ii]);
+        snaptr->compute_deidrj(fij);
 
-    for (int jj = 0; jj < ninside; jj++) {
-      int j = snaptr->inside[jj];
-      snaptr->compute_duidrj(jj);
+        f[i][0] += fij[0];
+        f[i][1] += fij[1];
+        f[i][2] += fij[2];
+        f[j][0] -= fij[0];
+        f[j][1] -= fij[1];
+        f[j][2] -= fij[2];
 
-      snaptr->compute_deidrj(fij);
+        // add in global and per-atom virial contributions
+        // this is optional and has no effect on force calculation
 
-      f[i][0] += fij[0];
-      f[i][1] += fij[1];
-      f[i][2] += fij[2];
-      f[j][0] -= fij[0];
-      f[j][1] -= fij[1];
-      f[j][2] -= fij[2];
+        if (data->vflag) data->pairmliap->v_tally(i, j, fij, snaptr->rij[jj]);
+      }
+    }
+  }
+}
 
-      // add in global and per-atom virial contributions
-      // this is optional and has no effect on force calculation
+/* ----------------------------------------------------------------------
+   fill the short neighbor list of SNA with the neighbors of atom ii,
+   starting at position ij in the flattened neighbor data
+   ---------------------------------------------------------------------- */
 
-      if (data->vflag) data->pairmliap->v_tally(i, j, fij, snaptr->rij[jj]);
+int MLIAPDescriptorSNAP::build_short_list(class MLIAPData *data, int ii, int ij)
+{
+  const int ielem = data->ielems[ii];
+
+  // ensure rij, inside, wj, and rcutij are of size jnum
+
+  const int jnum = data->numneighs[ii];
+  snaptr->grow_rij(jnum);
+
+  int ninside = 0;
+  for (int jj = 0; jj < jnum; jj++) {
+    const int j = data->jatoms[ij];
+    const int jelem = data->jelems[ij];
+    const double *delr = data->rij[ij];
+
+    snaptr->rij[ninside][0] = delr[0];
+    snaptr->rij[ninside][1] = delr[1];
+    snaptr->rij[ninside][2] = delr[2];
+    snaptr->inside[ninside] = j;
+    snaptr->wj[ninside] = wjelem[jelem];
+    snaptr->rcutij[ninside] = sqrt(cutsq[ielem][jelem]);
+    if (switchinnerflag) {
+      snaptr->sinnerij[ninside] = 0.5 * (sinnerelem[ielem] + sinnerelem[jelem]);
+      snaptr->dinnerij[ninside] = 0.5 * (dinnerelem[ielem] + dinnerelem[jelem]);
     }
+    if (chemflag) snaptr->element[ninside] = jelem;
+    ninside++;
+    ij++;
   }
+
+  return ninside;
 }
 
 /* ----------------------------------------------------------------------
@@ -357,6 +402,7 @@ void MLIAPDescriptorSNAP::read_paramfile(char *paramfilename)
   bnormflag = 0;
   wselfallflag = 0;
   switchinnerflag = 0;
+  batchsize = 1;
 
   // set local input checks
 
@@ -482,6 +528,8 @@ void MLIAPDescriptorSNAP::read_paramfile(char *paramfilename)
         wselfallflag = utils::inumeric(FLERR, keyval, false, lmp);
       else if (keywd == "switchinnerflag")
         switchinnerflag = utils::inumeric(FLERR, keyval, false, lmp);
+      else if (keywd == "batchsize")
+        batchsize = utils::inumeric(FLERR, keyval, false, lmp);
       else
         error->all(FLERR, "Incorrect SNAP parameter file");
     }
@@ -494,6 +542,8 @@ void MLIAPDescriptorSNAP::read_paramfile(char *paramfilename)
   if (switchinnerflag && !(sinnerflag && dinnerflag))
     error->all(FLERR, "Incorrect SNAP parameter file");
 
+  if (batchsize < 1) error->all(FLERR, "Incorrect SNAP parameter file");
+
   if (!switchinnerflag && (sinnerflag || dinnerflag))
     error->all(FLERR, "Incorrect SNAP parameter file");
 
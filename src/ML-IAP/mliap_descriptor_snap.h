@@ -34,12 +34,14 @@ class MLIAPDescriptorSNAP : public MLIAPDescriptor {
  protected:
   class SNA *snaptr;
   void read_paramfile(char *);
+  int build_short_list(class MLIAPData *, int, int);
   inline int equal(double *x, double *y);
   inline double dist2(double *x, double *y);
 
   int twojmax, switchflag, bzeroflag;
   int chemflag, bnormflag, wselfallflag;
   int switchinnerflag;
+  int batchsize;    // number of atoms per batch for Yi
   double rfac0, rmin0;
 
   double *sinnerelem;
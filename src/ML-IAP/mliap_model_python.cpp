@@ -150,6 +150,11 @@ void MLIAPModelPython::compute_gradients(MLIAPData *data)
     error->all(FLERR, "Running python model failure.");
   }
   PyGILState_Release(gstate);
+
+  // total energy from the atom energies, summed without holding the GIL
+
+  data->energy = 0.0;
+  for (int ii = 0; ii < data->nlistatoms; ii++) data->energy += data->eatoms[ii];
 }
 
 /* ----------------------------------------------------------------------
@@ -18,6 +18,7 @@ cdef extern from "mliap_data.h" namespace "LAMMPS_NS":
     cdef cppclass MLIAPData:
         # Array shapes
         int nlistatoms
+        int nlistatoms_max
         int nlocal
         int ndescriptors
 
@@ -40,6 +41,10 @@ class MLIAPPYModelNotLinked(Exception): pass
 
 LOADED_MODELS = {}
 
+# numpy views of the MLIAPData buffers of each model. They are only
+# rebuilt when LAMMPS reallocates the buffers, so no data is copied.
+BUFFERS = {}
+
 cdef object c_id(MLIAPModelPython * c_model):
     """
     Use python-style id of object to keep track of identity.
@@ -90,6 +95,7 @@ def load_from_python(model):
 
 cdef public void MLIAPPY_unload_model(MLIAPModelPython * c_model) with gil:
     del LOADED_MODELS[c_id(c_model)]
+    BUFFERS.pop(c_id(c_model), None)
 
 cdef public int MLIAPPY_nparams(MLIAPModelPython * c_model) with gil:
     return int(retrieve(c_model).n_params)
@@ -100,22 +106,31 @@ cdef public int MLIAPPY_nelements(MLIAPModelPython * c_model) with gil:
 cdef public int MLIAPPY_ndescriptors(MLIAPModelPython * c_model) with gil:
     return int(retrieve(c_model).n_descriptors)
 
+cdef object buffers(MLIAPModelPython * c_model, MLIAPData * data):
+    cdef int n_max = data.nlistatoms_max
+    cdef int n_d = data.ndescriptors
+    key = (<uintptr_t> data.betas, <uintptr_t> data.descriptors, <uintptr_t> data.ielems,
+           <uintptr_t> data.eatoms, n_max, n_d)
+    entry = BUFFERS.get(c_id(c_model))
+    if entry is None or entry[0] != key:
+        entry = (key,
+                 np.asarray(<double[:n_max,:n_d]> &data.betas[0][0]),
+                 np.asarray(<double[:n_max,:n_d]> &data.descriptors[0][0]),
+                 np.asarray(<int[:n_max]> &data.ielems[0]),
+                 np.asarray(<double[:n_max]> &data.eatoms[0]))
+        BUFFERS[c_id(c_model)] = entry
+    return entry
+
 cdef public void MLIAPPY_compute_gradients(MLIAPModelPython * c_model, MLIAPData * data) with gil:
     model = retrieve(c_model)
 
-    n_d = data.ndescriptors
     n_a = data.nlistatoms
+    if n_a == 0:
+        return
 
-    # Make numpy arrays from pointers
-    beta_np = np.asarray(<double[:n_a,:n_d] > &data.betas[0][0])
-    desc_np = np.asarray(<double[:n_a,:n_d]> &data.descriptors[0][0])
-    elem_np = np.asarray(<int[:n_a]> &data.ielems[0])
-    en_np = np.asarray(<double[:n_a]> &data.eatoms[0])
+    # Slice the cached numpy views of the LAMMPS arrays
+    _, beta_np, desc_np, elem_np, en_np = buffers(c_model, data)
 
     # Invoke python model on numpy arrays.
-    model(elem_np,desc_np,beta_np,en_np)
-
-    # Get the total energy from the atom energy.
-    energy = np.sum(en_np)
-    data.energy = <double> energy
-    return
+    # The total energy is summed up by the caller after releasing the GIL.
+    model(elem_np[:n_a], desc_np[:n_a], beta_np[:n_a], en_np[:n_a])
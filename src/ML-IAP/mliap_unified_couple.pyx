@@ -7,6 +7,7 @@ import lammps.mliap
 
 cimport cython
 from cpython.ref cimport PyObject
+from libc.stdint cimport uintptr_t
 from libc.stdlib cimport malloc, free
 from libc.string cimport memcpy
 
@@ -56,7 +57,10 @@ cdef extern from "mliap_data.h" namespace "LAMMPS_NS":
         int ntotal              # total number of owned and ghost atoms on this proc
         int nlistatoms          # current number of non-NULL atoms in local atom lists
         int nlocal              # current number of NULL and normal atoms in local atom lists
+        int nlistatoms_max      # allocated size of descriptor array
+        int natomgamma_max      # allocated size of gamma
         int natomneigh          # current number of atoms and ghosts in atom neighbor arrays
+        int natomneigh_max      # allocated size of atom neighbor arrays
         int * numneighs         # neighbors count for each atom
         int * iatoms            # index of each atom
         int * pair_i            # index of each i atom for each ij pair
@@ -96,8 +100,8 @@ cdef extern from "mliap_unified.h" namespace "LAMMPS_NS":
 
         void compute_gradients(MLIAPData *)
 
-    cdef void update_pair_energy(MLIAPData *, double *) except +
-    cdef void update_pair_forces(MLIAPData *, double *) except +
+    cdef void update_pair_energy(MLIAPData *, double *) except + nogil
+    cdef void update_pair_forces(MLIAPData *, double *) except + nogil
 
 
 LOADED_MODEL = None
@@ -109,62 +113,134 @@ def write_only_property(fset):
 
 
 # Cython implementation of MLIAPData
-# Automatically converts between C arrays and numpy when needed
+# Arrays are numpy views of the LAMMPS buffers, so no data is copied.
+# The views of the allocated buffers are cached and only rebuilt when
+# LAMMPS reallocates a buffer, so each access only creates a slice.
+# The views are valid only during the call from LAMMPS.
 cdef class MLIAPDataPy:
     cdef MLIAPData * data
+    cdef dict views
 
     def __cinit__(self):
         self.data = NULL
+        self.views = {}
+
+    # return the first n rows of a view of the allocated buffer at ptr
+    # with nalloc rows and ncols columns (or 1d if ncols = 0)
+
+    cdef object double_view(self, str name, double *ptr, int nalloc, int ncols, int n):
+        if ptr is NULL:
+            return None
+        key = (<uintptr_t> ptr, nalloc, ncols)
+        entry = self.views.get(name)
+        if entry is None or entry[0] != key:
+            if nalloc <= 0:
+                arr = np.zeros([0, ncols] if ncols > 0 else [0], dtype=np.float64)
+            elif ncols > 0:
+                arr = np.asarray(<double[:nalloc, :ncols]> ptr)
+            else:
+                arr = np.asarray(<double[:nalloc]> ptr)
+            entry = (key, arr)
+            self.views[name] = entry
+        return entry[1][:n]
+
+    cdef object int_view(self, str name, int *ptr, int nalloc, int ncols, int n):
+        if ptr is NULL:
+            return None
+        key = (<uintptr_t> ptr, nalloc, ncols)
+        entry = self.views.get(name)
+        if entry is None or entry[0] != key:
+            if nalloc <= 0:
+                arr = np.zeros([0, ncols] if ncols > 0 else [0], dtype=np.intc)
+            elif ncols > 0:
+                arr = np.asarray(<int[:nalloc, :ncols]> ptr)
+            else:
+                arr = np.asarray(<int[:nalloc]> ptr)
+            entry = (key, arr)
+            self.views[name] = entry
+        return entry[1][:n]
+
+    # copy value into a buffer, unless value already is the same view of it
+    # a view with the same start but another shape or strides is copied
+
+    cdef void copy_into(self, object view, object value):
+        if isinstance(value, np.ndarray) and value.dtype == view.dtype and \
+           value.shape == view.shape and value.strides == view.strides and \
+           value.__array_interface__['data'][0] == view.__array_interface__['data'][0]:
+            return
+        view[...] = value
 
     def update_pair_energy(self, eij):
         cdef double[:] eij_arr = eij
-        update_pair_energy(self.data, &eij_arr[0])
+        with nogil:
+            update_pair_energy(self.data, &eij_arr[0])
 
     def update_pair_forces(self, fij):
         cdef double[:, ::1] fij_arr = fij
-        update_pair_forces(self.data, &fij_arr[0][0])
+        with nogil:
+            update_pair_forces(self.data, &fij_arr[0][0])
 
     @property
     def f(self):
         if self.data.f is NULL:
             return None
-        return np.asarray(<double[:self.ntotal, :3]> &self.data.f[0][0])
+        return self.double_view('f', &self.data.f[0][0], self.ntotal, 3, self.ntotal)
 
     @property
     def size_gradforce(self):
         return self.data.size_gradforce
 
-    @write_only_property
+    @property
+    def gradforce(self):
+        if self.data.gradforce is NULL:
+            return None
+        return self.double_view('gradforce', &self.data.gradforce[0][0], self.ntotal,
+                                self.size_gradforce, self.ntotal)
+
+    @gradforce.setter
     def gradforce(self, value):
         if self.data.gradforce is NULL:
             raise ValueError("attempt to set NULL gradforce")
-        cdef double[:, :] gradforce_view = <double[:self.ntotal, :self.size_gradforce]> &self.data.gradforce[0][0]
-        cdef double[:, :] value_view = value
-        gradforce_view[:] = value_view
+        self.copy_into(self.gradforce, value)
 
-    @write_only_property
+    @property
+    def betas(self):
+        if self.data.betas is NULL:
+            return None
+        return self.double_view('betas', &self.data.betas[0][0], self.data.nlistatoms_max,
+                                self.ndescriptors, self.nlistatoms)
+
+    @betas.setter
     def betas(self, value):
         if self.data.betas is NULL:
             raise ValueError("attempt to set NULL betas")
-        cdef double[:, :] betas_view = <double[:self.nlistatoms, :self.ndescriptors]> &self.data.betas[0][0]
-        cdef double[:, :] value_view = value
-        betas_view[:] = value_view
+        self.copy_into(self.betas, value)
 
-    @write_only_property
+    @property
+    def descriptors(self):
+        if self.data.descriptors is NULL:
+            return None
+        return self.double_view('descriptors', &self.data.descriptors[0][0],
+                                self.data.nlistatoms_max, self.ndescriptors, self.nlistatoms)
+
+    @descriptors.setter
     def descriptors(self, value):
         if self.data.descriptors is NULL:
             raise ValueError("attempt to set NULL descriptors")
-        cdef double[:, :] descriptors_view = <double[:self.nlistatoms, :self.ndescriptors]> &self.data.descriptors[0][0]
-        cdef double[:, :] value_view = value
-        descriptors_view[:] = value_view
+        self.copy_into(self.descriptors, value)
 
-    @write_only_property
+    @property
+    def eatoms(self):
+        if self.data.eatoms is NULL:
+            return None
+        return self.double_view('eatoms', self.data.eatoms, self.data.nlistatoms_max, 0,
+                                self.nlistatoms)
+
+    @eatoms.setter
     def eatoms(self, value):
         if self.data.eatoms is NULL:
             raise ValueError("attempt to set NULL eatoms")
-        cdef double[:] eatoms_view = <double[:self.nlistatoms]> &self.data.eatoms[0]
-        cdef double[:] value_view = value
-        eatoms_view[:] = value_view
+        self.copy_into(self.eatoms, value)
 
     @write_only_property
     def energy(self, value):
@@ -192,25 +268,29 @@ cdef class MLIAPDataPy:
     def gamma(self):
         if self.data.gamma is NULL:
             return None
-        return np.asarray(<double[:self.nlistatoms, :self.gama_nnz]> &self.data.gamma[0][0])
+        return self.double_view('gamma', &self.data.gamma[0][0], self.data.natomgamma_max,
+                                self.gamma_nnz, self.nlistatoms)
 
     @property
     def gamma_row_index(self):
         if self.data.gamma_row_index is NULL:
             return None
-        return np.asarray(<int[:self.nlistatoms, :self.gamma_nnz]> &self.data.gamma_row_index[0][0])
+        return self.int_view('gamma_row_index', &self.data.gamma_row_index[0][0],
+                             self.data.natomgamma_max, self.gamma_nnz, self.nlistatoms)
 
     @property
     def gamma_col_index(self):
         if self.data.gamma_col_index is NULL:
             return None
-        return np.asarray(<int[:self.nlistatoms, :self.gamma_nnz]> &self.data.gamma_col_index[0][0])
+        return self.int_view('gamma_col_index', &self.data.gamma_col_index[0][0],
+                             self.data.natomgamma_max, self.gamma_nnz, self.nlistatoms)
 
     @property
     def egradient(self):
         if self.data.egradient is NULL:
             return None
-        return np.asarray(<double[:self.nelements*self.nparams]> &self.data.egradient[0])
+        return self.double_view('egradient', self.data.egradient, self.nelements*self.nparams,
+                                0, self.nelements*self.nparams)
 
     # data structures for mliap neighbor list
     # only neighbors strictly inside descriptor cutoff
@@ -223,7 +303,7 @@ cdef class MLIAPDataPy:
     def elems(self):
         if self.data.elems is NULL:
             return None
-        return np.asarray(<int[:self.ntotal]> &self.data.elems[0])
+        return self.int_view('elems', self.data.elems, self.ntotal, 0, self.ntotal)
 
     @property
     def nlistatoms(self):
@@ -241,19 +321,22 @@ cdef class MLIAPDataPy:
     def numneighs(self):
         if self.data.numneighs is NULL:
             return None
-        return np.asarray(<int[:self.natomneigh]> &self.data.numneighs[0])
+        return self.int_view('numneighs', self.data.numneighs, self.data.natomneigh_max, 0,
+                             self.natomneigh)
 
     @property
     def iatoms(self):
         if self.data.iatoms is NULL:
             return None
-        return np.asarray(<int[:self.natomneigh]> &self.data.iatoms[0])
+        return self.int_view('iatoms', self.data.iatoms, self.data.natomneigh_max, 0,
+                             self.natomneigh)
 
     @property
     def ielems(self):
         if self.data.ielems is NULL:
             return None
-        return np.asarray(<int[:self.natomneigh]> &self.data.ielems[0])
+        return self.int_view('ielems', self.data.ielems, self.data.natomneigh_max, 0,
+                             self.natomneigh)
 
     @property
     def npairs(self):
@@ -263,7 +346,7 @@ cdef class MLIAPDataPy:
     def pair_i(self):
         if self.data.pair_i is NULL:
             return None
-        return np.asarray(<int[:self.npairs]> &self.data.pair_i[0])
+        return self.int_view('pair_i', self.data.pair_i, self.nneigh_max, 0, self.npairs)
 
     @property
     def pair_j(self):
@@ -273,37 +356,48 @@ cdef class MLIAPDataPy:
     def jatoms(self):
         if self.data.jatoms is NULL:
             return None
-        return np.asarray(<int[:self.npairs]> &self.data.jatoms[0])
+        return self.int_view('jatoms', self.data.jatoms, self.nneigh_max, 0, self.npairs)
 
     @property
     def jelems(self):
         if self.data.jelems is NULL:
             return None
-        return np.asarray(<int[:self.npairs]> &self.data.jelems[0])
+        return self.int_view('jelems', self.data.jelems, self.nneigh_max, 0, self.npairs)
 
     @property
     def rij(self):
         if self.data.rij is NULL:
             return None
-        return np.asarray(<double[:self.npairs, :3]> &self.data.rij[0][0])
+        return self.double_view('rij', &self.data.rij[0][0], self.nneigh_max, 3, self.npairs)
 
     @property
     def rij_max(self):
         if self.data.rij is NULL:
             return None
-        return np.asarray(<double[:self.nneigh_max, :3]> &self.data.rij[0][0])
+        return self.double_view('rij', &self.data.rij[0][0], self.nneigh_max, 3,
+                                self.nneigh_max)
 
     @property
     def nneigh_max(self):
         return self.data.nneigh_max
 
-    @write_only_property
+    @property
+    def graddesc(self):
+        if self.data.graddesc is NULL:
+            return None
+        key = (<uintptr_t> &self.data.graddesc[0][0][0], self.nneigh_max, self.ndescriptors)
+        entry = self.views.get('graddesc')
+        if entry is None or entry[0] != key:
+            entry = (key, np.asarray(<double[:self.nneigh_max, :self.ndescriptors, :3]>
+                                     &self.data.graddesc[0][0][0]))
+            self.views['graddesc'] = entry
+        return entry[1][:self.npairs]
+
+    @graddesc.setter
     def graddesc(self, value):
         if self.data.graddesc is NULL:
             raise ValueError("attempt to set NULL graddesc")
-        cdef double[:, :, :] graddesc_view = <double[:self.npairs, :self.ndescriptors, :3]> &self.data.graddesc[0][0][0]
-        cdef double[:, :, :] value_view = value
-        graddesc_view[:] = value_view
+        self.copy_into(self.graddesc, value)
 
     @property
     def eflag(self):
@@ -319,11 +413,19 @@ cdef class MLIAPUnifiedInterface:
     cdef MLIAPDummyModel * model
     cdef MLIAPDummyDescriptor * descriptor
     cdef unified_impl
+    cdef MLIAPDataPy pydata
 
     def __init__(self, unified_impl):
         self.model = NULL
         self.descriptor = NULL
         self.unified_impl = unified_impl
+        self.pydata = MLIAPDataPy()
+
+    # reuse the same MLIAPDataPy object and its cached views for all calls
+
+    cdef MLIAPDataPy wrap(self, MLIAPData *data):
+        self.pydata.data = data
+        return self.pydata
 
     def compute_gradients(self, data):
         self.unified_impl.compute_gradients(data)
@@ -336,21 +438,18 @@ cdef class MLIAPUnifiedInterface:
 
 
 cdef public void compute_gradients_python(unified_int, MLIAPData *data) except * with gil:
-    pydata = MLIAPDataPy()
-    pydata.data = data
-    unified_int.compute_gradients(pydata)
+    cdef MLIAPUnifiedInterface interface = unified_int
+    interface.compute_gradients(interface.wrap(data))
 
 
 cdef public void compute_descriptors_python(unified_int, MLIAPData *data) except * with gil:
-    pydata = MLIAPDataPy()
-    pydata.data = data
-    unified_int.compute_descriptors(pydata)
+    cdef MLIAPUnifiedInterface interface = unified_int
+    interface.compute_descriptors(interface.wrap(data))
 
 
 cdef public void compute_forces_python(unified_int, MLIAPData *data) except * with gil:
-    pydata = MLIAPDataPy()
-    pydata.data = data
-    unified_int.compute_forces(pydata)
+    cdef MLIAPUnifiedInterface interface = unified_int
+    interface.compute_forces(interface.wrap(data))
 
 
 # Create a MLIAPUnifiedInterface and connect it to the dummy model, descriptor
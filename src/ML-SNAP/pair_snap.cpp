@@ -85,14 +85,12 @@ PairSNAP::~PairSNAP()
 
 void PairSNAP::compute(int eflag, int vflag)
 {
-  int i,j,jnum,ninside;
-  double delx,dely,delz,evdwl,rsq;
+  int i,ninside;
+  double evdwl;
   double fij[3];
-  int *jlist,*numneigh,**firstneigh;
 
   ev_init(eflag,vflag);
 
-  double **x = atom->x;
   double **f = atom->f;
   int *type = atom->type;
   int nlocal = atom->nlocal;
@@ -110,134 +108,178 @@ void PairSNAP::compute(int eflag, int vflag)
     compute_bispectrum();
   compute_beta();
 
-  numneigh = list->numneigh;
-  firstneigh = list->firstneigh;
-
-  for (int ii = 0; ii < list->inum; ii++) {
-    i = list->ilist[ii];
-
-    const double xtmp = x[i][0];
-    const double ytmp = x[i][1];
-    const double ztmp = x[i][2];
-    const int itype = type[i];
-    const int ielem = map[itype];
-    const double radi = radelem[ielem];
-
-    jlist = firstneigh[i];
-    jnum = numneigh[i];
+  // with batchsize > 1, Ui of a batch of atoms is computed first and
+  // then Yi of all atoms of the batch in one vectorizable pass
 
-    // ensure rij, inside, wj, and rcutij are of size jnum
-
-    snaptr->grow_rij(jnum);
-
-    // rij[][3] = displacements between atom I and those neighbors
-    // inside = indices of neighbors of I within cutoff
-    // wj = weights for neighbors of I within cutoff
-    // rcutij = cutoffs for neighbors of I within cutoff
-    // note Rij sign convention => dU/dRij = dU/dRj = -dU/dRi
+  const int inum = list->inum;
+  const int nstep = batchsize;
+  if (batchsize > 1) snaptr->grow_batch(batchsize);
 
-    ninside = 0;
-    for (int jj = 0; jj < jnum; jj++) {
-      j = jlist[jj];
-      j &= NEIGHMASK;
-      delx = x[j][0] - xtmp;
-      dely = x[j][1] - ytmp;
-      delz = x[j][2] - ztmp;
-      rsq = delx*delx + dely*dely + delz*delz;
-      int jtype = type[j];
-      int jelem = map[jtype];
+  for (int iibatch = 0; iibatch < inum; iibatch += nstep) {
+    const int nbatch = MIN(nstep,inum-iibatch);
 
-      if (rsq < cutsq[itype][jtype]&&rsq>1e-20) {
-        snaptr->rij[ninside][0] = delx;
-        snaptr->rij[ninside][1] = dely;
-        snaptr->rij[ninside][2] = delz;
-        snaptr->inside[ninside] = j;
-        snaptr->wj[ninside] = wjelem[jelem];
-        snaptr->rcutij[ninside] = (radi + radelem[jelem])*rcutfac;
-        if (switchinnerflag) {
-          snaptr->sinnerij[ninside] = 0.5*(sinnerelem[ielem]+sinnerelem[jelem]);
-          snaptr->dinnerij[ninside] = 0.5*(dinnerelem[ielem]+dinnerelem[jelem]);
-        }
-        if (chemflag) snaptr->element[ninside] = jelem;
-        ninside++;
+    if (batchsize > 1) {
+      for (int ib = 0; ib < nbatch; ib++) {
+        ninside = build_short_list(iibatch+ib);
+        if (chemflag)
+          snaptr->compute_ui(ninside, map[type[list->ilist[iibatch+ib]]]);
+        else
+          snaptr->compute_ui(ninside, 0);
+        snaptr->store_batch(ib, ninside);
       }
+      snaptr->compute_yi_batch(nbatch, &beta[iibatch]);
     }
 
-    // compute Ui, Yi for atom I
-
-    if (chemflag)
-      snaptr->compute_ui(ninside, ielem);
-    else
-      snaptr->compute_ui(ninside, 0);
-
-    // for neighbors of I within cutoff:
-    // compute Fij = dEi/dRj = -dEi/dRi
-    // add to Fi, subtract from Fj
-    // scaling is that for type I
+    for (int ib = 0; ib < nbatch; ib++) {
+      const int ii = iibatch + ib;
+      i = list->ilist[ii];
+
+      const int itype = type[i];
+      const int ielem = map[itype];
+
+      // compute Ui, Yi for atom I
+      // with batches, the short neighbor list is restored with Yi
+
+      if (batchsize > 1) {
+        ninside = snaptr->load_batch(ib);
+      } else {
+        ninside = build_short_list(ii);
+        if (chemflag)
+          snaptr->compute_ui(ninside, ielem);
+        else
+          snaptr->compute_ui(ninside, 0);
+        snaptr->compute_yi(beta[ii]);
+      }
 
-    snaptr->compute_yi(beta[ii]);
+      // for neighbors of I within cutoff:
+      // compute Fij = dEi/dRj = -dEi/dRi
+      // add to Fi, subtract from Fj
+      // scaling is that for type I
 
-    for (int jj = 0; jj < ninside; jj++) {
-      int j = snaptr->inside[jj];
-      snaptr->compute_duidrj(jj);
+      for (int jj = 0; jj < ninside; jj++) {
+        int j = snaptr->inside[jj];
+        snaptr->compute_duidrj(jj);
 
-      snaptr->compute_deidrj(fij);
+        snaptr->compute_deidrj(fij);
 
-      f[i][0] += fij[0]*scale[itype][itype];
-      f[i][1] += fij[1]*scale[itype][itype];
-      f[i][2] += fij[2]*scale[itype][itype];
-      f[j][0] -= fij[0]*scale[itype][itype];
-      f[j][1] -= fij[1]*scale[itype][itype];
-      f[j][2] -= fij[2]*scale[itype][itype];
+        f[i][0] += fij[0]*scale[itype][itype];
+        f[i][1] += fij[1]*scale[itype][itype];
+        f[i][2] += fij[2]*scale[itype][itype];
+        f[j][0] -= fij[0]*scale[itype][itype];
+        f[j][1] -= fij[1]*scale[itype][itype];
+        f[j][2] -= fij[2]*scale[itype][itype];
 
-      // tally per-atom virial contribution
+        // tally per-atom virial contribution
 
-      if (vflag)
-        ev_tally_xyz(i,j,nlocal,newton_pair,0.0,0.0,
-                     fij[0],fij[1],fij[2],
-                     -snaptr->rij[jj][0],-snaptr->rij[jj][1],
-                     -snaptr->rij[jj][2]);
-    }
+        if (vflag)
+          ev_tally_xyz(i,j,nlocal,newton_pair,0.0,0.0,
+                       fij[0],fij[1],fij[2],
+                       -snaptr->rij[jj][0],-snaptr->rij[jj][1],
+                       -snaptr->rij[jj][2]);
+      }
 
-    // tally energy contribution
+      // tally energy contribution
 
-    if (eflag) {
+      if (eflag) {
 
-      // evdwl = energy of atom I, sum over coeffs_k * Bi_k
+        // evdwl = energy of atom I, sum over coeffs_k * Bi_k
 
-      double* coeffi = coeffelem[ielem];
-      evdwl = coeffi[0];
-      // snaptr->copy_bi2bvec();
+        double* coeffi = coeffelem[ielem];
+        evdwl = coeffi[0];
 
-      // E = beta.B + 0.5*B^t.alpha.B
+        // E = beta.B + 0.5*B^t.alpha.B
 
-      // linear contributions
+        // linear contributions
 
-      for (int icoeff = 0; icoeff < ncoeff; icoeff++)
-        evdwl += coeffi[icoeff+1]*bispectrum[ii][icoeff];
+        for (int icoeff = 0; icoeff < ncoeff; icoeff++)
+          evdwl += coeffi[icoeff+1]*bispectrum[ii][icoeff];
 
-      // quadratic contributions
+        // quadratic contributions
 
-      if (quadraticflag) {
-        int k = ncoeff+1;
-        for (int icoeff = 0; icoeff < ncoeff; icoeff++) {
-          double bveci = bispectrum[ii][icoeff];
-          evdwl += 0.5*coeffi[k++]*bveci*bveci;
-          for (int jcoeff = icoeff+1; jcoeff < ncoeff; jcoeff++) {
-            double bvecj = bispectrum[ii][jcoeff];
-            evdwl += coeffi[k++]*bveci*bvecj;
+        if (quadraticflag) {
+          int k = ncoeff+1;
+          for (int icoeff = 0; icoeff < ncoeff; icoeff++) {
+            double bveci = bispectrum[ii][icoeff];
+            evdwl += 0.5*coeffi[k++]*bveci*bveci;
+            for (int jcoeff = icoeff+1; jcoeff < ncoeff; jcoeff++) {
+              double bvecj = bispectrum[ii][jcoeff];
+              evdwl += coeffi[k++]*bveci*bvecj;
+            }
           }
         }
+        evdwl *= scale[itype][itype];
+        ev_tally_full(i,2.0*evdwl,0.0,0.0,0.0,0.0,0.0);
       }
-      evdwl *= scale[itype][itype];
-      ev_tally_full(i,2.0*evdwl,0.0,0.0,0.0,0.0,0.0);
     }
-
   }
 
   if (vflag_fdotr) virial_fdotr_compute();
 }
 
+/* ----------------------------------------------------------------------
+   fill the short neighbor list of SNA with the neighbors of atom ii
+   in the neighbor list that are within the cutoff, return their number
+------------------------------------------------------------------------- */
+
+int PairSNAP::build_short_list(int ii)
+{
+  int j,ninside;
+  double delx,dely,delz,rsq;
+
+  double **x = atom->x;
+  int *type = atom->type;
+
+  const int i = list->ilist[ii];
+  const double xtmp = x[i][0];
+  const double ytmp = x[i][1];
+  const double ztmp = x[i][2];
+  const int itype = type[i];
+  const int ielem = map[itype];
+  const double radi = radelem[ielem];
+
+  const int *jlist = list->firstneigh[i];
+  const int jnum = list->numneigh[i];
+
+  // ensure rij, inside, wj, and rcutij are of size jnum
+
+  snaptr->grow_rij(jnum);
+
+  // rij[][3] = displacements between atom I and those neighbors
+  // inside = indices of neighbors of I within cutoff
+  // wj = weights for neighbors of I within cutoff
+  // rcutij = cutoffs for neighbors of I within cutoff
+  // note Rij sign convention => dU/dRij = dU/dRj = -dU/dRi
+
+  ninside = 0;
+  for (int jj = 0; jj < jnum; jj++) {
+    j = jlist[jj];
+    j &= NEIGHMASK;
+    delx = x[j][0] - xtmp;
+    dely = x[j][1] - ytmp;
+    delz = x[j][2] - ztmp;
+    rsq = delx*delx + dely*dely + delz*delz;
+    int jtype = type[j];
+    int jelem = map[jtype];
+
+    if (rsq < cutsq[itype][jtype]&&rsq>1e-20) {
+      snaptr->rij[ninside][0] = delx;
+      snaptr->rij[ninside][1] = dely;
+      snaptr->rij[ninside][2] = delz;
+      snaptr->inside[ninside] = j;
+      snaptr->wj[ninside] = wjelem[jelem];
+      snaptr->rcutij[ninside] = (radi + radelem[jelem])*rcutfac;
+      if (switchinnerflag) {
+        snaptr->sinnerij[ninside] = 0.5*(sinnerelem[ielem]+sinnerelem[jelem]);
+        snaptr->dinnerij[ninside] = 0.5*(dinnerelem[ielem]+dinnerelem[jelem]);
+      }
+      if (chemflag) snaptr->element[ninside] = jelem;
+      ninside++;
+    }
+  }
+
+  return ninside;
+}
+
 /* ----------------------------------------------------------------------
    compute beta
 ------------------------------------------------------------------------- */
@@ -640,6 +682,7 @@ void PairSNAP::read_files(char *coefffilename, char *paramfilename)
   switchinnerflag = 0;
   chunksize = 32768;
   parallel_thresh = 8192;
+  batchsize = 1;
 
   // set local input checks
 
@@ -759,6 +802,8 @@ void PairSNAP::read_files(char *coefffilename, char *paramfilename)
         chunksize = utils::inumeric(FLERR,keyval,false,lmp);
       else if (keywd == "parallelthresh")
         parallel_thresh = utils::inumeric(FLERR,keyval,false,lmp);
+      else if (keywd == "batchsize")
+        batchsize = utils::inumeric(FLERR,keyval,false,lmp);
       else
         error->all(FLERR,"Unknown parameter '{}' in SNAP parameter file", keywd);
     }
@@ -767,6 +812,9 @@ void PairSNAP::read_files(char *coefffilename, char *paramfilename)
   if (rcutfacflag == 0 || twojmaxflag == 0)
     error->all(FLERR,"Incorrect SNAP parameter file");
 
+  if (batchsize < 1)
+    error->all(FLERR,"Incorrect SNAP parameter file");
+
   if (chemflag && nelemtmp != nelements)
     error->all(FLERR,"Incorrect SNAP parameter file");
 
@@ -49,6 +49,7 @@ class PairSNAP : public Pair {
 
   void compute_beta();
   void compute_bispectrum();
+  int build_short_list(int);
 
   double rcutmax;         // max cutoff for all elements
   double *radelem;        // element radii
@@ -63,6 +64,7 @@ class PairSNAP : public Pair {
   double *sinnerelem;     // element inner cutoff midpoint
   double *dinnerelem;     // element inner cutoff half-width
   int chunksize, parallel_thresh;
+  int batchsize;                   // number of atoms per batch for Yi on CPU
   double rfac0, rmin0, wj1, wj2;
   int rcutfacflag, twojmaxflag;    // flags for required parameters
   int beta_max;                    // length of beta
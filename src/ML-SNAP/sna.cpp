@@ -154,6 +154,17 @@ SNA::SNA(LAMMPS* lmp, double rfac0_in, int twojmax_in,
   ulist_r_ij = nullptr;
   ulist_i_ij = nullptr;
 
+  nbatch_max = 0;
+  ulisttot_r_batch = ulisttot_i_batch = nullptr;
+  ylist_r_batch = ylist_i_batch = nullptr;
+  zbatch = nullptr;
+  ulist_batch_first = nullptr;
+  ulist_batch_max = 0;
+  ulist_r_batch = ulist_i_batch = nullptr;
+  rij_batch = nullptr;
+  inside_batch = element_batch = nullptr;
+  wj_batch = rcutij_batch = sinnerij_batch = dinnerij_batch = nullptr;
+
   build_indexlist();
   create_twojmax_arrays();
 
@@ -181,6 +192,21 @@ SNA::~SNA()
   if (chem_flag) memory->destroy(element);
   memory->destroy(ulist_r_ij);
   memory->destroy(ulist_i_ij);
+  memory->destroy(ulisttot_r_batch);
+  memory->destroy(ulisttot_i_batch);
+  memory->destroy(ylist_r_batch);
+  memory->destroy(ylist_i_batch);
+  memory->destroy(zbatch);
+  memory->destroy(ulist_batch_first);
+  memory->destroy(ulist_r_batch);
+  memory->destroy(ulist_i_batch);
+  memory->destroy(rij_batch);
+  memory->destroy(inside_batch);
+  memory->destroy(wj_batch);
+  memory->destroy(rcutij_batch);
+  memory->destroy(sinnerij_batch);
+  memory->destroy(dinnerij_batch);
+  memory->destroy(element_batch);
   delete[] idxz;
   delete[] idxb;
   destroy_twojmax_arrays();
@@ -562,6 +588,255 @@ void SNA::compute_yi(const double* beta)
 
 }
 
+/* ----------------------------------------------------------------------
+   the atom-batched evaluation of Yi works in three steps:
+   store_batch() saves Ui, the short neighbor list, and the u lists of the
+   neighbors of each atom after compute_ui(), compute_yi_batch() computes
+   Yi for all atoms of the batch in one pass, and load_batch() restores
+   the Yi, the short neighbor list, and the u lists of one atom for
+   compute_duidrj() and compute_deidrj().
+   in the batch arrays the atom index is fastest, so that the inner
+   loops of compute_yi_batch() run over atoms with unit stride and the
+   index and Clebsch-Gordan bookkeeping is shared by all atoms.
+------------------------------------------------------------------------- */
+
+void SNA::grow_batch(int newnbatch)
+{
+  if (newnbatch <= nbatch_max) return;
+
+  nbatch_max = newnbatch;
+
+  memory->destroy(ulisttot_r_batch);
+  memory->destroy(ulisttot_i_batch);
+  memory->destroy(ylist_r_batch);
+  memory->destroy(ylist_i_batch);
+  memory->destroy(zbatch);
+  memory->destroy(ulist_batch_first);
+  memory->create(ulisttot_r_batch, idxu_max*nelements*nbatch_max, "sna:ulisttot_batch");
+  memory->create(ulisttot_i_batch, idxu_max*nelements*nbatch_max, "sna:ulisttot_batch");
+  memory->create(ylist_r_batch, idxu_max*nelements*nbatch_max, "sna:ylist_batch");
+  memory->create(ylist_i_batch, idxu_max*nelements*nbatch_max, "sna:ylist_batch");
+  memory->create(zbatch, 5*nbatch_max, "sna:zbatch");
+  memory->create(ulist_batch_first, nbatch_max+1, "sna:ulist_batch_first");
+  ulist_batch_first[0] = 0;
+}
+
+/* ----------------------------------------------------------------------
+   save Ui, the short neighbor list and the u lists of jnum neighbors
+   as atom ib of the batch
+   atoms must be stored in order, starting with ib = 0
+------------------------------------------------------------------------- */
+
+void SNA::store_batch(int ib, int jnum)
+{
+  const int first = ulist_batch_first[ib];
+  ulist_batch_first[ib+1] = first + jnum;
+
+  if (first + jnum > ulist_batch_max) {
+    ulist_batch_max = first + jnum + nmax;
+    memory->grow(ulist_r_batch, ulist_batch_max, idxu_max, "sna:ulist_batch");
+    memory->grow(ulist_i_batch, ulist_batch_max, idxu_max, "sna:ulist_batch");
+    memory->grow(rij_batch, ulist_batch_max, 3, "sna:rij_batch");
+    memory->grow(inside_batch, ulist_batch_max, "sna:inside_batch");
+    memory->grow(wj_batch, ulist_batch_max, "sna:wj_batch");
+    memory->grow(rcutij_batch, ulist_batch_max, "sna:rcutij_batch");
+    if (switch_inner_flag) {
+      memory->grow(sinnerij_batch, ulist_batch_max, "sna:sinnerij_batch");
+      memory->grow(dinnerij_batch, ulist_batch_max, "sna:dinnerij_batch");
+    }
+    if (chem_flag) memory->grow(element_batch, ulist_batch_max, "sna:element_batch");
+  }
+
+  for (int jj = 0; jj < jnum; jj++) {
+    for (int jju = 0; jju < idxu_max; jju++) {
+      ulist_r_batch[first+jj][jju] = ulist_r_ij[jj][jju];
+      ulist_i_batch[first+jj][jju] = ulist_i_ij[jj][jju];
+    }
+    rij_batch[first+jj][0] = rij[jj][0];
+    rij_batch[first+jj][1] = rij[jj][1];
+    rij_batch[first+jj][2] = rij[jj][2];
+    inside_batch[first+jj] = inside[jj];
+    wj_batch[first+jj] = wj[jj];
+    rcutij_batch[first+jj] = rcutij[jj];
+    if (switch_inner_flag) {
+      sinnerij_batch[first+jj] = sinnerij[jj];
+      dinnerij_batch[first+jj] = dinnerij[jj];
+    }
+    if (chem_flag) element_batch[first+jj] = element[jj];
+  }
+
+  for (int jju = 0; jju < idxu_max*nelements; jju++) {
+    ulisttot_r_batch[jju*nbatch_max+ib] = ulisttot_r[jju];
+    ulisttot_i_batch[jju*nbatch_max+ib] = ulisttot_i[jju];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   restore Yi, the short neighbor list and the u lists of the neighbors
+   of atom ib of the batch, return the number of neighbors
+------------------------------------------------------------------------- */
+
+int SNA::load_batch(int ib)
+{
+  const int first = ulist_batch_first[ib];
+  const int jnum = ulist_batch_first[ib+1] - first;
+
+  grow_rij(jnum);
+
+  for (int jj = 0; jj < jnum; jj++) {
+    for (int jju = 0; jju < idxu_max; jju++) {
+      ulist_r_ij[jj][jju] = ulist_r_batch[first+jj][jju];
+      ulist_i_ij[jj][jju] = ulist_i_batch[first+jj][jju];
+    }
+    rij[jj][0] = rij_batch[first+jj][0];
+    rij[jj][1] = rij_batch[first+jj][1];
+    rij[jj][2] = rij_batch[first+jj][2];
+    inside[jj] = inside_batch[first+jj];
+    wj[jj] = wj_batch[first+jj];
+    rcutij[jj] = rcutij_batch[first+jj];
+    if (switch_inner_flag) {
+      sinnerij[jj] = sinnerij_batch[first+jj];
+      dinnerij[jj] = dinnerij_batch[first+jj];
+    }
+    if (chem_flag) element[jj] = element_batch[first+jj];
+  }
+
+  for (int jju = 0; jju < idxu_max*nelements; jju++) {
+    ylist_r[jju] = ylist_r_batch[jju*nbatch_max+ib];
+    ylist_i[jju] = ylist_i_batch[jju*nbatch_max+ib];
+  }
+
+  return jnum;
+}
+
+/* ----------------------------------------------------------------------
+   compute Yi for nbatch atoms stored with store_batch()
+   beta[ib] = dEi/dBi of atom ib of the batch
+   same operations in the same order as compute_yi() for each atom
+------------------------------------------------------------------------- */
+
+void SNA::compute_yi_batch(int nbatch, double **beta)
+{
+  int jju, itriple;
+  double betafac;
+
+  double *ztmp_r = zbatch;
+  double *ztmp_i = zbatch + nbatch_max;
+  double *suma1_r = zbatch + 2*nbatch_max;
+  double *suma1_i = zbatch + 3*nbatch_max;
+  double *betaj = zbatch + 4*nbatch_max;
+
+  for (int jju = 0; jju < idxu_max*nelements*nbatch_max; jju++) {
+    ylist_r_batch[jju] = 0.0;
+    ylist_i_batch[jju] = 0.0;
+  }
+
+  for (int elem1 = 0; elem1 < nelements; elem1++)
+    for (int elem2 = 0; elem2 < nelements; elem2++) {
+      for (int jjz = 0; jjz < idxz_max; jjz++) {
+        const int j1 = idxz[jjz].j1;
+        const int j2 = idxz[jjz].j2;
+        const int j = idxz[jjz].j;
+        const int ma1min = idxz[jjz].ma1min;
+        const int ma2max = idxz[jjz].ma2max;
+        const int na = idxz[jjz].na;
+        const int mb1min = idxz[jjz].mb1min;
+        const int mb2max = idxz[jjz].mb2max;
+        const int nb = idxz[jjz].nb;
+
+        const double *cgblock = cglist + idxcg_block[j1][j2][j];
+
+        for (int k = 0; k < nbatch; k++) {
+          ztmp_r[k] = 0.0;
+          ztmp_i[k] = 0.0;
+        }
+
+        int jju1 = idxu_block[j1] + (j1 + 1) * mb1min;
+        int jju2 = idxu_block[j2] + (j2 + 1) * mb2max;
+        int icgb = mb1min * (j2 + 1) + mb2max;
+        for (int ib = 0; ib < nb; ib++) {
+
+          for (int k = 0; k < nbatch; k++) {
+            suma1_r[k] = 0.0;
+            suma1_i[k] = 0.0;
+          }
+
+          int ma1 = ma1min;
+          int ma2 = ma2max;
+          int icga = ma1min * (j2 + 1) + ma2max;
+
+          for (int ia = 0; ia < na; ia++) {
+            const double cga = cgblock[icga];
+            const double *u1_r = &ulisttot_r_batch[(elem1*idxu_max+jju1+ma1)*nbatch_max];
+            const double *u1_i = &ulisttot_i_batch[(elem1*idxu_max+jju1+ma1)*nbatch_max];
+            const double *u2_r = &ulisttot_r_batch[(elem2*idxu_max+jju2+ma2)*nbatch_max];
+            const double *u2_i = &ulisttot_i_batch[(elem2*idxu_max+jju2+ma2)*nbatch_max];
+            for (int k = 0; k < nbatch; k++) {
+              suma1_r[k] += cga * (u1_r[k] * u2_r[k] - u1_i[k] * u2_i[k]);
+              suma1_i[k] += cga * (u1_r[k] * u2_i[k] + u1_i[k] * u2_r[k]);
+            }
+            ma1++;
+            ma2--;
+            icga += j2;
+          } // end loop over ia
+
+          const double cgb = cgblock[icgb];
+          for (int k = 0; k < nbatch; k++) {
+            ztmp_r[k] += cgb * suma1_r[k];
+            ztmp_i[k] += cgb * suma1_i[k];
+          }
+
+          jju1 += j1 + 1;
+          jju2 -= j2 + 1;
+          icgb += j2;
+        } // end loop over ib
+
+        if (bnorm_flag) {
+          for (int k = 0; k < nbatch; k++) {
+            ztmp_i[k] /= j+1;
+            ztmp_r[k] /= j+1;
+          }
+        }
+
+        // same choice of beta and multiplicity as in compute_yi()
+
+        jju = idxz[jjz].jju;
+        for (int elem3 = 0; elem3 < nelements; elem3++) {
+          if (j >= j1) {
+            const int jjb = idxb_block[j1][j2][j];
+            itriple = ((elem1 * nelements + elem2) * nelements + elem3) * idxb_max + jjb;
+            if (j1 == j) {
+              if (j2 == j) betafac = 3.0;
+              else betafac = 2.0;
+            } else betafac = 1.0;
+          } else if (j >= j2) {
+            const int jjb = idxb_block[j][j2][j1];
+            itriple = ((elem3 * nelements + elem2) * nelements + elem1) * idxb_max + jjb;
+            if (j2 == j) betafac = 2.0;
+            else betafac = 1.0;
+          } else {
+            const int jjb = idxb_block[j2][j][j1];
+            itriple = ((elem2 * nelements + elem3) * nelements + elem1) * idxb_max + jjb;
+            betafac = 1.0;
+          }
+
+          for (int k = 0; k < nbatch; k++) {
+            betaj[k] = betafac * beta[k][itriple];
+            if (!bnorm_flag && j1 > j)
+              betaj[k] *= (j1 + 1) / (j + 1.0);
+          }
+
+          double *y_r = &ylist_r_batch[(elem3 * idxu_max + jju)*nbatch_max];
+          double *y_i = &ylist_i_batch[(elem3 * idxu_max + jju)*nbatch_max];
+          for (int k = 0; k < nbatch; k++) {
+            y_r[k] += betaj[k] * ztmp_r[k];
+            y_i[k] += betaj[k] * ztmp_i[k];
+          }
+        }
+      } // end loop over jjz
+    }
+}
+
 /* ----------------------------------------------------------------------
    compute dEidRj
 ------------------------------------------------------------------------- */
@@ -1328,6 +1603,16 @@ double SNA::memory_usage()
   bytes += (double)nmax * sizeof(double);                      // dinnerij
   if (chem_flag) bytes += (double)nmax * sizeof(int);            // element
 
+  bytes += (double)idxu_max * nelements * nbatch_max * sizeof(double) * 4; // u/y batch
+  bytes += (double)nbatch_max * 5 * sizeof(double);              // zbatch
+  bytes += (double)(nbatch_max+1) * sizeof(int);                 // ulist_batch_first
+  bytes += (double)ulist_batch_max * idxu_max * sizeof(double) * 2; // ulist_batch
+  bytes += (double)ulist_batch_max * 6 * sizeof(double);         // rij/wj/rcutij_batch
+  if (switch_inner_flag)
+    bytes += (double)ulist_batch_max * 2 * sizeof(double);       // s/dinnerij_batch
+  bytes += (double)ulist_batch_max * sizeof(int);                // inside_batch
+  if (chem_flag) bytes += (double)ulist_batch_max * sizeof(int); // element_batch
+
   return bytes;
 }
 /* ---------------------------------------------------------------------- */
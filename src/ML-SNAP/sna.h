@@ -59,6 +59,13 @@ class SNA : protected Pointers {
   double compute_sfac(double, double, double, double);
   double compute_dsfac(double, double, double, double);
 
+  // functions for atom-batched evaluation of Yi
+
+  void grow_batch(int);
+  void store_batch(int, int);
+  void compute_yi_batch(int, double **);
+  int load_batch(int);
+
   // public bispectrum data
 
   int twojmax;
@@ -111,6 +118,21 @@ class SNA : protected Pointers {
   double *ylist_r, *ylist_i;
   int idxcg_max, idxu_max, idxz_max, idxb_max;
 
+  // data for atom-batched evaluation of Yi
+  // batch arrays are indexed as [(elem*idxu_max+jju)*nbatch_max+iatom]
+
+  int nbatch_max;                                 // allocated number of atoms in batch
+  double *ulisttot_r_batch, *ulisttot_i_batch;    // batch ulisttot
+  double *ylist_r_batch, *ylist_i_batch;          // batch ylist
+  double *zbatch;                                 // batch scratch for Zi and beta
+  int *ulist_batch_first;                         // first u list row of each atom in batch
+  int ulist_batch_max;                            // allocated rows of batch u list
+  double **ulist_r_batch, **ulist_i_batch;        // u lists of all atoms in batch
+  double **rij_batch;                             // short neighbor lists of all atoms in batch,
+  int *inside_batch, *element_batch;              // same rows as the batch u list
+  double *wj_batch, *rcutij_batch;
+  double *sinnerij_batch, *dinnerij_batch;        // only allocated for switch_inner_flag=1
+
   void create_twojmax_arrays();
   void destroy_twojmax_arrays();
   void init_clebsch_gordan();
@@ -35,6 +35,7 @@ BondHarmonicOMP::BondHarmonicOMP(class LAMMPS *lmp)
   : BondHarmonic(lmp), ThrOMP(lmp,THR_BOND)
 {
   suffix_flag |= Suffix::OMP;
+  color_flag = true;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -47,6 +48,14 @@ void BondHarmonicOMP::compute(int eflag, int vflag)
   const int nthreads = comm->nthreads;
   const int inum = neighbor->nbondlist;
 
+  // with spatial coloring, threads process one color at a time
+  // and write directly to the shared force array
+
+  const bool color = color_active_thr();
+  if (color)
+    color_setup_thr(inum ? neighbor->bondlist[0] : nullptr, inum, 3, 2, 0.0, neighbor->nrebuild);
+  const int ncolor = color ? color_ncolor : 1;
+
 #if defined(_OPENMP)
 #pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(eflag,vflag)
 #endif
@@ -58,19 +67,25 @@ void BondHarmonicOMP::compute(int eflag, int vflag)
     thr->timer(Timer::START);
     ev_setup_thr(eflag, vflag, nall, eatom, vatom, nullptr, thr);
 
-    if (inum > 0) {
-      if (evflag) {
-        if (eflag) {
-          if (force->newton_bond) eval<1,1,1>(ifrom, ito, thr);
-          else eval<1,1,0>(ifrom, ito, thr);
+    for (int icolor = 0; icolor < ncolor; ++icolor) {
+      if (color) color_range_thr(icolor, tid, ifrom, ito);
+      if (inum > 0) {
+        if (evflag) {
+          if (eflag) {
+            if (force->newton_bond) eval<1,1,1>(ifrom, ito, thr);
+            else eval<1,1,0>(ifrom, ito, thr);
+          } else {
+            if (force->newton_bond) eval<1,0,1>(ifrom, ito, thr);
+            else eval<1,0,0>(ifrom, ito, thr);
+          }
         } else {
-          if (force->newton_bond) eval<1,0,1>(ifrom, ito, thr);
-          else eval<1,0,0>(ifrom, ito, thr);
+          if (force->newton_bond) eval<0,0,1>(ifrom, ito, thr);
+          else eval<0,0,0>(ifrom, ito, thr);
         }
-      } else {
-        if (force->newton_bond) eval<0,0,1>(ifrom, ito, thr);
-        else eval<0,0,0>(ifrom, ito, thr);
       }
+
+      // all threads must be done with a color before the next one
+      if (color) sync_threads();
     }
     thr->timer(Timer::BOND);
     reduce_thr(this, eflag, vflag, thr);
@@ -86,7 +101,8 @@ void BondHarmonicOMP::eval(int nfrom, int nto, ThrData * const thr)
 
   const auto * _noalias const x = (dbl3_t *) atom->x[0];
   auto * _noalias const f = (dbl3_t *) thr->get_f()[0];
-  const int3_t * _noalias const bondlist = (int3_t *) neighbor->bondlist[0];
+  const int3_t * _noalias const bondlist =
+    (int3_t *) (color_active_thr() ? color_items.data() : neighbor->bondlist[0]);
   const int nlocal = atom->nlocal;
   ebond = 0.0;
 
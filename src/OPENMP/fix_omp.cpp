@@ -19,6 +19,7 @@
 
 #include "fix_omp.h"
 #include "thr_data.h"
+#include "thr_omp.h"
 
 #include "atom.h"
 #include "comm.h"
@@ -63,6 +64,7 @@ FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
   :  Fix(lmp, narg, arg),
      thr(nullptr), last_omp_style(nullptr), last_pair_hybrid(nullptr),
      _nthr(-1), _neighbor(true), _mixed(false), _reduced(true),
+     _color(false), _color_active(false), _color_all(false),
      _pair_compute_flag(false), _kspace_compute_flag(false)
 {
   if (narg < 4) error->all(FLERR,"Illegal package omp command");
@@ -100,6 +102,10 @@ FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
       if (iarg+2 > narg) error->all(FLERR,"Illegal package omp command");
       _neighbor = utils::logical(FLERR,arg[iarg+1],false,lmp) != 0;
       iarg += 2;
+    } else if (strcmp(arg[iarg],"color") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal package omp command");
+      _color = utils::logical(FLERR,arg[iarg+1],false,lmp) != 0;
+      iarg += 2;
     } else error->all(FLERR,"Illegal package omp command");
   }
 
@@ -112,6 +118,8 @@ FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
     if (reset_thr)
       utils::logmesg(lmp, "set {} OpenMP thread(s) per MPI task\n", nthreads);
     utils::logmesg(lmp, "using {} neighbor list subroutines\n", nmode);
+    if (_color)
+      utils::logmesg(lmp, "using spatial coloring for direct force accumulation\n");
 #else
     error->warning(FLERR,"OpenMP support not enabled during compilation; "
                          "using 1 thread only.");
@@ -283,6 +291,42 @@ void FixOMP::init()
 
 #undef CheckStyleForOMP
 #undef CheckHybridForOMP
+
+  // spatial coloring lets supporting /omp styles write directly to the
+  // shared force array. the per-thread force copies and their reduction
+  // are only skipped when all active /omp force styles support it.
+
+  _color_active = _color;
+  _color_all = _color;
+  if (_color) {
+    if (utils::strmatch(update->integrate_style,"^respa")) {
+      if (comm->me == 0)
+        error->warning(FLERR,"Spatial coloring is not supported with r-RESPA. Disabling it.");
+      _color_active = _color_all = false;
+    }
+
+#define CheckStyleForColor(name)                                        \
+    if (force->name) {                                                  \
+      if (utils::strmatch(force->name ## _style,"^hybrid")) {           \
+        if (_color_active && (comm->me == 0))                           \
+          error->warning(FLERR,"Spatial coloring is not supported "     \
+                         "with hybrid styles. Disabling it.");          \
+        _color_active = _color_all = false;                             \
+      } else if (force->name->suffix_flag & Suffix::OMP) {              \
+        auto thrstyle = dynamic_cast<ThrOMP *>(force->name);            \
+        if (!thrstyle || !thrstyle->get_color_flag()) _color_all = false; \
+      }                                                                 \
+    }
+
+    CheckStyleForColor(pair);
+    CheckStyleForColor(bond);
+    CheckStyleForColor(angle);
+    CheckStyleForColor(dihedral);
+    CheckStyleForColor(improper);
+    CheckStyleForColor(kspace);
+
+#undef CheckStyleForColor
+  }
   neighbor->set_omp_neighbor(_neighbor ? 1 : 0);
 
   // diagnostic output
@@ -294,6 +338,9 @@ void FixOMP::init()
     } else {
       utils::logmesg(lmp,"No /omp style for force computation currently active\n");
     }
+    if (_color_active && !_color_all)
+      utils::logmesg(lmp,"Not all /omp styles support spatial coloring. "
+                     "Using per-thread force arrays for those\n");
   }
 }
 
@@ -325,7 +372,7 @@ void FixOMP::pre_force(int)
   {
     const int tid = get_tid();
     thr[tid]->check_tid(tid);
-    thr[tid]->init_force(nall,f,torque,erforce,desph,drho);
+    thr[tid]->init_force(nall,f,torque,erforce,desph,drho,!_color_all);
   } // end of omp parallel region
 
   _reduced = false;
@@ -63,12 +63,17 @@ class FixOMP : public Fix {
   bool get_neighbor() const { return _neighbor; }
   bool get_mixed() const { return _mixed; }
   bool get_reduced() const { return _reduced; }
+  bool get_color() const { return _color_active; }
+  bool get_color_all() const { return _color_all; }
 
  private:
   int _nthr;                    // number of currently active ThrData objects
   bool _neighbor;               // en/disable threads for neighbor list construction
   bool _mixed;                  // whether to prefer mixed precision compute kernels
   bool _reduced;                // whether forces have been reduced for this step
+  bool _color;                  // whether spatial coloring was requested
+  bool _color_active;           // whether spatial coloring is used
+  bool _color_all;              // whether all active /omp styles use spatial coloring
   bool _pair_compute_flag;      // whether pair_compute is called
   bool _kspace_compute_flag;    // whether kspace_compute is called
 };
@@ -59,14 +59,6 @@ FixQEqReaxFFOMP::FixQEqReaxFFOMP(LAMMPS *lmp, int narg, char **arg) :
   FixQEqReaxFF(lmp, narg, arg)
 {
   b_temp = nullptr;
-
-  // ASPC: Kolafa, J. Comp. Chem., 25(3), 335 (2003)
-  do_aspc = 0;
-  aspc_order = 1;
-  // Must be consistent with nprev to store history: nprev = aspc_order + 2
-  aspc_order_max = nprev - 2;
-  aspc_omega = 0.0;
-  aspc_b = nullptr;
 }
 
 FixQEqReaxFFOMP::~FixQEqReaxFFOMP()
@@ -84,6 +76,8 @@ void FixQEqReaxFFOMP::post_constructor()
       s_hist[i][j] = t_hist[i][j] = 0;
 
   pertype_parameters(pertype_option);
+  if (precond_style != PRECOND_JACOBI)
+    error->all(FLERR,"Fix {} only supports the jacobi preconditioner", style);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -109,41 +103,6 @@ void FixQEqReaxFFOMP::deallocate_storage()
 
 /* ---------------------------------------------------------------------- */
 
-void FixQEqReaxFFOMP::init()
-{
-  FixQEqReaxFF::init();
-
-  // APSC setup
-  if (do_aspc) {
-    memory->create(aspc_b, aspc_order_max+2, "qeq/reaxff/aspc_b");
-
-    // Calculate damping factor
-    auto  o = double(aspc_order);
-    aspc_omega = (o+2.0) / (2*o+3.0);
-
-    // Calculate B coefficients
-    double c = (4.0 * o + 6.0) / (o + 3.0);
-    aspc_b[0] = c;
-
-    double n =  1.0;
-    double d =  4.0;
-    double s = -1.0;
-    double f =  2.0;
-
-    for (int i=1; i<aspc_order_max+2; i++) {
-      c*= (o + n) / (o + d);
-      aspc_b[i] = s * f * c;
-
-      s *= -1.0;
-      f += 1.0;
-      n -= 1.0;
-      d += 1.0;
-    }
-  }
-}
-
-/* ---------------------------------------------------------------------- */
-
 void FixQEqReaxFFOMP::compute_H()
 {
   double SMALL = 0.0001;
@@ -297,64 +256,28 @@ void FixQEqReaxFFOMP::init_matvec()
 
   int i;
 
-  // Should really be more careful with initialization and first (aspc_order+2) MD steps
-  if (do_aspc) {
-
-    double m_aspc_omega = 1.0 - aspc_omega;
 #if defined(_OPENMP)
 #pragma omp parallel for schedule(dynamic,50) private(i)
 #endif
-    for (int ii = 0; ii < nn; ++ii) {
-      i = ilist[ii];
-      if (atom->mask[i] & groupbit) {
-
-        /* init pre-conditioner for H and init solution vectors */
-        Hdia_inv[i] = 1. / eta[atom->type[i]];
-        b_s[i]      = -chi[atom->type[i]];
-        if (efield) b_s[i] -= chi_field[i];
-        b_t[i]      = -1.0;
-
-        // Predictor Step
-        double tp = 0.0;
-        double sp = 0.0;
-        for (int j=0; j<aspc_order+2; j++) {
-          tp+= aspc_b[j] * t_hist[i][j];
-          sp+= aspc_b[j] * s_hist[i][j];
-        }
-
-        // Corrector Step
-        t[i] = aspc_omega * t_hist[i][0] + m_aspc_omega * tp;
-        s[i] = aspc_omega * s_hist[i][0] + m_aspc_omega * sp;
-      }
-    }
-
-  } else {
-
-#if defined(_OPENMP)
-#pragma omp parallel for schedule(dynamic,50) private(i)
-#endif
-    for (int ii = 0; ii < nn; ++ii) {
-      i = ilist[ii];
-      if (atom->mask[i] & groupbit) {
-
-        /* init pre-conditioner for H and init solution vectors */
-        Hdia_inv[i] = 1. / eta[atom->type[i]];
-        b_s[i]      = -chi[atom->type[i]];
-        if (efield) b_s[i] -= chi_field[i];
-        b_t[i]      = -1.0;
-
-        /* linear extrapolation for s & t from previous solutions */
-        //s[i] = 2 * s_hist[i][0] - s_hist[i][1];
-        //t[i] = 2 * t_hist[i][0] - t_hist[i][1];
-
-        /* quadratic extrapolation for s & t from previous solutions */
-        //s[i] = s_hist[i][2] + 3 * (s_hist[i][0] - s_hist[i][1]);
-        t[i] = t_hist[i][2] + 3 * (t_hist[i][0] - t_hist[i][1]);
+  for (int ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
 
-        /* cubic extrapolation for s & t from previous solutions */
-        s[i] = 4*(s_hist[i][0]+s_hist[i][2])-(6*s_hist[i][1]+s_hist[i][3]);
-        //t[i] = 4*(t_hist[i][0]+t_hist[i][2])-(6*t_hist[i][1]+t_hist[i][3]);
+      /* init pre-conditioner for H and init solution vectors */
+      Hdia_inv[i] = 1. / eta[atom->type[i]];
+      b_s[i]      = -chi[atom->type[i]];
+      if (efield) b_s[i] -= chi_field[i];
+      b_t[i]      = -1.0;
+
+      /* extrapolation for s & t from previous solutions */
+      double sp = 0.0;
+      double tp = 0.0;
+      for (int k = 0; k < nprev; ++k) {
+        sp += s_extrap[k] * s_hist[i][k];
+        tp += t_extrap[k] * t_hist[i][k];
       }
+      s[i] = sp;
+      t[i] = tp;
     }
   }
 
@@ -581,12 +504,7 @@ void FixQEqReaxFFOMP::calculate_Q()
       q[i] = s[i] - u * t[i];
 
       // backup s & t
-      for (int k = nprev-1; k > 0; --k) {
-        s_hist[i][k] = s_hist[i][k-1];
-        t_hist[i][k] = t_hist[i][k-1];
-      }
-      s_hist[i][0] = s[i];
-      t_hist[i][0] = t[i];
+      store_history(i);
     }
   }
 
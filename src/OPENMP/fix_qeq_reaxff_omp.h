@@ -30,7 +30,6 @@ class FixQEqReaxFFOMP : public FixQEqReaxFF {
  public:
   FixQEqReaxFFOMP(class LAMMPS *, int, char **);
   ~FixQEqReaxFFOMP() override;
-  void init() override;
   void init_storage() override;
   void pre_force(int) override;
   void post_constructor() override;
@@ -38,11 +37,6 @@ class FixQEqReaxFFOMP : public FixQEqReaxFF {
  protected:
   double **b_temp;
 
-  int do_aspc;
-  int aspc_order, aspc_order_max;
-  double aspc_omega;
-  double *aspc_b;
-
   void allocate_storage() override;
   void deallocate_storage() override;
   void init_matvec() override;
@@ -56,9 +50,9 @@ class FixQEqReaxFFOMP : public FixQEqReaxFF {
   void vector_add(double *, double, double *, int) override;
 
   // dual CG support
-  virtual int dual_CG(double *, double *, double *, double *);
-  virtual void dual_sparse_matvec(sparse_matrix *, double *, double *, double *);
-  virtual void dual_sparse_matvec(sparse_matrix *, double *, double *);
+  int dual_CG(double *, double *, double *, double *) override;
+  void dual_sparse_matvec(sparse_matrix *, double *, double *, double *) override;
+  void dual_sparse_matvec(sparse_matrix *, double *, double *) override;
 };
 
 }    // namespace LAMMPS_NS
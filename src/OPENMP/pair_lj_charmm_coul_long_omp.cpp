@@ -19,6 +19,7 @@
 #include "comm.h"
 #include "force.h"
 #include "neigh_list.h"
+#include "neighbor.h"
 #include "suffix.h"
 
 #include <cmath>
@@ -32,6 +33,7 @@ PairLJCharmmCoulLongOMP::PairLJCharmmCoulLongOMP(LAMMPS *lmp) :
   PairLJCharmmCoulLong(lmp), ThrOMP(lmp, THR_PAIR)
 {
   suffix_flag |= Suffix::OMP;
+  color_flag = true;
   respa_enable = 0;
   cut_respa = nullptr;
 }
@@ -46,6 +48,13 @@ void PairLJCharmmCoulLongOMP::compute(int eflag, int vflag)
   const int nthreads = comm->nthreads;
   const int inum = list->inum;
 
+  // with spatial coloring, threads process one color at a time
+  // and write directly to the shared force array
+
+  const bool color = color_active_thr();
+  if (color) color_setup_thr(list->ilist, inum, 1, 1, neighbor->cutneighmax, neighbor->nrebuild);
+  const int ncolor = color ? color_ncolor : 1;
+
 #if defined(_OPENMP)
 #pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(eflag,vflag)
 #endif
@@ -57,19 +66,24 @@ void PairLJCharmmCoulLongOMP::compute(int eflag, int vflag)
     thr->timer(Timer::START);
     ev_setup_thr(eflag, vflag, nall, eatom, vatom, nullptr, thr);
 
-    if (evflag) {
-      if (eflag) {
-        if (force->newton_pair) eval<1,1,1>(ifrom, ito, thr);
-        else eval<1,1,0>(ifrom, ito, thr);
+    for (int icolor = 0; icolor < ncolor; ++icolor) {
+      if (color) color_range_thr(icolor, tid, ifrom, ito);
+      if (evflag) {
+        if (eflag) {
+          if (force->newton_pair) eval<1,1,1>(ifrom, ito, thr);
+          else eval<1,1,0>(ifrom, ito, thr);
+        } else {
+          if (force->newton_pair) eval<1,0,1>(ifrom, ito, thr);
+          else eval<1,0,0>(ifrom, ito, thr);
+        }
       } else {
-        if (force->newton_pair) eval<1,0,1>(ifrom, ito, thr);
-        else eval<1,0,0>(ifrom, ito, thr);
+        if (force->newton_pair) eval<0,0,1>(ifrom, ito, thr);
+        else eval<0,0,0>(ifrom, ito, thr);
       }
-    } else {
-      if (force->newton_pair) eval<0,0,1>(ifrom, ito, thr);
-      else eval<0,0,0>(ifrom, ito, thr);
-    }
 
+      // all threads must be done with a color before the next one
+      if (color) sync_threads();
+    }
     thr->timer(Timer::PAIR);
     reduce_thr(this, eflag, vflag, thr);
   } // end of omp parallel region
@@ -90,7 +104,7 @@ void PairLJCharmmCoulLongOMP::eval(int iifrom, int iito, ThrData * const thr)
   const double qqrd2e = force->qqrd2e;
   const double inv_denom_lj = 1.0/denom_lj;
 
-  const int * const ilist = list->ilist;
+  const int * const ilist = color_active_thr() ? color_items.data() : list->ilist;
   const int * const numneigh = list->numneigh;
   const int * const * const firstneigh = list->firstneigh;
   const int nlocal = atom->nlocal;
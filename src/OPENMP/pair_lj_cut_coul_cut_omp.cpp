@@ -19,6 +19,7 @@
 #include "comm.h"
 #include "force.h"
 #include "neigh_list.h"
+#include "neighbor.h"
 #include "suffix.h"
 
 #include <cmath>
@@ -32,6 +33,7 @@ PairLJCutCoulCutOMP::PairLJCutCoulCutOMP(LAMMPS *lmp) :
   PairLJCutCoulCut(lmp), ThrOMP(lmp, THR_PAIR)
 {
   suffix_flag |= Suffix::OMP;
+  color_flag = true;
   respa_enable = 0;
 }
 
@@ -45,6 +47,13 @@ void PairLJCutCoulCutOMP::compute(int eflag, int vflag)
   const int nthreads = comm->nthreads;
   const int inum = list->inum;
 
+  // with spatial coloring, threads process one color at a time
+  // and write directly to the shared force array
+
+  const bool color = color_active_thr();
+  if (color) color_setup_thr(list->ilist, inum, 1, 1, neighbor->cutneighmax, neighbor->nrebuild);
+  const int ncolor = color ? color_ncolor : 1;
+
 #if defined(_OPENMP)
 #pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(eflag,vflag)
 #endif
@@ -56,19 +65,24 @@ void PairLJCutCoulCutOMP::compute(int eflag, int vflag)
     thr->timer(Timer::START);
     ev_setup_thr(eflag, vflag, nall, eatom, vatom, nullptr, thr);
 
-    if (evflag) {
-      if (eflag) {
-        if (force->newton_pair) eval<1,1,1>(ifrom, ito, thr);
-        else eval<1,1,0>(ifrom, ito, thr);
+    for (int icolor = 0; icolor < ncolor; ++icolor) {
+      if (color) color_range_thr(icolor, tid, ifrom, ito);
+      if (evflag) {
+        if (eflag) {
+          if (force->newton_pair) eval<1,1,1>(ifrom, ito, thr);
+          else eval<1,1,0>(ifrom, ito, thr);
+        } else {
+          if (force->newton_pair) eval<1,0,1>(ifrom, ito, thr);
+          else eval<1,0,0>(ifrom, ito, thr);
+        }
       } else {
-        if (force->newton_pair) eval<1,0,1>(ifrom, ito, thr);
-        else eval<1,0,0>(ifrom, ito, thr);
+        if (force->newton_pair) eval<0,0,1>(ifrom, ito, thr);
+        else eval<0,0,0>(ifrom, ito, thr);
       }
-    } else {
-      if (force->newton_pair) eval<0,0,1>(ifrom, ito, thr);
-      else eval<0,0,0>(ifrom, ito, thr);
-    }
 
+      // all threads must be done with a color before the next one
+      if (color) sync_threads();
+    }
     thr->timer(Timer::PAIR);
     reduce_thr(this, eflag, vflag, thr);
   } // end of omp parallel region
@@ -96,7 +110,7 @@ void PairLJCutCoulCutOMP::eval(int iifrom, int iito, ThrData * const thr)
   const double qqrd2e = force->qqrd2e;
   double fxtmp,fytmp,fztmp;
 
-  ilist = list->ilist;
+  ilist = color_active_thr() ? color_items.data() : list->ilist;
   numneigh = list->numneigh;
   firstneigh = list->firstneigh;
 
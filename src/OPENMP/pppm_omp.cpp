@@ -47,6 +47,7 @@ PPPMOMP::PPPMOMP(LAMMPS *lmp) : PPPM(lmp), ThrOMP(lmp, THR_KSPACE)
 {
   triclinic_support = 1;
   suffix_flag |= Suffix::OMP;
+  color_flag = true;
 }
 
 /* ----------------------------------------------------------------------
@@ -300,15 +301,18 @@ void PPPMOMP::compute_gf_ad()
 }
 
 /* ----------------------------------------------------------------------
-   run the regular toplevel compute method from plain PPPM
+   run the regular force part of the compute method from plain PPPM
    which will have individual methods replaced by our threaded
    versions and then call the obligatory force reduction.
+   the grid part is run by PPPM::compute_grid() with threaded make_rho()
 ------------------------------------------------------------------------- */
 
-void PPPMOMP::compute(int eflag, int vflag)
+void PPPMOMP::compute_force()
 {
+  PPPM::compute_force();
 
-  PPPM::compute(eflag,vflag);
+  const int eflag = eflag_either;
+  const int vflag = vflag_either;
 
 #if defined(_OPENMP)
 #pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(eflag,vflag)
@@ -361,11 +365,17 @@ void PPPMOMP::make_rho()
     const double boxloz = boxlo[2];
 
     // determine range of grid points handled by this thread
+    // with kspace_modify concurrent this may be a nested team with its
+    // own size, using the per-thread data starting at concurrent_tid
     int i,jfrom,jto,tid;
-    loop_setup_thr(jfrom,jto,tid,ngrid,comm->nthreads);
+#if defined(_OPENMP)
+    loop_setup_thr(jfrom,jto,tid,ngrid,omp_get_num_threads());
+#else
+    loop_setup_thr(jfrom,jto,tid,ngrid,1);
+#endif
 
     // get per thread data
-    ThrData *thr = fix->get_thr(tid);
+    ThrData *thr = fix->get_thr(concurrent_tid + tid);
     thr->timer(Timer::START);
     FFT_SCALAR * const * const r1d = static_cast<FFT_SCALAR **>(thr->get_rho1d());
 
@@ -457,6 +467,10 @@ void PPPMOMP::fieldforce_ik()
     // get per thread data
     ThrData *thr = fix->get_thr(tid);
     thr->timer(Timer::START);
+
+    // each thread only updates the forces of its own atoms,
+    // so with spatial coloring they can use the shared force array
+    thr->set_shared_f(color_active_thr());
     auto * _noalias const f = (dbl3_t *) thr->get_f()[0];
     FFT_SCALAR * const * const r1d = static_cast<FFT_SCALAR **>(thr->get_rho1d());
 
@@ -543,6 +557,10 @@ void PPPMOMP::fieldforce_ad()
     // get per thread data
     ThrData *thr = fix->get_thr(tid);
     thr->timer(Timer::START);
+
+    // each thread only updates the forces of its own atoms,
+    // so with spatial coloring they can use the shared force array
+    thr->set_shared_f(color_active_thr());
     auto * _noalias const f = (dbl3_t *) thr->get_f()[0];
     FFT_SCALAR * const * const r1d = static_cast<FFT_SCALAR **>(thr->get_rho1d());
     FFT_SCALAR * const * const d1d = static_cast<FFT_SCALAR **>(thr->get_drho1d());
@@ -29,7 +29,7 @@ class PPPMOMP : public PPPM, public ThrOMP {
  public:
   PPPMOMP(class LAMMPS *);
   ~PPPMOMP() override;
-  void compute(int, int) override;
+  void compute_force() override;
 
  protected:
   void allocate() override;
@@ -29,7 +29,8 @@ using namespace LAMMPS_NS;
 /* ---------------------------------------------------------------------- */
 
 ThrData::ThrData(int tid, Timer *t) :
-    _f(nullptr), _torque(nullptr), _erforce(nullptr), _de(nullptr), _drho(nullptr), _mu(nullptr),
+    _f(nullptr), _fthr(nullptr), _fshared(nullptr), _shared(false), _torque(nullptr),
+    _erforce(nullptr), _de(nullptr), _drho(nullptr), _mu(nullptr),
     _lambda(nullptr), _rhoB(nullptr), _D_values(nullptr), _rho(nullptr), _fp(nullptr),
     _rho1d(nullptr), _drho1d(nullptr), _rho1d_6(nullptr), _drho1d_6(nullptr), _tid(tid), _timer(t)
 {
@@ -69,7 +70,7 @@ double ThrData::get_time(enum Timer::ttype flag)
 /* ---------------------------------------------------------------------- */
 
 void ThrData::init_force(int nall, double **f, double **torque, double *erforce, double *de,
-                         double *drho)
+                         double *drho, bool fthr)
 {
   eng_vdwl = eng_coul = eng_bond = eng_angle = eng_dihed = eng_imprp = eng_kspce = 0.0;
   memset(virial_pair, 0, 6 * sizeof(double));
@@ -82,11 +83,17 @@ void ThrData::init_force(int nall, double **f, double **torque, double *erforce,
   eatom_pair = eatom_bond = eatom_angle = eatom_dihed = eatom_imprp = eatom_kspce = nullptr;
   vatom_pair = vatom_bond = vatom_angle = vatom_dihed = vatom_imprp = vatom_kspce = nullptr;
 
+  // the per-thread force copies need not be cleared, if all
+  // threaded styles write directly to the shared force array
+
   if (nall >= 0 && f) {
     _f = f + _tid * nall;
-    memset(&(_f[0][0]), 0, nall * 3 * sizeof(double));
+    if (fthr || (_tid == 0)) memset(&(_f[0][0]), 0, nall * 3 * sizeof(double));
+    _fshared = f;
   } else
-    _f = nullptr;
+    _f = _fshared = nullptr;
+  _fthr = _f;
+  _shared = false;
 
   if (nall >= 0 && torque) {
     _torque = torque + _tid * nall;
@@ -261,6 +268,23 @@ void ThrData::virial_fdotr_compute(double **x, int nlocal, int nghost, int nfirs
   }
 }
 
+/* ----------------------------------------------------------------------
+   compute this thread's part of the global pair virial from the
+   shared force array for atoms ifrom to ito-1
+------------------------------------------------------------------------- */
+
+void ThrData::virial_fdotr_compute_shared(double **x, int ifrom, int ito)
+{
+  for (int i = ifrom; i < ito; i++) {
+    virial_pair[0] += _fshared[i][0] * x[i][0];
+    virial_pair[1] += _fshared[i][1] * x[i][1];
+    virial_pair[2] += _fshared[i][2] * x[i][2];
+    virial_pair[3] += _fshared[i][1] * x[i][0];
+    virial_pair[4] += _fshared[i][2] * x[i][0];
+    virial_pair[5] += _fshared[i][2] * x[i][1];
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 double ThrData::memory_usage()
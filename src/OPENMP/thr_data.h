@@ -49,7 +49,15 @@ class ThrData {
   double get_time(enum Timer::ttype flag);
 
   // erase accumulator contents and hook up force arrays
-  void init_force(int, double **, double **, double *, double *, double *);
+  void init_force(int, double **, double **, double *, double *, double *, bool fthr = true);
+
+  // switch between per-thread force copy and shared force array
+  void set_shared_f(bool flag)
+  {
+    _f = flag ? _fshared : _fthr;
+    _shared = flag;
+  };
+  bool get_shared_f() const { return _shared; };
 
   // give access to per-thread offset arrays
   double **get_f() const { return _f; };
@@ -112,6 +120,9 @@ class ThrData {
 
   // these are maintained by atom styles
   double **_f;
+  double **_fthr;       // per-thread segment of the force array
+  double **_fshared;    // force array shared by all threads
+  bool _shared;         // true if _f points to the shared force array
   double **_torque;
   double *_erforce;
   double *_de;
@@ -141,6 +152,8 @@ class ThrData {
  public:
   // compute global per thread virial contribution from global forces and positions
   void virial_fdotr_compute(double **, int, int, int);
+  // same for a range of atoms in the shared force array
+  void virial_fdotr_compute_shared(double **, int, int);
 
   double memory_usage();
 
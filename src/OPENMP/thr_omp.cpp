@@ -24,6 +24,7 @@
 #include "comm.h"
 #include "compute.h"
 #include "dihedral.h"
+#include "domain.h"
 #include "error.h"
 #include "force.h"
 #include "improper.h"
@@ -32,6 +33,7 @@
 #include "neighbor.h"
 #include "pair.h"
 
+#include <cmath>
 #include <cstring>
 
 #if defined(_OPENMP)
@@ -43,7 +45,9 @@ using MathConst::THIRD;
 
 /* ---------------------------------------------------------------------- */
 
-ThrOMP::ThrOMP(LAMMPS *ptr, int style) : lmp(ptr), fix(nullptr), thr_style(style), thr_error(0)
+ThrOMP::ThrOMP(LAMMPS *ptr, int style) :
+    lmp(ptr), fix(nullptr), thr_style(style), thr_error(0), color_flag(false), color_ncolor(0),
+    color_nitems(-1), color_nthreads(0), color_stamp(-1)
 {
   // register fix omp with this class
   fix = static_cast<FixOMP *>(lmp->modify->get_fix_by_id("package_omp"));
@@ -53,6 +57,141 @@ ThrOMP::ThrOMP(LAMMPS *ptr, int style) : lmp(ptr), fix(nullptr), thr_style(style
 #endif
 }
 
+/* ----------------------------------------------------------------------
+   Sort work items (e.g. entries of ilist or rows of bondlist) into
+   spatial bins and color the bins so that no two items with the same
+   color in different bins can update the force of the same atom.
+   Items are located at their first atom. Bins are at least as large
+   as the cutoff and the largest distance between the first and the
+   other "natom" atoms of any item, so items in same-colored bins,
+   which are two bins apart, cannot share an atom. The bins of each
+   color are then split into contiguous chunks of similar item count,
+   one per thread. Only redone when "stamp" or the item count change.
+   Must be called from outside a threaded region.
+   ---------------------------------------------------------------------- */
+
+void ThrOMP::color_setup_thr(const int *items, int nitems, int stride, int natom, double cut,
+                             bigint stamp)
+{
+  const int nthreads = lmp->comm->nthreads;
+  if ((stamp == color_stamp) && (nitems == color_nitems) && (nthreads == color_nthreads)) return;
+
+  color_stamp = stamp;
+  color_nitems = nitems;
+  color_nthreads = nthreads;
+
+  const int dimension = lmp->domain->dimension;
+  double **x = lmp->atom->x;
+
+  color_ncolor = (dimension == 3) ? 27 : 9;
+  color_items.resize((size_t) nitems * stride);
+  color_offset.assign((size_t) color_ncolor * nthreads + 1, nitems);
+  if (nitems == 0) return;
+
+  // bounding box of items and bin size
+
+  double lo[3], hi[3];
+  double binsize = cut;
+  for (int d = 0; d < 3; ++d) {
+    lo[d] = x[items[0]][d];
+    hi[d] = x[items[0]][d];
+  }
+  for (int n = 0; n < nitems; ++n) {
+    const int *item = items + (bigint) n * stride;
+    const double *xi = x[item[0]];
+    for (int d = 0; d < 3; ++d) {
+      lo[d] = MIN(lo[d], xi[d]);
+      hi[d] = MAX(hi[d], xi[d]);
+    }
+    for (int m = 1; m < natom; ++m) {
+      const double *xm = x[item[m]];
+      const double delx = xm[0] - xi[0];
+      const double dely = xm[1] - xi[1];
+      const double delz = xm[2] - xi[2];
+      binsize = MAX(binsize, sqrt(delx * delx + dely * dely + delz * delz));
+    }
+  }
+
+  // pad the bins slightly so that distances equal to the cutoff are safe.
+  // larger bins are always safe, so limit the number of bins to the item count.
+
+  binsize = MAX(binsize * (1.0 + 1.0e-6), 1.0e-6);
+  int nbin[3];
+  bigint nbins;
+  while (true) {
+    nbins = 1;
+    for (int d = 0; d < 3; ++d) {
+      nbin[d] = (d < dimension) ? static_cast<int>((hi[d] - lo[d]) / binsize) + 1 : 1;
+      nbins *= nbin[d];
+    }
+    if (nbins <= MAX(nitems, color_ncolor)) break;
+    binsize *= 2.0;
+  }
+
+  // bin index of each item and number of items per bin
+
+  std::vector<int> itembin(nitems);
+  std::vector<int> binstart(nbins + 1, 0);
+  for (int n = 0; n < nitems; ++n) {
+    const double *xi = x[items[(bigint) n * stride]];
+    int ib[3];
+    for (int d = 0; d < 3; ++d)
+      ib[d] = MIN(static_cast<int>((xi[d] - lo[d]) / binsize), nbin[d] - 1);
+    itembin[n] = (ib[2] * nbin[1] + ib[1]) * nbin[0] + ib[0];
+    ++binstart[itembin[n] + 1];
+  }
+
+  // order bins by color, then by bin index, and assign bins to threads
+
+  std::vector<int> binorder;
+  binorder.reserve(nbins);
+  for (int icolor = 0; icolor < color_ncolor; ++icolor) {
+    const int cx = icolor % 3;
+    const int cy = (icolor / 3) % 3;
+    const int cz = icolor / 9;
+    for (int iz = cz; iz < nbin[2]; iz += 3)
+      for (int iy = cy; iy < nbin[1]; iy += 3)
+        for (int ix = cx; ix < nbin[0]; ix += 3)
+          binorder.push_back((iz * nbin[1] + iy) * nbin[0] + ix);
+  }
+
+  std::vector<int> bincount(binstart.begin() + 1, binstart.end());
+  int next = 0;
+  int ibin = 0;
+  for (int icolor = 0; icolor < color_ncolor; ++icolor) {
+    const int cx = icolor % 3;
+    const int cy = (icolor / 3) % 3;
+    const int cz = icolor / 9;
+    const bigint nbincolor = (bigint) ((nbin[0] - cx + 2) / 3) * ((nbin[1] - cy + 2) / 3) *
+        ((nbin[2] - cz + 2) / 3);
+    int nitemcolor = 0;
+    for (bigint k = 0; k < nbincolor; ++k) nitemcolor += bincount[binorder[ibin + k]];
+
+    const int first = next;
+    int tid = 0;
+    color_offset[(size_t) icolor * nthreads] = first;
+    for (bigint k = 0; k < nbincolor; ++k) {
+      const int jbin = binorder[ibin + k];
+      while ((tid < nthreads - 1) &&
+             ((bigint) (next - first) * nthreads >= (bigint) (tid + 1) * nitemcolor))
+        color_offset[(size_t) icolor * nthreads + (++tid)] = next;
+      binstart[jbin] = next;
+      next += bincount[jbin];
+    }
+    while (tid < nthreads - 1) color_offset[(size_t) icolor * nthreads + (++tid)] = next;
+    ibin += nbincolor;
+  }
+  color_offset[(size_t) color_ncolor * nthreads] = next;
+
+  // copy items into their place in the colored order
+
+  for (int n = 0; n < nitems; ++n) {
+    const int pos = binstart[itembin[n]]++;
+    for (int k = 0; k < stride; ++k)
+      color_items[(size_t) pos * stride + k] = items[(size_t) n * stride + k];
+  }
+}
+
 // clang-format off
 /* ----------------------------------------------------------------------
    Hook up per thread per atom arrays into the tally infrastructure
@@ -63,6 +202,7 @@ void ThrOMP::ev_setup_thr(int eflag, int vflag, int nall, double *eatom,
 {
   const int tid = thr->get_tid();
   if (tid == 0) thr_error = 0;
+  thr->set_shared_f(color_active_thr());
 
   if (thr_style & THR_PAIR) {
     if (eflag & ENERGY_ATOM) {
@@ -194,7 +334,20 @@ void ThrOMP::reduce_thr(void *style, const int eflag, const int vflag,
 
       // this is a non-hybrid pair style. compute per thread fdotr
       if (fix->last_pair_hybrid == nullptr) {
-        if (lmp->neighbor->includegroup == 0)
+        if (thr->get_shared_f()) {
+          // forces were written to the shared array. split the sum over threads.
+          // the threads are synchronized here, since vflag_fdotr implies evflag.
+          int ifrom, ito, itmp;
+          if (lmp->neighbor->includegroup == 0) {
+            loop_setup_thr(ifrom, ito, itmp, nall, nthreads);
+            thr->virial_fdotr_compute_shared(x, ifrom, ito);
+          } else {
+            loop_setup_thr(ifrom, ito, itmp, nfirst, nthreads);
+            thr->virial_fdotr_compute_shared(x, ifrom, ito);
+            loop_setup_thr(ifrom, ito, itmp, nghost, nthreads);
+            thr->virial_fdotr_compute_shared(x, nlocal + ifrom, nlocal + ito);
+          }
+        } else if (lmp->neighbor->includegroup == 0)
           thr->virial_fdotr_compute(x, nlocal, nghost, -1);
         else
           thr->virial_fdotr_compute(x, nlocal, nghost, nfirst);
@@ -444,13 +597,15 @@ void ThrOMP::reduce_thr(void *style, const int eflag, const int vflag,
 
   if (style == fix->last_omp_style) {
     if (need_force_reduce) {
-      data_reduce_thr(&(f[0][0]), nall, nthreads, 3, tid);
+      // nothing to reduce if all threaded styles wrote to the shared force array
+      if (!fix->get_color_all()) data_reduce_thr(&(f[0][0]), nall, nthreads, 3, tid);
       fix->did_reduce();
     }
 
     if (lmp->atom->torque)
       data_reduce_thr(&(lmp->atom->torque[0][0]), nall, nthreads, 3, tid);
   }
+  thr->set_shared_f(false);
   thr->timer(Timer::COMM);
 }
 
@@ -1622,6 +1777,8 @@ void ThrOMP::v_tally4_thr(Pair *const pair, const int i, const int j, const int
 double ThrOMP::memory_usage_thr()
 {
   double bytes=0.0;
+  bytes += (double)color_items.capacity() * sizeof(int);
+  bytes += (double)color_offset.capacity() * sizeof(int);
 
   return bytes;
 }
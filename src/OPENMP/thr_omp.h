@@ -26,6 +26,8 @@
 #include "pointers.h"
 #include "thr_data.h"    // IWYU pragma: export
 
+#include <vector>
+
 namespace LAMMPS_NS {
 
 // forward declarations
@@ -44,12 +46,23 @@ class ThrOMP {
   const int thr_style;
   int thr_error;
 
+  // spatial coloring of work items, so threads can write to the shared force array
+  bool color_flag;                  // true if the style supports coloring
+  int color_ncolor;                 // number of colors
+  int color_nitems;                 // number of colored items
+  int color_nthreads;               // number of threads the coloring was made for
+  bigint color_stamp;               // identifies the item list that was colored
+  std::vector<int> color_items;     // copy of the items ordered by color, bin, and thread
+  std::vector<int> color_offset;    // index of first item for each color and thread
+
  public:
   ThrOMP(LAMMPS *, int);
   virtual ~ThrOMP() noexcept(false) {}
 
   double memory_usage_thr();
 
+  bool get_color_flag() const { return color_flag; }
+
   inline void sync_threads()
   {
 #if defined(_OPENMP)
@@ -81,6 +94,15 @@ class ThrOMP {
   void virial_fdotr_compute_thr(double *const, const double *const *const,
                                 const double *const *const, const int, const int, const int);
 
+  // spatial coloring support
+  bool color_active_thr() const { return color_flag && fix->get_color(); }
+  void color_setup_thr(const int *, int, int, int, double, bigint);
+  void color_range_thr(int icolor, int tid, int &ifrom, int &ito) const
+  {
+    ifrom = color_offset[icolor * color_nthreads + tid];
+    ito = color_offset[icolor * color_nthreads + tid + 1];
+  }
+
   // reduce per thread data as needed
   void reduce_thr(void *const style, const int eflag, const int vflag, ThrData *const thr);
 
@@ -0,0 +1,258 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pair_lj_cut_cluster.h"
+
+#include "atom.h"
+#include "error.h"
+#include "force.h"
+#include "memory.h"
+#include "neigh_list.h"
+#include "neighbor.h"
+#include "update.h"
+
+using namespace LAMMPS_NS;
+
+static constexpr int CLUSTERSIZE = NeighList::CLUSTERSIZE;
+
+// coordinate of unused cluster slots, puts them outside of any cutoff
+
+static constexpr double FARAWAY = 1.0e100;
+
+/* ---------------------------------------------------------------------- */
+
+PairLJCutCluster::PairLJCutCluster(LAMMPS *lmp) : PairLJCut(lmp)
+{
+  respa_enable = 0;
+  overlap_enable = 0;
+  no_virial_fdotr_compute = 1;
+
+  maxcluster = 0;
+  xcluster = nullptr;
+  tcluster = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+PairLJCutCluster::~PairLJCutCluster()
+{
+  memory->destroy(xcluster);
+  memory->destroy(tcluster);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJCutCluster::compute(int eflag, int vflag)
+{
+  ev_init(eflag, vflag);
+
+  pack_clusters();
+
+  if (evflag) eval<1>();
+  else eval<0>();
+}
+
+/* ----------------------------------------------------------------------
+   copy coords and types of all owned and ghost atoms into cluster order
+   each cluster stores CLUSTERSIZE x, then y, then z values contiguously
+------------------------------------------------------------------------- */
+
+void PairLJCutCluster::pack_clusters()
+{
+  const int nclusterall = list->nclusterall;
+  const int *clusteratoms = list->clusteratoms;
+  double **x = atom->x;
+  int *type = atom->type;
+
+  if (nclusterall > maxcluster) {
+    maxcluster = list->maxcluster;
+    memory->destroy(xcluster);
+    memory->destroy(tcluster);
+    memory->create(xcluster, 3 * CLUSTERSIZE * maxcluster, "pair:xcluster");
+    memory->create(tcluster, CLUSTERSIZE * maxcluster, "pair:tcluster");
+  }
+
+  for (int c = 0; c < nclusterall; c++) {
+    const int *catoms = &clusteratoms[c * CLUSTERSIZE];
+    double *xc = &xcluster[3 * CLUSTERSIZE * c];
+    int *tc = &tcluster[CLUSTERSIZE * c];
+    for (int l = 0; l < CLUSTERSIZE; l++) {
+      const int j = catoms[l];
+      if (j >= 0) {
+        xc[l] = x[j][0];
+        xc[CLUSTERSIZE + l] = x[j][1];
+        xc[2 * CLUSTERSIZE + l] = x[j][2];
+        tc[l] = type[j];
+      } else {
+        xc[l] = xc[CLUSTERSIZE + l] = xc[2 * CLUSTERSIZE + l] = FARAWAY;
+        tc[l] = 1;
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   loop over I atoms of owned clusters and all J atoms of neighbor clusters
+   the innermost loop runs over the slots of one J cluster without
+     branches or indirect coordinate access, so it can be vectorized
+   list is full, so only I atoms get forces and energy/virial is halved
+------------------------------------------------------------------------- */
+
+template <int EVFLAG> void PairLJCutCluster::eval()
+{
+  double **f = atom->f;
+
+  const int inum = list->inum;
+  const int *ilist = list->ilist;
+  const int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+  const int *clusteratoms = list->clusteratoms;
+
+  for (int ii = 0; ii < inum; ii++) {
+    const int ic = ilist[ii];
+    const int *iatoms = &clusteratoms[ic * CLUSTERSIZE];
+    const double *xic = &xcluster[3 * CLUSTERSIZE * ic];
+    const int *jlist = firstneigh[ic];
+    const int jnum = numneigh[ic];
+
+    for (int li = 0; li < CLUSTERSIZE; li++) {
+      const int i = iatoms[li];
+      if (i < 0) break;
+
+      const double xtmp = xic[li];
+      const double ytmp = xic[CLUSTERSIZE + li];
+      const double ztmp = xic[2 * CLUSTERSIZE + li];
+      const int itype = tcluster[CLUSTERSIZE * ic + li];
+      const double *cutsqi = cutsq[itype];
+      const double *lj1i = lj1[itype];
+      const double *lj2i = lj2[itype];
+      const double *lj3i = lj3[itype];
+      const double *lj4i = lj4[itype];
+      const double *offseti = offset[itype];
+      double fxtmp = 0.0;
+      double fytmp = 0.0;
+      double fztmp = 0.0;
+      double evdwli = 0.0;
+      double v0 = 0.0, v1 = 0.0, v2 = 0.0, v3 = 0.0, v4 = 0.0, v5 = 0.0;
+
+      for (int jj = 0; jj < jnum; jj++) {
+        const int jc = jlist[jj];
+        const double *xjc = &xcluster[3 * CLUSTERSIZE * jc];
+        const int *tjc = &tcluster[CLUSTERSIZE * jc];
+        const int self = (jc == ic) ? li : -1;
+
+#if defined(_OPENMP)
+#pragma omp simd reduction(+ : fxtmp, fytmp, fztmp, evdwli, v0, v1, v2, v3, v4, v5)
+#endif
+        for (int lj = 0; lj < CLUSTERSIZE; lj++) {
+          const double delx = xtmp - xjc[lj];
+          const double dely = ytmp - xjc[CLUSTERSIZE + lj];
+          const double delz = ztmp - xjc[2 * CLUSTERSIZE + lj];
+          const double rsq = delx * delx + dely * dely + delz * delz;
+          const int jtype = tjc[lj];
+          const bool inside = (rsq < cutsqi[jtype]) && (lj != self);
+          const double r2inv = 1.0 / (inside ? rsq : 1.0);
+          const double r6inv = r2inv * r2inv * r2inv;
+          const double forcelj = r6inv * (lj1i[jtype] * r6inv - lj2i[jtype]);
+          const double fpair = inside ? forcelj * r2inv : 0.0;
+          fxtmp += delx * fpair;
+          fytmp += dely * fpair;
+          fztmp += delz * fpair;
+
+          // all contributions go to atom I, so sum them here and tally once
+
+          if (EVFLAG) {
+            if (inside) evdwli += r6inv * (lj3i[jtype] * r6inv - lj4i[jtype]) - offseti[jtype];
+            v0 += delx * delx * fpair;
+            v1 += dely * dely * fpair;
+            v2 += delz * delz * fpair;
+            v3 += delx * dely * fpair;
+            v4 += delx * delz * fpair;
+            v5 += dely * delz * fpair;
+          }
+        }
+      }
+
+      f[i][0] += fxtmp;
+      f[i][1] += fytmp;
+      f[i][2] += fztmp;
+
+      if (EVFLAG) tally_full(i, evdwli, v0, v1, v2, v3, v4, v5);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   tally energy and virial summed over all neighbors of atom I
+   same as ev_tally_full() for each pair, so only half is tallied
+------------------------------------------------------------------------- */
+
+void PairLJCutCluster::tally_full(int i, double evdwl, double v0, double v1, double v2,
+                                  double v3, double v4, double v5)
+{
+  if (eflag_global) eng_vdwl += 0.5 * evdwl;
+  if (eflag_atom) eatom[i] += 0.5 * evdwl;
+
+  if (vflag_global) {
+    virial[0] += 0.5 * v0;
+    virial[1] += 0.5 * v1;
+    virial[2] += 0.5 * v2;
+    virial[3] += 0.5 * v3;
+    virial[4] += 0.5 * v4;
+    virial[5] += 0.5 * v5;
+  }
+
+  if (vflag_atom) {
+    vatom[i][0] += 0.5 * v0;
+    vatom[i][1] += 0.5 * v1;
+    vatom[i][2] += 0.5 * v2;
+    vatom[i][3] += 0.5 * v3;
+    vatom[i][4] += 0.5 * v4;
+    vatom[i][5] += 0.5 * v5;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   init specific to this pair style
+------------------------------------------------------------------------- */
+
+void PairLJCutCluster::init_style()
+{
+  // cluster lists carry no special bond or exclusion info
+  // check exclusion settings directly, Neighbor::exclude is only set in Neighbor::init()
+
+  if (atom->molecular != Atom::ATOMIC) {
+    for (int m = 1; m < 4; m++)
+      if (force->special_lj[m] != 1.0)
+        error->all(FLERR, "Pair style lj/cut/cluster requires special_bonds lj 1.0 1.0 1.0");
+  }
+  if (neighbor->nex_type || neighbor->nex_group || neighbor->nex_mol)
+    error->all(FLERR, "Pair style lj/cut/cluster does not support neigh_modify exclude");
+  if (update->whichflag == 1 && utils::strmatch(update->integrate_style, "^respa"))
+    error->all(FLERR, "Pair style lj/cut/cluster does not support run style respa");
+  if (neighbor->style != Neighbor::BIN)
+    error->all(FLERR, "Pair style lj/cut/cluster requires neighbor style bin");
+
+  neighbor->add_request(this, NeighConst::REQ_FULL | NeighConst::REQ_CLUSTER);
+  cut_respa = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+double PairLJCutCluster::memory_usage()
+{
+  double bytes = Pair::memory_usage();
+  bytes += (double) 3 * CLUSTERSIZE * maxcluster * sizeof(double);
+  bytes += (double) CLUSTERSIZE * maxcluster * sizeof(int);
+  return bytes;
+}
@@ -84,7 +84,10 @@ FixACKS2ReaxFF::FixACKS2ReaxFF(LAMMPS *lmp, int narg, char **arg) :
   if (lmp->citeme) lmp->citeme->add(cite_fix_acks2_reax);
 
   if (dual_enabled)
-    error->all(FLERR, Error::NOLASTLINE, "Dual keyword only supported with fix qeq/reax/omp");
+    error->all(FLERR, Error::NOLASTLINE, "Dual keyword is not supported with fix {}", style);
+  if ((precond_style != PRECOND_JACOBI) || (extrap_style != EXTRAP_DEFAULT))
+    error->all(FLERR, Error::NOLASTLINE,
+               "Precond and extrap keywords are not supported with fix {}", style);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -74,7 +74,7 @@ FixQEqReaxFF::FixQEqReaxFF(LAMMPS *lmp, int narg, char **arg) :
   imax = 200;
   maxwarn = 1;
 
-  if ((narg < 8) || (narg > 12)) error->all(FLERR,"Illegal fix qeq/reaxff command");
+  if (narg < 8) error->all(FLERR,"Illegal fix qeq/reaxff command");
 
   nevery = utils::inumeric(FLERR,arg[3],false,lmp);
   if (nevery <= 0) error->all(FLERR,"Illegal fix qeq/reaxff command");
@@ -84,10 +84,11 @@ FixQEqReaxFF::FixQEqReaxFF(LAMMPS *lmp, int narg, char **arg) :
   tolerance = utils::numeric(FLERR,arg[6],false,lmp);
   pertype_option = utils::strdup(arg[7]);
 
-  // dual CG support only available for OPENMP variant
-  // check for compatibility is in Fix::post_constructor()
-
   dual_enabled = 0;
+  precond_style = PRECOND_JACOBI;
+  extrap_style = EXTRAP_DEFAULT;
+  extrap_order = 3;
+  aspc_omega = 1.0;
 
   int iarg = 8;
   while (iarg < narg) {
@@ -98,6 +99,23 @@ FixQEqReaxFF::FixQEqReaxFF(LAMMPS *lmp, int narg, char **arg) :
         error->all(FLERR,"Illegal fix {} command", style);
       imax = utils::numeric(FLERR,arg[iarg+1],false,lmp);
       iarg++;
+    } else if (strcmp(arg[iarg],"precond") == 0) {
+      if (iarg+1 > narg-1)
+        error->all(FLERR,"Illegal fix {} command", style);
+      if (strcmp(arg[iarg+1],"jacobi") == 0) precond_style = PRECOND_JACOBI;
+      else if (strcmp(arg[iarg+1],"bjacobi") == 0) precond_style = PRECOND_BJACOBI;
+      else error->all(FLERR,"Unknown fix {} preconditioner {}", style, arg[iarg+1]);
+      iarg++;
+    } else if (strcmp(arg[iarg],"extrap") == 0) {
+      if (iarg+2 > narg-1)
+        error->all(FLERR,"Illegal fix {} command", style);
+      if (strcmp(arg[iarg+1],"poly") == 0) extrap_style = EXTRAP_POLY;
+      else if (strcmp(arg[iarg+1],"aspc") == 0) extrap_style = EXTRAP_ASPC;
+      else error->all(FLERR,"Unknown fix {} extrapolation {}", style, arg[iarg+1]);
+      extrap_order = utils::inumeric(FLERR,arg[iarg+2],false,lmp);
+      if ((extrap_order < 0) || (extrap_order > 8))
+        error->all(FLERR,"Fix {} extrapolation order must be between 0 and 8", style);
+      iarg += 2;
     } else error->all(FLERR,"Illegal fix {} command", style);
     iarg++;
   }
@@ -109,7 +127,14 @@ FixQEqReaxFF::FixQEqReaxFF(LAMMPS *lmp, int narg, char **arg) :
   pack_flag = 0;
   s = nullptr;
   t = nullptr;
+
+  // number of previous solutions kept for extrapolation
+
   nprev = 4;
+  if (extrap_style == EXTRAP_POLY) nprev = MAX(nprev, extrap_order+1);
+  if (extrap_style == EXTRAP_ASPC) nprev = MAX(nprev, extrap_order+2);
+  s_extrap = t_extrap = nullptr;
+  init_extrapolation();
 
   Hdia_inv = nullptr;
   b_s = nullptr;
@@ -125,6 +150,12 @@ FixQEqReaxFF::FixQEqReaxFF(LAMMPS *lmp, int narg, char **arg) :
   r = nullptr;
   d = nullptr;
 
+  // block Jacobi preconditioner
+
+  bj_nmax = bj_nrow = bj_ncap = 0;
+  bj_rank = bj_first = bj_jlist = nullptr;
+  bj_val = nullptr;
+
   // H matrix
 
   H.firstnbr = nullptr;
@@ -161,6 +192,13 @@ FixQEqReaxFF::~FixQEqReaxFF()
 
   memory->destroy(s_hist);
   memory->destroy(t_hist);
+  memory->destroy(s_extrap);
+  memory->destroy(t_extrap);
+
+  memory->destroy(bj_rank);
+  memory->destroy(bj_first);
+  memory->destroy(bj_jlist);
+  memory->destroy(bj_val);
 
   FixQEqReaxFF::deallocate_storage();
   FixQEqReaxFF::deallocate_matrix();
@@ -186,8 +224,6 @@ void FixQEqReaxFF::post_constructor()
       s_hist[i][j] = t_hist[i][j] = 0;
 
   pertype_parameters(pertype_option);
-  if (dual_enabled)
-    error->all(FLERR,"Dual keyword only supported with fix qeq/reaxff/omp");
 }
 
 /* ---------------------------------------------------------------------- */
@@ -608,9 +644,13 @@ void FixQEqReaxFF::pre_force(int /*vflag*/)
 
   init_matvec();
 
-  matvecs_s = CG(b_s, s);       // CG on s - parallel
-  matvecs_t = CG(b_t, t);       // CG on t - parallel
-  matvecs = matvecs_s + matvecs_t;
+  if (dual_enabled) {
+    matvecs = dual_CG(b_s, b_t, s, t);
+  } else {
+    matvecs_s = CG(b_s, s);       // CG on s - parallel
+    matvecs_t = CG(b_t, t);       // CG on t - parallel
+    matvecs = matvecs_s + matvecs_t;
+  }
 
   calculate_Q();
 }
@@ -635,8 +675,9 @@ void FixQEqReaxFF::init_matvec()
 {
   /* fill-in H matrix */
   compute_H();
+  if (precond_style == PRECOND_BJACOBI) init_bjacobi();
 
-  int ii, i;
+  int ii, i, k;
 
   for (ii = 0; ii < nn; ++ii) {
     i = ilist[ii];
@@ -648,11 +689,12 @@ void FixQEqReaxFF::init_matvec()
       if (efield) b_s[i] -= chi_field[i];
       b_t[i]      = -1.0;
 
-      /* quadratic extrapolation for s & t from previous solutions */
-      t[i] = t_hist[i][2] + 3 * (t_hist[i][0] - t_hist[i][1]);
-
-      /* cubic extrapolation for s & t from previous solutions */
-      s[i] = 4*(s_hist[i][0]+s_hist[i][2])-(6*s_hist[i][1]+s_hist[i][3]);
+      /* extrapolation for s & t from previous solutions */
+      s[i] = t[i] = 0.0;
+      for (k = 0; k < nprev; ++k) {
+        s[i] += s_extrap[k] * s_hist[i][k];
+        t[i] += t_extrap[k] * t_hist[i][k];
+      }
     }
   }
 
@@ -662,6 +704,52 @@ void FixQEqReaxFF::init_matvec()
   comm->forward_comm(this); //Dist_vector(t);
 }
 
+/* ----------------------------------------------------------------------
+   coefficients for extrapolating the initial guess of s & t
+   from the previous solutions, most recent first.
+   default: cubic polynomial for s and quadratic polynomial for t.
+   poly: polynomial through the last order+1 solutions.
+   aspc: predictor of the always stable predictor-corrector scheme of
+         Kolafa, J. Comp. Chem., 25(3), 335 (2004). the converged solution
+         takes the place of the corrector, see store_history()
+------------------------------------------------------------------------- */
+
+void FixQEqReaxFF::init_extrapolation()
+{
+  memory->destroy(s_extrap);
+  memory->destroy(t_extrap);
+  memory->create(s_extrap,nprev,"qeq:s_extrap");
+  memory->create(t_extrap,nprev,"qeq:t_extrap");
+  for (int k = 0; k < nprev; ++k) s_extrap[k] = t_extrap[k] = 0.0;
+
+  auto poly = [](double *c, int order) {
+    // c_k = (-1)^k binomial(order+1, k+1)
+    double binom = order + 1;
+    for (int k = 0; k <= order; ++k) {
+      c[k] = (k % 2) ? -binom : binom;
+      binom *= (double) (order - k) / (double) (k + 2);
+    }
+  };
+
+  if (extrap_style == EXTRAP_DEFAULT) {
+    poly(s_extrap, 3);
+    poly(t_extrap, 2);
+  } else if (extrap_style == EXTRAP_POLY) {
+    poly(s_extrap, extrap_order);
+    poly(t_extrap, extrap_order);
+  } else if (extrap_style == EXTRAP_ASPC) {
+    const auto o = (double) extrap_order;
+    double c = (4.0 * o + 6.0) / (o + 3.0);
+    s_extrap[0] = c;
+    for (int k = 1; k < extrap_order + 2; ++k) {
+      c *= (o + 2.0 - k) / (o + 3.0 + k);
+      s_extrap[k] = ((k % 2) ? -1.0 : 1.0) * (k + 1) * c;
+    }
+    for (int k = 0; k < nprev; ++k) t_extrap[k] = s_extrap[k];
+    aspc_omega = (o + 2.0) / (2.0 * o + 3.0);
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixQEqReaxFF::compute_H()
@@ -748,23 +836,17 @@ double FixQEqReaxFF::calculate_H(double r, double gamma)
 
 int FixQEqReaxFF::CG(double *b, double *x)
 {
-  int  i, j;
+  int  i;
   double tmp, alpha, beta, b_norm;
   double sig_old, sig_new;
 
-  int jj;
-
   pack_flag = 1;
   sparse_matvec(&H, x, q);
   comm->reverse_comm(this); //Coll_Vector(q);
 
   vector_sum(r , 1.,  b, -1., q, nn);
 
-  for (jj = 0; jj < nn; ++jj) {
-    j = ilist[jj];
-    if (atom->mask[j] & groupbit)
-      d[j] = r[j] * Hdia_inv[j]; //pre-condition
-  }
+  precondition(r, d, 1);
 
   b_norm = parallel_norm(b, nn);
   sig_new = parallel_dot(r, d, nn);
@@ -780,12 +862,7 @@ int FixQEqReaxFF::CG(double *b, double *x)
     vector_add(x, alpha, d, nn);
     vector_add(r, -alpha, q, nn);
 
-    // pre-conditioning
-    for (jj = 0; jj < nn; ++jj) {
-      j = ilist[jj];
-      if (atom->mask[j] & groupbit)
-        p[j] = r[j] * Hdia_inv[j];
-    }
+    precondition(r, p, 1);
 
     sig_old = sig_new;
     sig_new = parallel_dot(r, p, nn);
@@ -831,11 +908,346 @@ void FixQEqReaxFF::sparse_matvec(sparse_matrix *A, double *x, double *b)
 
 }
 
+/* ---------------------------------------------------------------------- */
+/* dual CG support                                                        */
+/* ---------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   solve for s & t at the same time with interleaved vectors, so that
+   each iteration needs only one matvec, one forward and one reverse
+   communication, and two MPI_Allreduce() calls for both systems
+------------------------------------------------------------------------- */
+
+int FixQEqReaxFF::dual_CG(double *b1, double *b2, double *x1, double *x2)
+{
+  int i, ii, jj, indxI;
+  double alpha_s, alpha_t, beta_s, beta_t, b_norm_s, b_norm_t;
+  double sig_old_s, sig_old_t, sig_new_s, sig_new_t;
+  double my_buf[4], buf[4];
+  const int *mask = atom->mask;
+
+  pack_flag = 5; // forward 2x d and reverse 2x q
+  dual_sparse_matvec(&H, x1, x2, q);
+  comm->reverse_comm(this); //Coll_Vector(q);
+
+  for (jj = 0; jj < nn; ++jj) {
+    ii = ilist[jj];
+    if (mask[ii] & groupbit) {
+      indxI = 2 * ii;
+      r[indxI] = b1[ii] - q[indxI];
+      r[indxI+1] = b2[ii] - q[indxI+1];
+    }
+  }
+
+  precondition(r, d, 2);
+
+  my_buf[0] = my_buf[1] = my_buf[2] = my_buf[3] = 0.0;
+  for (jj = 0; jj < nn; ++jj) {
+    ii = ilist[jj];
+    if (mask[ii] & groupbit) {
+      indxI = 2 * ii;
+      my_buf[0] += b1[ii] * b1[ii];
+      my_buf[1] += b2[ii] * b2[ii];
+      my_buf[2] += r[indxI] * d[indxI];
+      my_buf[3] += r[indxI+1] * d[indxI+1];
+    }
+  }
+
+  MPI_Allreduce(my_buf, buf, 4, MPI_DOUBLE, MPI_SUM, world);
+
+  b_norm_s = sqrt(buf[0]);
+  b_norm_t = sqrt(buf[1]);
+  sig_new_s = buf[2];
+  sig_new_t = buf[3];
+
+  for (i = 1; i < imax; ++i) {
+    if ((sqrt(sig_new_s)/b_norm_s <= tolerance) || (sqrt(sig_new_t)/b_norm_t <= tolerance)) break;
+
+    comm->forward_comm(this); //Dist_vector(d);
+    dual_sparse_matvec(&H, d, q);
+    comm->reverse_comm(this); //Coll_vector(q);
+
+    my_buf[0] = my_buf[1] = 0.0;
+    for (jj = 0; jj < nn; ++jj) {
+      ii = ilist[jj];
+      if (mask[ii] & groupbit) {
+        indxI = 2 * ii;
+        my_buf[0] += d[indxI] * q[indxI];
+        my_buf[1] += d[indxI+1] * q[indxI+1];
+      }
+    }
+    MPI_Allreduce(my_buf, buf, 2, MPI_DOUBLE, MPI_SUM, world);
+
+    alpha_s = sig_new_s / buf[0];
+    alpha_t = sig_new_t / buf[1];
+
+    for (jj = 0; jj < nn; ++jj) {
+      ii = ilist[jj];
+      if (mask[ii] & groupbit) {
+        indxI = 2 * ii;
+        x1[ii] += alpha_s * d[indxI];
+        x2[ii] += alpha_t * d[indxI+1];
+        r[indxI] -= alpha_s * q[indxI];
+        r[indxI+1] -= alpha_t * q[indxI+1];
+      }
+    }
+
+    precondition(r, p, 2);
+
+    my_buf[0] = my_buf[1] = 0.0;
+    for (jj = 0; jj < nn; ++jj) {
+      ii = ilist[jj];
+      if (mask[ii] & groupbit) {
+        indxI = 2 * ii;
+        my_buf[0] += r[indxI] * p[indxI];
+        my_buf[1] += r[indxI+1] * p[indxI+1];
+      }
+    }
+    MPI_Allreduce(my_buf, buf, 2, MPI_DOUBLE, MPI_SUM, world);
+
+    sig_old_s = sig_new_s;
+    sig_old_t = sig_new_t;
+    sig_new_s = buf[0];
+    sig_new_t = buf[1];
+
+    beta_s = sig_new_s / sig_old_s;
+    beta_t = sig_new_t / sig_old_t;
+
+    for (jj = 0; jj < nn; ++jj) {
+      ii = ilist[jj];
+      if (mask[ii] & groupbit) {
+        indxI = 2 * ii;
+        d[indxI] = p[indxI] + beta_s * d[indxI];
+        d[indxI+1] = p[indxI+1] + beta_t * d[indxI+1];
+      }
+    }
+  }
+
+  matvecs_s = matvecs_t = i;
+
+  // if only one system has converged, finish the other one with regular CG
+
+  if ((matvecs_s < imax) && (sqrt(sig_new_s)/b_norm_s > tolerance)) {
+    pack_flag = 2;
+    comm->forward_comm(this); // x1 => s
+    int saved_imax = imax;
+    imax -= matvecs_s;
+    matvecs_s += CG(b1, x1);
+    imax = saved_imax;
+  } else if ((matvecs_t < imax) && (sqrt(sig_new_t)/b_norm_t > tolerance)) {
+    pack_flag = 3;
+    comm->forward_comm(this); // x2 => t
+    int saved_imax = imax;
+    imax -= matvecs_t;
+    matvecs_t += CG(b2, x2);
+    imax = saved_imax;
+  }
+
+  if ((i >= imax) && maxwarn && (comm->me == 0))
+    error->warning(FLERR, "Fix qeq/reaxff CG convergence failed after {} iterations at step {}",
+                   i,update->ntimestep);
+  return matvecs_s + matvecs_t;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixQEqReaxFF::dual_sparse_matvec(sparse_matrix *A, double *x1, double *x2, double *b)
+{
+  int i, j, ii, itr_j, indxI, indxJ;
+  const int nlocal = atom->nlocal;
+  const int nall = atom->nlocal + atom->nghost;
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      indxI = 2 * i;
+      b[indxI] = eta[atom->type[i]] * x1[i];
+      b[indxI+1] = eta[atom->type[i]] * x2[i];
+    }
+  }
+
+  for (i = 2*nlocal; i < 2*nall; ++i) b[i] = 0.0;
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      indxI = 2 * i;
+      for (itr_j=A->firstnbr[i]; itr_j<A->firstnbr[i]+A->numnbrs[i]; itr_j++) {
+        j = A->jlist[itr_j];
+        indxJ = 2 * j;
+        b[indxI] += A->val[itr_j] * x1[j];
+        b[indxI+1] += A->val[itr_j] * x2[j];
+        b[indxJ] += A->val[itr_j] * x1[i];
+        b[indxJ+1] += A->val[itr_j] * x2[i];
+      }
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixQEqReaxFF::dual_sparse_matvec(sparse_matrix *A, double *x, double *b)
+{
+  int i, j, ii, itr_j, indxI, indxJ;
+  const int nlocal = atom->nlocal;
+  const int nall = atom->nlocal + atom->nghost;
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      indxI = 2 * i;
+      b[indxI] = eta[atom->type[i]] * x[indxI];
+      b[indxI+1] = eta[atom->type[i]] * x[indxI+1];
+    }
+  }
+
+  for (i = 2*nlocal; i < 2*nall; ++i) b[i] = 0.0;
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      indxI = 2 * i;
+      for (itr_j=A->firstnbr[i]; itr_j<A->firstnbr[i]+A->numnbrs[i]; itr_j++) {
+        j = A->jlist[itr_j];
+        indxJ = 2 * j;
+        b[indxI] += A->val[itr_j] * x[indxJ];
+        b[indxI+1] += A->val[itr_j] * x[indxJ+1];
+        b[indxJ] += A->val[itr_j] * x[indxI];
+        b[indxJ+1] += A->val[itr_j] * x[indxI+1];
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   extract the couplings between local atoms of the group from H
+   for the block Jacobi preconditioner. each pair is stored in the
+   row of the atom that comes first in ilist.
+------------------------------------------------------------------------- */
+
+void FixQEqReaxFF::init_bjacobi()
+{
+  int i, j, ii, jj, k, itr_j;
+  const int nlocal = atom->nlocal;
+  const int *mask = atom->mask;
+
+  if (atom->nmax > bj_nmax) {
+    bj_nmax = atom->nmax;
+    memory->destroy(bj_rank);
+    memory->destroy(bj_first);
+    memory->create(bj_rank,bj_nmax,"qeq:bj_rank");
+    memory->create(bj_first,bj_nmax+1,"qeq:bj_first");
+  }
+
+  // position of local group atoms in ilist, -1 for all others
+
+  for (i = 0; i < nlocal; ++i) bj_rank[i] = -1;
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (mask[i] & groupbit) bj_rank[i] = ii;
+  }
+
+  bj_nrow = nn;
+  for (ii = 0; ii <= nn; ++ii) bj_first[ii] = 0;
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (mask[i] & groupbit) {
+      for (itr_j = H.firstnbr[i]; itr_j < H.firstnbr[i]+H.numnbrs[i]; itr_j++) {
+        j = H.jlist[itr_j];
+        if ((j < nlocal) && (bj_rank[j] >= 0)) ++bj_first[MIN(ii,bj_rank[j])+1];
+      }
+    }
+  }
+  for (ii = 0; ii < nn; ++ii) bj_first[ii+1] += bj_first[ii];
+
+  if (bj_first[nn] > bj_ncap) {
+    bj_ncap = bj_first[nn];
+    memory->destroy(bj_jlist);
+    memory->destroy(bj_val);
+    memory->create(bj_jlist,bj_ncap,"qeq:bj_jlist");
+    memory->create(bj_val,bj_ncap,"qeq:bj_val");
+  }
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (mask[i] & groupbit) {
+      for (itr_j = H.firstnbr[i]; itr_j < H.firstnbr[i]+H.numnbrs[i]; itr_j++) {
+        j = H.jlist[itr_j];
+        if ((j < nlocal) && (bj_rank[j] >= 0)) {
+          jj = bj_rank[j];
+          if (jj > ii) {
+            k = bj_first[ii]++;
+            bj_jlist[k] = j;
+          } else {
+            k = bj_first[jj]++;
+            bj_jlist[k] = i;
+          }
+          bj_val[k] = H.val[itr_j];
+        }
+      }
+    }
+  }
+
+  // the fill advanced each row start to the start of the next row
+
+  for (ii = nn; ii > 0; --ii) bj_first[ii] = bj_first[ii-1];
+  bj_first[0] = 0;
+}
+
+/* ----------------------------------------------------------------------
+   apply the preconditioner z = M^-1 r to "stride" interleaved vectors
+   jacobi:  M = D, the diagonal of H
+   bjacobi: M = (D+L) D^-1 (D+U) with L+U the couplings between the
+            local atoms, i.e. one symmetric Gauss-Seidel sweep on the
+            local block of H. M is symmetric positive definite, and
+            applying it needs no communication.
+------------------------------------------------------------------------- */
+
+void FixQEqReaxFF::precondition(double *r, double *z, int stride)
+{
+  int i, j, ii, k, c;
+  const int *mask = atom->mask;
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (mask[i] & groupbit)
+      for (c = 0; c < stride; ++c) z[stride*i+c] = r[stride*i+c] * Hdia_inv[i];
+  }
+
+  if (precond_style == PRECOND_JACOBI) return;
+
+  // forward sweep: solve (D+L) y = r and scale with D to get D y
+
+  for (ii = 0; ii < bj_nrow; ++ii) {
+    i = ilist[ii];
+    if (mask[i] & groupbit) {
+      for (k = bj_first[ii]; k < bj_first[ii+1]; ++k) {
+        j = bj_jlist[k];
+        for (c = 0; c < stride; ++c)
+          z[stride*j+c] -= bj_val[k] * z[stride*i+c] * Hdia_inv[j];
+      }
+    }
+  }
+
+  // backward sweep: solve (D+U) z = D y
+
+  for (ii = bj_nrow-1; ii >= 0; --ii) {
+    i = ilist[ii];
+    if (mask[i] & groupbit) {
+      for (k = bj_first[ii]; k < bj_first[ii+1]; ++k) {
+        j = bj_jlist[k];
+        for (c = 0; c < stride; ++c)
+          z[stride*i+c] -= bj_val[k] * z[stride*j+c] * Hdia_inv[i];
+      }
+    }
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixQEqReaxFF::calculate_Q()
 {
-  int i, k;
+  int i;
   double u, s_sum, t_sum;
   double *q = atom->q;
 
@@ -851,12 +1263,7 @@ void FixQEqReaxFF::calculate_Q()
       q[i] = s[i] - u * t[i];
 
       /* backup s & t */
-      for (k = nprev-1; k > 0; --k) {
-        s_hist[i][k] = s_hist[i][k-1];
-        t_hist[i][k] = t_hist[i][k-1];
-      }
-      s_hist[i][0] = s[i];
-      t_hist[i][0] = t[i];
+      store_history(i);
     }
   }
 
@@ -864,6 +1271,35 @@ void FixQEqReaxFF::calculate_Q()
   comm->forward_comm(this); //Dist_vector(atom->q);
 }
 
+/* ----------------------------------------------------------------------
+   push the solution for s & t of atom i onto its history
+   with aspc the history holds the corrected values
+   omega * solution + (1 - omega) * predictor instead of the solution
+------------------------------------------------------------------------- */
+
+void FixQEqReaxFF::store_history(int i)
+{
+  double snew = s[i];
+  double tnew = t[i];
+
+  if (extrap_style == EXTRAP_ASPC) {
+    double sp = 0.0, tp = 0.0;
+    for (int k = 0; k < nprev; ++k) {
+      sp += s_extrap[k] * s_hist[i][k];
+      tp += t_extrap[k] * t_hist[i][k];
+    }
+    snew = aspc_omega * snew + (1.0 - aspc_omega) * sp;
+    tnew = aspc_omega * tnew + (1.0 - aspc_omega) * tp;
+  }
+
+  for (int k = nprev-1; k > 0; --k) {
+    s_hist[i][k] = s_hist[i][k-1];
+    t_hist[i][k] = t_hist[i][k-1];
+  }
+  s_hist[i][0] = snew;
+  t_hist[i][0] = tnew;
+}
+
 /* ---------------------------------------------------------------------- */
 
 int FixQEqReaxFF::pack_forward_comm(int n, int *list, double *buf,
@@ -969,6 +1405,9 @@ double FixQEqReaxFF::memory_usage()
   if (dual_enabled)
     bytes += (double)atom->nmax*4 * sizeof(double); // double size for q, d, r, and p
 
+  bytes += (double)bj_nmax*2 * sizeof(int); // block Jacobi preconditioner
+  bytes += (double)bj_ncap * (sizeof(int) + sizeof(double));
+
   return bytes;
 }
 
@@ -56,6 +56,9 @@ class FixQEqReaxFF : public Fix {
 
   double compute_scalar() override;
 
+  enum { PRECOND_JACOBI, PRECOND_BJACOBI };
+  enum { EXTRAP_DEFAULT, EXTRAP_POLY, EXTRAP_ASPC };
+
  protected:
   int nevery, reaxflag;
   int matvecs;
@@ -81,6 +84,12 @@ class FixQEqReaxFF : public Fix {
   double **s_hist, **t_hist;
   int nprev;
 
+  // extrapolation of the initial guess from previous solutions
+
+  int extrap_style, extrap_order;
+  double *s_extrap, *t_extrap;    // coefficients for s_hist and t_hist
+  double aspc_omega;              // weight of the solution in the aspc corrector
+
   typedef struct {
     int n, m;
     int *firstnbr;
@@ -99,6 +108,14 @@ class FixQEqReaxFF : public Fix {
   double *p, *q, *r, *d;
   int imax, maxwarn;
 
+  // block Jacobi preconditioner with one symmetric Gauss-Seidel sweep
+  // on the H matrix block of the local atoms, stored as upper triangle
+
+  int precond_style;
+  int bj_nmax, bj_nrow, bj_ncap;
+  int *bj_rank, *bj_first, *bj_jlist;
+  double *bj_val;
+
   char *pertype_option;    // argument to determine how per-type info is obtained
   virtual void pertype_parameters(char *);
   void init_shielding();
@@ -115,10 +132,15 @@ class FixQEqReaxFF : public Fix {
   virtual void compute_H();
   double calculate_H(double, double);
   virtual void calculate_Q();
+  void store_history(int);
 
   virtual int CG(double *, double *);
   virtual void sparse_matvec(sparse_matrix *, double *, double *);
 
+  void init_extrapolation();
+  void init_bjacobi();
+  void precondition(double *, double *, int);
+
   int pack_forward_comm(int, int *, double *, int, int *) override;
   void unpack_forward_comm(int, int, double *) override;
   int pack_reverse_comm(int, int, double *) override;
@@ -141,6 +163,10 @@ class FixQEqReaxFF : public Fix {
   // dual CG support
   int dual_enabled;            // 0: Original, separate s & t optimization; 1: dual optimization
   int matvecs_s, matvecs_t;    // Iteration count for each system
+
+  virtual int dual_CG(double *, double *, double *, double *);
+  virtual void dual_sparse_matvec(sparse_matrix *, double *, double *, double *);
+  virtual void dual_sparse_matvec(sparse_matrix *, double *, double *);
 };
 
 }    // namespace LAMMPS_NS
@@ -32,6 +32,7 @@ ComputePressureGrem::ComputePressureGrem(LAMMPS *lmp, int narg, char **arg) :
   ComputePressure(lmp, narg-1, arg)
 {
   fix_grem = utils::strdup(arg[narg-1]);
+  npartial_scalar = npartial_vector = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -0,0 +1,821 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "fix_lincs.h"
+
+#include "atom.h"
+#include "bond.h"
+#include "comm.h"
+#include "domain.h"
+#include "error.h"
+#include "force.h"
+#include "group.h"
+#include "memory.h"
+#include "update.h"
+
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#include "omp_compat.h"
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+enum { BONDINFO, XLINCS, WLINCS };
+
+static constexpr int DELTA = 1024;
+
+/* ---------------------------------------------------------------------- */
+
+FixLincs::FixLincs(LAMMPS *lmp, int narg, char **arg) :
+    Fix(lmp, narg, arg), bond_flag(nullptr), bond_distance(nullptr), npartner(nullptr),
+    partner_tag(nullptr), partner_type(nullptr), xlincs(nullptr), wlincs(nullptr),
+    cons_atom(nullptr), cons_type(nullptr), cons_dir(nullptr), cons_invm(nullptr),
+    cons_len(nullptr), cons_scale(nullptr), cons_rhs(nullptr), cons_tmp(nullptr),
+    cons_sol(nullptr), cons_solsum(nullptr), inc_first(nullptr), inc_list(nullptr)
+{
+  energy_global_flag = energy_peratom_flag = 1;
+  virial_global_flag = virial_peratom_flag = 1;
+  thermo_energy = thermo_virial = 1;
+  dof_flag = 1;
+  scalar_flag = 1;
+  extscalar = 1;
+
+  eflag_pre_reverse = 0;
+  ebond = 0.0;
+
+  if (atom->molecular != Atom::MOLECULAR)
+    error->all(FLERR, "Fix lincs requires a molecular system without molecule templates");
+  if (narg < 7) utils::missing_cmd_args(FLERR, "fix lincs", error);
+
+  order = utils::inumeric(FLERR, arg[3], false, lmp);
+  niter = utils::inumeric(FLERR, arg[4], false, lmp);
+  if (order < 1) error->all(FLERR, "Illegal fix lincs order value {}", order);
+  if (niter < 0) error->all(FLERR, "Illegal fix lincs niter value {}", niter);
+
+  // parse constrained bond types
+
+  if (strcmp(arg[5], "b") != 0) error->all(FLERR, "Unknown fix lincs command option: {}", arg[5]);
+
+  bond_flag = new int[atom->nbondtypes + 1];
+  for (int i = 0; i <= atom->nbondtypes; i++) bond_flag[i] = 0;
+  bond_distance = new double[atom->nbondtypes + 1];
+
+  int iarg = 6;
+  int nbtypes = 0;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg], "kbond") == 0) break;
+    int nlo, nhi;
+    utils::bounds_typelabel(FLERR, arg[iarg], 1, atom->nbondtypes, nlo, nhi, lmp, Atom::BOND);
+    for (int i = nlo; i <= nhi; i++) bond_flag[i] = 1;
+    nbtypes++;
+    iarg++;
+  }
+  if (nbtypes == 0) error->all(FLERR, "Fix lincs requires at least one bond type");
+
+  kbond = 1.0e6 * force->boltz;
+
+  while (iarg < narg) {
+    if (strcmp(arg[iarg], "kbond") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "fix lincs kbond", error);
+      kbond = utils::numeric(FLERR, arg[iarg + 1], false, lmp);
+      if (kbond < 0) error->all(FLERR, "Illegal fix lincs kbond value {}. Must be >= 0.0", kbond);
+      iarg += 2;
+    } else
+      error->all(FLERR, "Unknown fix lincs command option: {}", arg[iarg]);
+  }
+
+  // set bond types of constrained bonds negative so they are ignored
+  //   by the bond style, only for bonds stored with atoms in the group
+  // bonds of these types that are already negative belong to another constraint fix
+
+  int *mask = atom->mask;
+  int *num_bond = atom->num_bond;
+  int **bond_type = atom->bond_type;
+  int nlocal = atom->nlocal;
+
+  int flag = 0;
+  for (int i = 0; i < nlocal; i++) {
+    if (!(mask[i] & groupbit)) continue;
+    for (int m = 0; m < num_bond[i]; m++) {
+      if ((bond_type[i][m] > 0) && bond_flag[bond_type[i][m]])
+        bond_type[i][m] = -bond_type[i][m];
+      else if ((bond_type[i][m] < 0) && bond_flag[-bond_type[i][m]])
+        flag = 1;
+    }
+  }
+
+  int flagall;
+  MPI_Allreduce(&flag, &flagall, 1, MPI_INT, MPI_MAX, world);
+  if (flagall) error->all(FLERR, "Fix lincs bond types are already constrained by another fix");
+
+  comm_forward = MAX(3, 1 + 2 * atom->bond_per_atom);
+
+  nmax = 0;
+  ncons = maxcons = 0;
+  maxlocal = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixLincs::~FixLincs()
+{
+  // set bond types of constrained bonds back to positive
+
+  int *num_bond = atom->num_bond;
+  int **bond_type = atom->bond_type;
+  int nlocal = atom->nlocal;
+
+  if (bond_flag && bond_type)
+    for (int i = 0; i < nlocal; i++)
+      for (int m = 0; m < num_bond[i]; m++)
+        if ((bond_type[i][m] < 0) && bond_flag[-bond_type[i][m]])
+          bond_type[i][m] = -bond_type[i][m];
+
+  delete[] bond_flag;
+  delete[] bond_distance;
+
+  memory->destroy(npartner);
+  memory->destroy(partner_tag);
+  memory->destroy(partner_type);
+  memory->destroy(xlincs);
+  memory->destroy(wlincs);
+
+  memory->destroy(cons_atom);
+  memory->destroy(cons_type);
+  memory->destroy(cons_dir);
+  memory->destroy(cons_invm);
+  memory->destroy(cons_len);
+  memory->destroy(cons_scale);
+  memory->destroy(cons_rhs);
+  memory->destroy(cons_tmp);
+  memory->destroy(cons_sol);
+  memory->destroy(cons_solsum);
+
+  memory->destroy(inc_first);
+  memory->destroy(inc_list);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixLincs::setmask()
+{
+  int mask = 0;
+  mask |= PRE_NEIGHBOR;
+  mask |= POST_FORCE;
+  mask |= MIN_PRE_NEIGHBOR;
+  mask |= MIN_PRE_REVERSE;
+  mask |= MIN_POST_FORCE;
+  return mask;
+}
+
+/* ----------------------------------------------------------------------
+   set constraint lengths
+   this init must happen after force->bond init
+------------------------------------------------------------------------- */
+
+void FixLincs::init()
+{
+  if (utils::strmatch(update->integrate_style, "^respa"))
+    error->all(FLERR, "Fix lincs does not support run style respa");
+
+  if ((comm->me == 0) && (update->whichflag == 2))
+    error->warning(FLERR,
+                   "Using fix lincs with minimization.\n  Substituting constraints with "
+                   "harmonic restraint forces using kbond={:.4g}",
+                   kbond);
+
+  if (force->bond == nullptr) error->all(FLERR, "Bond style must be defined for fix lincs");
+
+  for (int i = 1; i <= atom->nbondtypes; i++)
+    if (bond_flag[i]) bond_distance[i] = force->bond->equilibrium_distance(i);
+}
+
+/* ----------------------------------------------------------------------
+   LINCS as pre-integrator constraint
+------------------------------------------------------------------------- */
+
+void FixLincs::setup(int vflag)
+{
+  pre_neighbor();
+
+  dtv = update->dt;
+  dtfsq = update->dt * update->dt * force->ftm2v;
+
+  // precalculate constraining forces for first integration step
+
+  post_force(vflag);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixLincs::setup_pre_reverse(int eflag, int vflag)
+{
+  min_pre_reverse(eflag, vflag);
+}
+
+/* ----------------------------------------------------------------------
+   during minimization fix LINCS adds strong bond forces
+------------------------------------------------------------------------- */
+
+void FixLincs::min_setup(int vflag)
+{
+  pre_neighbor();
+  min_post_force(vflag);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixLincs::min_pre_neighbor()
+{
+  pre_neighbor();
+}
+
+/* ----------------------------------------------------------------------
+   store eflag so it can be used in min_post_force
+------------------------------------------------------------------------- */
+
+void FixLincs::min_pre_reverse(int eflag, int /*vflag*/)
+{
+  eflag_pre_reverse = eflag;
+}
+
+/* ----------------------------------------------------------------------
+   build list of constraints to solve
+   a constraint is listed exactly once by each proc owning one of its atoms
+   constraint info for ghost atoms is acquired via forward communication
+------------------------------------------------------------------------- */
+
+void FixLincs::pre_neighbor()
+{
+  tagint *tag = atom->tag;
+  int *mask = atom->mask;
+  int *num_bond = atom->num_bond;
+  int **bond_type = atom->bond_type;
+  tagint **bond_atom = atom->bond_atom;
+  int newton_bond = force->newton_bond;
+  int nlocal = atom->nlocal;
+  int nall = nlocal + atom->nghost;
+
+  // grow per-atom arrays if necessary
+
+  if (atom->nmax > nmax) {
+    nmax = atom->nmax;
+    int maxpartner = MAX(1, atom->bond_per_atom);
+    memory->destroy(npartner);
+    memory->destroy(partner_tag);
+    memory->destroy(partner_type);
+    memory->destroy(xlincs);
+    memory->destroy(wlincs);
+    memory->create(npartner, nmax, "lincs:npartner");
+    memory->create(partner_tag, nmax, maxpartner, "lincs:partner_tag");
+    memory->create(partner_type, nmax, maxpartner, "lincs:partner_type");
+    memory->create(xlincs, nmax, 3, "lincs:xlincs");
+    memory->create(wlincs, nmax, 3, "lincs:wlincs");
+  }
+
+  // constrained bonds stored with owned atoms
+  // with newton_bond off, only store bond with the smaller atom ID
+
+  for (int i = 0; i < nlocal; i++) {
+    npartner[i] = 0;
+    if (!(mask[i] & groupbit)) continue;
+    for (int m = 0; m < num_bond[i]; m++) {
+      int btype = bond_type[i][m];
+      if ((btype >= 0) || !bond_flag[-btype]) continue;
+      if (!newton_bond && (tag[i] > bond_atom[i][m])) continue;
+      partner_tag[i][npartner[i]] = bond_atom[i][m];
+      partner_type[i][npartner[i]] = -btype;
+      npartner[i]++;
+    }
+  }
+
+  commflag = BONDINFO;
+  comm->forward_comm(this);
+
+  // list each constraint with at least one owned atom once
+  // owned atom stores bond: use closest image of partner
+  // ghost atom stores bond: only if partner is owned and this ghost
+  //   is the closest image of the bond atom to the partner
+
+  ncons = 0;
+  int flag = 0;
+
+  for (int k = 0; k < nall; k++) {
+    for (int n = 0; n < npartner[k]; n++) {
+      int j = atom->map(partner_tag[k][n]);
+      if (k < nlocal) {
+        if (j < 0)
+          error->one(FLERR, "Fix lincs atoms {} {} missing on proc {} at step {}{}", tag[k],
+                     partner_tag[k][n], comm->me, update->ntimestep, utils::errorurl(5));
+        j = domain->closest_image(k, j);
+      } else {
+        if ((j < 0) || (j >= nlocal)) continue;
+        if (domain->closest_image(j, atom->map(tag[k])) != k) continue;
+      }
+      if (!(mask[j] & groupbit)) flag = 1;
+
+      if (ncons == maxcons) {
+        maxcons += DELTA;
+        memory->grow(cons_atom, maxcons, 2, "lincs:cons_atom");
+        memory->grow(cons_type, maxcons, "lincs:cons_type");
+        memory->grow(cons_dir, maxcons, 3, "lincs:cons_dir");
+        memory->grow(cons_invm, maxcons, 2, "lincs:cons_invm");
+        memory->grow(cons_len, maxcons, "lincs:cons_len");
+        memory->grow(cons_scale, maxcons, "lincs:cons_scale");
+        memory->grow(cons_rhs, maxcons, "lincs:cons_rhs");
+        memory->grow(cons_tmp, maxcons, "lincs:cons_tmp");
+        memory->grow(cons_sol, maxcons, "lincs:cons_sol");
+        memory->grow(cons_solsum, maxcons, "lincs:cons_solsum");
+      }
+
+      cons_atom[ncons][0] = k;
+      cons_atom[ncons][1] = j;
+      cons_type[ncons] = partner_type[k][n];
+      ncons++;
+    }
+  }
+
+  int flagall;
+  MPI_Allreduce(&flag, &flagall, 1, MPI_INT, MPI_MAX, world);
+  if (flagall) error->all(FLERR, "Fix lincs constrained bond has only one atom in fix group");
+
+  // constraints incident to each owned atom
+
+  if (nlocal + 1 > maxlocal) {
+    maxlocal = atom->nmax + 1;
+    memory->destroy(inc_first);
+    memory->create(inc_first, maxlocal, "lincs:inc_first");
+  }
+  memory->destroy(inc_list);
+  memory->create(inc_list, 2 * ncons + 1, "lincs:inc_list");
+
+  for (int i = 0; i <= nlocal; i++) inc_first[i] = 0;
+  for (int c = 0; c < ncons; c++)
+    for (int m = 0; m < 2; m++)
+      if (cons_atom[c][m] < nlocal) inc_first[cons_atom[c][m] + 1]++;
+  for (int i = 0; i < nlocal; i++) inc_first[i + 1] += inc_first[i];
+
+  int *fill = new int[nlocal + 1];
+  for (int i = 0; i < nlocal; i++) fill[i] = inc_first[i];
+  for (int c = 0; c < ncons; c++)
+    for (int m = 0; m < 2; m++)
+      if (cons_atom[c][m] < nlocal) inc_list[fill[cons_atom[c][m]]++] = 2 * c + m;
+  delete[] fill;
+}
+
+/* ----------------------------------------------------------------------
+   compute the constraint forces with the P-LINCS algorithm
+   solve the linearized constraints by a matrix expansion of order N,
+     then correct for rotational lengthening niter times
+------------------------------------------------------------------------- */
+
+void FixLincs::post_force(int vflag)
+{
+  double **x = atom->x;
+  double **f = atom->f;
+  double *mass = atom->mass;
+  double *rmass = atom->rmass;
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+
+  // xlincs = unconstrained move with current v,f
+
+  unconstrained_update();
+  commflag = XLINCS;
+  comm->forward_comm(this);
+
+  v_init(vflag);
+
+  // constraint directions and scaling from current positions
+  // rhs = deviation of projected unconstrained length from constraint length
+
+#if defined(_OPENMP)
+#pragma omp parallel for LMP_DEFAULT_NONE LMP_SHARED(x, mass, rmass, type) num_threads(comm->nthreads) schedule(static)
+#endif
+  for (int c = 0; c < ncons; c++) {
+    const int i = cons_atom[c][0];
+    const int j = cons_atom[c][1];
+    double del[3];
+    del[0] = x[i][0] - x[j][0];
+    del[1] = x[i][1] - x[j][1];
+    del[2] = x[i][2] - x[j][2];
+    const double r = sqrt(del[0] * del[0] + del[1] * del[1] + del[2] * del[2]);
+    cons_len[c] = r;
+    cons_dir[c][0] = del[0] / r;
+    cons_dir[c][1] = del[1] / r;
+    cons_dir[c][2] = del[2] / r;
+
+    if (rmass) {
+      cons_invm[c][0] = 1.0 / rmass[i];
+      cons_invm[c][1] = 1.0 / rmass[j];
+    } else {
+      cons_invm[c][0] = 1.0 / mass[type[i]];
+      cons_invm[c][1] = 1.0 / mass[type[j]];
+    }
+    cons_scale[c] = 1.0 / sqrt(cons_invm[c][0] + cons_invm[c][1]);
+
+    const double proj = cons_dir[c][0] * (xlincs[i][0] - xlincs[j][0]) +
+        cons_dir[c][1] * (xlincs[i][1] - xlincs[j][1]) +
+        cons_dir[c][2] * (xlincs[i][2] - xlincs[j][2]);
+    cons_rhs[c] = cons_scale[c] * (proj - bond_distance[cons_type[c]]);
+  }
+
+  solve();
+  apply_correction();
+  for (int c = 0; c < ncons; c++) cons_solsum[c] = cons_sol[c];
+
+  // correct for rotational lengthening of the constraints
+
+  for (int iter = 0; iter < niter; iter++) {
+#if defined(_OPENMP)
+#pragma omp parallel for LMP_DEFAULT_NONE num_threads(comm->nthreads) schedule(static)
+#endif
+    for (int c = 0; c < ncons; c++) {
+      const int i = cons_atom[c][0];
+      const int j = cons_atom[c][1];
+      const double delx = xlincs[i][0] - xlincs[j][0];
+      const double dely = xlincs[i][1] - xlincs[j][1];
+      const double delz = xlincs[i][2] - xlincs[j][2];
+      const double len = bond_distance[cons_type[c]];
+      const double psq = 2.0 * len * len - (delx * delx + dely * dely + delz * delz);
+      const double p = (psq > 0.0) ? sqrt(psq) : 0.0;
+      cons_rhs[c] = cons_scale[c] * (len - p);
+    }
+
+    solve();
+    apply_correction();
+    for (int c = 0; c < ncons; c++) cons_solsum[c] += cons_sol[c];
+  }
+
+  // constraint force on owned atoms = displacement * mass / dtfsq
+
+  compute_w(cons_solsum);
+
+#if defined(_OPENMP)
+#pragma omp parallel for LMP_DEFAULT_NONE LMP_SHARED(f, nlocal) num_threads(comm->nthreads) schedule(static)
+#endif
+  for (int i = 0; i < nlocal; i++) {
+    if (inc_first[i] == inc_first[i + 1]) continue;
+    f[i][0] -= wlincs[i][0] / dtfsq;
+    f[i][1] -= wlincs[i][1] / dtfsq;
+    f[i][2] -= wlincs[i][2] / dtfsq;
+  }
+
+  if (evflag) {
+    int atomlist[2];
+    double v[6];
+
+    for (int c = 0; c < ncons; c++) {
+      const int i = cons_atom[c][0];
+      const int j = cons_atom[c][1];
+      const double r = cons_len[c];
+      double lamda = -cons_scale[c] * cons_solsum[c] / (dtfsq * r);
+
+      double del[3];
+      del[0] = cons_dir[c][0] * r;
+      del[1] = cons_dir[c][1] * r;
+      del[2] = cons_dir[c][2] * r;
+
+      int count = 0;
+      if (i < nlocal) atomlist[count++] = i;
+      if (j < nlocal) atomlist[count++] = j;
+
+      v[0] = lamda * del[0] * del[0];
+      v[1] = lamda * del[1] * del[1];
+      v[2] = lamda * del[2] * del[2];
+      v[3] = lamda * del[0] * del[1];
+      v[4] = lamda * del[0] * del[2];
+      v[5] = lamda * del[1] * del[2];
+
+      double fpairlist[] = {lamda};
+      double dellist[][3] = {{del[0], del[1], del[2]}};
+      int pairlist[][2] = {{i, j}};
+      v_tally(count, atomlist, 2.0, v, nlocal, 1, pairlist, fpairlist, dellist);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   substitute LINCS constraints with very strong bonds
+------------------------------------------------------------------------- */
+
+void FixLincs::min_post_force(int vflag)
+{
+  int eflag = eflag_pre_reverse;
+  ev_init(eflag, vflag);
+
+  ebond = 0.0;
+  for (int c = 0; c < ncons; c++)
+    bond_force(cons_atom[c][0], cons_atom[c][1], bond_distance[cons_type[c]]);
+}
+
+/* ----------------------------------------------------------------------
+   update the unconstrained position of each owned atom
+   assumes NVE update, seems to be accurate enough for NVT,NPT,NPH as well
+------------------------------------------------------------------------- */
+
+void FixLincs::unconstrained_update()
+{
+  double **x = atom->x;
+  double **v = atom->v;
+  double **f = atom->f;
+  double *mass = atom->mass;
+  double *rmass = atom->rmass;
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+
+#if defined(_OPENMP)
+#pragma omp parallel for LMP_DEFAULT_NONE LMP_SHARED(x, v, f, mass, rmass, type, nlocal) num_threads(comm->nthreads) schedule(static)
+#endif
+  for (int i = 0; i < nlocal; i++) {
+    const double dtfmsq = rmass ? dtfsq / rmass[i] : dtfsq / mass[type[i]];
+    xlincs[i][0] = x[i][0] + dtv * v[i][0] + dtfmsq * f[i][0];
+    xlincs[i][1] = x[i][1] + dtv * v[i][1] + dtfmsq * f[i][1];
+    xlincs[i][2] = x[i][2] + dtv * v[i][2] + dtfmsq * f[i][2];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   solve (I - A) sol = rhs by the series expansion sol = sum_n A^n rhs
+   A = I - S B M^-1 B^T S is applied atom-wise via compute_w()
+   rhs is overwritten
+------------------------------------------------------------------------- */
+
+void FixLincs::solve()
+{
+  for (int c = 0; c < ncons; c++) cons_sol[c] = cons_rhs[c];
+
+  for (int rec = 0; rec < order; rec++) {
+    compute_w(cons_rhs);
+    commflag = WLINCS;
+    comm->forward_comm(this);
+
+#if defined(_OPENMP)
+#pragma omp parallel for LMP_DEFAULT_NONE num_threads(comm->nthreads) schedule(static)
+#endif
+    for (int c = 0; c < ncons; c++) {
+      const int i = cons_atom[c][0];
+      const int j = cons_atom[c][1];
+      const double *dir = cons_dir[c];
+      const double wi = dir[0] * wlincs[i][0] + dir[1] * wlincs[i][1] + dir[2] * wlincs[i][2];
+      const double wj = dir[0] * wlincs[j][0] + dir[1] * wlincs[j][1] + dir[2] * wlincs[j][2];
+      cons_tmp[c] = cons_rhs[c] - cons_scale[c] * (cons_invm[c][0] * wi - cons_invm[c][1] * wj);
+      cons_sol[c] += cons_tmp[c];
+    }
+
+    std::swap(cons_rhs, cons_tmp);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   wlincs = B^T S vec for owned atoms, sum over incident constraints
+   ghost atom values must be acquired via forward communication
+------------------------------------------------------------------------- */
+
+void FixLincs::compute_w(double *vec)
+{
+  int nlocal = atom->nlocal;
+
+#if defined(_OPENMP)
+#pragma omp parallel for LMP_DEFAULT_NONE LMP_SHARED(vec, nlocal) num_threads(comm->nthreads) schedule(static)
+#endif
+  for (int i = 0; i < nlocal; i++) {
+    double w[3] = {0.0, 0.0, 0.0};
+    for (int k = inc_first[i]; k < inc_first[i + 1]; k++) {
+      const int c = inc_list[k] >> 1;
+      double s = cons_scale[c] * vec[c];
+      if (inc_list[k] & 1) s = -s;
+      w[0] += s * cons_dir[c][0];
+      w[1] += s * cons_dir[c][1];
+      w[2] += s * cons_dir[c][2];
+    }
+    wlincs[i][0] = w[0];
+    wlincs[i][1] = w[1];
+    wlincs[i][2] = w[2];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   displace owned atoms by -M^-1 B^T S sol and update ghost atoms
+------------------------------------------------------------------------- */
+
+void FixLincs::apply_correction()
+{
+  double *mass = atom->mass;
+  double *rmass = atom->rmass;
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+
+  compute_w(cons_sol);
+
+#if defined(_OPENMP)
+#pragma omp parallel for LMP_DEFAULT_NONE LMP_SHARED(mass, rmass, type, nlocal) num_threads(comm->nthreads) schedule(static)
+#endif
+  for (int i = 0; i < nlocal; i++) {
+    if (inc_first[i] == inc_first[i + 1]) continue;
+    const double invmass = rmass ? 1.0 / rmass[i] : 1.0 / mass[type[i]];
+    xlincs[i][0] -= invmass * wlincs[i][0];
+    xlincs[i][1] -= invmass * wlincs[i][1];
+    xlincs[i][2] -= invmass * wlincs[i][2];
+  }
+
+  commflag = XLINCS;
+  comm->forward_comm(this);
+}
+
+/* ----------------------------------------------------------------------
+   apply bond force for minimization between atom indices i1 and i2
+------------------------------------------------------------------------- */
+
+void FixLincs::bond_force(int i1, int i2, double length)
+{
+  double **x = atom->x;
+  double **f = atom->f;
+  int nlocal = atom->nlocal;
+
+  double delx = x[i1][0] - x[i2][0];
+  double dely = x[i1][1] - x[i2][1];
+  double delz = x[i1][2] - x[i2][2];
+
+  const double r = sqrt(delx * delx + dely * dely + delz * delz);
+  const double dr = r - length;
+  const double rk = kbond * dr;
+  const double fbond = (r > 0.0) ? -2.0 * rk / r : 0.0;
+  const double eb = rk * dr;
+  int atomlist[2];
+  int count = 0;
+
+  if (i1 < nlocal) {
+    f[i1][0] += delx * fbond;
+    f[i1][1] += dely * fbond;
+    f[i1][2] += delz * fbond;
+    atomlist[count++] = i1;
+    ebond += 0.5 * eb;
+  }
+  if (i2 < nlocal) {
+    f[i2][0] -= delx * fbond;
+    f[i2][1] -= dely * fbond;
+    f[i2][2] -= delz * fbond;
+    atomlist[count++] = i2;
+    ebond += 0.5 * eb;
+  }
+  if (evflag) {
+    double v[6];
+    v[0] = 0.5 * delx * delx * fbond;
+    v[1] = 0.5 * dely * dely * fbond;
+    v[2] = 0.5 * delz * delz * fbond;
+    v[3] = 0.5 * delx * dely * fbond;
+    v[4] = 0.5 * delx * delz * fbond;
+    v[5] = 0.5 * dely * delz * fbond;
+    ev_tally(count, atomlist, 2.0, eb, v);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixLincs::pack_forward_comm(int n, int *list, double *buf, int pbc_flag, int *pbc)
+{
+  int m = 0;
+
+  if (commflag == BONDINFO) {
+    for (int i = 0; i < n; i++) {
+      int j = list[i];
+      buf[m++] = ubuf(npartner[j]).d;
+      for (int k = 0; k < npartner[j]; k++) {
+        buf[m++] = ubuf(partner_tag[j][k]).d;
+        buf[m++] = ubuf(partner_type[j][k]).d;
+      }
+    }
+  } else if (commflag == XLINCS) {
+    double dx = 0.0, dy = 0.0, dz = 0.0;
+    if (pbc_flag) {
+      if (domain->triclinic == 0) {
+        dx = pbc[0] * domain->xprd;
+        dy = pbc[1] * domain->yprd;
+        dz = pbc[2] * domain->zprd;
+      } else {
+        dx = pbc[0] * domain->xprd + pbc[5] * domain->xy + pbc[4] * domain->xz;
+        dy = pbc[1] * domain->yprd + pbc[3] * domain->yz;
+        dz = pbc[2] * domain->zprd;
+      }
+    }
+    for (int i = 0; i < n; i++) {
+      int j = list[i];
+      buf[m++] = xlincs[j][0] + dx;
+      buf[m++] = xlincs[j][1] + dy;
+      buf[m++] = xlincs[j][2] + dz;
+    }
+  } else {
+    for (int i = 0; i < n; i++) {
+      int j = list[i];
+      buf[m++] = wlincs[j][0];
+      buf[m++] = wlincs[j][1];
+      buf[m++] = wlincs[j][2];
+    }
+  }
+
+  return m;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixLincs::unpack_forward_comm(int n, int first, double *buf)
+{
+  int m = 0;
+  int last = first + n;
+
+  if (commflag == BONDINFO) {
+    for (int i = first; i < last; i++) {
+      npartner[i] = (int) ubuf(buf[m++]).i;
+      for (int k = 0; k < npartner[i]; k++) {
+        partner_tag[i][k] = (tagint) ubuf(buf[m++]).i;
+        partner_type[i][k] = (int) ubuf(buf[m++]).i;
+      }
+    }
+  } else {
+    double **vec = (commflag == XLINCS) ? xlincs : wlincs;
+    for (int i = first; i < last; i++) {
+      vec[i][0] = buf[m++];
+      vec[i][1] = buf[m++];
+      vec[i][2] = buf[m++];
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   count # of degrees-of-freedom removed by LINCS for atoms in igroup
+   count a constraint if the atom it is stored with is in igroup
+------------------------------------------------------------------------- */
+
+bigint FixLincs::dof(int igroup)
+{
+  int igroupbit = group->bitmask[igroup];
+
+  tagint *tag = atom->tag;
+  int *mask = atom->mask;
+  int *num_bond = atom->num_bond;
+  int **bond_type = atom->bond_type;
+  tagint **bond_atom = atom->bond_atom;
+  int newton_bond = force->newton_bond;
+  int nlocal = atom->nlocal;
+
+  bigint n = 0;
+  for (int i = 0; i < nlocal; i++) {
+    if (!(mask[i] & igroupbit) || !(mask[i] & groupbit)) continue;
+    for (int m = 0; m < num_bond[i]; m++) {
+      if ((bond_type[i][m] >= 0) || !bond_flag[-bond_type[i][m]]) continue;
+      if (!newton_bond && (tag[i] > bond_atom[i][m])) continue;
+      n++;
+    }
+  }
+
+  bigint nall;
+  MPI_Allreduce(&n, &nall, 1, MPI_LMP_BIGINT, MPI_SUM, world);
+  return nall;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixLincs::reset_dt()
+{
+  dtv = update->dt;
+  dtfsq = update->dt * update->dt * force->ftm2v;
+}
+
+/* ----------------------------------------------------------------------
+   energy due to restraint forces during minimization
+------------------------------------------------------------------------- */
+
+double FixLincs::compute_scalar()
+{
+  double eall = 0.0;
+  MPI_Allreduce(&ebond, &eall, 1, MPI_DOUBLE, MPI_SUM, world);
+  return eall;
+}
+
+/* ----------------------------------------------------------------------
+   memory usage of local atom-based arrays and constraint list
+------------------------------------------------------------------------- */
+
+double FixLincs::memory_usage()
+{
+  double bytes = (double) nmax * sizeof(int);
+  bytes += (double) nmax * MAX(1, atom->bond_per_atom) * (sizeof(tagint) + sizeof(int));
+  bytes += (double) nmax * 6 * sizeof(double);
+  bytes += (double) maxcons * 3 * sizeof(int);
+  bytes += (double) maxcons * 12 * sizeof(double);
+  bytes += (double) (maxlocal + 2 * ncons + 1) * sizeof(int);
+  return bytes;
+}
@@ -0,0 +1,99 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+// clang-format off
+FixStyle(lincs,FixLincs);
+// clang-format on
+#else
+
+#ifndef LMP_FIX_LINCS_H
+#define LMP_FIX_LINCS_H
+
+#include "fix.h"
+
+namespace LAMMPS_NS {
+
+class FixLincs : public Fix {
+ public:
+  FixLincs(class LAMMPS *, int, char **);
+  ~FixLincs() override;
+  int setmask() override;
+  void init() override;
+  void setup(int) override;
+  void setup_pre_reverse(int, int) override;
+  void min_setup(int) override;
+  void pre_neighbor() override;
+  void post_force(int) override;
+  void min_pre_neighbor() override;
+  void min_pre_reverse(int, int) override;
+  void min_post_force(int) override;
+
+  int pack_forward_comm(int, int *, double *, int, int *) override;
+  void unpack_forward_comm(int, int, double *) override;
+
+  bigint dof(int) override;
+  void reset_dt() override;
+  double compute_scalar() override;
+  double memory_usage() override;
+
+ protected:
+  int order;                // order of the matrix expansion
+  int niter;                // # of corrections for rotational lengthening
+  double kbond;             // force constant for restraints during minimization
+  int eflag_pre_reverse;    // store the eflag of last pre_reverse call
+  int commflag;             // which quantity to forward communicate
+  double dtv, dtfsq;
+  double ebond;
+
+  int *bond_flag;            // bond types to constrain
+  double *bond_distance;     // constraint length for each bond type
+
+  // per-atom constraint info for owned and ghost atoms
+  // each constrained bond is stored with exactly one of its atoms
+
+  int nmax;
+  int *npartner;               // # of constrained bonds stored with atom
+  tagint **partner_tag;        // atom ID of bond partners
+  int **partner_type;          // bond type to each partner
+  double **xlincs;             // unconstrained and then constrained positions
+  double **wlincs;             // per-atom sum of scaled constraint vectors
+
+  // list of constraints with at least one owned atom
+
+  int ncons, maxcons;
+  int **cons_atom;       // local indices of the 2 atoms
+  int *cons_type;        // bond type
+  double **cons_dir;     // unit vector along constraint
+  double **cons_invm;    // inverse masses of the 2 atoms
+  double *cons_len;      // current constraint length
+  double *cons_scale;    // 1/sqrt(invm0 + invm1)
+  double *cons_rhs, *cons_tmp, *cons_sol, *cons_solsum;
+
+  // constraints incident to each owned atom, in CSR format
+  // entries are 2*constraint index + 0/1 for first/second atom
+
+  int maxlocal;
+  int *inc_first, *inc_list;
+
+  void unconstrained_update();
+  void solve();
+  void compute_w(double *);
+  void apply_correction();
+  void bond_force(int, int, double);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
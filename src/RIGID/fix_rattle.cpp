@@ -31,6 +31,8 @@
 #include <cmath>
 #include <cstring>
 
+#include "omp_compat.h"
+
 using namespace LAMMPS_NS;
 using namespace FixConst;
 using namespace MathExtra;
@@ -164,14 +166,7 @@ void FixRattle::post_force(int vflag)
 
   // correct the velocity for each molecule accordingly
 
-  int m;
-  for (int i = 0; i < nlist; i++) {
-    m = list[i];
-    if      (shake_flag[m] == 2)        vrattle2(m);
-    else if (shake_flag[m] == 3)        vrattle3(m);
-    else if (shake_flag[m] == 4)        vrattle4(m);
-    else                                vrattle3angle(m);
-  }
+  vrattle_clusters();
 }
 
 /* ---------------------------------------------------------------------- */
@@ -196,14 +191,7 @@ void FixRattle::post_force_respa(int vflag, int ilevel, int /*iloop*/)
 
   // correct the velocity for each molecule accordingly
 
-  int m;
-  for (int i = 0; i < nlist; i++) {
-    m = list[i];
-    if      (shake_flag[m] == 2)        vrattle2(m);
-    else if (shake_flag[m] == 3)        vrattle3(m);
-    else if (shake_flag[m] == 4)        vrattle4(m);
-    else                                vrattle3angle(m);
-  }
+  vrattle_clusters();
 }
 
 /* ----------------------------------------------------------------------
@@ -224,11 +212,51 @@ void FixRattle::final_integrate_respa(int ilevel, int iloop)
   FixShake::post_force_respa(vflag_post_force, ilevel, iloop);
 }
 
+/* ----------------------------------------------------------------------
+   correct velocities of all clusters
+   clusters of each size are distributed across threads
+   each owned atom is in a single cluster, so v can be updated directly
+   zero determinants are counted and reported after all clusters
+------------------------------------------------------------------------- */
+
+void FixRattle::vrattle_clusters()
+{
+  int nzero = 0;
+
+#if defined(_OPENMP)
+#pragma omp parallel LMP_DEFAULT_NONE num_threads(comm->nthreads) reduction(+:nzero)
+#endif
+  {
+#if defined(_OPENMP)
+#pragma omp for schedule(static) nowait
+#endif
+    for (int k = list_start[0]; k < list_start[1]; k++) nzero += vrattle3angle(list[list_sorted[k]]);
+
+#if defined(_OPENMP)
+#pragma omp for schedule(static) nowait
+#endif
+    for (int k = list_start[1]; k < list_start[2]; k++) vrattle2(list[list_sorted[k]]);
+
+#if defined(_OPENMP)
+#pragma omp for schedule(static) nowait
+#endif
+    for (int k = list_start[2]; k < list_start[3]; k++) nzero += vrattle3(list[list_sorted[k]]);
+
+#if defined(_OPENMP)
+#pragma omp for schedule(static) nowait
+#endif
+    for (int k = list_start[3]; k < list_start[4]; k++) nzero += vrattle4(list[list_sorted[k]]);
+  }
+
+  if (nzero) error->one(FLERR,"Rattle determinant = 0.0");
+}
+
 /* ----------------------------------------------------------------------
    correct velocities of molecule m with 2 constraints bonds and 1 angle
+   return 1 if the determinant is zero and m was skipped, else 0
 ------------------------------------------------------------------------- */
 
-void FixRattle::vrattle3angle(int m)
+int FixRattle::vrattle3angle(int m)
 {
   tagint i0,i1,i2;
   double c[3], l[3], a[3][3], r01[3], imass[3],
@@ -290,7 +318,7 @@ void FixRattle::vrattle3angle(int m)
 
   // calculate the inverse matrix exactly
 
-  solve3x3exactly(a,c,l);
+  if (!solve3x3exactly(a,c,l)) return 1;
 
   // add corrections to the velocities if processor owns atom
 
@@ -306,6 +334,7 @@ void FixRattle::vrattle3angle(int m)
     for (int k=0; k<3; k++)
       v[i2][k] -=   imass[2] * ( -l[1] * r02[k] - l[2] * r12[k] );
   }
+  return 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -356,9 +385,11 @@ void FixRattle::vrattle2(int m)
   }
 }
 
-/* ---------------------------------------------------------------------- */
+/* ----------------------------------------------------------------------
+   return 1 if the determinant is zero and m was skipped, else 0
+------------------------------------------------------------------------- */
 
-void FixRattle::vrattle3(int m)
+int FixRattle::vrattle3(int m)
 {
   tagint    i0,i1,i2;
   double    imass[3], r01[3], r02[3], vp01[3], vp02[3],
@@ -407,7 +438,7 @@ void FixRattle::vrattle3(int m)
 
   // calculate the inverse 2x2 matrix exactly
 
-  solve2x2exactly(a,c,l);
+  if (!solve2x2exactly(a,c,l)) return 1;
 
   // add corrections to the velocities if the process owns this atom
 
@@ -423,11 +454,14 @@ void FixRattle::vrattle3(int m)
     for (int k=0; k<3; k++)
       v[i2][k] -= imass[2] * ( -l[1] * r02[k] );
   }
+  return 0;
 }
 
-/* ---------------------------------------------------------------------- */
+/* ----------------------------------------------------------------------
+   return 1 if the determinant is zero and m was skipped, else 0
+------------------------------------------------------------------------- */
 
-void FixRattle::vrattle4(int m)
+int FixRattle::vrattle4(int m)
 {
   tagint    i0,i1,i2,i3;
   double    imass[4], c[3], l[3], a[3][3],
@@ -490,7 +524,7 @@ void FixRattle::vrattle4(int m)
 
   // calculate the inverse 3x3 matrix exactly
 
-  solve3x3exactly(a,c,l);
+  if (!solve3x3exactly(a,c,l)) return 1;
 
   // add corrections to the velocities if the process owns this atom
 
@@ -510,11 +544,14 @@ void FixRattle::vrattle4(int m)
     for (int k=0; k<3; k++)
       v[i3][k] -= imass[3] * ( -l[2] * r03[k]);
   }
+  return 0;
 }
 
-/* ---------------------------------------------------------------------- */
+/* ----------------------------------------------------------------------
+   return false if the matrix is singular, else true
+------------------------------------------------------------------------- */
 
-void FixRattle::solve2x2exactly(const double a[][2],
+bool FixRattle::solve2x2exactly(const double a[][2],
                                 const double c[], double l[])
 {
   double determ, determinv;
@@ -525,18 +562,21 @@ void FixRattle::solve2x2exactly(const double a[][2],
 
   // check if matrix is actually invertible
 
-  if (determ == 0.0) error->one(FLERR,"Rattle determinant = 0.0");
+  if (determ == 0.0) return false;
   determinv = 1.0/determ;
 
   // Calculate the solution:  (l01, l02)^T = A^(-1) * c
 
   l[0] = determinv * ( a[1][1] * c[0]  - a[0][1] * c[1]);
   l[1] = determinv * (-a[1][0] * c[0]  + a[0][0] * c[1]);
+  return true;
 }
 
-/* ---------------------------------------------------------------------- */
+/* ----------------------------------------------------------------------
+   return false if the matrix is singular, else true
+------------------------------------------------------------------------- */
 
-void FixRattle::solve3x3exactly(const double a[][3],
+bool FixRattle::solve3x3exactly(const double a[][3],
                                 const double c[], double l[])
 {
   double ai[3][3];
@@ -550,7 +590,7 @@ void FixRattle::solve3x3exactly(const double a[][3],
 
   // check if matrix is actually invertible
 
-  if (determ == 0.0) error->one(FLERR,"Rattle determinant = 0.0");
+  if (determ == 0.0) return false;
 
   // calculate the inverse 3x3 matrix: A^(-1) = (ai_jk)
 
@@ -572,6 +612,7 @@ void FixRattle::solve3x3exactly(const double a[][3],
     for (int j=0; j<3; j++)
       l[i] += ai[i][j] * c[j];
   }
+  return true;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -766,14 +807,7 @@ void FixRattle::correct_velocities() {
 
   // correct the velocity for each molecule accordingly
 
-  int m;
-  for (int i = 0; i < nlist; i++) {
-    m = list[i];
-    if      (shake_flag[m] == 2)  vrattle2(m);
-    else if (shake_flag[m] == 3)  vrattle3(m);
-    else if (shake_flag[m] == 4)  vrattle4(m);
-    else                          vrattle3angle(m);
-  }
+  vrattle_clusters();
 }
 
 /* ----------------------------------------------------------------------
@@ -54,12 +54,13 @@ class FixRattle : public FixShake {
   void update_v_half_nocons();
   void update_v_half_nocons_respa(int);
 
+  void vrattle_clusters();
   void vrattle2(int m);
-  void vrattle3(int m);
-  void vrattle4(int m);
-  void vrattle3angle(int m);
-  void solve3x3exactly(const double a[][3], const double c[], double l[]);
-  void solve2x2exactly(const double a[][2], const double c[], double l[]);
+  int vrattle3(int m);
+  int vrattle4(int m);
+  int vrattle3angle(int m);
+  bool solve3x3exactly(const double a[][3], const double c[], double l[]);
+  bool solve2x2exactly(const double a[][2], const double c[], double l[]);
 
   // debugging methods
 
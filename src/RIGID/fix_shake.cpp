@@ -36,6 +36,8 @@
 #include <cmath>
 #include <cstring>
 
+#include "omp_compat.h"
+
 using namespace LAMMPS_NS;
 using namespace FixConst;
 using namespace MathConst;
@@ -53,6 +55,7 @@ FixShake::FixShake(LAMMPS *lmp, int narg, char **arg) :
     step_respa(nullptr), x(nullptr), v(nullptr), f(nullptr), ftmp(nullptr), vtmp(nullptr),
     mass(nullptr), rmass(nullptr), type(nullptr), shake_flag(nullptr), shake_atom(nullptr),
     shake_type(nullptr), xshake(nullptr), nshake(nullptr), list(nullptr), closest_list(nullptr),
+    list_sorted(nullptr),
     b_count(nullptr), b_count_all(nullptr), b_ave(nullptr), b_max(nullptr), b_min(nullptr),
     b_ave_all(nullptr), b_max_all(nullptr), b_min_all(nullptr), a_count(nullptr),
     a_count_all(nullptr), a_ave(nullptr), a_max(nullptr), a_min(nullptr), a_ave_all(nullptr),
@@ -271,6 +274,8 @@ FixShake::FixShake(LAMMPS *lmp, int narg, char **arg) :
   maxlist = 0;
   list = nullptr;
   closest_list = nullptr;
+  list_sorted = nullptr;
+  for (int k = 0; k < 5; k++) list_start[k] = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -347,6 +352,7 @@ FixShake::~FixShake()
 
   memory->destroy(list);
   memory->destroy(closest_list);
+  memory->destroy(list_sorted);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -584,6 +590,8 @@ void FixShake::pre_neighbor()
     memory->create(list,maxlist,"shake:list");
     memory->destroy(closest_list);
     memory->create(closest_list,maxlist,4,"shake:closest_list");
+    memory->destroy(list_sorted);
+    memory->create(list_sorted,maxlist,"shake:list_sorted");
   }
 
   // build list of SHAKE clusters I compute
@@ -647,6 +655,20 @@ void FixShake::pre_neighbor()
         }
       }
     }
+
+  // group clusters by shake_flag, so clusters of the same size are
+  // solved together and can be distributed evenly across threads
+
+  int count[5] = {0, 0, 0, 0, 0};
+  for (int i = 0; i < nlist; i++) count[shake_flag[list[i]]]++;
+
+  int next[4];
+  list_start[0] = 0;
+  for (int k = 1; k < 5; k++) {
+    next[k-1] = list_start[k-1];
+    list_start[k] = list_start[k-1] + count[k];
+  }
+  for (int i = 0; i < nlist; i++) list_sorted[next[shake_flag[list[i]]-1]++] = i;
 }
 
 /* ----------------------------------------------------------------------
@@ -671,14 +693,7 @@ void FixShake::post_force(int vflag)
 
   // loop over clusters to add constraint forces
 
-  int m;
-  for (int i = 0; i < nlist; i++) {
-    m = list[i];
-    if (shake_flag[m] == 2) shake(i);
-    else if (shake_flag[m] == 3) shake3(i);
-    else if (shake_flag[m] == 4) shake4(i);
-    else shake3angle(i);
-  }
+  shake_clusters();
 
   // store vflag for coordinate_constraints_end_of_step()
 
@@ -719,14 +734,7 @@ void FixShake::post_force_respa(int vflag, int ilevel, int iloop)
 
   // loop over clusters to add constraint forces
 
-  int m;
-  for (int i = 0; i < nlist; i++) {
-    m = list[i];
-    if (shake_flag[m] == 2) shake(i);
-    else if (shake_flag[m] == 3) shake3(i);
-    else if (shake_flag[m] == 4) shake4(i);
-    else shake3angle(i);
-  }
+  shake_clusters();
 
   // store vflag for coordinate_constraints_end_of_step()
   vflag_post_force = vflag;
@@ -1801,11 +1809,109 @@ void FixShake::unconstrained_update_respa(int ilevel)
   }
 }
 
+/* ----------------------------------------------------------------------
+   calculate SHAKE constraint forces for all clusters
+   clusters of each size are distributed across threads
+   each owned atom is in a single cluster, so forces and per-atom virial
+     can be updated directly and only the global virial needs a reduction
+   negative and zero determinants are counted and reported after all clusters
+------------------------------------------------------------------------- */
+
+void FixShake::shake_clusters()
+{
+  double vsum[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  int ndeterm = 0, nzero = 0;
+
+#if defined(_OPENMP)
+#pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(vsum) num_threads(comm->nthreads) reduction(+:ndeterm,nzero)
+#endif
+  {
+    double vthr[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+#if defined(_OPENMP)
+#pragma omp for schedule(static) nowait
+#endif
+    for (int k = list_start[0]; k < list_start[1]; k++) nzero += shake3angle(list_sorted[k], vthr);
+
+#if defined(_OPENMP)
+#pragma omp for schedule(static) nowait
+#endif
+    for (int k = list_start[1]; k < list_start[2]; k++) ndeterm += shake(list_sorted[k], vthr);
+
+#if defined(_OPENMP)
+#pragma omp for schedule(static) nowait
+#endif
+    for (int k = list_start[2]; k < list_start[3]; k++) nzero += shake3(list_sorted[k], vthr);
+
+#if defined(_OPENMP)
+#pragma omp for schedule(static) nowait
+#endif
+    for (int k = list_start[3]; k < list_start[4]; k++) nzero += shake4(list_sorted[k], vthr);
+
+    if (vflag_global) {
+#if defined(_OPENMP)
+#pragma omp critical
+#endif
+      for (int n = 0; n < 6; n++) vsum[n] += vthr[n];
+    }
+  }
+
+  if (vflag_global)
+    for (int n = 0; n < 6; n++) virial[n] += vsum[n];
+
+  if (nzero) error->one(FLERR,"Shake determinant = 0.0");
+  if (ndeterm) error->warning(FLERR,"Shake determinant < 0.0");
+}
+
+/* ----------------------------------------------------------------------
+   tally virial of a cluster into global and per-atom accumulators
+   same as Fix::v_tally(), except that the global virial is added to vsum
+------------------------------------------------------------------------- */
+
+void FixShake::v_tally_cluster(double *vsum, int n, int *atomlist, double total, double *v,
+                               int npair, int pairlist[][2], double *fpairlist,
+                               double dellist[][3])
+{
+  if (vflag_global) {
+    double fraction = n/total;
+    for (int k = 0; k < 6; k++) vsum[k] += fraction*v[k];
+  }
+
+  if (vflag_atom) {
+    double fraction = 1.0/total;
+    for (int i = 0; i < n; i++) {
+      int m = atomlist[i];
+      for (int k = 0; k < 6; k++) vatom[m][k] += fraction*v[k];
+    }
+  }
+
+  if (cvflag_atom) {
+    double vpair[6];
+    for (int i = 0; i < npair; i++) {
+      vpair[0] = 0.5*dellist[i][0]*dellist[i][0]*fpairlist[i];
+      vpair[1] = 0.5*dellist[i][1]*dellist[i][1]*fpairlist[i];
+      vpair[2] = 0.5*dellist[i][2]*dellist[i][2]*fpairlist[i];
+      vpair[3] = 0.5*dellist[i][0]*dellist[i][1]*fpairlist[i];
+      vpair[4] = 0.5*dellist[i][0]*dellist[i][2]*fpairlist[i];
+      vpair[5] = 0.5*dellist[i][1]*dellist[i][2]*fpairlist[i];
+      for (int j = 0; j < 2; j++) {
+        int m = pairlist[i][j];
+        if (m >= nlocal) continue;
+        for (int k = 0; k < 6; k++) cvatom[m][k] += vpair[k];
+        cvatom[m][6] += vpair[3];
+        cvatom[m][7] += vpair[4];
+        cvatom[m][8] += vpair[5];
+      }
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    calculate SHAKE constraint forces for size 2 cluster = single bond
+   return 1 if the determinant was negative and was reset to 0, else 0
 ------------------------------------------------------------------------- */
 
-void FixShake::shake(int ilist)
+int FixShake::shake(int ilist, double *vsum)
 {
   int atomlist[2];
   double v[6];
@@ -1855,8 +1961,9 @@ void FixShake::shake(int ilist)
   // error check
 
   double determ = b*b - 4.0*a*c;
+  int negative = 0;
   if (determ < 0.0) {
-    error->warning(FLERR,"Shake determinant < 0.0");
+    negative = 1;
     determ = 0.0;
   }
 
@@ -1900,15 +2007,18 @@ void FixShake::shake(int ilist)
     double fpairlist[] = {lamda};
     double dellist[][3]  = {{r01[0], r01[1], r01[2]}};
     int pairlist[][2] = {{i0,i1}};
-    v_tally(count,atomlist,2.0,v,nlocal,1,pairlist,fpairlist,dellist);
+    v_tally_cluster(vsum,count,atomlist,2.0,v,1,pairlist,fpairlist,dellist);
   }
+
+  return negative;
 }
 
 /* ----------------------------------------------------------------------
    calculate SHAKE constraint forces for size 3 cluster = two bonds
+   return 1 if the determinant is zero and the cluster was skipped, else 0
 ------------------------------------------------------------------------- */
 
-void FixShake::shake3(int ilist)
+int FixShake::shake3(int ilist, double *vsum)
 {
   int atomlist[3];
   double v[6];
@@ -1978,7 +2088,7 @@ void FixShake::shake3(int ilist)
   // inverse of matrix
 
   double determ = a11*a22 - a12*a21;
-  if (determ == 0.0) error->one(FLERR,"Shake determinant = 0.0");
+  if (determ == 0.0) return 1;
   double determinv = 1.0/determ;
 
   double a11inv = a22*determinv;
@@ -2074,15 +2184,17 @@ void FixShake::shake3(int ilist)
     double dellist[][3]  = {{r01[0], r01[1], r01[2]},
                             {r02[0], r02[1], r02[2]}};
     int pairlist[][2] = {{i0,i1}, {i0,i2}};
-    v_tally(count,atomlist,3.0,v,nlocal,2,pairlist,fpairlist,dellist);
+    v_tally_cluster(vsum,count,atomlist,3.0,v,2,pairlist,fpairlist,dellist);
   }
+  return 0;
 }
 
 /* ----------------------------------------------------------------------
    calculate SHAKE constraint forces for size 4 cluster = three bonds
+   return 1 if the determinant is zero and the cluster was skipped, else 0
 ------------------------------------------------------------------------- */
 
-void FixShake::shake4(int ilist)
+int FixShake::shake4(int ilist, double *vsum)
 {
  int atomlist[4];
   double v[6];
@@ -2179,7 +2291,7 @@ void FixShake::shake4(int ilist)
 
   double determ = a11*a22*a33 + a12*a23*a31 + a13*a21*a32 -
     a11*a23*a32 - a12*a21*a33 - a13*a22*a31;
-  if (determ == 0.0) error->one(FLERR,"Shake determinant = 0.0");
+  if (determ == 0.0) return 1;
   double determinv = 1.0/determ;
 
   double a11inv = determinv * (a22*a33 - a23*a32);
@@ -2326,15 +2438,17 @@ void FixShake::shake4(int ilist)
                             {r02[0], r02[1], r02[2]},
                             {r03[0], r03[1], r03[2]}};
     int pairlist[][2] = {{i0,i1}, {i0,i2}, {i0,i3}};
-    v_tally(count,atomlist,4.0,v,nlocal,3,pairlist,fpairlist,dellist);
+    v_tally_cluster(vsum,count,atomlist,4.0,v,3,pairlist,fpairlist,dellist);
   }
+  return 0;
 }
 
 /* ----------------------------------------------------------------------
    calculate SHAKE constraint forces for size 3 cluster = two bonds + angle
+   return 1 if the determinant is zero and the cluster was skipped, else 0
 ------------------------------------------------------------------------- */
 
-void FixShake::shake3angle(int ilist)
+int FixShake::shake3angle(int ilist, double *vsum)
 {
   int atomlist[3];
   double v[6];
@@ -2428,7 +2542,7 @@ void FixShake::shake3angle(int ilist)
 
   double determ = a11*a22*a33 + a12*a23*a31 + a13*a21*a32 -
     a11*a23*a32 - a12*a21*a33 - a13*a22*a31;
-  if (determ == 0.0) error->one(FLERR,"Shake determinant = 0.0");
+  if (determ == 0.0) return 1;
   double determinv = 1.0/determ;
 
   double a11inv = determinv * (a22*a33 - a23*a32);
@@ -2569,8 +2683,9 @@ void FixShake::shake3angle(int ilist)
                             {r02[0], r02[1], r02[2]},
                             {r12[0], r12[1], r12[2]}};
     int pairlist[][2] = {{i0,i1}, {i0,i2}, {i1,i2}};
-    v_tally(count,atomlist,3.0,v,nlocal,3,pairlist,fpairlist,dellist);
+    v_tally_cluster(vsum,count,atomlist,3.0,v,3,pairlist,fpairlist,dellist);
   }
+  return 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -115,6 +115,8 @@ class FixShake : public Fix {
   int *list;             // list of clusters to SHAKE
   int **closest_list;    // list of closest atom indices in SHAKE clusters
   int nlist, maxlist;    // size and max-size of list
+  int *list_sorted;      // indices into list, grouped by shake_flag
+  int list_start[5];     // first index in list_sorted for shake_flag = 1 to 4
 
   // stat quantities
   bigint *b_count, *b_count_all;                // counts for each bond type, atoms in bond cluster
@@ -137,10 +139,13 @@ class FixShake : public Fix {
   int masscheck(double);
   virtual void unconstrained_update();
   void unconstrained_update_respa(int);
-  void shake(int);
-  void shake3(int);
-  void shake4(int);
-  void shake3angle(int);
+  void shake_clusters();
+  int shake(int, double *);
+  int shake3(int, double *);
+  int shake4(int, double *);
+  int shake3angle(int, double *);
+  void v_tally_cluster(double *, int, int *, double, double *, int, int[][2], double *,
+                       double[][3]);
   void bond_force(int, int, double);
   virtual void stats();
   int bondtype_findset(int, tagint, tagint, int);
@@ -590,6 +590,16 @@ int MPI_Scan(void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI
 
 /* ---------------------------------------------------------------------- */
 
+/* recvbuf is undefined on the first (and only) rank, so leave it alone */
+
+int MPI_Exscan(void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op,
+               MPI_Comm comm)
+{
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
 /* copy values from data1 to data2 */
 
 int MPI_Allgather(void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
@@ -716,3 +726,76 @@ int MPI_Alltoallv(void *sendbuf, int *sendcounts, int *sdispls, MPI_Datatype sen
 }
 
 /* ---------------------------------------------------------------------- */
+
+/* ---------------------------------------------------------------------- */
+/* MPI-IO functions, mapped to stdio of the single process */
+/* ---------------------------------------------------------------------- */
+
+/* existing files are not truncated, same as with MPI-IO */
+
+int MPI_File_open(MPI_Comm comm, const char *filename, int amode, MPI_Info info, MPI_File *fh)
+{
+  FILE *fp;
+
+  if (amode & MPI_MODE_RDONLY) {
+    fp = fopen(filename, "rb");
+  } else {
+    fp = fopen(filename, "r+b");
+    if (!fp && (amode & MPI_MODE_CREATE)) fp = fopen(filename, "w+b");
+  }
+  *fh = (MPI_File) fp;
+  if (!fp) return MPI_ERR_ARG;
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MPI_File_close(MPI_File *fh)
+{
+  if (*fh == MPI_FILE_NULL) return MPI_ERR_ARG;
+  fclose((FILE *) *fh);
+  *fh = MPI_FILE_NULL;
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MPI_File_write_at(MPI_File fh, MPI_Offset offset, const void *buf, int count,
+                      MPI_Datatype datatype, MPI_Status *status)
+{
+  FILE *fp = (FILE *) fh;
+  size_t n = stubtypesize(datatype);
+
+  if (fseek(fp, offset, SEEK_SET)) return MPI_ERR_ARG;
+  if (fwrite(buf, n, count, fp) != (size_t) count) return MPI_ERR_ARG;
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MPI_File_write_at_all(MPI_File fh, MPI_Offset offset, const void *buf, int count,
+                          MPI_Datatype datatype, MPI_Status *status)
+{
+  return MPI_File_write_at(fh, offset, buf, count, datatype, status);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MPI_File_read_at(MPI_File fh, MPI_Offset offset, void *buf, int count, MPI_Datatype datatype,
+                     MPI_Status *status)
+{
+  FILE *fp = (FILE *) fh;
+  size_t n = stubtypesize(datatype);
+
+  if (fseek(fp, offset, SEEK_SET)) return MPI_ERR_ARG;
+  if (fread(buf, n, count, fp) != (size_t) count) return MPI_ERR_ARG;
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MPI_File_read_at_all(MPI_File fh, MPI_Offset offset, void *buf, int count,
+                         MPI_Datatype datatype, MPI_Status *status)
+{
+  return MPI_File_read_at(fh, offset, buf, count, datatype, status);
+}
@@ -37,6 +37,7 @@ ComputePressureUef::ComputePressureUef(LAMMPS *lmp, int narg, char **arg) :
   ext_flags[1] = true;
   ext_flags[2] = true;
   in_fix=false;
+  npartial_scalar = npartial_vector = 0;
 }
 
 /* ----------------------------------------------------------------------
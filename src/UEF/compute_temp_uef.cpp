@@ -30,6 +30,7 @@ ComputeTempUef::ComputeTempUef(LAMMPS *lmp, int narg, char **arg) :
   ComputeTemp(lmp, narg, arg)
 {
   rot_flag=true;
+  npartial_vector = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -103,8 +103,9 @@ Atom::Atom(LAMMPS *_lmp) : Pointers(_lmp), atom_style(nullptr), avec(nullptr), a
   sortfreq = 1000;
   nextsort = 0;
   userbinsize = 0.0;
+  sortorder = SORT_XYZ;
   maxbin = maxnext = 0;
-  binhead = nullptr;
+  binhead = binrank = nullptr;
   next = permute = nullptr;
 
   // --------------------------------------------------------------------
@@ -301,6 +302,7 @@ Atom::~Atom()
 
   delete[] firstgroupname;
   memory->destroy(binhead);
+  memory->destroy(binrank);
   memory->destroy(next);
   memory->destroy(permute);
 
@@ -386,6 +388,7 @@ void Atom::settings(Atom *old)
   map_style = old->map_style;
   sortfreq = old->sortfreq;
   userbinsize = old->userbinsize;
+  sortorder = old->sortorder;
   if (old->firstgroupname)
     firstgroupname = utils::strdup(old->firstgroupname);
 }
@@ -870,6 +873,13 @@ void Atom::modify_params(int narg, char **arg)
       if ((sortfreq >= 0) && firstgroupname)
         error->all(FLERR, idx, "Atom_modify sort and first options cannot be used together");
       iarg += 3;
+    } else if (strcmp(arg[iarg],"sort/order") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "atom_modify sort/order", error);
+      if (strcmp(arg[iarg+1],"xyz") == 0) sortorder = SORT_XYZ;
+      else if (strcmp(arg[iarg+1],"morton") == 0) sortorder = SORT_MORTON;
+      else if (strcmp(arg[iarg+1],"hilbert") == 0) sortorder = SORT_HILBERT;
+      else error->all(FLERR, iarg + 1, "Illegal atom_modify sort/order argument {}", arg[iarg+1]);
+      iarg += 2;
     } else error->all(FLERR, idx, "Illegal atom_modify command argument: {}", arg[iarg]);
   }
 }
@@ -2369,6 +2379,7 @@ void Atom::sort()
     iy = MIN(iy,nbiny-1);
     iz = MIN(iz,nbinz-1);
     ibin = iz*nbiny*nbinx + iy*nbinx + ix;
+    if (sortorder != SORT_XYZ) ibin = binrank[ibin];
     next[i] = binhead[ibin];
     binhead[ibin] = i;
   }
@@ -2565,11 +2576,95 @@ void Atom::setup_sort_bins()
 
   if (nbins > maxbin) {
     memory->destroy(binhead);
+    memory->destroy(binrank);
     maxbin = nbins;
     memory->create(binhead,maxbin,"atom:binhead");
+    if (sortorder != SORT_XYZ) memory->create(binrank,maxbin,"atom:binrank");
+  } else if (sortorder != SORT_XYZ && !binrank)
+    memory->create(binrank,maxbin,"atom:binrank");
+
+  // rank bins along a Morton or Hilbert curve through the bin grid
+  // bins are visited in rank order when sorting, so atoms close along
+  //   the curve are also close in memory for any shape of the sub-domain
+
+  if (sortorder != SORT_XYZ) {
+    int ndim = (domain->dimension == 3) ? 3 : 2;
+    int nmax = MAX(nbinx,MAX(nbiny,nbinz));
+    int nbits = 1;
+    while ((1 << nbits) < nmax) nbits++;
+
+    // curve keys must fit into 64 bits, coarsen bin grid if needed
+    // bins that share a key keep their x-y-z order
+
+    int shift = MAX(0,nbits - 63/ndim);
+    nbits -= shift;
+
+    std::vector<std::pair<uint64_t,int>> keys(nbins);
+    unsigned int coord[3];
+    int ibin = 0;
+    for (int iz = 0; iz < nbinz; iz++)
+      for (int iy = 0; iy < nbiny; iy++)
+        for (int ix = 0; ix < nbinx; ix++) {
+          coord[0] = ix >> shift;
+          coord[1] = iy >> shift;
+          coord[2] = iz >> shift;
+          keys[ibin].first = curve_key(coord,ndim,nbits,sortorder);
+          keys[ibin].second = ibin;
+          ibin++;
+        }
+
+    std::sort(keys.begin(),keys.end());
+    for (int m = 0; m < nbins; m++) binrank[keys[m].second] = m;
   }
 }
 
+/* ----------------------------------------------------------------------
+   position of grid point coord[] along a Morton or Hilbert curve
+   with nbits per dimension in ndim dimensions, coord[] is overwritten
+   Hilbert index via transposed axes, see J. Skilling, AIP Conf Proc,
+   707, 381 (2004)
+------------------------------------------------------------------------- */
+
+uint64_t Atom::curve_key(unsigned int *coord, int ndim, int nbits, int order)
+{
+  int i;
+
+  if (order == SORT_HILBERT) {
+    unsigned int p, q, t;
+    unsigned int m = 1U << (nbits - 1);
+
+    // inverse undo of excess work
+
+    for (q = m; q > 1; q >>= 1) {
+      p = q - 1;
+      for (i = 0; i < ndim; i++) {
+        if (coord[i] & q) coord[0] ^= p;
+        else {
+          t = (coord[0] ^ coord[i]) & p;
+          coord[0] ^= t;
+          coord[i] ^= t;
+        }
+      }
+    }
+
+    // Gray encode
+
+    for (i = 1; i < ndim; i++) coord[i] ^= coord[i-1];
+    t = 0;
+    for (q = m; q > 1; q >>= 1)
+      if (coord[ndim-1] & q) t ^= q - 1;
+    for (i = 0; i < ndim; i++) coord[i] ^= t;
+  }
+
+  // interleave bits, most significant first
+
+  uint64_t key = 0;
+  for (int b = nbits - 1; b >= 0; b--)
+    for (i = 0; i < ndim; i++)
+      key = (key << 1) | ((coord[i] >> b) & 1U);
+  return key;
+}
+
 /* ----------------------------------------------------------------------
    register a callback to a fix so it can manage atom-based arrays
    happens when fix is created
@@ -36,6 +36,7 @@ class Atom : protected Pointers {
   enum { ATOM = 0, BOND = 1, ANGLE = 2, DIHEDRAL = 3, IMPROPER = 4 };
   enum { NUMERIC = 0, LABELS = 1 };
   enum { MAP_NONE = 0, MAP_ARRAY = 1, MAP_HASH = 2, MAP_YES = 3 };
+  enum { SORT_XYZ = 0, SORT_MORTON = 1, SORT_HILBERT = 2 };
 
   // atom counts
 
@@ -292,6 +293,7 @@ class Atom : protected Pointers {
   int sortfreq;          // sort atoms every this many steps, 0 = off
   bigint nextsort;       // next timestep to sort on
   double userbinsize;    // requested sort bin size
+  int sortorder;         // order of sort bins: SORT_XYZ, SORT_MORTON, SORT_HILBERT
 
   // indices of atoms with same ID
 
@@ -439,6 +441,7 @@ class Atom : protected Pointers {
   int maxbin;                          // max # of bins
   int maxnext;                         // max size of next,permute
   int *binhead;                        // 1st atom in each bin
+  int *binrank;                        // position of each bin along space-filling curve
   int *next;                           // next atom in bin
   int *permute;                        // permutation vector
   double bininvx, bininvy, bininvz;    // inverse actual bin sizes
@@ -446,6 +449,7 @@ class Atom : protected Pointers {
 
   void set_atomflag_defaults();
   void setup_sort_bins();
+  static uint64_t curve_key(unsigned int *, int, int, int);
   int next_prime(int);
 };
 
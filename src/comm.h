@@ -49,6 +49,8 @@ class Comm : protected Pointers {
 
   int nthreads;    // OpenMP threads per MPI process
 
+  int overlap;    // 1 if forward comm may overlap pair computation
+
   // public settings specific to layout = UNIFORM, NONUNIFORM
 
   int procgrid[3];                     // proc count assigned to each dim of 3d grid
@@ -85,6 +87,12 @@ class Comm : protected Pointers {
   virtual void exchange() = 0;                     // move atoms to new procs
   virtual void borders() = 0;                      // setup list of atoms to comm
 
+  // split forward comm of atom coords, only owned coords may be used in between
+  // default is to do the whole forward comm at once
+
+  virtual void forward_comm_begin() { forward_comm(); }
+  virtual void forward_comm_end() {}
+
   // forward/reverse comm from a Pair, Bond, Fix, Compute, Dump
 
   virtual void forward_comm(class Pair *, int size = 0) = 0;
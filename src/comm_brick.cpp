@@ -29,6 +29,7 @@
 #include "memory.h"
 #include "neighbor.h"
 #include "pair.h"
+#include "timer.h"
 
 #include <cmath>
 #include <cstring>
@@ -48,7 +49,8 @@ CommBrick::CommBrick(LAMMPS *lmp) :
   slablo(nullptr), slabhi(nullptr), multilo(nullptr), multihi(nullptr),
   multioldlo(nullptr), multioldhi(nullptr), cutghostmulti(nullptr), cutghostmultiold(nullptr),
   pbc_flag(nullptr), pbc(nullptr), firstrecv(nullptr), sendlist(nullptr),
-  localsendlist(nullptr), maxsendlist(nullptr), buf_send(nullptr), buf_recv(nullptr)
+  localsendlist(nullptr), maxsendlist(nullptr), buf_send(nullptr), buf_recv(nullptr),
+  buf_overlap(nullptr), requests(nullptr)
 {
   style = Comm::BRICK;
   layout = Comm::LAYOUT_UNIFORM;
@@ -78,6 +80,8 @@ CommBrick::~CommBrick()
 
   memory->destroy(buf_send);
   memory->destroy(buf_recv);
+  memory->destroy(buf_overlap);
+  memory->sfree(requests);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -115,6 +119,11 @@ void CommBrick::init_buffers()
   CommBrick::grow_send(maxsend,2);
   memory->create(buf_recv,maxrecv,"comm:buf_recv");
 
+  buf_overlap = nullptr;
+  requests = nullptr;
+  maxoverlap = nrequest = maxrequest = 0;
+  noverlap = nbegin = 0;
+
   nswap = 0;
   maxswap = 6;
   CommBrick::allocate_swap(maxswap);
@@ -550,6 +559,7 @@ void CommBrick::forward_comm(int /*dummy*/)
   // if comm_x_only set, exchange or copy directly to x, don't unpack
 
   for (int iswap = 0; iswap < nswap; iswap++) {
+    timer->trace_begin("forward_comm","comm","swap",iswap);
     if (sendproc[iswap] != me) {
       if (comm_x_only) {
         if (size_forward_recv[iswap]) {
@@ -589,6 +599,98 @@ void CommBrick::forward_comm(int /*dummy*/)
         avec->unpack_comm(recvnum[iswap],firstrecv[iswap],buf_send);
       }
     }
+    timer->trace_end();
+  }
+}
+
+/* ----------------------------------------------------------------------
+   start forward communication of atom coords
+   swaps that only send owned atoms are posted as non-blocking messages,
+     so their ghost coords can arrive while pairs of owned atoms are computed
+   only possible if coords are exchanged directly, else do full forward comm
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_begin()
+{
+  int iswap,n,offset;
+  AtomVec *avec = atom->avec;
+  double **x = atom->x;
+
+  if (!comm_x_only) {
+    forward_comm();
+    nbegin = nswap;
+    return;
+  }
+
+  // one send buffer section per started swap, since messages are pending
+
+  n = 0;
+  for (iswap = 0; iswap < noverlap; iswap++)
+    if (sendproc[iswap] != me) n += size_forward*sendnum[iswap];
+  if (n > maxoverlap) {
+    maxoverlap = n;
+    memory->destroy(buf_overlap);
+    memory->create(buf_overlap,maxoverlap,"comm:buf_overlap");
+  }
+  if (2*noverlap > maxrequest) {
+    maxrequest = 2*noverlap;
+    requests = (MPI_Request *)
+      memory->srealloc(requests,maxrequest*sizeof(MPI_Request),"comm:requests");
+  }
+
+  // same message tag as forward_comm(), so swaps match with procs
+  //   that start fewer swaps, messages arrive in order of the swaps
+
+  nrequest = 0;
+  offset = 0;
+  for (iswap = 0; iswap < noverlap; iswap++) {
+    if (sendproc[iswap] != me) {
+      if (size_forward_recv[iswap])
+        MPI_Irecv(x[firstrecv[iswap]],size_forward_recv[iswap],MPI_DOUBLE,
+                  recvproc[iswap],0,world,&requests[nrequest++]);
+      n = avec->pack_comm(sendnum[iswap],sendlist[iswap],&buf_overlap[offset],
+                          pbc_flag[iswap],pbc[iswap]);
+      if (n) MPI_Isend(&buf_overlap[offset],n,MPI_DOUBLE,sendproc[iswap],0,world,
+                       &requests[nrequest++]);
+      offset += n;
+    } else if (sendnum[iswap])
+      avec->pack_comm(sendnum[iswap],sendlist[iswap],x[firstrecv[iswap]],
+                      pbc_flag[iswap],pbc[iswap]);
+  }
+  nbegin = noverlap;
+}
+
+/* ----------------------------------------------------------------------
+   complete forward communication started by forward_comm_begin()
+   wait for pending messages, then do remaining swaps which forward
+     ghost atoms received in earlier swaps
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_end()
+{
+  int n;
+  MPI_Request request;
+  AtomVec *avec = atom->avec;
+  double **x = atom->x;
+  double *buf;
+
+  if (nrequest) MPI_Waitall(nrequest,requests,MPI_STATUSES_IGNORE);
+  nrequest = 0;
+
+  for (int iswap = nbegin; iswap < nswap; iswap++) {
+    timer->trace_begin("forward_comm","comm","swap",iswap);
+    if (sendproc[iswap] != me) {
+      if (size_forward_recv[iswap]) {
+        buf = x[firstrecv[iswap]];
+        MPI_Irecv(buf,size_forward_recv[iswap],MPI_DOUBLE,recvproc[iswap],0,world,&request);
+      }
+      n = avec->pack_comm(sendnum[iswap],sendlist[iswap],buf_send,pbc_flag[iswap],pbc[iswap]);
+      if (n) MPI_Send(buf_send,n,MPI_DOUBLE,sendproc[iswap],0,world);
+      if (size_forward_recv[iswap]) MPI_Wait(&request,MPI_STATUS_IGNORE);
+    } else if (sendnum[iswap])
+      avec->pack_comm(sendnum[iswap],sendlist[iswap],x[firstrecv[iswap]],
+                      pbc_flag[iswap],pbc[iswap]);
+    timer->trace_end();
   }
 }
 
@@ -610,6 +712,7 @@ void CommBrick::reverse_comm()
   // if comm_f_only set, exchange or copy directly from f, don't pack
 
   for (int iswap = nswap-1; iswap >= 0; iswap--) {
+    timer->trace_begin("reverse_comm","comm","swap",iswap);
     if (sendproc[iswap] != me) {
       if (comm_f_only) {
         if (size_reverse_recv[iswap])
@@ -637,6 +740,7 @@ void CommBrick::reverse_comm()
         avec->unpack_reverse(sendnum[iswap],sendlist[iswap],buf_send);
       }
     }
+    timer->trace_end();
   }
 }
 
@@ -696,6 +800,7 @@ void CommBrick::exchange()
   int dimension = domain->dimension;
 
   for (int dim = 0; dim < dimension; dim++) {
+    timer->trace_begin("exchange","comm","dim",dim);
 
     // fill buffer with atoms leaving my box, using < and >=
     // when atom is deleted, fill it in with last atom
@@ -757,6 +862,7 @@ void CommBrick::exchange()
       if (value >= lo && value < hi) m += avec->unpack_exchange(&buf_recv[m]);
       else m += static_cast<int> (buf_recv[m]);
     }
+    timer->trace_end();
   }
 
   if (atom->firstgroupname) atom->first_reorder();
@@ -791,11 +897,13 @@ void CommBrick::borders()
 
   iswap = 0;
   smax = rmax = 0;
+  noverlap = 0;
 
   for (dim = 0; dim < 3; dim++) {
     nlast = 0;
     twoneed = 2*maxneed[dim];
     for (ineed = 0; ineed < twoneed; ineed++) {
+      timer->trace_begin("borders","comm","swap",iswap);
 
       // find atoms within slab boundaries lo/hi using <= and >=
       // check atoms between nfirst and nlast
@@ -910,6 +1018,12 @@ void CommBrick::borders()
         }
       }
 
+      // count leading swaps which only send owned atoms
+      // sendlist is in ascending order, so last atom is the largest index
+
+      if (noverlap == iswap && (nsend == 0 || sendlist[iswap][nsend-1] < atom->nlocal))
+        noverlap++;
+
       // pack up list of border atoms
 
       if (nsend*size_border > maxsend) grow_send(nsend*size_border,0);
@@ -959,6 +1073,7 @@ void CommBrick::borders()
       if (neighbor->style == Neighbor::MULTI) neighbor->build_collection(nprior);
 
       iswap++;
+      timer->trace_end();
     }
   }
 
@@ -1695,5 +1810,6 @@ double CommBrick::memory_usage()
     bytes += memory->usage(sendlist[i],maxsendlist[i]);
   bytes += memory->usage(buf_send,maxsend+bufextra);
   bytes += memory->usage(buf_recv,maxrecv);
+  bytes += memory->usage(buf_overlap,maxoverlap);
   return bytes;
 }
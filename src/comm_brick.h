@@ -31,6 +31,8 @@ class CommBrick : public Comm {
   void reverse_comm() override;                 // reverse comm of forces
   void exchange() override;                     // move atoms to new procs
   void borders() override;                      // setup list of atoms to comm
+  void forward_comm_begin() override;           // start forward comm of atom coords
+  void forward_comm_end() override;             // finish forward comm of atom coords
 
   void forward_comm(class Pair *, int size = 0) override;     // forward comm from a Pair
   void reverse_comm(class Pair *, int size = 0) override;     // reverse comm from a Pair
@@ -77,6 +79,13 @@ class CommBrick : public Comm {
   int maxsend, maxrecv;    // current size of send/recv buffer
   int smax, rmax;          // max size in atoms of single borders send/recv
 
+  int noverlap;                // # of leading swaps that only send owned atoms
+  int nbegin;                  // # of swaps done or started by forward_comm_begin()
+  double *buf_overlap;         // send buffer for swaps started by forward_comm_begin()
+  int maxoverlap;              // current size of overlap send buffer
+  MPI_Request *requests;       // pending requests of forward_comm_begin()
+  int nrequest, maxrequest;    // # of pending requests, size of requests
+
   // NOTE: init_buffers is called from a constructor and must not be made virtual
   void init_buffers();
 
@@ -74,6 +74,7 @@ Compute::Compute(LAMMPS *lmp, int narg, char **arg) :
   comm_forward = comm_reverse = 0;
   dynamic = 0;
   dynamic_group_allow = 1;
+  npartial_scalar = npartial_vector = 0;
 
   initialized_flag = 0;
   invoked_scalar = invoked_vector = invoked_array = -1;
@@ -103,6 +103,9 @@ class Compute : protected Pointers {
   int comm_reverse;           // size of reverse communication (0 if none)
   int dynamic_group_allow;    // 1 if can be used with dynamic group, else 0
 
+  int npartial_scalar;    // # of per-proc partial sums of compute_scalar(), 0 if not split
+  int npartial_vector;    // ditto for compute_vector()
+
   // KOKKOS host/device flag and data masks
 
   ExecutionSpace execution_space;
@@ -129,6 +132,14 @@ class Compute : protected Pointers {
   virtual void compute_pergrid() {}
   virtual void set_arrays(int) {}
 
+  // compute_scalar()/compute_vector() split into per-proc partial sums
+  // and their completion from the global sums, see Modify::reduce_computes()
+
+  virtual void partial_scalar(double *) {}
+  virtual void finish_scalar(double *) {}
+  virtual void partial_vector(double *) {}
+  virtual void finish_vector(double *) {}
+
   virtual int pack_forward_comm(int, int *, double *, int, int *) { return 0; }
   virtual void unpack_forward_comm(int, int, double *) {}
   virtual int pack_reverse_comm(int, int, double *) { return 0; }
@@ -28,6 +28,7 @@ ComputeKE::ComputeKE(LAMMPS *lmp, int narg, char **arg) : Compute(lmp, narg, arg
 
   scalar_flag = 1;
   extscalar = 1;
+  npartial_scalar = 1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -41,8 +42,17 @@ void ComputeKE::init()
 
 double ComputeKE::compute_scalar()
 {
-  invoked_scalar = update->ntimestep;
+  double ke;
+  partial_scalar(&ke);
+  MPI_Allreduce(&ke, &scalar, 1, MPI_DOUBLE, MPI_SUM, world);
+  finish_scalar(&scalar);
+  return scalar;
+}
 
+/* ---------------------------------------------------------------------- */
+
+void ComputeKE::partial_scalar(double *one)
+{
   double **v = atom->v;
   double *rmass = atom->rmass;
   double *mass = atom->mass;
@@ -62,7 +72,13 @@ double ComputeKE::compute_scalar()
         ke += mass[type[i]] * (v[i][0] * v[i][0] + v[i][1] * v[i][1] + v[i][2] * v[i][2]);
   }
 
-  MPI_Allreduce(&ke, &scalar, 1, MPI_DOUBLE, MPI_SUM, world);
-  scalar *= pfactor;
-  return scalar;
+  one[0] = ke;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeKE::finish_scalar(double *all)
+{
+  invoked_scalar = update->ntimestep;
+  scalar = all[0] * pfactor;
 }
@@ -29,6 +29,8 @@ class ComputeKE : public Compute {
   ComputeKE(class LAMMPS *, int, char **);
   void init() override;
   double compute_scalar() override;
+  void partial_scalar(double *) override;
+  void finish_scalar(double *) override;
 
  private:
   double pfactor;
@@ -42,6 +42,7 @@ ComputePE::ComputePE(LAMMPS *lmp, int narg, char **arg) : Compute(lmp, narg, arg
   extscalar = 1;
   peflag = 1;
   timeflag = 1;
+  npartial_scalar = 1;
 
   if (narg == 3) {
     pairflag = 1;
@@ -83,8 +84,20 @@ ComputePE::ComputePE(LAMMPS *lmp, int narg, char **arg) : Compute(lmp, narg, arg
 
 double ComputePE::compute_scalar()
 {
-  invoked_scalar = update->ntimestep;
-  if (update->eflag_global != invoked_scalar)
+  double one;
+  partial_scalar(&one);
+  MPI_Allreduce(&one, &scalar, 1, MPI_DOUBLE, MPI_SUM, world);
+  finish_scalar(&scalar);
+  return scalar;
+}
+
+/* ----------------------------------------------------------------------
+   per-proc energies tallied by force styles
+------------------------------------------------------------------------- */
+
+void ComputePE::partial_scalar(double *partial)
+{
+  if (update->eflag_global != update->ntimestep)
     error->all(FLERR, Error::NOLASTLINE, "Energy was not tallied on needed timestep{}", utils::errorurl(22));
 
   double one = 0.0;
@@ -97,7 +110,17 @@ double ComputePE::compute_scalar()
     if (improperflag && force->improper) one += force->improper->energy;
   }
 
-  MPI_Allreduce(&one, &scalar, 1, MPI_DOUBLE, MPI_SUM, world);
+  partial[0] = one;
+}
+
+/* ----------------------------------------------------------------------
+   add contributions that are already global
+------------------------------------------------------------------------- */
+
+void ComputePE::finish_scalar(double *all)
+{
+  invoked_scalar = update->ntimestep;
+  scalar = all[0];
 
   if (kspaceflag && force->kspace) scalar += force->kspace->energy;
 
@@ -107,6 +130,4 @@ double ComputePE::compute_scalar()
   }
 
   if (fixflag && modify->n_energy_global) scalar += modify->energy_global();
-
-  return scalar;
 }
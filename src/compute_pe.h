@@ -29,6 +29,8 @@ class ComputePE : public Compute {
   ComputePE(class LAMMPS *, int, char **);
   void init() override {}
   double compute_scalar() override;
+  void partial_scalar(double *) override;
+  void finish_scalar(double *) override;
 
  private:
   int pairflag, bondflag, angleflag, dihedralflag, improperflag, kspaceflag, fixflag;
@@ -48,6 +48,8 @@ ComputePressure::ComputePressure(LAMMPS *lmp, int narg, char **arg) :
   extvector = 0;
   pressflag = 1;
   timeflag = 1;
+  npartial_scalar = domain->dimension;
+  npartial_vector = (domain->dimension == 3) ? 6 : 4;
 
   // store temperature ID used by pressure computation
   // ensure it is valid for temperature computation
@@ -237,11 +239,45 @@ void ComputePressure::init()
 
 double ComputePressure::compute_scalar()
 {
-  invoked_scalar = update->ntimestep;
-  if (update->vflag_global != invoked_scalar)
+  double v[3], vall[3];
+  partial_scalar(v);
+  MPI_Allreduce(v, vall, npartial_scalar, MPI_DOUBLE, MPI_SUM, world);
+  finish_scalar(vall);
+  return scalar;
+}
+
+/* ----------------------------------------------------------------------
+   compute pressure tensor
+   assume KE tensor has already been computed
+------------------------------------------------------------------------- */
+
+void ComputePressure::compute_vector()
+{
+  double v[6], vall[6];
+  partial_vector(v);
+  MPI_Allreduce(v, vall, npartial_vector, MPI_DOUBLE, MPI_SUM, world);
+  finish_vector(vall);
+}
+
+/* ----------------------------------------------------------------------
+   per-proc diagonal virial components
+------------------------------------------------------------------------- */
+
+void ComputePressure::partial_scalar(double *v)
+{
+  if (update->vflag_global != update->ntimestep)
     error->all(FLERR, Error::NOLASTLINE, "Virial was not tallied on needed timestep"
                + utils::errorurl(22));
 
+  virial_partial(v, dimension);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputePressure::finish_scalar(double *vall)
+{
+  invoked_scalar = update->ntimestep;
+
   // invoke temperature if it hasn't been already
 
   if (keflag) {
@@ -249,9 +285,11 @@ double ComputePressure::compute_scalar()
       temperature->compute_scalar();
   }
 
+  for (int i = 0; i < dimension; i++) virial[i] = vall[i];
+
   if (dimension == 3) {
     inv_volume = 1.0 / (domain->xprd * domain->yprd * domain->zprd);
-    virial_compute(3,3);
+    virial_finish(3,3);
     if (keflag)
       scalar = (temperature->dof * boltz * temperature->scalar +
                 virial[0] + virial[1] + virial[2]) / 3.0 * inv_volume * nktv2p;
@@ -259,26 +297,22 @@ double ComputePressure::compute_scalar()
       scalar = (virial[0] + virial[1] + virial[2]) / 3.0 * inv_volume * nktv2p;
   } else {
     inv_volume = 1.0 / (domain->xprd * domain->yprd);
-    virial_compute(2,2);
+    virial_finish(2,2);
     if (keflag)
       scalar = (temperature->dof * boltz * temperature->scalar +
                 virial[0] + virial[1]) / 2.0 * inv_volume * nktv2p;
     else
       scalar = (virial[0] + virial[1]) / 2.0 * inv_volume * nktv2p;
   }
-
-  return scalar;
 }
 
 /* ----------------------------------------------------------------------
-   compute pressure tensor
-   assume KE tensor has already been computed
+   per-proc virial tensor
 ------------------------------------------------------------------------- */
 
-void ComputePressure::compute_vector()
+void ComputePressure::partial_vector(double *v)
 {
-  invoked_vector = update->ntimestep;
-  if (update->vflag_global != invoked_vector)
+  if (update->vflag_global != update->ntimestep)
     error->all(FLERR, Error::NOLASTLINE,
                "Virial was not tallied on needed timestep" + utils::errorurl(22));
 
@@ -286,6 +320,15 @@ void ComputePressure::compute_vector()
     error->all(FLERR, Error::NOLASTLINE, "Must use 'kspace_modify pressure/scalar no' for "
                "tensor components with kspace_style msm");
 
+  virial_partial(v, npartial_vector);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputePressure::finish_vector(double *vall)
+{
+  invoked_vector = update->ntimestep;
+
   // invoke temperature if it hasn't been already
 
   double *ke_tensor;
@@ -295,9 +338,11 @@ void ComputePressure::compute_vector()
     ke_tensor = temperature->vector;
   }
 
+  for (int i = 0; i < npartial_vector; i++) virial[i] = vall[i];
+
   if (dimension == 3) {
     inv_volume = 1.0 / (domain->xprd * domain->yprd * domain->zprd);
-    virial_compute(6,3);
+    virial_finish(6,3);
     if (keflag) {
       for (int i = 0; i < 6; i++)
         vector[i] = (ke_tensor[i] + virial[i]) * inv_volume * nktv2p;
@@ -306,7 +351,7 @@ void ComputePressure::compute_vector()
         vector[i] = virial[i] * inv_volume * nktv2p;
   } else {
     inv_volume = 1.0 / (domain->xprd * domain->yprd);
-    virial_compute(4,2);
+    virial_finish(4,2);
     if (keflag) {
       vector[0] = (ke_tensor[0] + virial[0]) * inv_volume * nktv2p;
       vector[1] = (ke_tensor[1] + virial[1]) * inv_volume * nktv2p;
@@ -324,22 +369,42 @@ void ComputePressure::compute_vector()
 /* ---------------------------------------------------------------------- */
 
 void ComputePressure::virial_compute(int n, int ndiag)
+{
+  double v[6];
+
+  virial_partial(v,n);
+
+  // sum virial across procs
+
+  MPI_Allreduce(v,virial,n,MPI_DOUBLE,MPI_SUM,world);
+
+  virial_finish(n,ndiag);
+}
+
+/* ----------------------------------------------------------------------
+   sum contributions to virial from forces and fixes on this proc
+------------------------------------------------------------------------- */
+
+void ComputePressure::virial_partial(double *v, int n)
 {
   int i,j;
-  double v[6],*vcomponent;
+  double *vcomponent;
 
   for (i = 0; i < n; i++) v[i] = 0.0;
 
-  // sum contributions to virial from forces and fixes
-
   for (j = 0; j < nvirial; j++) {
     vcomponent = vptr[j];
     for (i = 0; i < n; i++) v[i] += vcomponent[i];
   }
+}
 
-  // sum virial across procs
+/* ----------------------------------------------------------------------
+   add contributions to summed virial that are already global
+------------------------------------------------------------------------- */
 
-  MPI_Allreduce(v,virial,n,MPI_DOUBLE,MPI_SUM,world);
+void ComputePressure::virial_finish(int n, int ndiag)
+{
+  int i;
 
   // KSpace virial contribution is already summed across procs
 
@@ -33,6 +33,11 @@ class ComputePressure : public Compute {
   void compute_vector() override;
   void reset_extra_compute_fix(const char *) override;
 
+  void partial_scalar(double *) override;
+  void finish_scalar(double *) override;
+  void partial_vector(double *) override;
+  void finish_vector(double *) override;
+
  protected:
   double boltz, nktv2p, inv_volume;
   int nvirial, dimension;
@@ -47,6 +52,8 @@ class ComputePressure : public Compute {
   int fixflag, kspaceflag;
 
   void virial_compute(int, int);
+  void virial_partial(double *, int);
+  void virial_finish(int, int);
 
  private:
   char *pstyle;
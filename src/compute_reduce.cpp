@@ -371,6 +371,13 @@ ComputeReduce::ComputeReduce(LAMMPS *lmp, int narg, char **arg) :
     owner = new int[size_vector];
   }
 
+  // plain sums can be combined with other global reductions
+
+  if (mode == SUM || mode == SUMSQ || mode == SUMABS) {
+    if (nvalues == 1) npartial_scalar = 1;
+    else npartial_vector = nvalues;
+  }
+
   maxatom = 0;
   varatom = nullptr;
 }
@@ -457,9 +464,8 @@ void ComputeReduce::compute_vector()
       indices[m] = index;
     }
 
-  if (mode == SUM || mode == SUMSQ || mode == AVEABS) {
-    for (int m = 0; m < nvalues; m++)
-      MPI_Allreduce(&onevec[m], &vector[m], 1, MPI_DOUBLE, MPI_SUM, world);
+  if (mode == SUM || mode == SUMSQ || mode == SUMABS) {
+    MPI_Allreduce(onevec, vector, nvalues, MPI_DOUBLE, MPI_SUM, world);
   } else if (mode == MINABS || mode == MAXABS) {
     for (int m = 0; m < nvalues; m++)
       MPI_Allreduce(&onevec[m], &vector[m], 1, MPI_DOUBLE, this->scalar_reduction_operation, world);
@@ -507,14 +513,46 @@ void ComputeReduce::compute_vector()
     }
 
   } else if (mode == AVE || mode == AVESQ || mode == AVEABS) {
+    MPI_Allreduce(onevec, vector, nvalues, MPI_DOUBLE, MPI_SUM, world);
     for (int m = 0; m < nvalues; m++) {
-      MPI_Allreduce(&onevec[m], &vector[m], 1, MPI_DOUBLE, MPI_SUM, world);
       bigint n = count(m);
       if (n) vector[m] /= n;
     }
   }
 }
 
+/* ----------------------------------------------------------------------
+   per-proc sums for modes that only add values
+------------------------------------------------------------------------- */
+
+void ComputeReduce::partial_scalar(double *one)
+{
+  one[0] = compute_one(0, -1);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeReduce::finish_scalar(double *all)
+{
+  invoked_scalar = update->ntimestep;
+  scalar = all[0];
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeReduce::partial_vector(double *one)
+{
+  for (int m = 0; m < nvalues; m++) one[m] = compute_one(m, -1);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeReduce::finish_vector(double *all)
+{
+  invoked_vector = update->ntimestep;
+  for (int m = 0; m < nvalues; m++) vector[m] = all[m];
+}
+
 /* ----------------------------------------------------------------------
    calculate reduced value for one input M and return it
    if flag = -1:
@@ -34,6 +34,10 @@ class ComputeReduce : public Compute {
   void init() override;
   double compute_scalar() override;
   void compute_vector() override;
+  void partial_scalar(double *) override;
+  void finish_scalar(double *) override;
+  void partial_vector(double *) override;
+  void finish_vector(double *) override;
   double memory_usage() override;
 
  protected:
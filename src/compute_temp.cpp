@@ -33,6 +33,8 @@ ComputeTemp::ComputeTemp(LAMMPS *lmp, int narg, char **arg) : Compute(lmp, narg,
   extscalar = 0;
   extvector = 1;
   tempflag = 1;
+  npartial_scalar = 1;
+  npartial_vector = 6;
 
   vector = new double[size_vector];
 }
@@ -71,8 +73,29 @@ void ComputeTemp::dof_compute()
 
 double ComputeTemp::compute_scalar()
 {
-  invoked_scalar = update->ntimestep;
+  double t, tall;
+  partial_scalar(&t);
+  MPI_Allreduce(&t, &tall, 1, MPI_DOUBLE, MPI_SUM, world);
+  finish_scalar(&tall);
+  return scalar;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeTemp::compute_vector()
+{
+  double t[6], tall[6];
+  partial_vector(t);
+  MPI_Allreduce(t, tall, 6, MPI_DOUBLE, MPI_SUM, world);
+  finish_vector(tall);
+}
 
+/* ----------------------------------------------------------------------
+   sum of m v^2 over owned atoms in group
+------------------------------------------------------------------------- */
+
+void ComputeTemp::partial_scalar(double *one)
+{
   double **v = atom->v;
   double *mass = atom->mass;
   double *rmass = atom->rmass;
@@ -92,22 +115,30 @@ double ComputeTemp::compute_scalar()
         t += (v[i][0] * v[i][0] + v[i][1] * v[i][1] + v[i][2] * v[i][2]) * mass[type[i]];
   }
 
-  MPI_Allreduce(&t, &scalar, 1, MPI_DOUBLE, MPI_SUM, world);
+  one[0] = t;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeTemp::finish_scalar(double *all)
+{
+  invoked_scalar = update->ntimestep;
+
+  scalar = all[0];
   if (dynamic) dof_compute();
   if (dof < 0.0 && natoms_temp > 0.0)
     error->all(FLERR, "Temperature compute degrees of freedom < 0");
   scalar *= tfactor;
-  return scalar;
 }
 
-/* ---------------------------------------------------------------------- */
+/* ----------------------------------------------------------------------
+   sum of m v_i v_j over owned atoms in group
+------------------------------------------------------------------------- */
 
-void ComputeTemp::compute_vector()
+void ComputeTemp::partial_vector(double *t)
 {
   int i;
 
-  invoked_vector = update->ntimestep;
-
   double **v = atom->v;
   double *mass = atom->mass;
   double *rmass = atom->rmass;
@@ -115,7 +146,7 @@ void ComputeTemp::compute_vector()
   int *mask = atom->mask;
   int nlocal = atom->nlocal;
 
-  double massone, t[6];
+  double massone;
   for (i = 0; i < 6; i++) t[i] = 0.0;
 
   for (i = 0; i < nlocal; i++)
@@ -131,7 +162,13 @@ void ComputeTemp::compute_vector()
       t[4] += massone * v[i][0] * v[i][2];
       t[5] += massone * v[i][1] * v[i][2];
     }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeTemp::finish_vector(double *all)
+{
+  invoked_vector = update->ntimestep;
 
-  MPI_Allreduce(t, vector, 6, MPI_DOUBLE, MPI_SUM, world);
-  for (i = 0; i < 6; i++) vector[i] *= force->mvv2e;
+  for (int i = 0; i < 6; i++) vector[i] = all[i] * force->mvv2e;
 }
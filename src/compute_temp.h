@@ -33,6 +33,11 @@ class ComputeTemp : public Compute {
   double compute_scalar() override;
   void compute_vector() override;
 
+  void partial_scalar(double *) override;
+  void finish_scalar(double *) override;
+  void partial_vector(double *) override;
+  void finish_vector(double *) override;
+
  protected:
   double tfactor;
 
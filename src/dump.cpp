@@ -78,6 +78,9 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
   append_flag = 0;
   buffer_allow = 0;
   buffer_flag = 0;
+  mpiioflag = 0;
+  mpifh = MPI_FILE_NULL;
+  mpioffset = 0;
   padflag = 0;
   pbcflag = 0;
   time_flag = 0;
@@ -183,6 +186,8 @@ Dump::~Dump()
     delete[] nameslist;
   }
 
+  if (mpifh != MPI_FILE_NULL) mpiio_close();
+
   // XTC style sets fp to a null pointer since it closes file in its destructor
 
   if (multifile == 0 && fp != nullptr) {
@@ -221,6 +226,17 @@ void Dump::init()
                      "This may complicate post-processing tasks or visualization", id);
   }
 
+  // MPI-IO output requires one file of formatted strings
+
+  if (mpiioflag) {
+    if (!buffer_allow || !buffer_flag)
+      error->all(FLERR, Error::NOLASTLINE, "Dump {} requires dump_modify buffer yes for MPI-IO", id);
+    if (binary || compressed)
+      error->all(FLERR, Error::NOLASTLINE, "Dump {} cannot use MPI-IO with binary or compressed files", id);
+    if (multiproc)
+      error->all(FLERR, Error::NOLASTLINE, "Dump {} cannot use MPI-IO with one file per processor", id);
+  }
+
   if (sort_flag) {
     if (multiproc > 1)
       error->all(FLERR, Error::NOLASTLINE,
@@ -480,9 +496,14 @@ void Dump::write()
   MPI_Status status;
   MPI_Request request;
 
+  // collective output of sbuf via MPI-IO
+
+  if (mpiioflag) {
+    write_mpiio();
+
   // comm and output buf of doubles
 
-  if (buffer_flag == 0 || binary) {
+  } else if (buffer_flag == 0 || binary) {
     if (filewriter) {
       for (int iproc = 0; iproc < nclusterprocs; iproc++) {
         if (iproc) {
@@ -538,6 +559,7 @@ void Dump::write()
   if (refreshflag) irefresh->refresh();
 
   if (filewriter && fp != nullptr) write_footer();
+  if (mpiioflag) mpiio_write_text();
 
   if (fp && ferror(fp))
     error->one(FLERR, Error::NOLASTLINE, "Error writing dump {}: {}", id, utils::getsyserror());
@@ -551,6 +573,7 @@ void Dump::write()
       if (filewriter && fp != nullptr) fclose(fp);
     }
     fp = nullptr;
+    if (mpiioflag) mpiio_close();
   }
 }
 
@@ -590,10 +613,13 @@ void Dump::openfile()
   }
 
   // each proc with filewriter = 1 opens a file
+  // for MPI-IO, this is a scratch file for the header and footer text
 
   if (filewriter) {
     if (compressed) {
       fp = platform::compressed_write(filecurrent);
+    } else if (mpiioflag) {
+      fp = tmpfile();
     } else if (binary) {
       fp = fopen(filecurrent,"wb");
     } else if (append_flag) {
@@ -607,11 +633,100 @@ void Dump::openfile()
                  filecurrent, utils::getsyserror());
   } else fp = nullptr;
 
+  if (mpiioflag) mpiio_open(filecurrent);
+
   // delete string with timestep replaced
 
   if (multifile) delete[] filecurrent;
 }
 
+/* ----------------------------------------------------------------------
+   all procs open the dump file for MPI-IO output
+   proc 0 first creates or truncates it, or finds its end when appending
+   all writes to the file then use explicit offsets starting at mpioffset
+------------------------------------------------------------------------- */
+
+void Dump::mpiio_open(const char *name)
+{
+  bigint offset = 0;
+  if (me == 0) {
+    FILE *fptmp = fopen(name, append_flag ? "a" : "w");
+    if (fptmp == nullptr)
+      error->one(FLERR, Error::NOLASTLINE, "Cannot open dump file {}:{}", name,
+                 utils::getsyserror());
+    platform::fseek(fptmp, platform::END_OF_FILE);
+    offset = platform::ftell(fptmp);
+    fclose(fptmp);
+  }
+  MPI_Bcast(&offset,1,MPI_LMP_BIGINT,0,world);
+  mpioffset = offset;
+
+  int err = MPI_File_open(world,name,MPI_MODE_WRONLY,MPI_INFO_NULL,&mpifh);
+  if (err != MPI_SUCCESS)
+    error->one(FLERR, Error::NOLASTLINE, "Cannot open dump file {} for MPI-IO", name);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Dump::mpiio_close()
+{
+  MPI_File_close(&mpifh);
+  mpifh = MPI_FILE_NULL;
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 moves the text it wrote to its scratch file, e.g. a header or footer,
+     into the dump file at the current offset via MPI-IO
+   called by all procs, so they all advance the offset
+------------------------------------------------------------------------- */
+
+void Dump::mpiio_write_text()
+{
+  bigint nchars = 0;
+  if (me == 0) {
+    fflush(fp);
+    nchars = platform::ftell(fp);
+    if (nchars > 0) {
+      std::string text(nchars, ' ');
+      rewind(fp);
+      if (fread(&text[0],1,nchars,fp) != (size_t) nchars)
+        error->one(FLERR, Error::NOLASTLINE, "Error reading text of dump {}: {}", id,
+                   utils::getsyserror());
+      rewind(fp);
+      int err = MPI_File_write_at(mpifh,(MPI_Offset) mpioffset,text.data(),(int) nchars,MPI_CHAR,
+                                  MPI_STATUS_IGNORE);
+      if (err != MPI_SUCCESS)
+        error->one(FLERR, Error::NOLASTLINE, "Error writing dump {} via MPI-IO", id);
+    }
+  }
+  MPI_Bcast(&nchars,1,MPI_LMP_BIGINT,0,world);
+  mpioffset += nchars;
+}
+
+/* ----------------------------------------------------------------------
+   all procs write their formatted strings into the dump file with MPI-IO
+   the header is written first, strings are placed after it in proc order,
+     which is also the order of the atoms after a sort
+------------------------------------------------------------------------- */
+
+void Dump::write_mpiio()
+{
+  mpiio_write_text();
+
+  bigint nchars = nsme;
+  bigint nbefore = 0;
+  bigint nall;
+  MPI_Exscan(&nchars,&nbefore,1,MPI_LMP_BIGINT,MPI_SUM,world);
+  if (me == 0) nbefore = 0;
+  MPI_Allreduce(&nchars,&nall,1,MPI_LMP_BIGINT,MPI_SUM,world);
+
+  int err = MPI_File_write_at_all(mpifh,(MPI_Offset) (mpioffset+nbefore),sbuf,nsme,MPI_CHAR,
+                                  MPI_STATUS_IGNORE);
+  if (err != MPI_SUCCESS)
+    error->one(FLERR, Error::NOLASTLINE, "Error writing dump {} via MPI-IO", id);
+  mpioffset += nall;
+}
+
 /* ----------------------------------------------------------------------
    parallel sort of buf across all procs
    changes nme, reorders datums in buf, grows buf if necessary
@@ -1225,6 +1340,17 @@ void Dump::modify_params(int narg, char **arg)
       write_header_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"io") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "dump_modify io", error);
+      int flag = 0;
+      if (strcmp(arg[iarg+1],"mpiio") == 0) flag = 1;
+      else if (strcmp(arg[iarg+1],"serial") == 0) flag = 0;
+      else error->all(FLERR, iarg + 1, "Unknown dump_modify io argument: {}", arg[iarg+1]);
+      if (singlefile_opened && (flag != mpiioflag))
+        error->all(FLERR, iarg + 1, "Cannot change dump_modify io after dump file is opened");
+      mpiioflag = flag;
+      iarg += 2;
+
     } else if (strcmp(arg[iarg],"maxfiles") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "dump_modify maxfiles", error);
       if (!multifile)
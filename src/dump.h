@@ -45,6 +45,7 @@ class Dump : protected Pointers {
   ~Dump() override;
   void init();
   virtual void write();
+  virtual void post_run() {}    // complete pending output at end of run
 
   virtual int pack_forward_comm(int, int *, double *, int, int *) { return 0; }
   virtual void unpack_forward_comm(int, int, double *) {}
@@ -66,6 +67,8 @@ class Dump : protected Pointers {
   int filewriter;          // 1 if this proc writes a file, else 0
   int fileproc;            // ID of proc in my cluster who writes to file
   char *multiname;         // filename with % converted to cluster ID
+  MPI_File mpifh;          // handle of dump file for MPI-IO output
+  bigint mpioffset;        // file offset of next MPI-IO write
   MPI_Comm clustercomm;    // MPI communicator within my cluster of procs
 
   int flush_flag;           // 0 if no flush, 1 if flush every dump
@@ -74,6 +77,7 @@ class Dump : protected Pointers {
   int append_flag;          // 1 if open file in append mode, 0 if not
   int buffer_allow;         // 1 if style allows for buffer_flag, 0 if not
   int buffer_flag;          // 1 if buffer output as one big string, 0 if not
+  int mpiioflag;            // 1 if all procs write strings to one file via MPI-IO
   int padflag;              // timestep padding in filename
   int pbcflag;              // 1 if remap dumped atoms via PBC, 0 if not
   int singlefile_opened;    // 1 = one big file, already opened, else 0
@@ -175,6 +179,10 @@ class Dump : protected Pointers {
   static int bufcompare_reverse(const int, const int, void *);
 #endif
   void balance();
+  void mpiio_open(const char *);
+  void mpiio_close();
+  void mpiio_write_text();
+  void write_mpiio();
 };
 
 }    // namespace LAMMPS_NS
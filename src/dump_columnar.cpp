@@ -0,0 +1,261 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "dump_columnar.h"
+
+#include "domain.h"
+#include "error.h"
+#include "memory.h"
+#include "update.h"
+
+#include <cstring>
+
+#ifdef LAMMPS_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace LAMMPS_NS;
+
+/* ----------------------------------------------------------------------
+   layout of a columnar dump file, all values in native binary format:
+   file header:
+     bigint -strlen(COLUMNAR_MAGIC), COLUMNAR_MAGIC chars, int endian,
+     int revision, int compressed flag,
+     int # of columns, int len + column labels, int len + unit style
+   one frame per snapshot:
+     bigint timestep, bigint natoms, int triclinic, int boundary[6],
+     double box bounds[6], double tilt[3] (triclinic only),
+     char time flag + double time (if flag set), int # of chunks,
+     each chunk = int # of lines, then for each column:
+       bigint # of bytes + column values (zstd frame, if compressed)
+   index after last frame, written at the end of each run and on close:
+     (bigint timestep, bigint frame offset) for each frame,
+     bigint # of frames, bigint offset of index, INDEX_MAGIC chars
+------------------------------------------------------------------------- */
+
+DumpColumnar::DumpColumnar(LAMMPS *lmp, int narg, char **arg) :
+    DumpCustom(lmp, narg, arg), colbuf(nullptr), zbuf(nullptr)
+{
+  if (compressed)
+    error->all(FLERR, "Dump columnar does not write compressed files, use dump_modify compress");
+
+  // columnar files are always binary
+
+  binary = 1;
+  compress_level = 0;
+  maxcol = 0;
+  maxzbuf = 0;
+  index_start = 0;
+  index_end = 0;
+  nindex = -1;
+}
+
+/* ---------------------------------------------------------------------- */
+
+DumpColumnar::~DumpColumnar()
+{
+  if (filewriter && fp) write_index();
+  memory->destroy(colbuf);
+  memory->sfree(zbuf);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpColumnar::init_style()
+{
+  if (append_flag)
+    error->all(FLERR, Error::NOLASTLINE, "Dump columnar does not support dump_modify append");
+  if (!write_header_flag)
+    error->all(FLERR, Error::NOLASTLINE, "Dump columnar requires dump_modify header yes");
+
+  DumpCustom::init_style();
+}
+
+/* ----------------------------------------------------------------------
+   open file and write file header, start a new frame index
+------------------------------------------------------------------------- */
+
+void DumpColumnar::openfile()
+{
+  if (singlefile_opened) return;
+
+  DumpCustom::openfile();
+
+  index_step.clear();
+  index_offset.clear();
+  index_end = 0;
+  nindex = -1;
+  if (!filewriter) return;
+
+  bigint fmtlen = strlen(COLUMNAR_MAGIC);
+  bigint marker = -fmtlen;
+  fwrite(&marker, sizeof(bigint), 1, fp);
+  fwrite(COLUMNAR_MAGIC, sizeof(char), fmtlen, fp);
+  fwrite(&ENDIAN, sizeof(int), 1, fp);
+  fwrite(&COLUMNAR_REVISION, sizeof(int), 1, fp);
+
+  int flag = compress_level ? 1 : 0;
+  fwrite(&flag, sizeof(int), 1, fp);
+  fwrite(&nfield, sizeof(int), 1, fp);
+  int len = strlen(columns);
+  fwrite(&len, sizeof(int), 1, fp);
+  fwrite(columns, sizeof(char), len, fp);
+  len = unit_flag ? strlen(update->unit_style) : 0;
+  fwrite(&len, sizeof(int), 1, fp);
+  fwrite(update->unit_style, sizeof(char), len, fp);
+
+  index_start = platform::ftell(fp);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int DumpColumnar::modify_param(int narg, char **arg)
+{
+  if (strcmp(arg[0], "compress") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR, "dump_modify compress", error);
+    if (utils::is_integer(arg[1]))
+      compress_level = utils::inumeric(FLERR, arg[1], false, lmp);
+    else
+      compress_level = utils::logical(FLERR, arg[1], false, lmp) ? 3 : 0;
+#ifndef LAMMPS_ZSTD
+    if (compress_level)
+      error->all(FLERR, "Dump columnar compression requires LAMMPS built with Zstd support");
+#endif
+    if (singlefile_opened)
+      error->all(FLERR, "Dump_modify compress must be set before dump columnar file is opened");
+    return 2;
+  }
+  return DumpCustom::modify_param(narg, arg);
+}
+
+/* ----------------------------------------------------------------------
+   write frame header at position of previous index, which is overwritten
+   clear the magic chars at the end of a previous index first, so that an
+     incomplete file with a partially overwritten index is not read with it
+------------------------------------------------------------------------- */
+
+void DumpColumnar::write_header(bigint ndump)
+{
+  if (!filewriter) return;
+
+  if (index_end > 0) {
+    const int nmagic = strlen(INDEX_MAGIC);
+    const char zero[16] = {0};
+    platform::fseek(fp, index_end - nmagic);
+    fwrite(zero, sizeof(char), nmagic, fp);
+    index_end = 0;
+  }
+
+  platform::fseek(fp, index_start);
+  index_step.push_back(update->ntimestep);
+  index_offset.push_back(index_start);
+
+  fwrite(&update->ntimestep, sizeof(bigint), 1, fp);
+  fwrite(&ndump, sizeof(bigint), 1, fp);
+  fwrite(&domain->triclinic, sizeof(int), 1, fp);
+  fwrite(&domain->boundary[0][0], 6 * sizeof(int), 1, fp);
+
+  double box[9] = {boxxlo, boxxhi, boxylo, boxyhi, boxzlo, boxzhi, boxxy, boxxz, boxyz};
+  fwrite(box, sizeof(double), domain->triclinic ? 9 : 6, fp);
+
+  char flag = time_flag ? 1 : 0;
+  fwrite(&flag, sizeof(char), 1, fp);
+  if (time_flag) {
+    double t = compute_time();
+    fwrite(&t, sizeof(double), 1, fp);
+  }
+
+  fwrite(&nclusterprocs, sizeof(int), 1, fp);
+}
+
+/* ----------------------------------------------------------------------
+   write one chunk of N lines as one block per column
+------------------------------------------------------------------------- */
+
+void DumpColumnar::write_data(int n, double *mybuf)
+{
+  fwrite(&n, sizeof(int), 1, fp);
+  if (n > maxcol) {
+    maxcol = n;
+    memory->destroy(colbuf);
+    memory->create(colbuf, maxcol, "dump:colbuf");
+  }
+
+  for (int j = 0; j < nfield; j++) {
+    for (int i = 0; i < n; i++) colbuf[i] = mybuf[i * size_one + j];
+
+    bigint nbytes = (bigint) n * sizeof(double);
+    const void *block = colbuf;
+
+#ifdef LAMMPS_ZSTD
+    if (compress_level) {
+      size_t bound = ZSTD_compressBound(nbytes);
+      if (bound > maxzbuf) {
+        maxzbuf = bound;
+        zbuf = (char *) memory->srealloc(zbuf, maxzbuf, "dump:zbuf");
+      }
+      size_t zbytes = ZSTD_compress(zbuf, maxzbuf, colbuf, nbytes, compress_level);
+      if (ZSTD_isError(zbytes))
+        error->one(FLERR, "Dump columnar compression failed: {}", ZSTD_getErrorName(zbytes));
+      nbytes = zbytes;
+      block = zbuf;
+    }
+#endif
+
+    fwrite(&nbytes, sizeof(bigint), 1, fp);
+    fwrite(block, sizeof(char), nbytes, fp);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   the index is written at the end of the run, or after the frame
+     for one file per snapshot, since the file is closed after it
+------------------------------------------------------------------------- */
+
+void DumpColumnar::write_footer()
+{
+  index_start = platform::ftell(fp);
+  if (multifile)
+    write_index();
+  else if (flush_flag)
+    fflush(fp);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpColumnar::post_run()
+{
+  if (filewriter && fp) write_index();
+}
+
+/* ----------------------------------------------------------------------
+   write index of all frames after the last frame, unless already written
+------------------------------------------------------------------------- */
+
+void DumpColumnar::write_index()
+{
+  bigint nframes = index_step.size();
+  if (nframes == nindex) return;
+
+  platform::fseek(fp, index_start);
+  for (bigint i = 0; i < nframes; i++) {
+    fwrite(&index_step[i], sizeof(bigint), 1, fp);
+    fwrite(&index_offset[i], sizeof(bigint), 1, fp);
+  }
+  fwrite(&nframes, sizeof(bigint), 1, fp);
+  fwrite(&index_start, sizeof(bigint), 1, fp);
+  fwrite(INDEX_MAGIC, sizeof(char), strlen(INDEX_MAGIC), fp);
+  fflush(fp);
+  index_end = platform::ftell(fp);
+  nindex = nframes;
+}
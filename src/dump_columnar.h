@@ -0,0 +1,64 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef DUMP_CLASS
+// clang-format off
+DumpStyle(columnar,DumpColumnar);
+// clang-format on
+#else
+
+#ifndef LMP_DUMP_COLUMNAR_H
+#define LMP_DUMP_COLUMNAR_H
+
+#include "dump_custom.h"
+
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class DumpColumnar : public DumpCustom {
+ public:
+  DumpColumnar(class LAMMPS *, int, char **);
+  ~DumpColumnar() override;
+  void post_run() override;
+
+  static constexpr const char *COLUMNAR_MAGIC = "DUMPCOLUMNAR";
+  static constexpr const char *INDEX_MAGIC = "COLINDEX";
+  static constexpr int COLUMNAR_REVISION = 0x0001;
+
+ protected:
+  int compress_level;    // zstd compression level, 0 = no compression
+  int maxcol;            // size of colbuf and zbuf
+  double *colbuf;        // values of one column of a chunk
+  size_t maxzbuf;
+  char *zbuf;            // compressed column
+
+  bigint index_start;                 // file offset of index at end of file
+  bigint index_end;                   // end of index in file, 0 if not written
+  bigint nindex;                      // # of frames in index in file, -1 if not written
+  std::vector<bigint> index_step;     // timestep of each frame in file
+  std::vector<bigint> index_offset;   // file offset of each frame in file
+
+  void init_style() override;
+  void openfile() override;
+  int modify_param(int, char **) override;
+  void write_header(bigint) override;
+  void write_data(int, double *) override;
+  void write_footer() override;
+  void write_index();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
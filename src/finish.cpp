@@ -530,6 +530,10 @@ void Finish::end(int flag)
       MPI_Allreduce(&tmp,&nspec_all,1,MPI_DOUBLE,MPI_SUM,world);
     }
 
+    bigint nprune = 0;
+    if (neighbor->nprune)
+      MPI_Allreduce(&neighbor->nprunecalls,&nprune,1,MPI_LMP_BIGINT,MPI_MAX,world);
+
     if (me == 0) {
       std::string mesg;
 
@@ -539,6 +543,8 @@ void Finish::end(int flag)
       if ((atom->molecular != Atom::ATOMIC) && (atom->natoms > 0))
         mesg += fmt::format("Ave special neighs/atom = {:.8}\n",nspec_all/atom->natoms);
       mesg += fmt::format("Neighbor list builds = {}\n",neighbor->ncalls);
+      if (neighbor->nprune)
+        mesg += fmt::format("Max neighbor list prunings per proc = {}\n",nprune);
       if (neighbor->dist_check)
         mesg += fmt::format("Dangerous builds = {}\n",neighbor->ndanger);
       else mesg += "Dangerous builds not checked\n";
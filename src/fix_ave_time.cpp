@@ -25,9 +25,11 @@
 #include "input.h"
 #include "memory.h"
 #include "modify.h"
+#include "universe.h"
 #include "update.h"
 #include "variable.h"
 
+#include <algorithm>
 #include <cstring>
 #include <stdexcept>
 
@@ -40,9 +42,10 @@ enum { SCALAR, VECTOR };
 /* ---------------------------------------------------------------------- */
 
 FixAveTime::FixAveTime(LAMMPS *lmp, int narg, char **arg) :
-    Fix(lmp, narg, arg), nvalues(0), fp(nullptr), offlist(nullptr), format(nullptr), vector(nullptr),
-    vector_total(nullptr), vector_list(nullptr), column(nullptr), array(nullptr),
-    array_total(nullptr), array_list(nullptr)
+    Fix(lmp, narg, arg), nvalues(0), fp(nullptr), fpmerge(nullptr), offlist(nullptr),
+    format(nullptr), roots(MPI_COMM_NULL), vector(nullptr), vector_total(nullptr),
+    vector_list(nullptr), column(nullptr), array(nullptr), array_total(nullptr),
+    array_list(nullptr)
 {
   if (narg < 7) utils::missing_cmd_args(FLERR, "fix ave/time", error);
 
@@ -135,6 +138,8 @@ FixAveTime::FixAveTime(LAMMPS *lmp, int narg, char **arg) :
     error->all(FLERR, Error::NOPOINTER, "Inconsistent fix ave/time nevery/nrepeat/nfreq values");
   if (ave != RUNNING && overwrite)
     error->all(FLERR, Error::NOPOINTER, "Fix ave/time overwrite keyword requires ave running setting");
+  if (universeflag && (ave != ONE))
+    error->all(FLERR, Error::NOPOINTER, "Fix ave/time universe yes requires ave one setting");
 
   for (auto &val : values) {
 
@@ -283,6 +288,22 @@ FixAveTime::FixAveTime(LAMMPS *lmp, int narg, char **arg) :
     filepos = platform::ftell(fp);
   }
 
+  // with universe yes, each partition root writes its data to a scratch file
+  // which is merged into the output file by the first partition in post_run()
+  // the partition roots form a communicator, ordered by partition
+
+  if (universeflag) {
+    MPI_Comm_split(universe->uworld, (comm->me == 0) ? 0 : MPI_UNDEFINED, universe->iworld,
+                   &roots);
+    if (comm->me == 0) {
+      fpmerge = fp;
+      fp = tmpfile();
+      if (fp == nullptr)
+        error->one(FLERR, Error::NOLASTLINE, "Cannot open fix ave/time scratch file: {}",
+                   utils::getsyserror());
+    }
+  }
+
   delete[] title1;
   delete[] title2;
   delete[] title3;
@@ -456,6 +477,8 @@ FixAveTime::~FixAveTime()
     if (yaml_flag) fputs("...\n", fp);
     fclose(fp);
   }
+  if (fpmerge) fclose(fpmerge);
+  if (roots != MPI_COMM_NULL) MPI_Comm_free(&roots);
   memory->destroy(column);
 
   delete[] vector;
@@ -474,6 +497,109 @@ int FixAveTime::setmask()
   return mask;
 }
 
+/* ----------------------------------------------------------------------
+   with universe yes, merge the records written by all partitions since
+   the last merge into the output file in order of their timestep
+------------------------------------------------------------------------- */
+
+void FixAveTime::post_run()
+{
+  if (!universeflag || (comm->me != 0)) return;
+
+  // read back the records in the scratch file and reset it
+
+  bigint nbytes = platform::ftell(fp);
+  std::string text(nbytes, '\0');
+  rewind(fp);
+  if (nbytes && (fread(&text[0], 1, nbytes, fp) != (std::size_t) nbytes))
+    error->one(FLERR, Error::NOLASTLINE, "Error reading fix ave/time scratch file: {}",
+               utils::getsyserror());
+  rewind(fp);
+  (void) platform::ftruncate(fp, 0);
+
+  if (nbytes > MAXSMALLINT)
+    error->one(FLERR, Error::NOLASTLINE, "Too much fix ave/time output to merge at end of run");
+  int nrec = recstep.size();
+  recpos.push_back(nbytes);
+
+  // gather steps, offsets, and text of the records of all partitions
+  // on the root of the first partition, which is rank 0 in roots
+
+  int nworlds = universe->nworlds;
+  int mycounts[2] = {nrec, (int) nbytes};
+  std::vector<int> counts(2 * nworlds);
+  MPI_Gather(mycounts, 2, MPI_INT, counts.data(), 2, MPI_INT, 0, roots);
+
+  std::vector<int> nrecs(nworlds), npos(nworlds), nchars(nworlds);
+  std::vector<int> recoff(nworlds, 0), posoff(nworlds, 0), charoff(nworlds, 0);
+  for (int iworld = 0; iworld < nworlds; iworld++) {
+    nrecs[iworld] = counts[2 * iworld];
+    npos[iworld] = counts[2 * iworld] + 1;
+    nchars[iworld] = counts[2 * iworld + 1];
+    if (iworld > 0) {
+      recoff[iworld] = recoff[iworld - 1] + nrecs[iworld - 1];
+      posoff[iworld] = posoff[iworld - 1] + npos[iworld - 1];
+      charoff[iworld] = charoff[iworld - 1] + nchars[iworld - 1];
+    }
+  }
+
+  // only the first partition allocates the gathered data
+
+  bigint ntotal = 0;
+  if (universe->iworld == 0)
+    for (int iworld = 0; iworld < nworlds; iworld++) ntotal += nchars[iworld];
+  if (ntotal > MAXSMALLINT)
+    error->one(FLERR, Error::NOLASTLINE, "Too much fix ave/time output to merge at end of run");
+
+  std::vector<bigint> allsteps, allpos;
+  std::string alltext;
+  if (universe->iworld == 0) {
+    allsteps.resize(recoff[nworlds - 1] + nrecs[nworlds - 1]);
+    allpos.resize(posoff[nworlds - 1] + npos[nworlds - 1]);
+    alltext.resize(ntotal);
+  }
+
+  MPI_Gatherv(recstep.data(), nrec, MPI_LMP_BIGINT, allsteps.data(), nrecs.data(), recoff.data(),
+              MPI_LMP_BIGINT, 0, roots);
+  MPI_Gatherv(recpos.data(), nrec + 1, MPI_LMP_BIGINT, allpos.data(), npos.data(), posoff.data(),
+              MPI_LMP_BIGINT, 0, roots);
+  MPI_Gatherv(&text[0], nbytes, MPI_CHAR, &alltext[0], nchars.data(), charoff.data(), MPI_CHAR, 0,
+              roots);
+
+  // write records of all partitions in timestep order
+
+  if (universe->iworld == 0) {
+    struct record_t {
+      bigint step;
+      bigint start, stop;
+    };
+    std::vector<record_t> records;
+
+    for (int iworld = 0; iworld < nworlds; iworld++) {
+      const bigint *steps = allsteps.data() + recoff[iworld];
+      const bigint *pos = allpos.data() + posoff[iworld];
+      for (int i = 0; i < nrecs[iworld]; i++)
+        records.push_back({steps[i], charoff[iworld] + pos[i], charoff[iworld] + pos[i + 1]});
+    }
+
+    std::stable_sort(records.begin(), records.end(),
+                     [](const record_t &a, const record_t &b) { return a.step < b.step; });
+
+    if (fpmerge) {
+      clearerr(fpmerge);
+      for (const auto &rec : records)
+        fwrite(alltext.data() + rec.start, 1, rec.stop - rec.start, fpmerge);
+      fflush(fpmerge);
+      if (ferror(fpmerge))
+        error->one(FLERR, Error::NOLASTLINE, "Error writing out time averaged data: {}",
+                   utils::getsyserror());
+    }
+  }
+
+  recstep.clear();
+  recpos.clear();
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixAveTime::init()
@@ -553,6 +679,16 @@ void FixAveTime::invoke_scalar(bigint ntimestep)
 
   modify->clearstep_compute();
 
+  // combine global sums of computes that support it
+
+  std::vector<std::pair<Compute *, int>> reduce_list;
+  for (auto &val : values) {
+    if (val.which != ArgInfo::COMPUTE) continue;
+    if (val.argindex == 0) reduce_list.emplace_back(val.val.c, Compute::INVOKED_SCALAR);
+    else reduce_list.emplace_back(val.val.c, Compute::INVOKED_VECTOR);
+  }
+  modify->reduce_computes(reduce_list);
+
   int i = 0;
   double scalar = 0.0;
   for (auto &val : values) {
@@ -664,6 +800,10 @@ void FixAveTime::invoke_scalar(bigint ntimestep)
 
   if (fp && comm->me == 0) {
     clearerr(fp);
+    if (universeflag) {
+      recstep.push_back(ntimestep);
+      recpos.push_back(platform::ftell(fp));
+    }
     if (overwrite) (void) platform::fseek(fp,filepos);
     if (yaml_flag) {
       if (!yaml_header || overwrite) {
@@ -747,6 +887,14 @@ void FixAveTime::invoke_vector(bigint ntimestep)
 
   modify->clearstep_compute();
 
+  // combine global sums of computes that support it
+
+  std::vector<std::pair<Compute *, int>> reduce_list;
+  for (auto &val : values)
+    if ((val.which == ArgInfo::COMPUTE) && (val.argindex == 0))
+      reduce_list.emplace_back(val.val.c, Compute::INVOKED_VECTOR);
+  modify->reduce_computes(reduce_list);
+
   int j = 0;
   for (auto &val : values) {
 
@@ -882,6 +1030,10 @@ void FixAveTime::invoke_vector(bigint ntimestep)
   // output result to file
 
   if (fp && comm->me == 0) {
+    if (universeflag) {
+      recstep.push_back(ntimestep);
+      recpos.push_back(platform::ftell(fp));
+    }
     if (overwrite) platform::fseek(fp,filepos);
     if (yaml_flag) {
       if (!yaml_header || overwrite) {
@@ -1051,12 +1203,16 @@ void FixAveTime::options(int iarg, int narg, char **arg)
   noff = 0;
   offlist = nullptr;
   overwrite = 0;
+  universeflag = 0;
   yaml_flag = yaml_header = false;
   format = utils::strdup(" %g");
   title1 = nullptr;
   title2 = nullptr;
   title3 = nullptr;
 
+  int fileiarg = -1;
+  int appendflag = 0;
+
   // optional args
 
   while (iarg < narg) {
@@ -1064,13 +1220,8 @@ void FixAveTime::options(int iarg, int narg, char **arg)
       if (iarg+2 > narg)
         utils::missing_cmd_args(FLERR, std::string("fix ave/time ")+arg[iarg], error);
       yaml_flag = utils::strmatch(arg[iarg+1],"\\.[yY][aA]?[mM][lL]$");
-      if (comm->me == 0) {
-        if (strcmp(arg[iarg],"file") == 0) fp = fopen(arg[iarg+1],"w");
-        else fp = fopen(arg[iarg+1],"a");
-        if (fp == nullptr)
-          error->one(FLERR, iarg+1, "Cannot open fix ave/time file {}: {}",
-                     arg[iarg+1], utils::getsyserror());
-      }
+      appendflag = (strcmp(arg[iarg],"append") == 0) ? 1 : 0;
+      fileiarg = iarg+1;
       iarg += 2;
     } else if (strcmp(arg[iarg],"ave") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "fix ave/time ave", error);
@@ -1105,6 +1256,10 @@ void FixAveTime::options(int iarg, int narg, char **arg)
     } else if (strcmp(arg[iarg],"overwrite") == 0) {
       overwrite = 1;
       iarg += 1;
+    } else if (strcmp(arg[iarg],"universe") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "fix ave/time universe", error);
+      universeflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
     } else if (strcmp(arg[iarg],"format") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "fix ave/time format", error);
       delete[] format;
@@ -1127,6 +1282,21 @@ void FixAveTime::options(int iarg, int narg, char **arg)
       iarg += 2;
     } else error->all(FLERR,"Unknown fix ave/time keyword {}", arg[iarg]);
   }
+
+  if (universeflag) {
+    if (fileiarg < 0) error->all(FLERR, "Fix ave/time universe yes requires file or append keyword");
+    if (overwrite) error->all(FLERR, "Fix ave/time universe yes cannot be used with overwrite");
+    if (yaml_flag) error->all(FLERR, "Fix ave/time universe yes cannot be used with YAML output");
+  }
+
+  // with universe yes, only the first partition opens the output file
+
+  if ((fileiarg >= 0) && (comm->me == 0) && (!universeflag || (universe->iworld == 0))) {
+    fp = fopen(arg[fileiarg], appendflag ? "a" : "w");
+    if (fp == nullptr)
+      error->one(FLERR, fileiarg, "Cannot open fix ave/time file {}: {}",
+                 arg[fileiarg], utils::getsyserror());
+  }
 }
 
 /* ----------------------------------------------------------------------
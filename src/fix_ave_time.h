@@ -34,6 +34,7 @@ class FixAveTime : public Fix {
   void init() override;
   void setup(int) override;
   void end_of_step() override;
+  void post_run() override;
   int modify_param(int, char **) override;
   double compute_scalar() override;
   double compute_vector(int) override;
@@ -60,6 +61,7 @@ class FixAveTime : public Fix {
   bigint nvalid, nvalid_last;
 
   FILE *fp;
+  FILE *fpmerge;
   int nrows;
   int any_variable_length;
   int all_variable_length;
@@ -73,6 +75,11 @@ class FixAveTime : public Fix {
   char *title1, *title2, *title3;
   bigint filepos;
 
+  int universeflag;                // 1 if merging output of all partitions
+  MPI_Comm roots;                  // communicator of partition roots for merging
+  std::vector<bigint> recstep;     // timestep of each record in scratch file
+  std::vector<bigint> recpos;      // file offset of each record in scratch file
+
   std::map<std::string, int> key2col;
 
   int norm, iwindow, window_limit;
@@ -44,6 +44,7 @@ KSpace::KSpace(LAMMPS *lmp) : Pointers(lmp)
     dipoleflag = spinflag = 0;
   compute_flag = 1;
   group_group_enable = 0;
+  mc_energy_enable = 0;
   stagger_flag = 0;
 
   order = 5;
@@ -52,6 +53,12 @@ KSpace::KSpace(LAMMPS *lmp) : Pointers(lmp)
   minorder = 2;
   overlap_allowed = 1;
   fftbench = 0;
+  fft_tune_flag = 0;
+  fft_tune_enable = 0;
+  split_enable = 0;
+  concurrent_flag = 0;
+  concurrent_nthreads = 1;
+  concurrent_tid = 0;
 
   // default to using MPI collectives for FFT/remap only on IBM BlueGene
 
@@ -549,6 +556,30 @@ void KSpace::modify_params(int narg, char **arg)
       if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
       collective_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"concurrent") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      if (strcmp(arg[iarg+1],"select") == 0) concurrent_flag = 2;
+      else concurrent_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"concurrent/threads") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      concurrent_nthreads = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (concurrent_nthreads < 1)
+        error->all(FLERR,"Invalid kspace_modify concurrent/threads value: {}",
+                   concurrent_nthreads);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"fft/tune") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      fft_tune_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      if (fft_tune_flag && !fft_tune_enable)
+        error->all(FLERR,"Kspace style {} does not support kspace_modify fft/tune",
+                   force->kspace_style);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"fft/wisdom") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      if (strcmp(arg[iarg+1],"none") == 0) fft_wisdom.clear();
+      else fft_wisdom = arg[iarg+1];
+      iarg += 2;
     } else if (strcmp(arg[iarg],"diff") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
       if (strcmp(arg[iarg+1],"ad") == 0) differentiation_flag = 1;
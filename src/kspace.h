@@ -116,6 +116,7 @@ class KSpace : protected Pointers {
   int nx_msm_max, ny_msm_max, nz_msm_max;
 
   int group_group_enable;    // 1 if style supports group/group calculation
+  int mc_energy_enable;      // 1 if style supports incremental Monte Carlo energies
 
   int centroidstressflag;    // centroid stress compared to two-body stress
                              // CENTROID_SAME = same as two-body stress
@@ -131,6 +132,13 @@ class KSpace : protected Pointers {
   int compute_flag;       // 0 if skip compute()
   int fftbench;           // 0 if skip FFT timing
   int collective_flag;    // 1 if use MPI collectives for FFT/remap
+  int fft_tune_flag;      // 1 if autotune FFT decomposition and remap mode
+  int fft_tune_enable;    // 1 if kspace_modify fft/tune is supported
+  int split_enable;       // 1 if compute_grid() and compute_force() exist
+  int concurrent_flag;    // 1/2 if run grid part concurrent with pair (2 = select)
+  int concurrent_nthreads;    // # of OpenMP threads for grid part when concurrent
+  int concurrent_tid;         // first per-thread data slot of grid part when concurrent
+  std::string fft_wisdom;    // file to cache autotuned FFT settings in
   int stagger_flag;       // 1 if using staggered PPPM grids
 
   double splittol;    // tolerance for when to truncate splitting
@@ -160,8 +168,27 @@ class KSpace : protected Pointers {
   virtual void setup() = 0;
   virtual void reset_grid() {};
   virtual void compute(int, int) = 0;
+
+  // compute() split into grid part, which does not modify forces, and force part
+  // used with kspace_modify concurrent, only available if split_enable is set
+
+  virtual void compute_grid(int, int) {}
+  virtual void compute_force() {}
   virtual void compute_group_group(int, int, int) {};
 
+  // incremental energy for Monte Carlo moves, only available if mc_energy_enable is set
+  // setup caches structure factors of current config and returns kspace energy
+  // delta returns energy change for removing and adding lists of charges,
+  //   optionally without the self interaction of the changed charges
+  // accept makes last delta part of the cached state
+
+  virtual double mc_energy_setup() { return 0.0; }
+  virtual double mc_energy_delta(int, double *, double **, int, double *, double **, int)
+  {
+    return 0.0;
+  }
+  virtual void mc_energy_accept() {}
+
   virtual void pack_forward_grid(int, void *, int, int *) {};
   virtual void unpack_forward_grid(int, void *, int, int *) {};
   virtual void pack_reverse_grid(int, void *, int, int *) {};
@@ -60,6 +60,7 @@
 #include "version.h"
 
 #include <cstring>
+#include <type_traits>
 
 #if defined(LMP_PYTHON)
 #include <Python.h>
@@ -3917,6 +3918,303 @@ void lammps_gather_atoms_subset(void *handle, const char *name, int dtype,
   END_CAPTURE
 }
 
+/* ----------------------------------------------------------------------
+   helper for the root-only gather functions
+   pack count values for each of the nsend local atoms in local[]
+   and send them together with their destination slot in index[]
+   to MPI rank 0 with MPI_Gatherv(), which stores them in data
+------------------------------------------------------------------------- */
+
+template <typename T>
+static void gather_atoms_to_root(LAMMPS *lmp, const char *name, void *vptr, int count,
+                                 int nsend, const int *local, const int *index, T *data)
+{
+  const MPI_Datatype mpitype = std::is_same<T, int>::value ? MPI_INT : MPI_DOUBLE;
+  const int imgunpack = (count == 3) && (strcmp(name,"image") == 0);
+  const int me = lmp->comm->me;
+  const int nprocs = lmp->comm->nprocs;
+
+  T *vector = nullptr;
+  T **array = nullptr;
+  if ((count == 1) || imgunpack) vector = (T *) vptr;
+  else array = (T **) vptr;
+
+  T *sendbuf;
+  lmp->memory->create(sendbuf, count*nsend, "lib/gather:sendbuf");
+
+  int offset = 0;
+  for (int k = 0; k < nsend; k++) {
+    const int m = local[k];
+    if (count == 1) {
+      sendbuf[offset++] = vector[m];
+    } else if (imgunpack) {
+      const auto image = (imageint) vector[m];
+      sendbuf[offset++] = (image & IMGMASK) - IMGMAX;
+      sendbuf[offset++] = ((image >> IMGBITS) & IMGMASK) - IMGMAX;
+      sendbuf[offset++] = ((image >> IMG2BITS) & IMGMASK) - IMGMAX;
+    } else {
+      for (int j = 0; j < count; j++) sendbuf[offset++] = array[m][j];
+    }
+  }
+
+  // rank 0 collects per-rank atom counts, then slot indices, then values
+
+  int *recvcounts = nullptr;
+  int *displs = nullptr;
+  int *rindex = nullptr;
+  T *rvalues = nullptr;
+  int nrecv = 0;
+
+  if (me == 0) {
+    lmp->memory->create(recvcounts, nprocs, "lib/gather:recvcounts");
+    lmp->memory->create(displs, nprocs, "lib/gather:displs");
+  }
+  MPI_Gather(&nsend, 1, MPI_INT, recvcounts, 1, MPI_INT, 0, lmp->world);
+  if (me == 0) {
+    for (int iproc = 0; iproc < nprocs; iproc++) {
+      displs[iproc] = nrecv;
+      nrecv += recvcounts[iproc];
+    }
+    lmp->memory->create(rindex, nrecv, "lib/gather:rindex");
+    lmp->memory->create(rvalues, count*nrecv, "lib/gather:rvalues");
+  }
+
+  MPI_Gatherv((void *) index, nsend, MPI_INT, rindex, recvcounts, displs, MPI_INT, 0, lmp->world);
+  if (me == 0) {
+    for (int iproc = 0; iproc < nprocs; iproc++) {
+      recvcounts[iproc] *= count;
+      displs[iproc] *= count;
+    }
+  }
+  MPI_Gatherv(sendbuf, count*nsend, mpitype, rvalues, recvcounts, displs, mpitype, 0, lmp->world);
+
+  if (me == 0) {
+    for (int i = 0; i < nrecv; i++) {
+      T *dest = data + (bigint) count*rindex[i];
+      for (int j = 0; j < count; j++) dest[j] = rvalues[count*i+j];
+    }
+  }
+
+  lmp->memory->destroy(sendbuf);
+  lmp->memory->destroy(recvcounts);
+  lmp->memory->destroy(displs);
+  lmp->memory->destroy(rindex);
+  lmp->memory->destroy(rvalues);
+}
+
+/** Gather the named atom-based entity for all atoms on MPI rank 0 only,
+ * in order.
+ *
+\verbatim embed:rst
+
+.. versionadded:: TBD
+
+This function is a variant of :cpp:func:`lammps_gather_atoms` which
+stores the gathered data only on MPI rank 0 of the LAMMPS communicator.
+It produces the same data layout, ordered by atom ID, but each process
+only sends the data of its owned atoms with ``MPI_Gatherv()`` instead of
+summing a zeroed array of length (*count* :math:`\times` *natoms*) across
+all processes with ``MPI_Allreduce()``.  This avoids allocating and
+communicating the full array on every process and is thus much cheaper
+for large systems.
+
+The function must be called on all processes.  The *data* array is only
+accessed on MPI rank 0 and may be a NULL pointer elsewhere.  On MPI rank
+0 it must be pre-allocated by the caller to length (*count*
+:math:`\times` *natoms*) and may be kept and reused across calls.
+
+.. admonition:: Restrictions
+    :class: warning
+
+    This function is not compatible with ``-DLAMMPS_BIGBIG``.
+
+    Atom IDs must be defined and consecutive.
+
+    The total number of atoms must not be more than 2147483647 (max 32-bit signed int).
+
+\endverbatim
+ *
+ * \param handle  pointer to a previously created LAMMPS instance
+ * \param name    desired quantity (e.g., *x* or *q*)
+ * \param dtype   0 for ``int`` values, 1 for ``double`` values
+ * \param count   number of per-atom values (e.g., 1 for *type* or *q*,
+ *                3 for *x* or *f*); use *count* = 3 with *image* if you want
+ *                a single image flag unpacked into (*x*,*y*,*z*) components.
+ * \param data    per-atom values packed in a 1-dimensional array of length
+ *                *natoms* \* *count*; only used on MPI rank 0.
+ *
+ */
+
+void lammps_gather_atoms_root(void *handle, const char *name, int dtype, int count, void *data)
+{
+  auto *lmp = (LAMMPS *) handle;
+  if (!lmp || !lmp->error || !lmp->atom || !lmp->comm || !lmp->memory) {
+    lammps_last_global_errormessage = fmt::format("ERROR: {}(): Invalid LAMMPS handle\n", FNERR);
+    return;
+  }
+  if (!name) return;
+
+  BEGIN_CAPTURE
+  {
+#if defined(LAMMPS_BIGBIG)
+    lmp->error->all(FLERR, Error::NOLASTLINE, "{}() is not compatible with -DLAMMPS_BIGBIG", FNERR);
+#else
+    // error if tags are not defined or not consecutive
+
+    int flag = 0;
+    if (lmp->atom->tag_enable == 0 || lmp->atom->tag_consecutive() == 0)
+      flag = 1;
+    if (lmp->atom->natoms > MAXSMALLINT) flag = 1;
+    if (flag)
+      lmp->error->all(FLERR, Error::NOLASTLINE, "{}(): Atom-IDs must exist and be consecutive", FNERR);
+    flag = ((lmp->comm->me == 0) && !data) ? 1 : 0;
+    MPI_Bcast(&flag, 1, MPI_INT, 0, lmp->world);
+    if (flag)
+      lmp->error->all(FLERR, Error::NOLASTLINE, "{}(): data must not be NULL on MPI rank 0", FNERR);
+
+    void *vptr = lmp->atom->extract(name);
+    if (!vptr) lmp->error->all(FLERR, Error::NOLASTLINE, "{}(): unknown property {}", FNERR, name);
+
+    // local = my owned atoms, index = their position in data by atom ID
+
+    int nlocal = lmp->atom->nlocal;
+    tagint *tag = lmp->atom->tag;
+    int *local, *index;
+    lmp->memory->create(local, nlocal, "lib/gather:local");
+    lmp->memory->create(index, nlocal, "lib/gather:index");
+    for (int i = 0; i < nlocal; i++) {
+      local[i] = i;
+      index[i] = tag[i] - 1;
+    }
+
+    if (dtype == 0)
+      gather_atoms_to_root(lmp, name, vptr, count, nlocal, local, index, (int *) data);
+    else if (dtype == 1)
+      gather_atoms_to_root(lmp, name, vptr, count, nlocal, local, index, (double *) data);
+    else {
+      lmp->memory->destroy(local);
+      lmp->memory->destroy(index);
+      lmp->error->all(FLERR, Error::NOLASTLINE, "{}(): unsupported data type: {}", FNERR, dtype);
+      return;
+    }
+
+    lmp->memory->destroy(local);
+    lmp->memory->destroy(index);
+#endif
+  }
+  END_CAPTURE
+}
+
+/** Gather the named atom-based entity for a subset of atoms on MPI rank 0 only.
+ *
+\verbatim embed:rst
+
+.. versionadded:: TBD
+
+This function is a variant of :cpp:func:`lammps_gather_atoms_subset`
+which stores the gathered data only on MPI rank 0 of the LAMMPS
+communicator.  It produces the same data layout, ordered as the list of
+atom IDs in *ids*, but each process only sends the data of the atoms it
+owns with ``MPI_Gatherv()`` instead of summing a zeroed array of length
+(*count* :math:`\times` *ndata*) across all processes with
+``MPI_Allreduce()``.
+
+The function must be called on all processes with the same *ndata* and
+*ids*.  The *data* array is only accessed on MPI rank 0 and may be a
+NULL pointer elsewhere.  On MPI rank 0 it must be pre-allocated by the
+caller to length (*count* :math:`\times` *ndata*) and may be kept and
+reused across calls.  Entries for atom IDs that do not exist are left
+unchanged.
+
+.. admonition:: Restrictions
+    :class: warning
+
+    This function is not compatible with ``-DLAMMPS_BIGBIG``.
+
+    Atom IDs must be defined and an :doc:`atom map must be enabled <atom_modify>`
+
+    The total number of atoms must not be more than 2147483647 (max 32-bit signed int).
+
+\endverbatim
+ *
+ * \param handle  pointer to a previously created LAMMPS instance
+ * \param name    desired quantity (e.g., *x* or *q*)
+ * \param dtype   0 for ``int`` values, 1 for ``double`` values
+ * \param count   number of per-atom values (e.g., 1 for *type* or *q*,
+ *                3 for *x* or *f*); use *count* = 3 with "image" if you want
+ *                single image flags unpacked into (*x*,*y*,*z*)
+ * \param ndata   number of atoms for which to return data (can be all of them)
+ * \param ids     list of *ndata* atom IDs for which to return data
+ * \param data    per-atom values packed in a 1-dimensional array of length
+ *                *ndata* \* *count*; only used on MPI rank 0.
+ *
+ */
+
+void lammps_gather_atoms_subset_root(void *handle, const char *name, int dtype,
+                                     int count, int ndata, int *ids, void *data)
+{
+  auto *lmp = (LAMMPS *) handle;
+  if (!lmp || !lmp->error || !lmp->atom || !lmp->comm || !lmp->memory) {
+    lammps_last_global_errormessage = fmt::format("ERROR: {}(): Invalid LAMMPS handle\n", FNERR);
+    return;
+  }
+  if (!name || !ids) return;
+
+  BEGIN_CAPTURE
+  {
+#if defined(LAMMPS_BIGBIG)
+    lmp->error->all(FLERR, Error::NOLASTLINE, "{}() is not compatible with -DLAMMPS_BIGBIG", FNERR);
+#else
+    // error if tags are not defined or no atom map
+
+    int flag = 0;
+    if (lmp->atom->tag_enable == 0) flag = 1;
+    if (lmp->atom->natoms > MAXSMALLINT) flag = 1;
+    if (lmp->atom->map_style == Atom::MAP_NONE) flag = 1;
+    if (flag)
+      lmp->error->all(FLERR, Error::NOLASTLINE, "{}(): Atom-IDs must exist and be mapped", FNERR);
+    flag = ((lmp->comm->me == 0) && !data) ? 1 : 0;
+    MPI_Bcast(&flag, 1, MPI_INT, 0, lmp->world);
+    if (flag)
+      lmp->error->all(FLERR, Error::NOLASTLINE, "{}(): data must not be NULL on MPI rank 0", FNERR);
+
+    void *vptr = lmp->atom->extract(name);
+    if (!vptr) lmp->error->all(FLERR, Error::NOLASTLINE, "{}(): unknown property {}", FNERR, name);
+
+    // local = requested atoms that I own, index = their position in ids
+
+    int nlocal = lmp->atom->nlocal;
+    int *local, *index;
+    lmp->memory->create(local, ndata, "lib/gather:local");
+    lmp->memory->create(index, ndata, "lib/gather:index");
+
+    int nsend = 0;
+    for (int i = 0; i < ndata; i++) {
+      const int m = lmp->atom->map(ids[i]);
+      if ((m >= 0) && (m < nlocal)) {
+        local[nsend] = m;
+        index[nsend++] = i;
+      }
+    }
+
+    if (dtype == 0)
+      gather_atoms_to_root(lmp, name, vptr, count, nsend, local, index, (int *) data);
+    else if (dtype == 1)
+      gather_atoms_to_root(lmp, name, vptr, count, nsend, local, index, (double *) data);
+    else {
+      lmp->memory->destroy(local);
+      lmp->memory->destroy(index);
+      lmp->error->all(FLERR, Error::NOLASTLINE, "{}(): unsupported data type: {}", FNERR, dtype);
+      return;
+    }
+
+    lmp->memory->destroy(local);
+    lmp->memory->destroy(index);
+#endif
+  }
+  END_CAPTURE
+}
+
 /** Scatter the named atom-based entities in *data* to all processes.
  *
 \verbatim embed:rst
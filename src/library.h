@@ -214,6 +214,9 @@ void lammps_gather_atoms(void *handle, const char *name, int type, int count, vo
 void lammps_gather_atoms_concat(void *handle, const char *name, int type, int count, void *data);
 void lammps_gather_atoms_subset(void *handle, const char *name, int type, int count, int ndata,
                                 int *ids, void *data);
+void lammps_gather_atoms_root(void *handle, const char *name, int type, int count, void *data);
+void lammps_gather_atoms_subset_root(void *handle, const char *name, int type, int count,
+                                     int ndata, int *ids, void *data);
 void lammps_scatter_atoms(void *handle, const char *name, int type, int count, void *data);
 void lammps_scatter_atoms_subset(void *handle, const char *name, int type, int count, int ndata,
                                  int *ids, void *data);
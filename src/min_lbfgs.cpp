@@ -0,0 +1,349 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   Sources: J Nocedal, Math Comput, 35, 773-782 (1980)
+            DC Liu and J Nocedal, Math Program, 45, 503-528 (1989)
+------------------------------------------------------------------------- */
+
+#include "min_lbfgs.h"
+
+#include "error.h"
+#include "fix_minimize.h"
+#include "memory.h"
+#include "output.h"
+#include "timer.h"
+#include "update.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+// EPS_ENERGY = minimum normalization for energy tolerance
+// EPS_CURVATURE = min ratio of s.y to y.y for accepting a correction pair
+
+static constexpr double EPS_ENERGY = 1.0e-8;
+static constexpr double EPS_CURVATURE = 1.0e-10;
+
+/* ---------------------------------------------------------------------- */
+
+MinLBFGS::MinLBFGS(LAMMPS *lmp) : MinLineSearch(lmp)
+{
+  nhistory = 8;
+  nstored = 0;
+  newest = -1;
+  gamma = 1.0;
+
+  s = y = nullptr;
+  sextra = yextra = nullptr;
+  rho = alpha_hist = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+MinLBFGS::~MinLBFGS()
+{
+  delete[] s;
+  delete[] y;
+  memory->destroy(sextra);
+  memory->destroy(yextra);
+  memory->destroy(rho);
+  memory->destroy(alpha_hist);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void MinLBFGS::init()
+{
+  MinLineSearch::init();
+
+  delete[] s;
+  delete[] y;
+  s = y = nullptr;
+  memory->destroy(sextra);
+  memory->destroy(yextra);
+  memory->destroy(rho);
+  memory->destroy(alpha_hist);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void MinLBFGS::setup_style()
+{
+  if (nextra_atom)
+    error->all(FLERR, "Min_style lbfgs does not support extra per-atom degrees of freedom");
+
+  MinLineSearch::setup_style();
+
+  // memory for s,y history of atomic dof
+  // stored after x0,g,h of MinLineSearch
+
+  s = new double*[nhistory];
+  y = new double*[nhistory];
+  for (int k = 0; k < nhistory; k++) {
+    fix_minimize->add_vector(3);
+    fix_minimize->add_vector(3);
+  }
+
+  // memory for s,y history of extra global dof
+
+  if (nextra_global) {
+    memory->create(sextra,nhistory,nextra_global,"min:sextra");
+    memory->create(yextra,nhistory,nextra_global,"min:yextra");
+  }
+
+  memory->create(rho,nhistory,"min:rho");
+  memory->create(alpha_hist,nhistory,"min:alpha_hist");
+}
+
+/* ----------------------------------------------------------------------
+   set current vector lengths and pointers
+   called after atoms have migrated
+------------------------------------------------------------------------- */
+
+void MinLBFGS::reset_vectors()
+{
+  MinLineSearch::reset_vectors();
+
+  for (int k = 0; k < nhistory; k++) {
+    s[k] = fix_minimize->request_vector(3 + 2*k);
+    y[k] = fix_minimize->request_vector(4 + 2*k);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MinLBFGS::modify_param(int narg, char **arg)
+{
+  if (strcmp(arg[0],"history") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR,"min_modify history",error);
+    nhistory = utils::inumeric(FLERR,arg[1],false,lmp);
+    if (nhistory < 1) error->all(FLERR,"Illegal min_modify history value: {}", nhistory);
+    return 2;
+  }
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   minimization via limited-memory BFGS iterations
+------------------------------------------------------------------------- */
+
+int MinLBFGS::iterate(int maxiter)
+{
+  int i,fail,ntimestep;
+  double dot,fdotf;
+
+  // initial search direction is steepest descent
+
+  clear_history();
+  for (i = 0; i < nvec; i++) h[i] = g[i] = fvec[i];
+  if (nextra_global)
+    for (i = 0; i < nextra_global; i++) hextra[i] = gextra[i] = fextra[i];
+
+  for (int iter = 0; iter < maxiter; iter++) {
+
+    if (timer->check_timeout(niter))
+      return TIMEOUT;
+
+    ntimestep = ++update->ntimestep;
+    niter++;
+
+    // line minimization along direction h from current atom->x
+    // if it fails with a quasi-Newton direction, discard the history
+    //   and retry once along steepest descent
+    // failed linemin restores x and f at the start of the line search
+
+    eprevious = ecurrent;
+    fail = (this->*linemin)(ecurrent,alpha_final);
+    if (fail && nstored) {
+      clear_history();
+      for (i = 0; i < nvec; i++) h[i] = g[i] = fvec[i];
+      if (nextra_global)
+        for (i = 0; i < nextra_global; i++) hextra[i] = gextra[i] = fextra[i];
+      fail = (this->*linemin)(ecurrent,alpha_final);
+    }
+    if (fail) return fail;
+
+    // function evaluation criterion
+
+    if (neval >= update->max_eval) return MAXEVAL;
+
+    // energy tolerance criterion
+
+    if (fabs(ecurrent-eprevious) <
+        update->etol * 0.5*(fabs(ecurrent) + fabs(eprevious) + EPS_ENERGY))
+      return ETOL;
+
+    // force tolerance criterion
+
+    fdotf = 0.0;
+    if (update->ftol > 0.0) {
+      if (normstyle == MAX) fdotf = fnorm_max();        // max force norm
+      else if (normstyle == INF) fdotf = fnorm_inf();   // infinite force norm
+      else if (normstyle == TWO) fdotf = fnorm_sqr();   // Euclidean force 2-norm
+      else error->all(FLERR,"Illegal min_modify command");
+      if (fdotf < update->ftol*update->ftol) return FTOL;
+    }
+
+    // add correction pair from this step, set g = new f
+    // new search direction h from two-loop recursion
+
+    store_pair();
+
+    for (i = 0; i < nvec; i++) g[i] = fvec[i];
+    if (nextra_global)
+      for (i = 0; i < nextra_global; i++) gextra[i] = fextra[i];
+
+    compute_direction();
+
+    // reinitialize with steepest descent if new search direction h is not downhill
+
+    dot = dot_product(g,h,gextra,hextra);
+    if (dot <= 0.0) {
+      clear_history();
+      for (i = 0; i < nvec; i++) h[i] = g[i];
+      if (nextra_global)
+        for (i = 0; i < nextra_global; i++) hextra[i] = gextra[i];
+    }
+
+    // output for thermo, dump, restart files
+
+    if (output->next == ntimestep) {
+      timer->stamp();
+      output->write(ntimestep);
+      timer->stamp(Timer::OUTPUT);
+    }
+  }
+
+  return MAXITER;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void MinLBFGS::clear_history()
+{
+  nstored = 0;
+  newest = -1;
+  gamma = 1.0;
+}
+
+/* ----------------------------------------------------------------------
+   store s = alpha*h and y = g - f from the last line search
+   g still holds the force at the start of the line search
+   skip pairs with insufficient curvature to keep inverse Hessian pos-definite
+   test curvature before writing to slot k, which may hold the oldest pair
+------------------------------------------------------------------------- */
+
+void MinLBFGS::store_pair()
+{
+  int i;
+  double si,yi,dot[2],dotall[2];
+
+  dot[0] = dot[1] = 0.0;
+  for (i = 0; i < nvec; i++) {
+    si = alpha_final*h[i];
+    yi = g[i] - fvec[i];
+    dot[0] += si*yi;
+    dot[1] += yi*yi;
+  }
+  MPI_Allreduce(dot,dotall,2,MPI_DOUBLE,MPI_SUM,world);
+  if (nextra_global)
+    for (i = 0; i < nextra_global; i++) {
+      si = alpha_final*hextra[i];
+      yi = gextra[i] - fextra[i];
+      dotall[0] += si*yi;
+      dotall[1] += yi*yi;
+    }
+
+  if (dotall[0] <= EPS_CURVATURE*dotall[1]) return;
+
+  int k = (newest + 1) % nhistory;
+  double *sk = s[k];
+  double *yk = y[k];
+
+  for (i = 0; i < nvec; i++) {
+    sk[i] = alpha_final*h[i];
+    yk[i] = g[i] - fvec[i];
+  }
+  if (nextra_global)
+    for (i = 0; i < nextra_global; i++) {
+      sextra[k][i] = alpha_final*hextra[i];
+      yextra[k][i] = gextra[i] - fextra[i];
+    }
+
+  newest = k;
+  nstored = MIN(nstored+1,nhistory);
+  rho[k] = 1.0/dotall[0];
+  gamma = dotall[0]/dotall[1];
+}
+
+/* ----------------------------------------------------------------------
+   two-loop recursion for h = H f with the stored correction pairs
+   initial inverse Hessian is gamma times identity
+------------------------------------------------------------------------- */
+
+void MinLBFGS::compute_direction()
+{
+  int i,k,n;
+  double beta;
+
+  for (i = 0; i < nvec; i++) h[i] = fvec[i];
+  if (nextra_global)
+    for (i = 0; i < nextra_global; i++) hextra[i] = fextra[i];
+
+  k = newest;
+  for (n = 0; n < nstored; n++) {
+    double *sextrak = nextra_global ? sextra[k] : nullptr;
+    double *yextrak = nextra_global ? yextra[k] : nullptr;
+    alpha_hist[k] = rho[k] * dot_product(s[k],h,sextrak,hextra);
+    for (i = 0; i < nvec; i++) h[i] -= alpha_hist[k]*y[k][i];
+    if (nextra_global)
+      for (i = 0; i < nextra_global; i++) hextra[i] -= alpha_hist[k]*yextrak[i];
+    k = (k - 1 + nhistory) % nhistory;
+  }
+
+  for (i = 0; i < nvec; i++) h[i] *= gamma;
+  if (nextra_global)
+    for (i = 0; i < nextra_global; i++) hextra[i] *= gamma;
+
+  k = (newest - nstored + 1 + nhistory) % nhistory;
+  for (n = 0; n < nstored; n++) {
+    double *sextrak = nextra_global ? sextra[k] : nullptr;
+    double *yextrak = nextra_global ? yextra[k] : nullptr;
+    beta = rho[k] * dot_product(y[k],h,yextrak,hextra);
+    for (i = 0; i < nvec; i++) h[i] += (alpha_hist[k] - beta)*s[k][i];
+    if (nextra_global)
+      for (i = 0; i < nextra_global; i++) hextra[i] += (alpha_hist[k] - beta)*sextrak[i];
+    k = (k + 1) % nhistory;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   dot product of two atomic dof vectors summed over all procs
+   plus the contribution of the extra global dof
+------------------------------------------------------------------------- */
+
+double MinLBFGS::dot_product(double *a, double *b, double *aextra, double *bextra)
+{
+  double dot = 0.0;
+  double dotall;
+
+  for (int i = 0; i < nvec; i++) dot += a[i]*b[i];
+  MPI_Allreduce(&dot,&dotall,1,MPI_DOUBLE,MPI_SUM,world);
+  if (nextra_global)
+    for (int i = 0; i < nextra_global; i++) dotall += aextra[i]*bextra[i];
+
+  return dotall;
+}
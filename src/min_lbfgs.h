@@ -0,0 +1,63 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef MINIMIZE_CLASS
+// clang-format off
+MinimizeStyle(lbfgs,MinLBFGS);
+// clang-format on
+#else
+
+#ifndef LMP_MIN_LBFGS_H
+#define LMP_MIN_LBFGS_H
+
+#include "min_linesearch.h"
+
+namespace LAMMPS_NS {
+
+class MinLBFGS : public MinLineSearch {
+ public:
+  MinLBFGS(class LAMMPS *);
+  ~MinLBFGS() override;
+  void init() override;
+  void setup_style() override;
+  void reset_vectors() override;
+  int modify_param(int, char **) override;
+  int iterate(int) override;
+
+ protected:
+  int nhistory;    // max # of stored correction pairs
+  int nstored;     // # of currently stored correction pairs
+  int newest;      // index of most recent pair in circular buffer
+  double gamma;    // scaling of initial inverse Hessian
+
+  // correction pairs for atomic dof, stored by fix_minimize
+  // s = change in coords, y = change in gradient
+
+  double **s;
+  double **y;
+
+  double **sextra;       // s,y for extra global dof
+  double **yextra;
+  double *rho;           // 1/(s.y) for each pair
+  double *alpha_hist;    // work array for two-loop recursion
+
+  void clear_history();
+  void store_pair();
+  void compute_direction();
+  double dot_product(double *, double *, double *, double *);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -18,6 +18,7 @@
 #include "error.h"
 #include "finish.h"
 #include "min.h"
+#include "output.h"
 #include "timer.h"
 #include "update.h"
 
@@ -61,6 +62,7 @@ void Minimize::command(int narg, char **arg)
   timer->init();
   timer->barrier_start();
   update->minimize->run(update->nsteps);
+  output->post_run();
   timer->barrier_stop();
 
   update->minimize->cleanup();
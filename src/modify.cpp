@@ -25,9 +25,11 @@
 #include "input.h"
 #include "memory.h"
 #include "region.h"
+#include "timer.h"
 #include "update.h"
 #include "variable.h"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace LAMMPS_NS;
@@ -398,8 +400,12 @@ void Modify::setup_pre_reverse(int eflag, int vflag)
 
 void Modify::initial_integrate(int vflag)
 {
-  for (int i = 0; i < n_initial_integrate; i++)
-    fix[list_initial_integrate[i]]->initial_integrate(vflag);
+  for (int i = 0; i < n_initial_integrate; i++) {
+    Fix *ifix = fix[list_initial_integrate[i]];
+    timer->trace_begin(ifix->id, "initial_integrate");
+    ifix->initial_integrate(vflag);
+    timer->trace_end();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -408,7 +414,12 @@ void Modify::initial_integrate(int vflag)
 
 void Modify::post_integrate()
 {
-  for (int i = 0; i < n_post_integrate; i++) fix[list_post_integrate[i]]->post_integrate();
+  for (int i = 0; i < n_post_integrate; i++) {
+    Fix *ifix = fix[list_post_integrate[i]];
+    timer->trace_begin(ifix->id, "post_integrate");
+    ifix->post_integrate();
+    timer->trace_end();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -417,7 +428,12 @@ void Modify::post_integrate()
 
 void Modify::pre_exchange()
 {
-  for (int i = 0; i < n_pre_exchange; i++) fix[list_pre_exchange[i]]->pre_exchange();
+  for (int i = 0; i < n_pre_exchange; i++) {
+    Fix *ifix = fix[list_pre_exchange[i]];
+    timer->trace_begin(ifix->id, "pre_exchange");
+    ifix->pre_exchange();
+    timer->trace_end();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -426,7 +442,12 @@ void Modify::pre_exchange()
 
 void Modify::pre_neighbor()
 {
-  for (int i = 0; i < n_pre_neighbor; i++) fix[list_pre_neighbor[i]]->pre_neighbor();
+  for (int i = 0; i < n_pre_neighbor; i++) {
+    Fix *ifix = fix[list_pre_neighbor[i]];
+    timer->trace_begin(ifix->id, "pre_neighbor");
+    ifix->pre_neighbor();
+    timer->trace_end();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -435,7 +456,12 @@ void Modify::pre_neighbor()
 
 void Modify::post_neighbor()
 {
-  for (int i = 0; i < n_post_neighbor; i++) fix[list_post_neighbor[i]]->post_neighbor();
+  for (int i = 0; i < n_post_neighbor; i++) {
+    Fix *ifix = fix[list_post_neighbor[i]];
+    timer->trace_begin(ifix->id, "post_neighbor");
+    ifix->post_neighbor();
+    timer->trace_end();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -444,7 +470,12 @@ void Modify::post_neighbor()
 
 void Modify::pre_force(int vflag)
 {
-  for (int i = 0; i < n_pre_force; i++) fix[list_pre_force[i]]->pre_force(vflag);
+  for (int i = 0; i < n_pre_force; i++) {
+    Fix *ifix = fix[list_pre_force[i]];
+    timer->trace_begin(ifix->id, "pre_force");
+    ifix->pre_force(vflag);
+    timer->trace_end();
+  }
 }
 /* ----------------------------------------------------------------------
    pre_reverse call, only for relevant fixes
@@ -452,7 +483,12 @@ void Modify::pre_force(int vflag)
 
 void Modify::pre_reverse(int eflag, int vflag)
 {
-  for (int i = 0; i < n_pre_reverse; i++) fix[list_pre_reverse[i]]->pre_reverse(eflag, vflag);
+  for (int i = 0; i < n_pre_reverse; i++) {
+    Fix *ifix = fix[list_pre_reverse[i]];
+    timer->trace_begin(ifix->id, "pre_reverse");
+    ifix->pre_reverse(eflag, vflag);
+    timer->trace_end();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -464,11 +500,21 @@ void Modify::pre_reverse(int eflag, int vflag)
 void Modify::post_force(int vflag)
 {
   if (n_post_force_group) {
-    for (int i = 0; i < n_post_force_group; i++) fix[list_post_force_group[i]]->post_force(vflag);
+    for (int i = 0; i < n_post_force_group; i++) {
+      Fix *ifix = fix[list_post_force_group[i]];
+      timer->trace_begin(ifix->id, "post_force");
+      ifix->post_force(vflag);
+      timer->trace_end();
+    }
   }
 
   if (n_post_force) {
-    for (int i = 0; i < n_post_force; i++) fix[list_post_force[i]]->post_force(vflag);
+    for (int i = 0; i < n_post_force; i++) {
+      Fix *ifix = fix[list_post_force[i]];
+      timer->trace_begin(ifix->id, "post_force");
+      ifix->post_force(vflag);
+      timer->trace_end();
+    }
   }
 }
 
@@ -478,7 +524,12 @@ void Modify::post_force(int vflag)
 
 void Modify::final_integrate()
 {
-  for (int i = 0; i < n_final_integrate; i++) fix[list_final_integrate[i]]->final_integrate();
+  for (int i = 0; i < n_final_integrate; i++) {
+    Fix *ifix = fix[list_final_integrate[i]];
+    timer->trace_begin(ifix->id, "final_integrate");
+    ifix->final_integrate();
+    timer->trace_end();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -488,8 +539,14 @@ void Modify::final_integrate()
 
 void Modify::end_of_step()
 {
-  for (int i = 0; i < n_end_of_step; i++)
-    if (update->ntimestep % end_of_step_every[i] == 0) fix[list_end_of_step[i]]->end_of_step();
+  for (int i = 0; i < n_end_of_step; i++) {
+    if (update->ntimestep % end_of_step_every[i] == 0) {
+      Fix *ifix = fix[list_end_of_step[i]];
+      timer->trace_begin(ifix->id, "end_of_step");
+      ifix->end_of_step();
+      timer->trace_end();
+    }
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -1464,6 +1521,68 @@ void Modify::addstep_compute_all(bigint newstep)
     if (compute[icompute]->timeflag) compute[icompute]->addstep(newstep);
 }
 
+/* ----------------------------------------------------------------------
+   invoke compute_scalar() or compute_vector() of the requested computes
+     which = Compute::INVOKED_SCALAR or Compute::INVOKED_VECTOR
+   computes that provide per-proc partial sums and were not yet invoked
+     on this step are completed with a single combined MPI_Allreduce()
+   all other requests are left to the caller
+   called by Thermo and fixes before they invoke their computes one by one
+------------------------------------------------------------------------- */
+
+void Modify::reduce_computes(const std::vector<std::pair<Compute *, int>> &requests)
+{
+  std::vector<std::pair<Compute *, int>> batch;
+  int nsum = 0;
+
+  for (const auto &req : requests) {
+    int n = 0;
+    if (req.first->invoked_flag & req.second) continue;
+    if (req.second == Compute::INVOKED_SCALAR) n = req.first->npartial_scalar;
+    else if (req.second == Compute::INVOKED_VECTOR) n = req.first->npartial_vector;
+    if (n <= 0) continue;
+    if (std::find(batch.begin(), batch.end(), req) != batch.end()) continue;
+    batch.push_back(req);
+    nsum += n;
+  }
+
+  // nothing to gain for a single reduction
+
+  if (batch.size() < 2) return;
+
+  // temperature computes go first, so pressure computes find them completed
+
+  std::stable_partition(batch.begin(), batch.end(),
+                        [](const std::pair<Compute *, int> &b) { return b.first->tempflag != 0; });
+
+  std::vector<double> one(nsum), all(nsum);
+
+  int offset = 0;
+  for (const auto &b : batch) {
+    if (b.second == Compute::INVOKED_SCALAR) {
+      b.first->partial_scalar(&one[offset]);
+      offset += b.first->npartial_scalar;
+    } else {
+      b.first->partial_vector(&one[offset]);
+      offset += b.first->npartial_vector;
+    }
+  }
+
+  MPI_Allreduce(one.data(), all.data(), nsum, MPI_DOUBLE, MPI_SUM, world);
+
+  offset = 0;
+  for (const auto &b : batch) {
+    if (b.second == Compute::INVOKED_SCALAR) {
+      b.first->finish_scalar(&all[offset]);
+      offset += b.first->npartial_scalar;
+    } else {
+      b.first->finish_vector(&all[offset]);
+      offset += b.first->npartial_vector;
+    }
+    b.first->invoked_flag |= b.second;
+  }
+}
+
 /* ----------------------------------------------------------------------
    write to restart file for all Fixes with restart info
    (1) fixes that have global state
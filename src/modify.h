@@ -146,6 +146,7 @@ class Modify : protected Pointers {
   void clearstep_compute();
   void addstep_compute(bigint);
   void addstep_compute_all(bigint);
+  void reduce_computes(const std::vector<std::pair<class Compute *, int>> &);
 
   int check_package(const char *);
   int check_rigid_group_overlap(int);
@@ -21,6 +21,8 @@
 #include "my_page.h"
 #include "memory.h"
 
+#include <utility>
+
 using namespace LAMMPS_NS;
 
 static constexpr int PGDELTA = 1;
@@ -43,6 +45,7 @@ NeighList::NeighList(LAMMPS *lmp) : Pointers(lmp)
   occasional = 0;
   ghost = 0;
   ssa = 0;
+  cluster = 0;
   history = 0;
   respaouter = 0;
   respamiddle = 0;
@@ -64,6 +67,25 @@ NeighList::NeighList(LAMMPS *lmp) : Pointers(lmp)
 
   ipage = nullptr;
 
+  // cluster lists
+
+  nclusterall = 0;
+  clusteratoms = nullptr;
+  maxcluster = 0;
+
+  // pruned lists
+
+  prune = 0;
+  numneigh_outer = nullptr;
+  firstneigh_outer = nullptr;
+  ipage_outer = nullptr;
+
+  // lists split into owned and ghost neighbors
+
+  partition = 0;
+  numneigh_owned = nullptr;
+  maxowned = 0;
+
   // extra rRESPA lists
 
   inum_inner = gnum_inner = 0;
@@ -106,6 +128,12 @@ NeighList::~NeighList()
     delete [] ipage;
   }
 
+  memory->destroy(clusteratoms);
+
+  memory->destroy(numneigh_outer);
+  memory->sfree(firstneigh_outer);
+  delete [] ipage_outer;
+
   if (respainner) {
     memory->destroy(ilist_inner);
     memory->destroy(numneigh_inner);
@@ -141,6 +169,7 @@ void NeighList::post_constructor(NeighRequest *nq)
   occasional = nq->occasional;
   ghost = nq->ghost;
   ssa = nq->ssa;
+  cluster = nq->cluster;
   history = nq->history;
   respaouter = nq->respaouter;
   respamiddle = nq->respamiddle;
@@ -201,6 +230,70 @@ void NeighList::setup_pages(int pgsize_caller, int oneatom_caller)
   }
 }
 
+/* ----------------------------------------------------------------------
+   allocate pages and per-atom data of the outer list for list pruning
+   only done once, data is kept if pruning is turned off again
+------------------------------------------------------------------------- */
+
+void NeighList::setup_prune()
+{
+  if (ipage_outer) return;
+
+  int nmypage = comm->nthreads;
+  ipage_outer = new MyPage<int>[nmypage];
+  for (int i = 0; i < nmypage; i++)
+    ipage_outer[i].init(oneatom,pgsize,PGDELTA);
+
+  memory->create(numneigh_outer,maxatom,"neighlist:numneigh_outer");
+  firstneigh_outer = (int **) memory->smalloc(maxatom*sizeof(int *),
+                                              "neighlist:firstneigh_outer");
+}
+
+/* ----------------------------------------------------------------------
+   exchange regular and outer list data, called after a list build
+   moves the newly built list to the outer list and makes the
+     previous outer pages available for the pruned list
+------------------------------------------------------------------------- */
+
+void NeighList::swap_outer()
+{
+  std::swap(numneigh,numneigh_outer);
+  std::swap(firstneigh,firstneigh_outer);
+  std::swap(ipage,ipage_outer);
+}
+
+/* ----------------------------------------------------------------------
+   reorder neighbors of each I atom so that owned J atoms come first
+   called after a list build, so pairs of owned atoms can be computed
+     before ghost coords are updated by forward comm
+   also works for copy lists, which reorder the pages of their parent,
+     since no other list depends on the order of neighbors
+------------------------------------------------------------------------- */
+
+void NeighList::split_owned()
+{
+  if (atom->nmax > maxowned) {
+    maxowned = atom->nmax;
+    memory->destroy(numneigh_owned);
+    memory->create(numneigh_owned,maxowned,"neighlist:numneigh_owned");
+  }
+
+  const int nlocal = atom->nlocal;
+
+  for (int ii = 0; ii < inum; ii++) {
+    const int i = ilist[ii];
+    int *jlist = firstneigh[i];
+    int lo = 0;
+    int hi = numneigh[i] - 1;
+
+    while (lo <= hi) {
+      if ((jlist[lo] & NEIGHMASK) < nlocal) lo++;
+      else std::swap(jlist[lo],jlist[hi--]);
+    }
+    numneigh_owned[i] = lo;
+  }
+}
+
 /* ----------------------------------------------------------------------
    grow per-atom data to allow for nlocal/nall atoms
    triggered by neighbor list build
@@ -213,7 +306,7 @@ void NeighList::grow(int nlocal, int nall)
 
   if (ssa) {
     if ((nlocal * 3) + nall <= maxatom) return;
-  } else if (ghost) {
+  } else if (ghost || cluster) {
     if (nall <= maxatom) return;
   } else {
     if (nlocal <= maxatom) return;
@@ -230,6 +323,22 @@ void NeighList::grow(int nlocal, int nall)
   firstneigh = (int **) memory->smalloc(maxatom*sizeof(int *),
                                         "neighlist:firstneigh");
 
+  // each cluster holds at least one atom, so there are at most nall clusters
+
+  if (cluster) {
+    maxcluster = maxatom;
+    memory->destroy(clusteratoms);
+    memory->create(clusteratoms,CLUSTERSIZE*maxcluster,"neighlist:clusteratoms");
+  }
+
+  if (ipage_outer) {
+    memory->destroy(numneigh_outer);
+    memory->sfree(firstneigh_outer);
+    memory->create(numneigh_outer,maxatom,"neighlist:numneigh_outer");
+    firstneigh_outer = (int **) memory->smalloc(maxatom*sizeof(int *),
+                                                "neighlist:firstneigh_outer");
+  }
+
   if (respainner) {
     memory->destroy(ilist_inner);
     memory->destroy(numneigh_inner);
@@ -288,6 +397,9 @@ void NeighList::print_attributes()
   printf("  %d = kokkos host\n",rq->kokkos_host);
   printf("  %d = kokkos device\n",rq->kokkos_device);
   printf("  %d = ssa flag\n",ssa);
+  printf("  %d = cluster flag\n",cluster);
+  printf("  %d = prune flag\n",prune);
+  printf("  %d = partition flag\n",partition);
   printf("\n");
   printf("  %d = skip flag\n",rq->skip);
   printf("  %d = off2on\n",rq->off2on);
@@ -310,6 +422,7 @@ double NeighList::memory_usage()
   bytes += memory->usage(ilist,maxatom);
   bytes += memory->usage(numneigh,maxatom);
   bytes += (double)maxatom * sizeof(int *);
+  if (cluster) bytes += memory->usage(clusteratoms,CLUSTERSIZE*maxcluster);
 
   int nmypage = comm->nthreads;
 
@@ -318,6 +431,15 @@ double NeighList::memory_usage()
       bytes += ipage[i].size();
   }
 
+  bytes += memory->usage(numneigh_owned,maxowned);
+
+  if (ipage_outer) {
+    bytes += memory->usage(numneigh_outer,maxatom);
+    bytes += (double)maxatom * sizeof(int *);
+    for (int i = 0; i < nmypage; i++)
+      bytes += ipage_outer[i].size();
+  }
+
   if (respainner) {
     bytes += memory->usage(ilist_inner,maxatom);
     bytes += memory->usage(numneigh_inner,maxatom);
@@ -47,6 +47,7 @@ class NeighList : protected Pointers {
   int copymode;       // 1 if this is a Kokkos on-device copy
   int id;             // copied from neighbor list request
   int molskip;        // 1/2 if this is an intra-/inter-molecular skip list
+  int cluster;        // 1 if list stores neighbor clusters instead of atoms
 
   // data structs to store neighbor pairs I,J and associated values
 
@@ -61,6 +62,33 @@ class NeighList : protected Pointers {
   int oneatom;           // max size for one atom
   MyPage<int> *ipage;    // pages of neighbor indices
 
+  // data structs for cluster lists
+  // ilist/numneigh/firstneigh then refer to cluster indices, not atoms
+  // a cluster holds either only owned or only ghost atoms of one bin,
+  //   ilist stores the indices of the clusters of owned atoms
+
+  static constexpr int CLUSTERSIZE = 4;    // max # of atoms per cluster
+
+  int nclusterall;       // # of clusters of owned and ghost atoms
+  int *clusteratoms;     // CLUSTERSIZE atom indices per cluster, -1 if unused
+  int maxcluster;        // size of allocated per-cluster arrays
+
+  // data structs for pruned lists
+  // the full-skin outer list is kept here, numneigh/firstneigh store
+  //   the subset of pairs within the smaller pruning cutoff
+
+  int prune;                    // 1 if numneigh/firstneigh hold a pruned list
+  int *numneigh_outer;          // # of J neighbors for each I atom in outer list
+  int **firstneigh_outer;       // ptr to 1st J int value of each I atom in outer list
+  MyPage<int> *ipage_outer;     // pages of neighbor indices of outer list
+
+  // data structs for lists split into owned and ghost neighbors
+  // used to overlap forward comm of ghost coords with pair computation
+
+  int partition;           // 1 if owned J neighbors of each I atom are stored first
+  int *numneigh_owned;     // # of owned J neighbors for each I atom
+  int maxowned;            // size of numneigh_owned
+
   // data structs to store rRESPA neighbor pairs I,J and associated values
 
   int inum_inner;            // # of I atoms neighbors are stored for
@@ -107,6 +135,9 @@ class NeighList : protected Pointers {
   ~NeighList() override;
   void post_constructor(class NeighRequest *);
   void setup_pages(int, int);    // setup page data structures
+  void setup_prune();            // setup data structures of outer list
+  void swap_outer();             // exchange outer and regular list data
+  void split_owned();            // move owned neighbors in front of ghost neighbors
   void grow(int, int);           // grow all data structs
   void print_attributes();       // debug routine
   int get_maxlocal() { return maxatom; }
@@ -33,6 +33,7 @@
 #include "group.h"
 #include "memory.h"
 #include "modify.h"
+#include "my_page.h"
 #include "nbin.h"
 #include "neigh_list.h"
 #include "neigh_request.h"
@@ -48,6 +49,7 @@
 #include "style_nstencil.h"  // IWYU pragma: keep
 #include "style_ntopo.h"  // IWYU pragma: keep
 #include "suffix.h"
+#include "timer.h"
 #include "tokenizer.h"
 #include "update.h"
 
@@ -63,6 +65,14 @@ static constexpr int DELTA_PERATOM = 64;
 
 static constexpr double BIG = 1.0e20;
 
+// settings for automatic tuning of the skin distance
+
+static constexpr int AUTO_NBUILD = 10;          // # of builds per tuning window
+static constexpr int AUTO_NSAMPLE = 40;         // # of skins sampled per tuning
+static constexpr double AUTO_SKINMIN = 0.25;    // skin range relative to initial skin
+static constexpr double AUTO_SKINMAX = 2.0;
+static constexpr double AUTO_MAXCHANGE = 1.25;    // max change of skin per tuning
+
 enum{NONE,ALL,PARTIAL,TEMPLATE};
 
 static const char cite_neigh_multi_old[] =
@@ -136,6 +146,20 @@ pairclass(nullptr), pairnames(nullptr), pairmasks(nullptr)
   binsizeflag = 0;
   build_once = 0;
   cluster_check = 0;
+  autoflag = 0;
+  autotol = 0.02;
+  autoskin_ref = -1.0;
+  autoevery_ref = 1;
+  auto_step0 = -1;
+  pruneflag = 0;
+  prunebuffer = 0.0;
+  nprune = 0;
+  overlap_pair = 0;
+  nprunecalls = 0;
+  nrebuild = 0;
+  cutprunesq = nullptr;
+  xprune = nullptr;
+  maxprune = 0;
   ago = -1;
 
   cutneighmax = 0.0;
@@ -284,6 +308,8 @@ Neighbor::~Neighbor()
   delete neigh_improper;
 
   memory->destroy(xhold);
+  memory->destroy(cutprunesq);
+  memory->destroy(xprune);
 
   memory->destroy(ex1_type);
   memory->destroy(ex2_type);
@@ -365,39 +391,7 @@ void Neighbor::init()
     cuttypesq = new double[n+1];
   }
 
-  double cutoff,delta,cut;
-  cutneighmin = BIG;
-  cutneighmax = 0.0;
-
-  for (i = 1; i <= n; i++) {
-    cuttype[i] = cuttypesq[i] = 0.0;
-    for (j = 1; j <= n; j++) {
-      if (force->pair) cutoff = sqrt(force->pair->cutsq[i][j]);
-      else cutoff = 0.0;
-      if (cutoff > 0.0) delta = skin;
-      else delta = 0.0;
-      cut = cutoff + delta;
-
-      cutneighsq[i][j] = cut*cut;
-      cuttype[i] = MAX(cuttype[i],cut);
-      cuttypesq[i] = MAX(cuttypesq[i],cut*cut);
-      cutneighmin = MIN(cutneighmin,cut);
-      cutneighmax = MAX(cutneighmax,cut);
-
-      if (force->pair && force->pair->ghostneigh) {
-        cut = force->pair->cutghost[i][j] + skin;
-        cutneighghostsq[i][j] = cut*cut;
-      } else cutneighghostsq[i][j] = cut*cut;
-    }
-  }
-  cutneighmaxsq = cutneighmax * cutneighmax;
-
-  // update cutneighmin based on individual neighbor list requests
-
-  for (i = 0; i < nrequest; ++i) {
-    if (requests[i]->cut) cutneighmin = MIN(cutneighmin, requests[i]->cutoff +
-                                            (requests[i]->occasional ? 0.0 : skin));
-  }
+  init_cutoffs();
 
   // Define cutoffs for multi
   if (style == Neighbor::MULTI) {
@@ -515,6 +509,27 @@ void Neighbor::init()
     if (cut_respa[0]-skin < 0) cut_middle_inside_sq = 0.0;
   }
 
+  // automatic tuning of skin and check interval
+  // needs distance checks and per-category timings to make decisions
+  // tuning window restarts with each run since timers are reset
+  // tuned settings are restored to the input settings in cleanup() after the run
+
+  if (autoflag) {
+    if (!dist_check)
+      error->all(FLERR, Error::NOLASTLINE, "Neigh_modify auto requires neigh_modify check yes");
+    if (style == Neighbor::MULTI || style == Neighbor::MULTI_OLD)
+      error->all(FLERR, Error::NOLASTLINE, "Neigh_modify auto is not compatible with neighbor style multi");
+    if (respa)
+      error->all(FLERR, Error::NOLASTLINE, "Neigh_modify auto is not compatible with run style respa");
+    if (lmp->kokkos)
+      error->all(FLERR, Error::NOLASTLINE, "Neigh_modify auto is not supported by the KOKKOS package");
+    if (!timer->has_normal() && (me == 0))
+      error->warning(FLERR, "Neigh_modify auto requires timer normal or full, skin will not be tuned");
+    autoskin_ref = skin;
+    autoevery_ref = every;
+    auto_step0 = -1;
+  }
+
   must_check = restart_check = 0;
   if (output->restart_flag) must_check = restart_check = 1;
 
@@ -694,6 +709,11 @@ void Neighbor::init()
 
   if (!same && (nrequest > 0) && (comm->me == 0)) print_pairwise_info();
 
+  // select lists for pruning, uses request info
+
+  init_prune();
+  init_overlap();
+
   // can now delete requests so next run can make new ones
   // print_pairwise_info() made use of requests
   // set of NeighLists now stores all needed info
@@ -711,6 +731,147 @@ void Neighbor::init()
   init_topology();
 }
 
+/* ----------------------------------------------------------------------
+   select perpetual pair lists that are pruned between builds
+   only lists built directly from atoms and used by a pair style are pruned,
+     not lists with custom data or parents of derived (copy, skip, half) lists
+   lists with a custom cutoff are not pruned, since it can exceed the pair cutoff
+   pruning is only done during dynamics with the plain Verlet integrator,
+     which calls prune() after each regular forward communication
+------------------------------------------------------------------------- */
+
+void Neighbor::init_prune()
+{
+  int i,j;
+
+  nprune = 0;
+  nprunecalls = 0;
+  for (i = 0; i < nlist; i++) lists[i]->prune = 0;
+  if (!pruneflag) return;
+
+  if (update->whichflag != 1 || strcmp(update->integrate_style,"verlet") != 0) {
+    if (me == 0 && update->whichflag == 1)
+      error->warning(FLERR, "Neigh_modify prune requires run style verlet, lists will not be pruned");
+    return;
+  }
+  if (prunebuffer >= skin) {
+    if (me == 0)
+      error->warning(FLERR, "Neigh_modify prune buffer {} is not smaller than skin {}, "
+                     "lists will not be pruned", prunebuffer, skin);
+    return;
+  }
+
+  int n = atom->ntypes;
+  memory->destroy(cutprunesq);
+  memory->create(cutprunesq,n+1,n+1,"neigh:cutprunesq");
+  for (i = 1; i <= n; i++) {
+    for (j = 1; j <= n; j++) {
+      double cut = 0.0;
+      if (force->pair && force->pair->cutsq[i][j] > 0.0)
+        cut = sqrt(force->pair->cutsq[i][j]) + prunebuffer;
+      cutprunesq[i][j] = cut*cut;
+    }
+  }
+
+  for (i = 0; i < nlist; i++) {
+    NeighList *list = lists[i];
+    NeighRequest *rq = requests[i];
+    if (list->occasional || !list->pair_method || list->requestor_type != NeighList::PAIR)
+      continue;
+    if (list->copy || list->listskip || list->listfull || list->ghost || list->history ||
+        list->respaouter || list->ssa || list->cluster || list->kokkos)
+      continue;
+    if (rq->size || rq->bond || rq->intel || rq->cut) continue;
+
+    for (j = 0; j < nlist; j++)
+      if ((lists[j]->listcopy == list) || (lists[j]->listskip == list) ||
+          (lists[j]->listfull == list)) break;
+    if (j < nlist) continue;
+
+    list->prune = 1;
+    list->setup_prune();
+    nprune++;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   select pair list that is split into owned and ghost neighbors
+     so Verlet can compute pairs of owned atoms during forward comm
+   requires a pair style with compute_overlap() and no fixes which
+     need current ghost coords in pre_force()
+------------------------------------------------------------------------- */
+
+void Neighbor::init_overlap()
+{
+  overlap_pair = 0;
+  for (int i = 0; i < nlist; i++) lists[i]->partition = 0;
+  if (!comm->overlap || update->whichflag != 1 || strcmp(update->integrate_style,"verlet") != 0)
+    return;
+
+  Pair *pair = force->pair;
+  const char *reason = nullptr;
+  if (!pair || !pair->overlap_enable || !pair->compute_flag || !pair->list)
+    reason = "pair style does not support it";
+  else if (modify->n_pre_force)
+    reason = "fixes require updated ghost atoms in pre_force()";
+  else if (nprune)
+    reason = "neighbor lists are pruned";
+  else if (pair->list->kokkos || pair->list->history || pair->list->occasional)
+    reason = "pair style neighbor list cannot be split";
+
+  if (reason) {
+    if (me == 0) error->warning(FLERR, "Comm_modify overlap is ignored since {}", reason);
+    return;
+  }
+
+  pair->list->partition = 1;
+  overlap_pair = 1;
+}
+
+/* ----------------------------------------------------------------------
+   set per-type neighbor cutoffs from pair cutoffs and current skin
+------------------------------------------------------------------------- */
+
+void Neighbor::init_cutoffs()
+{
+  int i,j;
+  int n = atom->ntypes;
+
+  double cutoff,delta,cut;
+  cutneighmin = BIG;
+  cutneighmax = 0.0;
+
+  for (i = 1; i <= n; i++) {
+    cuttype[i] = cuttypesq[i] = 0.0;
+    for (j = 1; j <= n; j++) {
+      if (force->pair) cutoff = sqrt(force->pair->cutsq[i][j]);
+      else cutoff = 0.0;
+      if (cutoff > 0.0) delta = skin;
+      else delta = 0.0;
+      cut = cutoff + delta;
+
+      cutneighsq[i][j] = cut*cut;
+      cuttype[i] = MAX(cuttype[i],cut);
+      cuttypesq[i] = MAX(cuttypesq[i],cut*cut);
+      cutneighmin = MIN(cutneighmin,cut);
+      cutneighmax = MAX(cutneighmax,cut);
+
+      if (force->pair && force->pair->ghostneigh) {
+        cut = force->pair->cutghost[i][j] + skin;
+        cutneighghostsq[i][j] = cut*cut;
+      } else cutneighghostsq[i][j] = cut*cut;
+    }
+  }
+  cutneighmaxsq = cutneighmax * cutneighmax;
+
+  // update cutneighmin based on individual neighbor list requests
+
+  for (i = 0; i < nrequest; ++i) {
+    if (requests[i]->cut) cutneighmin = MIN(cutneighmin, requests[i]->cutoff +
+                                            (requests[i]->occasional ? 0.0 : skin));
+  }
+}
+
 /* ----------------------------------------------------------------------
    create and initialize lists of Nbin, Nstencil, NPair classes
    lists have info on all classes in 3 style*.h files
@@ -1316,6 +1477,7 @@ void Neighbor::morph_skip()
       if (irq->kokkos_host != jrq->kokkos_host) continue;
       if (irq->kokkos_device != jrq->kokkos_device) continue;
       if (irq->ssa != jrq->ssa) continue;
+      if (irq->cluster != jrq->cluster) continue;
 
       // 2 lists are a match
 
@@ -1479,6 +1641,7 @@ void Neighbor::morph_halffull()
       if (irq->kokkos_host != jrq->kokkos_host) continue;
       if (irq->kokkos_device != jrq->kokkos_device) continue;
       if (irq->ssa != jrq->ssa) continue;
+      if (irq->cluster != jrq->cluster) continue;
 
       // skip flag must be same
       // if both are skip lists, skip info must match
@@ -1592,6 +1755,7 @@ void Neighbor::morph_copy_trim()
       if (irq->kokkos_host && !jrq->kokkos_host) continue;
       if (irq->kokkos_device && !jrq->kokkos_device) continue;
       if (irq->ssa != jrq->ssa) continue;
+      if (irq->cluster != jrq->cluster) continue;
 
       // skip flag must be same
       // if both are skip lists, skip info must match
@@ -1877,6 +2041,7 @@ void Neighbor::print_pairwise_info()
     if (rq->kokkos_device) out += ", kokkos_device";
     if (rq->kokkos_host) out += ", kokkos_host";
     if (rq->ssa) out += ", ssa";
+    if (rq->cluster) out += ", cluster";
     if (rq->cut) out += fmt::format(", cut {}",rq->cutoff);
     if (rq->off2on) out += ", off2on";
     out += "\n";
@@ -2208,6 +2373,7 @@ int Neighbor::choose_pair(NeighRequest *rq)
     if (!rq->kokkos_device != !(mask & NP_KOKKOS_DEVICE)) continue;
     if (!rq->kokkos_host != !(mask & NP_KOKKOS_HOST)) continue;
     if (!rq->ssa != !(mask & NP_SSA)) continue;
+    if (!rq->cluster != !(mask & NP_CLUSTER)) continue;
 
     if (!rq->skip != !(mask & NP_SKIP)) continue;
 
@@ -2370,10 +2536,235 @@ int Neighbor::decide()
   if (ago >= delay && ago % every == 0) {
     if (build_once) return 0;
     if (dist_check == 0) return 1;
-    return check_distance();
+    int flag = check_distance();
+    if (flag && autoflag) autotune();
+    return flag;
   } else return 0;
 }
 
+/* ----------------------------------------------------------------------
+   tune skin and check interval from measured costs, called before a rebuild
+   collect Pair and Neighbor time and # of steps over AUTO_NBUILD builds
+   model for time per step at skin s with current skin s0 and force cutoff rc:
+     pair and build cost scale with (rc+s)^dim / (rc+s0)^dim,
+     steps between builds scale with s/s0, i.e. ballistic motion
+   switch to the skin with lowest predicted time per step
+     if gain is larger than tolerance, new skin is used for upcoming rebuild
+   check every half of shortest build interval, every step after dangerous builds
+------------------------------------------------------------------------- */
+
+void Neighbor::autotune()
+{
+  if (update->whichflag != 1 || !timer->has_normal()) return;
+
+  const bigint ntimestep = update->ntimestep;
+  const double tpair = timer->get_wall(Timer::PAIR);
+  const double tneigh = timer->get_wall(Timer::NEIGH);
+
+  // first build of tuning window only sets its reference values
+
+  if (auto_step0 >= 0) {
+    auto_nbuild++;
+    auto_minago = MIN(auto_minago, ago);
+    if (auto_nbuild < AUTO_NBUILD) return;
+
+    // average timings over all procs so that all make the same choice
+
+    double tlocal[2], tall[2];
+    tlocal[0] = tpair - auto_pair0;
+    tlocal[1] = tneigh - auto_neigh0;
+    MPI_Allreduce(tlocal, tall, 2, MPI_DOUBLE, MPI_SUM, world);
+
+    const double nsteps = (double) (ntimestep - auto_step0);
+    const double costpair = tall[0] / nprocs / nsteps;
+    const double costbuild = tall[1] / nprocs / auto_nbuild;
+    const double interval = nsteps / auto_nbuild;
+    const double cutforce = cutneighmax - skin;
+    double newskin = skin;
+
+    if ((cutforce > 0.0) && (skin > 0.0) && (costpair + costbuild > 0.0)) {
+      auto cost = [&](double s) {
+        const double scale = pow((cutforce + s) / (cutforce + skin), dimension);
+        return scale * (costpair + costbuild / MAX(1.0, interval * s / skin));
+      };
+
+      const double skinlo = MAX(AUTO_SKINMIN * autoskin_ref, skin / AUTO_MAXCHANGE);
+      const double skinhi = MIN(AUTO_SKINMAX * autoskin_ref, skin * AUTO_MAXCHANGE);
+      const double cost0 = cost(skin);
+      double costmin = cost0;
+      for (int i = 0; i <= AUTO_NSAMPLE; i++) {
+        const double s = skinlo + (skinhi - skinlo) * i / AUTO_NSAMPLE;
+        const double c = cost(s);
+        if (c < costmin) {
+          costmin = c;
+          newskin = s;
+        }
+      }
+      if (costmin > (1.0 - autotol) * cost0) newskin = skin;
+    }
+
+    // keep the delay setting, so every must remain a divisor of it
+
+    int newevery = 1;
+    if (ndanger == auto_ndanger)
+      newevery = MAX(1, static_cast<int>(0.5 * auto_minago * newskin / skin));
+    if (delay > 0)
+      while (delay % newevery) newevery--;
+
+    if ((me == 0) && ((newskin != skin) || (newevery != every)))
+      utils::logmesg(lmp, "Neighbor auto tuning on step {}: skin = {:.8} -> {:.8}, "
+                     "every = {} -> {}\n", ntimestep, skin, newskin, every, newevery);
+
+    every = newevery;
+    if (newskin != skin) reset_skin(newskin);
+  }
+
+  auto_step0 = ntimestep;
+  auto_nbuild = 0;
+  auto_minago = MAXSMALLINT;
+  auto_ndanger = ndanger;
+  auto_pair0 = tpair;
+  auto_neigh0 = tneigh;
+}
+
+/* ----------------------------------------------------------------------
+   change skin distance during a run, called before atoms are migrated
+   update cutoffs, ghost cutoff and bins, so the pending build uses new skin
+   NBin, NStencil, NPair classes need the new cutoffs, same as in init()
+------------------------------------------------------------------------- */
+
+void Neighbor::reset_skin(double newskin)
+{
+  skin = newskin;
+  triggersq = 0.25*skin*skin;
+  init_cutoffs();
+
+  for (int i = 0; i < nbin; i++) neigh_bin[i]->copy_neighbor_info();
+  for (int i = 0; i < nstencil; i++) neigh_stencil[i]->copy_neighbor_info();
+  for (int i = 0; i < nlist; i++)
+    if (neigh_pair[i]) neigh_pair[i]->copy_neighbor_info();
+
+  comm->setup();
+  if (style != Neighbor::NSQ) setup_bins();
+}
+
+/* ----------------------------------------------------------------------
+   restore skin and check interval after a run with auto tuning
+   later runs and commands between runs use the settings from the input
+------------------------------------------------------------------------- */
+
+void Neighbor::cleanup()
+{
+  if (!autoflag || (autoskin_ref < 0.0)) return;
+  if ((skin == autoskin_ref) && (every == autoevery_ref)) return;
+
+  if (me == 0)
+    utils::logmesg(lmp, "Neighbor auto tuning: restoring skin = {:.8}, every = {}\n",
+                   autoskin_ref, autoevery_ref);
+
+  every = autoevery_ref;
+  if (skin != autoskin_ref) reset_skin(autoskin_ref);
+}
+
+/* ----------------------------------------------------------------------
+   re-prune lists if any owned or ghost atom moved half the prune buffer
+     since the last pruning, called after forward communication
+   decision is local since lists only contain my owned and ghost atoms
+------------------------------------------------------------------------- */
+
+void Neighbor::prune()
+{
+  if (!nprune) return;
+
+  double **x = atom->x;
+  const int nall = atom->nlocal + atom->nghost;
+  const double deltasq = 0.25*prunebuffer*prunebuffer;
+
+  for (int i = 0; i < nall; i++) {
+    const double delx = x[i][0] - xprune[i][0];
+    const double dely = x[i][1] - xprune[i][1];
+    const double delz = x[i][2] - xprune[i][2];
+    if (delx*delx + dely*dely + delz*delz > deltasq) {
+      prune_lists();
+      return;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   store pairs of outer lists within the pruning cutoff in regular lists
+   keeps neighbor bits of outer list entries
+------------------------------------------------------------------------- */
+
+void Neighbor::prune_lists()
+{
+  int i,j,ii,jj,n,inum,jnum,itype;
+  double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
+  int *jlist,*neighptr;
+
+  double **x = atom->x;
+  int *type = atom->type;
+  const int nall = atom->nlocal + atom->nghost;
+
+  if (atom->nmax > maxprune) {
+    maxprune = atom->nmax;
+    memory->destroy(xprune);
+    memory->create(xprune,maxprune,3,"neigh:xprune");
+  }
+  for (i = 0; i < nall; i++) {
+    xprune[i][0] = x[i][0];
+    xprune[i][1] = x[i][1];
+    xprune[i][2] = x[i][2];
+  }
+
+  for (int m = 0; m < nlist; m++) {
+    NeighList *list = lists[m];
+    if (!list->prune) continue;
+
+    inum = list->inum;
+    int *ilist = list->ilist;
+    int *numneigh = list->numneigh;
+    int **firstneigh = list->firstneigh;
+    int *numneigh_outer = list->numneigh_outer;
+    int **firstneigh_outer = list->firstneigh_outer;
+    // pruned list is stored serially in the first page
+    // reset all per-thread pages, which may hold entries from an older build
+
+    MyPage<int> *ipage = list->ipage;
+    for (int tid = 0; tid < comm->nthreads; tid++) list->ipage[tid].reset();
+
+    for (ii = 0; ii < inum; ii++) {
+      i = ilist[ii];
+      itype = type[i];
+      xtmp = x[i][0];
+      ytmp = x[i][1];
+      ztmp = x[i][2];
+      jlist = firstneigh_outer[i];
+      jnum = numneigh_outer[i];
+      neighptr = ipage->vget();
+      n = 0;
+
+      for (jj = 0; jj < jnum; jj++) {
+        j = jlist[jj] & NEIGHMASK;
+        delx = xtmp - x[j][0];
+        dely = ytmp - x[j][1];
+        delz = ztmp - x[j][2];
+        rsq = delx*delx + dely*dely + delz*delz;
+        if (rsq <= cutprunesq[itype][type[j]]) neighptr[n++] = jlist[jj];
+      }
+
+      firstneigh[i] = neighptr;
+      numneigh[i] = n;
+      ipage->vgot(n);
+      if (ipage->status())
+        error->one(FLERR, Error::NOLASTLINE,
+                   "Neighbor list overflow, boost neigh_modify one" + utils::errorurl(36));
+    }
+  }
+
+  nprunecalls++;
+}
+
 /* ----------------------------------------------------------------------
    if any atom moved trigger distance (half of neighbor skin) return 1
    shrink trigger distance if box size has changed
@@ -2452,6 +2843,7 @@ void Neighbor::build(int topoflag)
 
   ago = 0;
   ncalls++;
+  nrebuild++;
   lastcall = update->ntimestep;
 
   int nlocal = atom->nlocal;
@@ -2526,6 +2918,20 @@ void Neighbor::build(int topoflag)
     neigh_pair[m]->build(lists[m]);
   }
 
+  // new lists become outer lists, then prune them for the pair styles
+
+  if (nprune) {
+    for (i = 0; i < npair_perpetual; i++)
+      if (lists[plist[i]]->prune) lists[plist[i]]->swap_outer();
+    prune_lists();
+  }
+
+  // split pair list into owned and ghost neighbors for forward comm overlap
+
+  if (overlap_pair)
+    for (i = 0; i < nlist; i++)
+      if (lists[i]->partition) lists[i]->split_owned();
+
   // build topology lists for bonds/angles/etc
   // skip if GPU package styles will call it explicitly to overlap with GPU computation.
 
@@ -2549,6 +2955,7 @@ void Neighbor::build(int topoflag)
 
 void Neighbor::build_topology()
 {
+  nrebuild++;
   if (force->bond) {
     neigh_bond->build();
     nbondlist = neigh_bond->nbondlist;
@@ -2719,6 +3126,26 @@ void Neighbor::modify_params(int narg, char **arg)
       if (binsize_user <= 0.0) binsizeflag = 0;
       else binsizeflag = 1;
       iarg += 2;
+    } else if (strcmp(arg[iarg],"auto") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "neigh_modify auto", error);
+      autoflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"tolerance") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "neigh_modify tolerance", error);
+      autotol = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      if ((autotol < 0.0) || (autotol >= 1.0))
+        error->all(FLERR, iarg+1, "Invalid neigh_modify tolerance argument: {}", autotol);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"prune") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "neigh_modify prune", error);
+      if (strcmp(arg[iarg+1],"no") == 0) pruneflag = 0;
+      else {
+        pruneflag = 1;
+        prunebuffer = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+        if (prunebuffer < 0.0)
+          error->all(FLERR, iarg+1, "Invalid neigh_modify prune argument: {}", prunebuffer);
+      }
+      iarg += 2;
     } else if (strcmp(arg[iarg],"cluster") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "neigh_modify cluster", error);
       cluster_check = utils::logical(FLERR,arg[iarg+1],false,lmp);
@@ -34,6 +34,12 @@ class Neighbor : protected Pointers {
   int oneatom;         // max # of neighbors for one atom
   int includegroup;    // only build pairwise lists for this group
   int build_once;      // 1 if only build lists once per run
+  int autoflag;        // 1 if skin and check interval are tuned during a run
+  double autotol;      // min relative gain per step to accept a new skin
+  int pruneflag;       // 1 if pair lists are pruned between builds
+  double prunebuffer;  // distance beyond force cutoff kept in pruned lists
+  int nprune;          // # of lists that are pruned in current run
+  int overlap_pair;    // 1 if pair list is split for forward comm overlap
 
   double skin;                    // skin distance
   double cutneighmin;             // min neighbor cutoff for all type pairs
@@ -51,8 +57,10 @@ class Neighbor : protected Pointers {
   double binsize_user;    // set externally by some accelerator pkgs
 
   bigint ncalls;      // # of times build has been called
+  bigint nprunecalls; // # of times lists were pruned on this proc
   bigint ndanger;     // # of dangerous builds
   bigint lastcall;    // timestep of last neighbor::build() call
+  bigint nrebuild;    // # of list or topology rebuilds, never reset
 
   // geometry and static info, used by other Neigh classes
 
@@ -145,6 +153,8 @@ class Neighbor : protected Pointers {
   bool has_intel_request() const;
 
   int decide();                     // decide whether to build or not
+  void prune();                     // prune lists if atoms moved far enough
+  void cleanup();                   // restore settings changed by auto tuning
   virtual int check_distance();     // check max distance moved since last build
   void setup_bins();                // setup bins based on box and cutoff
   virtual void build(int);          // build all perpetual neighbor lists
@@ -205,6 +215,19 @@ class Neighbor : protected Pointers {
 
   double inner[2], middle[2];    // rRESPA cutoffs for extra lists
 
+  double **cutprunesq;    // pruning cutoff sq for each type pair
+  double **xprune;        // owned and ghost atom coords at last pruning
+  int maxprune;           // size of xprune array
+
+  double autoskin_ref;         // skin set in input, sets range of skins, restored after run
+  int autoevery_ref;           // every setting in input, restored after run
+  bigint auto_step0;           // timestep at start of tuning window, -1 if none
+  int auto_nbuild;             // # of builds in current tuning window
+  int auto_minago;             // min # of steps between builds in tuning window
+  bigint auto_ndanger;         // # of dangerous builds at start of tuning window
+  double auto_pair0;           // Pair wall time at start of tuning window
+  double auto_neigh0;          // Neighbor wall time at start of tuning window
+
   int old_style, old_triclinic;    // previous run info
   int old_pgsize, old_oneatom;     // used to avoid re-creating neigh lists
 
@@ -255,6 +278,7 @@ class Neighbor : protected Pointers {
   // including creator methods for Nbin,Nstencil,Npair instances
 
   void init_styles();
+  void init_cutoffs();
   int init_pair();
   virtual void init_topology();
 
@@ -269,6 +293,13 @@ class Neighbor : protected Pointers {
   void print_pairwise_info();
   void requests_new2old();
 
+  void autotune();
+  void reset_skin(double);
+
+  void init_prune();
+  void prune_lists();
+  void init_overlap();
+
   int choose_bin(class NeighRequest *);
   int choose_stencil(class NeighRequest *);
   int choose_pair(class NeighRequest *);
@@ -340,7 +371,8 @@ namespace NeighConst {
     NP_HALF_FULL = 1 << 23,
     NP_OFF2ON = 1 << 24,
     NP_MULTI_OLD = 1 << 25,
-    NP_TRIM = 1 << 26
+    NP_TRIM = 1 << 26,
+    NP_CLUSTER = 1 << 27
   };
 
   enum {
@@ -355,6 +387,7 @@ namespace NeighConst {
     REQ_NEWTON_ON = 1 << 8,
     REQ_NEWTON_OFF = 1 << 9,
     REQ_SSA = 1 << 10,
+    REQ_CLUSTER = 1 << 11,
   };
 }    // namespace NeighConst
 
@@ -0,0 +1,168 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "npair_bin_cluster.h"
+
+#include "atom.h"
+#include "error.h"
+#include "memory.h"
+#include "my_page.h"
+#include "neigh_list.h"
+
+using namespace LAMMPS_NS;
+
+static constexpr int CLUSTERSIZE = NeighList::CLUSTERSIZE;
+
+/* ---------------------------------------------------------------------- */
+
+NPairBinCluster::NPairBinCluster(LAMMPS *lmp) :
+    NPair(lmp), binfirst(nullptr), binnum(nullptr), clusterbox(nullptr)
+{
+  maxbin = maxbox = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+NPairBinCluster::~NPairBinCluster()
+{
+  memory->destroy(binfirst);
+  memory->destroy(binnum);
+  memory->destroy(clusterbox);
+}
+
+/* ----------------------------------------------------------------------
+   binned neighbor list construction for clusters of atoms
+   atoms of each bin are grouped into clusters of up to CLUSTERSIZE atoms,
+     owned atoms come first in the bin list, so no cluster mixes
+     owned and ghost atoms
+   each cluster of owned atoms checks all clusters in its own bin
+     and the other bins of a full stencil, including itself
+   a cluster pair is stored if their bounding boxes are within the
+     largest neighbor cutoff, the pair style does the per-atom check
+   every cluster pair appears in the list of both clusters (full list)
+   exclusions and special bonds are not encoded, requestor must check
+------------------------------------------------------------------------- */
+
+void NPairBinCluster::build(NeighList *list)
+{
+  int i, j, k, c, jc, n, ibin, jbin, nc, nslot;
+  double dx, dy, dz;
+  int *neighptr;
+
+  double **x = atom->x;
+  int nlocal = atom->nlocal;
+  if (includegroup) nlocal = atom->nfirst;
+  const int ntypes = atom->ntypes;
+
+  // pairs of clusters are screened against the largest per-type cutoff
+
+  double cutmaxsq = 0.0;
+  for (i = 1; i <= ntypes; i++)
+    for (j = 1; j <= ntypes; j++) cutmaxsq = MAX(cutmaxsq, cutneighsq[i][j]);
+
+  if (mbins > maxbin) {
+    maxbin = mbins;
+    memory->destroy(binfirst);
+    memory->destroy(binnum);
+    memory->create(binfirst, maxbin, "neigh:binfirst");
+    memory->create(binnum, maxbin, "neigh:binnum");
+  }
+  if (list->maxcluster > maxbox) {
+    maxbox = list->maxcluster;
+    memory->destroy(clusterbox);
+    memory->create(clusterbox, 6 * maxbox, "neigh:clusterbox");
+  }
+
+  int *clusteratoms = list->clusteratoms;
+  int *ilist = list->ilist;
+  int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+  MyPage<int> *ipage = list->ipage;
+
+  // assign atoms of each bin to clusters and compute their bounding boxes
+  // a new cluster is started when the current one is full
+  //   or when the bin list switches from owned to ghost atoms
+
+  nc = 0;
+  for (ibin = 0; ibin < mbins; ibin++) {
+    binfirst[ibin] = nc;
+    nslot = CLUSTERSIZE;
+    int ghostflag = 0;
+
+    for (j = binhead[ibin]; j >= 0; j = bins[j]) {
+      if (!ghostflag && j >= nlocal) {
+        ghostflag = 1;
+        nslot = CLUSTERSIZE;
+      }
+      if (nslot == CLUSTERSIZE) {
+        for (k = 0; k < CLUSTERSIZE; k++) clusteratoms[nc * CLUSTERSIZE + k] = -1;
+        double *box = &clusterbox[6 * nc];
+        box[0] = box[3] = x[j][0];
+        box[1] = box[4] = x[j][1];
+        box[2] = box[5] = x[j][2];
+        nc++;
+        nslot = 0;
+      }
+      c = nc - 1;
+      clusteratoms[c * CLUSTERSIZE + nslot++] = j;
+      double *box = &clusterbox[6 * c];
+      for (k = 0; k < 3; k++) {
+        box[k] = MIN(box[k], x[j][k]);
+        box[k + 3] = MAX(box[k + 3], x[j][k]);
+      }
+    }
+    binnum[ibin] = nc - binfirst[ibin];
+  }
+  list->nclusterall = nc;
+
+  // loop over clusters of owned atoms in each bin, they precede ghost clusters
+
+  int inum = 0;
+  ipage->reset();
+
+  for (ibin = 0; ibin < mbins; ibin++) {
+    const int cfirst = binfirst[ibin];
+    const int clast = cfirst + binnum[ibin];
+
+    for (c = cfirst; c < clast; c++) {
+      if (clusteratoms[c * CLUSTERSIZE] >= nlocal) break;
+
+      n = 0;
+      neighptr = ipage->vget();
+      const double *ibox = &clusterbox[6 * c];
+
+      for (k = 0; k < nstencil; k++) {
+        jbin = ibin + stencil[k];
+        const int jlast = binfirst[jbin] + binnum[jbin];
+        for (jc = binfirst[jbin]; jc < jlast; jc++) {
+          const double *jbox = &clusterbox[6 * jc];
+          dx = MAX(0.0, MAX(ibox[0] - jbox[3], jbox[0] - ibox[3]));
+          dy = MAX(0.0, MAX(ibox[1] - jbox[4], jbox[1] - ibox[4]));
+          dz = MAX(0.0, MAX(ibox[2] - jbox[5], jbox[2] - ibox[5]));
+          if (dx * dx + dy * dy + dz * dz <= cutmaxsq) neighptr[n++] = jc;
+        }
+      }
+
+      ilist[inum++] = c;
+      firstneigh[c] = neighptr;
+      numneigh[c] = n;
+      ipage->vgot(n);
+      if (ipage->status())
+        error->one(FLERR, Error::NOLASTLINE,
+                   "Neighbor list overflow, boost neigh_modify one" + utils::errorurl(36));
+    }
+  }
+
+  list->inum = inum;
+  list->gnum = 0;
+}
@@ -0,0 +1,47 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef NPAIR_CLASS
+// clang-format off
+NPairStyle(full/bin/cluster,
+           NPairBinCluster,
+           NP_FULL | NP_BIN | NP_CLUSTER |
+           NP_NEWTON | NP_NEWTOFF | NP_ORTHO | NP_TRI);
+// clang-format on
+#else
+
+#ifndef LMP_NPAIR_BIN_CLUSTER_H
+#define LMP_NPAIR_BIN_CLUSTER_H
+
+#include "npair.h"
+
+namespace LAMMPS_NS {
+
+class NPairBinCluster : public NPair {
+ public:
+  NPairBinCluster(class LAMMPS *);
+  ~NPairBinCluster() override;
+  void build(class NeighList *) override;
+
+ protected:
+  int maxbin;           // size of allocated per-bin arrays
+  int *binfirst;        // index of first cluster in each bin
+  int *binnum;          // # of clusters in each bin
+  int maxbox;           // size of allocated bounding box array
+  double *clusterbox;    // lo/hi bounding box corners of each cluster
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -600,6 +600,15 @@ int Output::check_time_dumps(bigint ntimestep)
   return nowflag;
 }
 
+/* ----------------------------------------------------------------------
+   let dumps complete output still pending at the end of a run or minimization
+------------------------------------------------------------------------- */
+
+void Output::post_run()
+{
+  for (int idump = 0; idump < ndump; idump++) dump[idump]->post_run();
+}
+
 /* ----------------------------------------------------------------------
    force restart file(s) to be written
    called from PRD and TAD
@@ -1002,6 +1011,18 @@ void Output::create_restart(int narg, char **arg)
       error->all(FLERR,"Both restart files must use % or neither");
   }
 
+  int mpiioflag;
+  if (utils::strmatch(arg[1],"\\.mpiio$")) mpiioflag = 1;
+  else mpiioflag = 0;
+  if (nfile == 2) {
+    if (mpiioflag && !utils::strmatch(arg[2],"\\.mpiio$"))
+      error->all(FLERR,"Both restart files must use MPI-IO or neither");
+    if (!mpiioflag && utils::strmatch(arg[2],"\\.mpiio$"))
+      error->all(FLERR,"Both restart files must use MPI-IO or neither");
+  }
+  if (multiproc && mpiioflag)
+    error->all(FLERR,"Cannot use % and .mpiio in the same restart file name");
+
   // setup output style and process optional args
 
   delete restart;
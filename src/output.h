@@ -77,6 +77,7 @@ class Output : protected Pointers {
   void write(bigint);             // output for current timestep
   void write_dump(bigint);        // force output of dump snapshots
   void write_restart(bigint);     // force output of a restart file
+  void post_run();                // complete pending output at end of run
   void reset_timestep(bigint);    // reset output which depends on timestep
   void reset_dt();                // reset output which depends on timestep size
 
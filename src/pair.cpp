@@ -75,6 +75,7 @@ Pair::Pair(LAMMPS *lmp) :
   single_hessian_enable = 0;
   restartinfo = 1;
   respa_enable = 0;
+  overlap_enable = 0;
   one_coeff = 0;
   no_virial_fdotr_compute = 0;
   writedata = 0;
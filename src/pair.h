@@ -58,6 +58,7 @@ class Pair : protected Pointers {
 
   int restartinfo;                // 1 if pair style writes restart info
   int respa_enable;               // 1 if inner/middle/outer rRESPA routines
+  int overlap_enable;             // 1 if compute_overlap() routine exists
   int one_coeff;                  // 1 if allows only one coeff * * call
   int manybody_flag;              // 1 if a manybody potential
   int unit_convert_flag;          // value != 0 indicates support for unit conversion.
@@ -158,6 +159,11 @@ class Pair : protected Pointers {
   virtual void compute_inner() {}
   virtual void compute_middle() {}
   virtual void compute_outer(int, int) {}
+
+  // compute in two passes for a list with owned neighbors stored first
+  // 3rd arg = 0: pairs of owned atoms, 1: pairs with ghost atoms
+
+  virtual void compute_overlap(int, int, int) {}
   virtual double compute_atomic_energy(int, NeighList *) { return 0.0; }
 
   virtual double single(int, int, int, int, double, double, double, double &fforce)
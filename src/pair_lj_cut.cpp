@@ -39,6 +39,7 @@ using namespace MathConst;
 PairLJCut::PairLJCut(LAMMPS *lmp) : Pair(lmp)
 {
   respa_enable = 1;
+  overlap_enable = 1;
   born_matrix_enable = 1;
   writedata = 1;
 }
@@ -68,13 +69,40 @@ PairLJCut::~PairLJCut()
 
 void PairLJCut::compute(int eflag, int vflag)
 {
-  int i, j, ii, jj, inum, jnum, itype, jtype;
+  ev_init(eflag, vflag);
+
+  eval_neigh(eflag, ALLNEIGH);
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
+/* ----------------------------------------------------------------------
+   compute pairs with owned (ghostflag = 0) or ghost (ghostflag = 1) J atoms
+   list stores owned neighbors first, see NeighList::split_owned()
+   first pass initializes accumulators, second pass completes the virial
+------------------------------------------------------------------------- */
+
+void PairLJCut::compute_overlap(int eflag, int vflag, int ghostflag)
+{
+  if (!ghostflag) ev_init(eflag, vflag);
+
+  eval_neigh(eflag, ghostflag ? GHOSTNEIGH : OWNEDNEIGH);
+
+  if (ghostflag && vflag_fdotr) virial_fdotr_compute();
+}
+
+/* ----------------------------------------------------------------------
+   loop over all, only owned, or only ghost J neighbors of my atoms
+------------------------------------------------------------------------- */
+
+void PairLJCut::eval_neigh(int eflag, int range)
+{
+  int i, j, ii, jj, inum, jfrom, jto, itype, jtype;
   double xtmp, ytmp, ztmp, delx, dely, delz, evdwl, fpair;
   double rsq, r2inv, r6inv, forcelj, factor_lj;
-  int *ilist, *jlist, *numneigh, **firstneigh;
+  int *ilist, *jlist, *numneigh, *numneigh_owned, **firstneigh;
 
   evdwl = 0.0;
-  ev_init(eflag, vflag);
 
   double **x = atom->x;
   double **f = atom->f;
@@ -86,6 +114,7 @@ void PairLJCut::compute(int eflag, int vflag)
   inum = list->inum;
   ilist = list->ilist;
   numneigh = list->numneigh;
+  numneigh_owned = list->numneigh_owned;
   firstneigh = list->firstneigh;
 
   // loop over neighbors of my atoms
@@ -97,9 +126,10 @@ void PairLJCut::compute(int eflag, int vflag)
     ztmp = x[i][2];
     itype = type[i];
     jlist = firstneigh[i];
-    jnum = numneigh[i];
+    jfrom = (range == GHOSTNEIGH) ? numneigh_owned[i] : 0;
+    jto = (range == OWNEDNEIGH) ? numneigh_owned[i] : numneigh[i];
 
-    for (jj = 0; jj < jnum; jj++) {
+    for (jj = jfrom; jj < jto; jj++) {
       j = jlist[jj];
       factor_lj = special_lj[sbmask(j)];
       j &= NEIGHMASK;
@@ -134,8 +164,6 @@ void PairLJCut::compute(int eflag, int vflag)
       }
     }
   }
-
-  if (vflag_fdotr) virial_fdotr_compute();
 }
 
 /* ---------------------------------------------------------------------- */
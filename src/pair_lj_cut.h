@@ -46,6 +46,7 @@ class PairLJCut : public Pair {
   void compute_inner() override;
   void compute_middle() override;
   void compute_outer(int, int) override;
+  void compute_overlap(int, int, int) override;
 
  protected:
   double cut_global;
@@ -55,6 +56,11 @@ class PairLJCut : public Pair {
   double *cut_respa;
 
   virtual void allocate();
+
+  // range of J neighbors in eval_neigh(), owned neighbors are stored first for overlap
+
+  enum { ALLNEIGH, OWNEDNEIGH, GHOSTNEIGH };
+  void eval_neigh(int, int);
 };
 
 }    // namespace LAMMPS_NS
@@ -435,6 +435,17 @@ bigint ReadDump::next(bigint ncurrent, bigint nlast, int nevery, int nskip)
   return ntimestep;
 }
 
+/* ----------------------------------------------------------------------
+   skip the remainder of the current snapshot without reading it
+   current snapshot is the one whose timestep was returned by seek() or next()
+------------------------------------------------------------------------- */
+
+void ReadDump::skip()
+{
+  if (filereader)
+    for (int i = 0; i < nreader; i++) readers[i]->skip();
+}
+
 /* ----------------------------------------------------------------------
    read and broadcast and store snapshot header info
    set nsnapatoms = # of atoms in snapshot
@@ -37,6 +37,7 @@ class ReadDump : public Command {
   bigint seek(bigint, int);
   void header(int);
   bigint next(bigint, bigint, int, int);
+  void skip();
   void atoms();
   int fields_and_keywords(int, char **);
 
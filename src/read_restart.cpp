@@ -43,7 +43,7 @@ using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
-ReadRestart::ReadRestart(LAMMPS *lmp) : Command(lmp) {}
+ReadRestart::ReadRestart(LAMMPS *lmp) : Command(lmp), mpiio_sizes(nullptr) {}
 
 /* ---------------------------------------------------------------------- */
 
@@ -88,8 +88,10 @@ void ReadRestart::command(int narg, char **arg)
 
   if (strchr(arg[0],'%')) multiproc = 1;
   else multiproc = 0;
-  if (utils::strmatch(arg[0],"\\.mpiio"))
-    error->all(FLERR,"MPI-IO files are no longer supported by LAMMPS");
+  if (utils::strmatch(arg[0],"\\.mpiio$")) mpiioflag = 1;
+  else mpiioflag = 0;
+  if (multiproc && mpiioflag)
+    error->all(FLERR,"Cannot use % and .mpiio in the same restart file name");
 
   // open single restart file or base file for multiproc case
 
@@ -159,11 +161,15 @@ void ReadRestart::command(int narg, char **arg)
   file_layout();
 
   // close header file if in multiproc mode
+  // for MPI-IO file, atom data starts at the current file position
 
-  if (multiproc && me == 0) {
+  bigint headersize = 0;
+  if ((multiproc || mpiioflag) && me == 0) {
+    if (mpiioflag) headersize = ftell(fp);
     fclose(fp);
     fp = nullptr;
   }
+  if (mpiioflag) MPI_Bcast(&headersize,1,MPI_LMP_BIGINT,0,world);
 
   // read per-proc info
 
@@ -173,6 +179,49 @@ void ReadRestart::command(int narg, char **arg)
   double *buf = nullptr;
   int m,flag;
 
+  // input of single MPI-IO file
+  // nprocs_file = # of chunks in file, stored back-to-back after header
+  // chunk I is read by proc I*nprocs/nprocs_file, so each proc reads
+  //   a contiguous range of chunks with one collective read
+  // each proc keeps all atoms in its chunks, migrated below
+
+  if (mpiioflag) {
+    bigint offset = headersize;
+    bigint mystart = -1;
+    bigint nread = 0;
+    for (int iproc = 0; iproc < nprocs_file; iproc++) {
+      int owner = static_cast<int>((bigint) iproc * nprocs / nprocs_file);
+      if (owner == me) {
+        if (mystart < 0) mystart = offset;
+        nread += mpiio_sizes[iproc];
+      }
+      offset += (bigint) mpiio_sizes[iproc] * sizeof(double);
+    }
+    if (mystart < 0) mystart = headersize;
+    if (nread > MAXSMALLINT)
+      error->one(FLERR,"Too much per-proc info in MPI-IO restart file");
+
+    n = static_cast<int>(nread);
+    if (n > maxbuf) {
+      maxbuf = n;
+      memory->destroy(buf);
+      memory->create(buf,maxbuf,"read_restart:buf");
+    }
+
+    MPI_File fh;
+    int err = MPI_File_open(world,file,MPI_MODE_RDONLY,MPI_INFO_NULL,&fh);
+    if (err != MPI_SUCCESS)
+      error->one(FLERR,"Cannot open restart file {} for MPI-IO",file);
+    err = MPI_File_read_at_all(fh,mystart,buf,n,MPI_DOUBLE,MPI_STATUS_IGNORE);
+    if (err != MPI_SUCCESS)
+      error->one(FLERR,"Error reading MPI-IO restart file {}",file);
+    MPI_File_close(&fh);
+    memory->destroy(mpiio_sizes);
+
+    m = 0;
+    while (m < n) m += avec->unpack_restart(&buf[m]);
+  }
+
   // input of single native file
   // nprocs_file = # of chunks in file
   // proc 0 reads a chunk and bcasts it to other procs
@@ -180,7 +229,7 @@ void ReadRestart::command(int narg, char **arg)
   // if remapflag set, remap the atom to box before checking sub-domain
   // check for atom in sub-domain differs for orthogonal vs triclinic box
 
-  if (multiproc == 0) {
+  else if (multiproc == 0) {
 
     int triclinic = domain->triclinic;
     imageint *iptr;
@@ -379,7 +428,7 @@ void ReadRestart::command(int narg, char **arg)
   // for multiproc or MPI-IO files:
   // perform irregular comm to migrate atoms to correct procs
 
-  if (multiproc) {
+  if (multiproc || mpiioflag) {
 
     // if remapflag set, remap all atoms I read back to box before migrating
 
@@ -958,6 +1007,7 @@ void ReadRestart::force_fields()
 
 void ReadRestart::file_layout()
 {
+  int mpiio_found = 0;
   int flag = read_int();
   while (flag >= 0) {
 
@@ -967,9 +1017,24 @@ void ReadRestart::file_layout()
         error->all(FLERR,"Restart file is not a multi-proc file");
       if (multiproc && multiproc_file == 0)
         error->all(FLERR,"Restart file is a multi-proc file");
+
+    } else if (flag == MPIIO) {
+      int mpiioflag_file = read_int();
+      if (mpiioflag == 0 && mpiioflag_file)
+        error->all(FLERR,"Restart file is a MPI-IO file");
+      if (mpiioflag && mpiioflag_file == 0)
+        error->all(FLERR,"Restart file is not a MPI-IO file");
+      if (mpiioflag) {
+        memory->create(mpiio_sizes,nprocs_file,"read_restart:mpiio_sizes");
+        read_int_vec(nprocs_file,mpiio_sizes);
+        mpiio_found = 1;
+      }
     }
     flag = read_int();
   }
+
+  if (mpiioflag && !mpiio_found)
+    error->all(FLERR,"Restart file is not a MPI-IO file");
 }
 
 // ----------------------------------------------------------------------
@@ -38,6 +38,8 @@ class ReadRestart : public Command {
   int multiproc_file;    // # of parallel files in restart
   int nprocs_file;       // total # of procs that wrote restart file
   int revision;          // revision number of the restart file format
+  int mpiioflag;         // 1 = restart file is a single MPI-IO file
+  int *mpiio_sizes;      // # of doubles in each per-proc chunk of MPI-IO file
 
   std::string file_search(const std::string &);
   void header();
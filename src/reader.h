@@ -18,6 +18,8 @@
 
 #include "pointers.h"
 
+#include <map>
+
 namespace LAMMPS_NS {
 
 class Reader : protected Pointers {
@@ -43,6 +45,10 @@ class Reader : protected Pointers {
   FILE *fp;           // pointer to opened file or pipe
   bool compressed;    // flag for dump file compression
   bool binary;        // flag for (native) binary files
+
+  void match_fields(const std::map<std::string, int> &, int, int, int *, char **, int, int, int *,
+                    int &, int &, int &, int &);
+  int find_label(const std::string &, const std::map<std::string, int> &);
 };
 
 }    // namespace LAMMPS_NS
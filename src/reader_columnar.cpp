@@ -0,0 +1,356 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "reader_columnar.h"
+
+#include "dump_columnar.h"
+#include "error.h"
+#include "memory.h"
+#include "tokenizer.h"
+
+#include <cstring>
+#include <map>
+
+#ifdef LAMMPS_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace LAMMPS_NS;
+
+// only proc 0 calls methods of this class, except for constructor/destructor
+// see dump_columnar.cpp for the file layout
+
+/* ---------------------------------------------------------------------- */
+
+ReaderColumnar::ReaderColumnar(LAMMPS *lmp) : Reader(lmp)
+{
+  compressflag = 0;
+  ncol = 0;
+  data_start = 0;
+  iframe = 0;
+  fieldindex = nullptr;
+  colneed = nullptr;
+  nchunk = ichunk = 0;
+  natom_chunk = iatom_chunk = 0;
+  maxchunk = 0;
+  colbuf = nullptr;
+  maxzbuf = 0;
+  zbuf = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+ReaderColumnar::~ReaderColumnar()
+{
+  memory->destroy(fieldindex);
+  memory->destroy(colneed);
+  memory->destroy(colbuf);
+  memory->sfree(zbuf);
+}
+
+/* ----------------------------------------------------------------------
+   open file, read file header and index of frames
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::open_file(const std::string &file)
+{
+  if (fp != nullptr) close_file();
+
+  compressed = false;
+  binary = true;
+  fp = fopen(file.c_str(), "rb");
+  if (!fp) error->one(FLERR, "Cannot open file {}: {}", file, utils::getsyserror());
+
+  bigint marker = 0;
+  read_buf(&marker, sizeof(bigint), 1);
+  if ((marker >= 0) || (-marker != (bigint) strlen(DumpColumnar::COLUMNAR_MAGIC)))
+    error->one(FLERR, "File {} is not a columnar dump file", file);
+  std::string magic(-marker, '\0');
+  read_buf(&magic[0], sizeof(char), -marker);
+  if (magic != DumpColumnar::COLUMNAR_MAGIC)
+    error->one(FLERR, "File {} is not a columnar dump file", file);
+
+  int endian, revision;
+  read_buf(&endian, sizeof(int), 1);
+  read_buf(&revision, sizeof(int), 1);
+  if (endian != 0x0001)
+    error->one(FLERR, "Columnar dump file {} was written with a different byte order", file);
+  if (revision > DumpColumnar::COLUMNAR_REVISION)
+    error->one(FLERR, "Columnar dump file {} has unsupported revision {}", file, revision);
+
+  read_buf(&compressflag, sizeof(int), 1);
+#ifndef LAMMPS_ZSTD
+  if (compressflag)
+    error->one(FLERR, "Reading compressed columnar dump file {} requires Zstd support", file);
+#endif
+
+  int len;
+  read_buf(&ncol, sizeof(int), 1);
+  read_buf(&len, sizeof(int), 1);
+  columns.assign(len, '\0');
+  read_buf(&columns[0], sizeof(char), len);
+  read_buf(&len, sizeof(int), 1);
+  if (len < 0) error->one(FLERR, "Columnar dump file {} is invalid or corrupted", file);
+  (void) platform::fseek(fp, platform::ftell(fp) + len);
+
+  data_start = platform::ftell(fp);
+  read_index();
+  iframe = 0;
+}
+
+/* ----------------------------------------------------------------------
+   read index of frames from end of file
+   if there is no valid index, e.g. for an incomplete file, scan frames
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::read_index()
+{
+  index_step.clear();
+  index_offset.clear();
+
+  const int nmagic = strlen(DumpColumnar::INDEX_MAGIC);
+  const bigint trailer = 2 * sizeof(bigint) + nmagic;
+  (void) platform::fseek(fp, platform::END_OF_FILE);
+  bigint size = platform::ftell(fp);
+
+  if (size - data_start >= trailer) {
+    bigint nframes, start;
+    std::string magic(nmagic, '\0');
+    (void) platform::fseek(fp, size - trailer);
+    read_buf(&nframes, sizeof(bigint), 1);
+    read_buf(&start, sizeof(bigint), 1);
+    read_buf(&magic[0], sizeof(char), nmagic);
+
+    if ((magic == DumpColumnar::INDEX_MAGIC) && (start >= data_start) && (nframes >= 0) &&
+        (start + nframes * 2 * (bigint) sizeof(bigint) + trailer == size)) {
+      (void) platform::fseek(fp, start);
+      index_step.resize(nframes);
+      index_offset.resize(nframes);
+      for (bigint i = 0; i < nframes; i++) {
+        read_buf(&index_step[i], sizeof(bigint), 1);
+        read_buf(&index_offset[i], sizeof(bigint), 1);
+      }
+      return;
+    }
+  }
+
+  error->warning(FLERR, "Columnar dump file has no valid index, scanning frames");
+  scan_frames();
+}
+
+/* ----------------------------------------------------------------------
+   build index by reading frame headers and skipping column blocks
+   stop at first frame that is incomplete or not a valid frame
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::scan_frames()
+{
+  (void) platform::fseek(fp, platform::END_OF_FILE);
+  bigint size = platform::ftell(fp);
+  bigint pos = data_start;
+
+  auto get = [this](void *ptr, size_t nbytes) { return fread(ptr, nbytes, 1, fp) == 1; };
+
+  while (pos < size) {
+    (void) platform::fseek(fp, pos);
+
+    bigint step, natoms;
+    int triclinic, boundary[6], n;
+    double box[9], time;
+    char flag;
+
+    if (!get(&step, sizeof(bigint)) || !get(&natoms, sizeof(bigint))) break;
+    if (!get(&triclinic, sizeof(int)) || (triclinic != 0 && triclinic != 1)) break;
+    if (!get(boundary, 6 * sizeof(int)) || !get(box, (triclinic ? 9 : 6) * sizeof(double))) break;
+    if (!get(&flag, sizeof(char)) || (flag && !get(&time, sizeof(double)))) break;
+    if (!get(&n, sizeof(int)) || (n < 0) || (natoms < 0)) break;
+
+    bool valid = true;
+    for (int i = 0; valid && i < n; i++) {
+      int nlines;
+      if (!get(&nlines, sizeof(int)) || (nlines < 0)) valid = false;
+      for (int j = 0; valid && j < ncol; j++) {
+        bigint nbytes;
+        if (!get(&nbytes, sizeof(bigint)) || (nbytes < 0)) valid = false;
+        else {
+          bigint next = platform::ftell(fp) + nbytes;
+          if (next > size) valid = false;
+          else (void) platform::fseek(fp, next);
+        }
+      }
+    }
+    if (!valid) break;
+
+    index_step.push_back(step);
+    index_offset.push_back(pos);
+    pos = platform::ftell(fp);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   return timestep of next frame from index
+   if no more frames, return 1 so caller can open next file
+------------------------------------------------------------------------- */
+
+int ReaderColumnar::read_time(bigint &ntimestep)
+{
+  if (iframe >= (bigint) index_step.size()) return 1;
+  ntimestep = index_step[iframe];
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   skip frame, no file access required
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::skip()
+{
+  iframe++;
+}
+
+/* ----------------------------------------------------------------------
+   seek to frame and read its header, see ReaderNative::read_header()
+   columns not needed for the requested fields are never read
+------------------------------------------------------------------------- */
+
+bigint ReaderColumnar::read_header(double box[3][3], int &boxinfo, int &triclinic, int fieldinfo,
+                                   int nfield, int *fieldtype, char **fieldlabel, int scaleflag,
+                                   int wrapflag, int &fieldflag, int &xflag, int &yflag,
+                                   int &zflag)
+{
+  if (iframe >= (bigint) index_offset.size()) error->one(FLERR, "Unexpected end of dump file");
+  (void) platform::fseek(fp, index_offset[iframe]);
+  iframe++;
+
+  bigint ntimestep, natoms;
+  read_buf(&ntimestep, sizeof(bigint), 1);
+  read_buf(&natoms, sizeof(bigint), 1);
+
+  boxinfo = 1;
+  triclinic = 0;
+  int boundary[3][2];
+  read_buf(&triclinic, sizeof(int), 1);
+  read_buf(&boundary[0][0], sizeof(int), 6);
+
+  double bounds[9] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  read_buf(bounds, sizeof(double), triclinic ? 9 : 6);
+  for (int i = 0; i < 3; i++) {
+    box[i][0] = bounds[2 * i];
+    box[i][1] = bounds[2 * i + 1];
+    box[i][2] = bounds[6 + i];
+  }
+
+  char flag = 0;
+  read_buf(&flag, sizeof(char), 1);
+  if (flag) {
+    double time;
+    read_buf(&time, sizeof(double), 1);
+  }
+
+  read_buf(&nchunk, sizeof(int), 1);
+  ichunk = 0;
+  natom_chunk = iatom_chunk = 0;
+
+  if (!fieldinfo) return natoms;
+
+  // extract column labels and match to requested fields
+
+  Tokenizer tokens(columns);
+  std::map<std::string, int> labels;
+  int nwords = 0;
+  while (tokens.has_next()) labels[tokens.next()] = nwords++;
+  if (nwords != ncol) error->one(FLERR, "Columnar dump file is invalid or corrupted");
+
+  memory->destroy(fieldindex);
+  memory->create(fieldindex, nfield, "read_dump:fieldindex");
+  match_fields(labels, nwords, nfield, fieldtype, fieldlabel, scaleflag, wrapflag, fieldindex,
+               fieldflag, xflag, yflag, zflag);
+
+  memory->destroy(colneed);
+  memory->create(colneed, ncol, "read_dump:colneed");
+  for (int i = 0; i < ncol; i++) colneed[i] = 0;
+  for (int i = 0; i < nfield; i++)
+    if (fieldindex[i] >= 0) colneed[fieldindex[i]] = 1;
+
+  return natoms;
+}
+
+/* ----------------------------------------------------------------------
+   read N atoms from current frame
+   stores appropriate values in fields array
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::read_atoms(int n, int nfield, double **fields)
+{
+  for (int i = 0; i < n; i++) {
+    if (iatom_chunk == natom_chunk) read_chunk();
+    for (int k = 0; k < nfield; k++) fields[i][k] = colbuf[fieldindex[k]][iatom_chunk];
+    iatom_chunk++;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   read next non-empty chunk of current frame
+   read only the needed columns, seek past all others
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::read_chunk()
+{
+  natom_chunk = 0;
+  while (natom_chunk == 0) {
+    if (ichunk == nchunk) error->one(FLERR, "Unexpected end of dump file");
+    read_buf(&natom_chunk, sizeof(int), 1);
+    ichunk++;
+
+    if (natom_chunk > maxchunk) {
+      maxchunk = natom_chunk;
+      memory->destroy(colbuf);
+      memory->create(colbuf, ncol, maxchunk, "read_dump:colbuf");
+    }
+
+    const size_t nbytes_col = (size_t) natom_chunk * sizeof(double);
+    for (int j = 0; j < ncol; j++) {
+      bigint nbytes;
+      read_buf(&nbytes, sizeof(bigint), 1);
+      if (!colneed[j]) {
+        (void) platform::fseek(fp, platform::ftell(fp) + nbytes);
+        continue;
+      }
+
+      if (compressflag) {
+#ifdef LAMMPS_ZSTD
+        if ((size_t) nbytes > maxzbuf) {
+          maxzbuf = nbytes;
+          zbuf = (char *) memory->srealloc(zbuf, maxzbuf, "read_dump:zbuf");
+        }
+        read_buf(zbuf, sizeof(char), nbytes);
+        size_t nout = ZSTD_decompress(colbuf[j], nbytes_col, zbuf, nbytes);
+        if (ZSTD_isError(nout) || (nout != nbytes_col))
+          error->one(FLERR, "Columnar dump file is invalid or corrupted");
+#endif
+      } else {
+        if ((size_t) nbytes != nbytes_col)
+          error->one(FLERR, "Columnar dump file is invalid or corrupted");
+        read_buf(colbuf[j], sizeof(double), natom_chunk);
+      }
+    }
+  }
+  iatom_chunk = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ReaderColumnar::read_buf(void *ptr, size_t size, size_t count)
+{
+  utils::sfread(FLERR, ptr, size, count, fp, nullptr, error);
+}
@@ -0,0 +1,75 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef READER_CLASS
+// clang-format off
+ReaderStyle(columnar,ReaderColumnar);
+// clang-format on
+#else
+
+#ifndef LMP_READER_COLUMNAR_H
+#define LMP_READER_COLUMNAR_H
+
+#include "reader.h"
+
+#include <string>
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class ReaderColumnar : public Reader {
+ public:
+  ReaderColumnar(class LAMMPS *);
+  ~ReaderColumnar() override;
+
+  int read_time(bigint &) override;
+  void skip() override;
+  bigint read_header(double[3][3], int &, int &, int, int, int *, char **, int, int, int &, int &,
+                     int &, int &) override;
+  void read_atoms(int, int, double **) override;
+
+  void open_file(const std::string &) override;
+
+ private:
+  int compressflag;       // 1 if column blocks are zstd compressed
+  int ncol;               // # of per-atom columns in file
+  std::string columns;    // column labels
+  bigint data_start;      // file offset of first frame
+
+  std::vector<bigint> index_step;      // timestep of each frame
+  std::vector<bigint> index_offset;    // file offset of each frame
+  bigint iframe;                       // index of next frame
+
+  int *fieldindex;    // which column each requested field maps to
+  int *colneed;       // 1 if column is read, 0 if skipped
+
+  int nchunk;         // # of chunks in current frame
+  int ichunk;         // index of next chunk to read
+  int natom_chunk;    // # of atoms in current chunk
+  int iatom_chunk;    // index of next atom in current chunk
+
+  int maxchunk;       // allocated length of columns in colbuf
+  double **colbuf;    // values of all read columns of current chunk
+  size_t maxzbuf;
+  char *zbuf;         // compressed column block
+
+  void read_index();
+  void scan_frames();
+  void read_chunk();
+  void read_buf(void *, size_t, size_t);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -58,7 +58,6 @@ class ReaderNative : public Reader {
   int natom_chunk;    // number of atoms in the current chunks
   int iatom_chunk;    // index of current atom in the current chunk
 
-  int find_label(const std::string &label, const std::map<std::string, int> &labels);
   void read_lines(int);
 
   void read_buf(void *, size_t, size_t);
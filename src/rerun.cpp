@@ -14,6 +14,7 @@
 
 #include "rerun.h"
 
+#include "comm.h"
 #include "domain.h"
 #include "error.h"
 #include "finish.h"
@@ -23,6 +24,7 @@
 #include "output.h"
 #include "read_dump.h"
 #include "timer.h"
+#include "universe.h"
 #include "update.h"
 #include "variable.h"
 
@@ -57,6 +59,7 @@ void Rerun::command(int narg, char **arg)
     if (strcmp(arg[iarg],"stop") == 0) break;
     if (strcmp(arg[iarg],"dump") == 0) break;
     if (strcmp(arg[iarg],"post") == 0) break;
+    if (strcmp(arg[iarg],"split") == 0) break;
     iarg++;
   }
   int nfile = iarg;
@@ -72,6 +75,7 @@ void Rerun::command(int narg, char **arg)
   int startflag = 0;
   int stopflag = 0;
   int postflag = 0;
+  int splitflag = 0;
   bigint start = -1;
   bigint stop = -1;
 
@@ -112,6 +116,10 @@ void Rerun::command(int narg, char **arg)
       if (iarg+2 > narg) error->all(FLERR,"Illegal rerun command");
       postflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"split") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal rerun command");
+      splitflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
     } else if (strcmp(arg[iarg],"dump") == 0) {
       break;
     } else error->all(FLERR,"Illegal rerun command");
@@ -160,7 +168,22 @@ void Rerun::command(int narg, char **arg)
   if (ntimestep < 0)
     error->all(FLERR,"Rerun dump file does not contain requested snapshot");
 
-  while (true) {
+  // with split, partition I processes snapshots I, I+Nworlds, I+2*Nworlds, ...
+  // of the selected snapshots and skips the others without reading atoms
+
+  int nsplit = 1;
+  if (splitflag) {
+    nsplit = universe->nworlds;
+    for (int i = 0; i < universe->iworld && ntimestep >= 0; i++) {
+      rd->skip();
+      ntimestep = rd->next(ntimestep,last,nevery,nskip);
+    }
+    if ((ntimestep < 0) && (comm->me == 0))
+      error->warning(FLERR,"Rerun split leaves no snapshots for partition {}",
+                     universe->iworld+1);
+  }
+
+  while (ntimestep >= 0) {
     ndump++;
     rd->header(firstflag);
     update->reset_timestep(ntimestep, false);
@@ -247,15 +270,21 @@ void Rerun::command(int narg, char **arg)
 
     firstflag = 0;
     ntimestep = rd->next(ntimestep,last,nevery,nskip);
+    for (int i = 1; i < nsplit && ntimestep >= 0; i++) {
+      rd->skip();
+      ntimestep = rd->next(ntimestep,last,nevery,nskip);
+    }
     if (stopflag && ntimestep > stop)
       error->all(FLERR,"Read rerun dump file timestep {} > specified stop {}", ntimestep, stop);
-    if (ntimestep < 0) break;
   }
 
   // ensure thermo output on last dump timestep
 
-  output->next_thermo = update->ntimestep;
-  output->write(update->ntimestep);
+  if (ndump) {
+    output->next_thermo = update->ntimestep;
+    output->write(update->ntimestep);
+  }
+  output->post_run();
 
   timer->barrier_stop();
 
@@ -530,6 +530,7 @@ void Respa::run(int n)
 
     ntimestep = ++update->ntimestep;
     ev_set(ntimestep);
+    timer->trace_begin("Step","step","step",ntimestep);
 
     recurse(nlevels - 1);
 
@@ -548,6 +549,7 @@ void Respa::run(int n)
       output->write(update->ntimestep);
       timer->stamp(Timer::OUTPUT);
     }
+    timer->trace_end();
   }
 }
 
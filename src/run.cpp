@@ -174,6 +174,7 @@ void Run::command(int narg, char **arg)
     timer->init();
     timer->barrier_start();
     update->integrate->run(nsteps);
+    output->post_run();
     timer->barrier_stop();
 
     update->integrate->cleanup();
@@ -215,6 +216,7 @@ void Run::command(int narg, char **arg)
       timer->init();
       timer->barrier_start();
       update->integrate->run(nsteps);
+      output->post_run();
       timer->barrier_stop();
 
       update->integrate->cleanup();
@@ -411,21 +411,37 @@ void Thermo::compute(int flag)
     normflag = normvalue;
 
   // invoke Compute methods needed for thermo keywords
+  // first combine global sums of all computes that support it
+
+  std::vector<std::pair<Compute *, int>> reduce_list;
+  for (i = 0; i < ncompute; i++) {
+    if (compute_which[i] == SCALAR)
+      reduce_list.emplace_back(computes[i], Compute::INVOKED_SCALAR);
+    else if (compute_which[i] == VECTOR)
+      reduce_list.emplace_back(computes[i], Compute::INVOKED_VECTOR);
+  }
+  modify->reduce_computes(reduce_list);
 
   for (i = 0; i < ncompute; i++)
     if (compute_which[i] == SCALAR) {
       if (!(computes[i]->invoked_flag & Compute::INVOKED_SCALAR)) {
+        timer->trace_begin(computes[i]->id, "compute_scalar");
         computes[i]->compute_scalar();
+        timer->trace_end();
         computes[i]->invoked_flag |= Compute::INVOKED_SCALAR;
       }
     } else if (compute_which[i] == VECTOR) {
       if (!(computes[i]->invoked_flag & Compute::INVOKED_VECTOR)) {
+        timer->trace_begin(computes[i]->id, "compute_vector");
         computes[i]->compute_vector();
+        timer->trace_end();
         computes[i]->invoked_flag |= Compute::INVOKED_VECTOR;
       }
     } else if (compute_which[i] == ARRAY) {
       if (!(computes[i]->invoked_flag & Compute::INVOKED_ARRAY)) {
+        timer->trace_begin(computes[i]->id, "compute_array");
         computes[i]->compute_array();
+        timer->trace_end();
         computes[i]->invoked_flag |= Compute::INVOKED_ARRAY;
       }
     }
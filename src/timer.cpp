@@ -19,12 +19,20 @@
 #include "fmt/chrono.h"
 #endif
 #include "tokenizer.h"
+#include "universe.h"
 
 #include <cstring>
 #include <ctime>
 
 using namespace LAMMPS_NS;
 
+// names of timer categories in trace file, must match enum ttype
+
+static const char *timer_name[] = {"Total",  "Pair",     "Bond",   "Kspace", "Neigh",
+                                   "Comm",   "Modify",   "Output", "Sync",   "All",
+                                   "Dephase", "Dynamics", "Quench", "Neb",    "Repcomm",
+                                   "Repout"};
+
 /* ---------------------------------------------------------------------- */
 
 Timer::Timer(LAMMPS *_lmp) : Pointers(_lmp)
@@ -35,11 +43,21 @@ Timer::Timer(LAMMPS *_lmp) : Pointers(_lmp)
   _s_timeout = -1.0;
   _checkfreq = 10;
   _nextcheck = -1;
+  _tracefp = nullptr;
+  _trace_origin = 0.0;
+  _trace_depth = 0;
   this->_stamp(RESET);
 }
 
 /* ---------------------------------------------------------------------- */
 
+Timer::~Timer()
+{
+  _trace_close();
+}
+
+/* ---------------------------------------------------------------------- */
+
 void Timer::init()
 {
   for (int i = 0; i < NUM_TIMER; i++) {
@@ -67,6 +85,9 @@ void Timer::_stamp(enum ttype which)
     wall_array[ALL] += delta_wall;
   }
 
+  if (_tracefp && (which > TOTAL) && (which < NUM_TIMER) && (which != ALL))
+    _trace_event(timer_name[which], "timer", nullptr, 0, previous_wall, current_wall, STAMPTID);
+
   previous_cpu = current_cpu;
   previous_wall = current_wall;
 
@@ -87,6 +108,8 @@ void Timer::_stamp(enum ttype which)
     wall_array[SYNC] += delta_wall;
     cpu_array[ALL] += delta_cpu;
     wall_array[ALL] += delta_wall;
+    if (_tracefp)
+      _trace_event(timer_name[SYNC], "timer", nullptr, 0, previous_wall, current_wall, STAMPTID);
     previous_cpu = current_cpu;
     previous_wall = current_wall;
   }
@@ -213,6 +236,111 @@ double Timer::get_timeout_remain()
   return (_timeout < 0.0) ? 0.0 : remain;
 }
 
+/* ----------------------------------------------------------------------
+   open per-rank trace file, '%' in file name is replaced by the rank ID
+     in the universe, so partitions do not overwrite each other's files
+   the trace is a JSON array of Chrome trace events, one span per event,
+     which can be loaded into Perfetto or chrome://tracing
+   intervals between time stamps do not nest with spans, e.g. a Modify
+     interval may start before a step span, so they are a separate thread
+   time origin is taken after a barrier, so traces of all ranks are aligned
+------------------------------------------------------------------------- */
+
+void Timer::_trace_open(const std::string &file)
+{
+  _trace_close();
+
+  std::string name = file;
+  auto pos = name.find('%');
+  if (pos != std::string::npos)
+    name.replace(pos, 1, std::to_string(universe->me));
+  else if (universe->nprocs > 1)
+    error->all(FLERR, "Timer trace file name {} must contain '%' with multiple MPI processes",
+               file);
+
+  _tracefp = fopen(name.c_str(), "w");
+  if (!_tracefp)
+    error->one(FLERR, "Cannot open timer trace file {}: {}", name, utils::getsyserror());
+
+  utils::print(_tracefp,
+               "[\n{{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":{},"
+               "\"args\":{{\"name\":\"MPI rank {}\"}}}},\n",
+               universe->me, universe->me);
+  utils::print(_tracefp,
+               "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":{},\"tid\":{},"
+               "\"args\":{{\"name\":\"spans\"}}}},\n"
+               "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":{},\"tid\":{},"
+               "\"args\":{{\"name\":\"timer categories\"}}}},\n",
+               universe->me, SPANTID, universe->me, STAMPTID);
+
+  MPI_Barrier(world);
+  _trace_origin = platform::walltime();
+  _trace_depth = 0;
+}
+
+/* ----------------------------------------------------------------------
+   close trace file, final event has no trailing comma to make valid JSON
+------------------------------------------------------------------------- */
+
+void Timer::_trace_close()
+{
+  if (!_tracefp) return;
+  utils::print(_tracefp,
+               "{{\"name\":\"process_sort_index\",\"ph\":\"M\",\"pid\":{},"
+               "\"args\":{{\"sort_index\":{}}}}}\n]\n",
+               universe->me, universe->me);
+  fclose(_tracefp);
+  _tracefp = nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   open a nested span, spans beyond the max depth are counted, not recorded
+------------------------------------------------------------------------- */
+
+void Timer::_trace_begin(const char *name, const char *cat, const char *argname, bigint arg)
+{
+  if (_trace_depth < MAXTRACEDEPTH) {
+    TraceSpan &span = _trace_stack[_trace_depth];
+    span.name = name;
+    span.cat = cat;
+    span.argname = argname;
+    span.arg = arg;
+    span.start = platform::walltime();
+  }
+  ++_trace_depth;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Timer::_trace_end()
+{
+  if (_trace_depth <= 0) return;
+  --_trace_depth;
+  if (_trace_depth < MAXTRACEDEPTH) {
+    const TraceSpan &span = _trace_stack[_trace_depth];
+    _trace_event(span.name, span.cat, span.argname, span.arg, span.start, platform::walltime(),
+                 SPANTID);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   write one complete event, timestamps are in microseconds
+------------------------------------------------------------------------- */
+
+void Timer::_trace_event(const char *name, const char *cat, const char *argname, bigint arg,
+                         double start, double stop, int tid)
+{
+  utils::print(_tracefp,
+               "{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},"
+               "\"dur\":{:.3f},\"pid\":{},\"tid\":{}",
+               name, cat, 1.0e6 * (start - _trace_origin), 1.0e6 * (stop - start), universe->me,
+               tid);
+  if (argname)
+    utils::print(_tracefp, ",\"args\":{{\"{}\":{}}}}},\n", argname, arg);
+  else
+    fputs("},\n", _tracefp);
+}
+
 /* ----------------------------------------------------------------------
    modify parameters of the Timer class
 ------------------------------------------------------------------------- */
@@ -254,6 +382,19 @@ void Timer::modify_params(int narg, char **arg)
       } else {
         utils::missing_cmd_args(FLERR, "timer every", error);
       }
+    } else if (strcmp(arg[iarg], "trace") == 0) {
+      ++iarg;
+      if (iarg < narg) {
+        if (strcmp(arg[iarg], "off") == 0) {
+          _trace_close();
+        } else {
+          _trace_open(arg[iarg]);
+          if (comm->me == 0)
+            utils::logmesg(lmp, "Writing timer trace of each MPI process to {}\n", arg[iarg]);
+        }
+      } else {
+        utils::missing_cmd_args(FLERR, "timer trace", error);
+      }
     } else {
       error->all(FLERR, "Unknown timer keyword {}", arg[iarg]);
     }
@@ -44,6 +44,7 @@ class Timer : protected Pointers {
   enum tlevel { OFF = 0, LOOP, NORMAL, FULL };
 
   Timer(class LAMMPS *);
+  ~Timer() override;
 
   void init();
 
@@ -57,6 +58,20 @@ class Timer : protected Pointers {
   void barrier_start();
   void barrier_stop();
 
+  // inline functions to record nested spans in a per-rank trace file
+  // names must remain valid until the matching trace_end() call
+
+  bool has_trace() const { return (_tracefp != nullptr); }
+  void trace_begin(const char *name, const char *cat, const char *argname = nullptr,
+                   bigint arg = 0)
+  {
+    if (_tracefp) _trace_begin(name, cat, argname, arg);
+  }
+  void trace_end()
+  {
+    if (_tracefp) _trace_end();
+  }
+
   // accessor methods for supported level of detail
 
   bool has_loop() const { return (_level >= LOOP); }
@@ -117,9 +132,31 @@ class Timer : protected Pointers {
   int _checkfreq;       // frequency of timeout checking
   int _nextcheck;       // loop number of next timeout check
 
+  // data for tracing of nested spans in Chrome trace event format
+
+  static constexpr int MAXTRACEDEPTH = 16;
+  static constexpr int SPANTID = 0;     // trace thread ID of nested spans
+  static constexpr int STAMPTID = 1;    // trace thread ID of intervals between time stamps
+  struct TraceSpan {
+    const char *name, *cat, *argname;
+    bigint arg;
+    double start;
+  };
+  FILE *_tracefp;                           // trace file of this rank, null if not tracing
+  double _trace_origin;                     // wall time corresponding to trace timestamp 0
+  int _trace_depth;                         // # of currently open spans
+  TraceSpan _trace_stack[MAXTRACEDEPTH];    // currently open spans
+
   // update one specific timer array
   void _stamp(enum ttype);
 
+  // open, close and write to trace file
+  void _trace_open(const std::string &);
+  void _trace_close();
+  void _trace_begin(const char *, const char *, const char *, bigint);
+  void _trace_end();
+  void _trace_event(const char *, const char *, const char *, bigint, double, double, int);
+
   // check for timeout
   bool _check_timeout();
 };
@@ -81,7 +81,24 @@ enum{DONE,ADD,SUBTRACT,MULTIPLY,DIVIDE,CARAT,MODULO,UNARY,
      RAMP,STAGGER,LOGFREQ,LOGFREQ2,LOGFREQ3,STRIDE,STRIDE2,
      VDISPLACE,SWIGGLE,CWIGGLE,SIGN,GMASK,RMASK,
      GRMASK,IS_ACTIVE,IS_DEFINED,IS_AVAILABLE,IS_FILE,EXTRACT_SETTING,
-     VALUE,ATOMARRAY,TYPEARRAY,INTARRAY,BIGINTARRAY,VECTORARRAY};
+     VALUE,ATOMARRAY,TYPEARRAY,INTARRAY,BIGINTARRAY,VECTORARRAY,
+     THERMO_KEYWORD,COMPUTE_GLOBAL,FIX_GLOBAL,VARIABLE_SCALAR};
+
+// math functions which can be compiled for equal-style variables and their # of args
+// functions not listed here cause the formula to be parsed on every evaluation
+
+static const std::unordered_map<std::string, std::pair<int, int>> compiled_functions = {
+    {"sqrt", {SQRT, 1}},   {"exp", {EXP, 1}},         {"ln", {LN, 1}},
+    {"log", {LOG, 1}},     {"abs", {ABS, 1}},         {"sin", {SIN, 1}},
+    {"cos", {COS, 1}},     {"tan", {TAN, 1}},         {"asin", {ASIN, 1}},
+    {"acos", {ACOS, 1}},   {"atan", {ATAN, 1}},       {"atan2", {ATAN2, 2}},
+    {"ceil", {CEIL, 1}},   {"floor", {FLOOR, 1}},     {"round", {ROUND, 1}},
+    {"sign", {SIGN, 1}},   {"ternary", {TERNARY, 3}}, {"ramp", {RAMP, 2}},
+    {"stagger", {STAGGER, 2}}};
+
+// VECLEN = # of atoms or vector elements evaluated at a time by eval_tree_block()
+
+static constexpr int VECLEN = 128;
 
 // customize by adding a special function
 
@@ -120,6 +137,7 @@ Variable::Variable(LAMMPS *lmp) : Pointers(lmp)
   data = nullptr;
   dvalue = nullptr;
   vecs = nullptr;
+  program = nullptr;
 
   eval_in_progress = nullptr;
 
@@ -156,6 +174,7 @@ Variable::~Variable()
       for (int j = 0; j < num[i]; j++) delete[] data[i][j];
     delete[] data[i];
     if (style[i] == VECTOR) memory->destroy(vecs[i].values);
+    delete program[i];
   }
   memory->sfree(names);
   memory->destroy(style);
@@ -166,6 +185,7 @@ Variable::~Variable()
   memory->sfree(data);
   memory->sfree(dvalue);
   memory->sfree(vecs);
+  memory->sfree(program);
 
   memory->destroy(eval_in_progress);
 
@@ -474,6 +494,8 @@ void Variable::set(int narg, char **arg)
         error->all(FLERR, 1, "Cannot redefine variable {} with a different style", arg[0]);
       delete[] data[ivar][0];
       data[ivar][0] = utils::strdup(combined);
+      delete program[ivar];
+      program[ivar] = nullptr;
       replaceflag = 1;
     } else {
       if (nvar == maxvar) grow();
@@ -1057,7 +1079,7 @@ char *Variable::retrieve(const char *name)
     str = data[ivar][0] = utils::strdup(result);
 
   } else if (style[ivar] == EQUAL) {
-    double answer = evaluate(data[ivar][0],nullptr,ivar);
+    double answer = evaluate_equal(ivar);
     // round to zero on underflow
     if (fabs(answer) < std::numeric_limits<double>::min()) answer = 0.0;
     delete[] data[ivar][1];
@@ -1154,7 +1176,7 @@ double Variable::compute_equal(int ivar)
   eval_in_progress[ivar] = 1;
 
   double value = 0.0;
-  if (style[ivar] == EQUAL) value = evaluate(data[ivar][0],nullptr,ivar);
+  if (style[ivar] == EQUAL) value = evaluate_equal(ivar);
   else if (style[ivar] == TIMER) value = dvalue[ivar];
   else if (style[ivar] == INTERNAL) value = dvalue[ivar];
   else if (style[ivar] == PYTHON) {
@@ -1223,7 +1245,39 @@ void Variable::compute_atom(int ivar, int igroup, double *result, int stride, in
   int *mask = atom->mask;
   int nlocal = atom->nlocal;
 
-  if (style[ivar] == ATOM) {
+  // evaluate flattened tree for blocks of VECLEN atoms if possible
+  // skip blocks without atoms in group
+
+  std::vector<Tree *> code;
+  int depth = 0, maxdepth = 0;
+
+  if (style[ivar] == ATOM && flatten_tree(tree,code,depth,maxdepth)) {
+    std::vector<double> stack((std::size_t) maxdepth*VECLEN);
+    double *values = stack.data();
+
+    for (int ifirst = 0; ifirst < nlocal; ifirst += VECLEN) {
+      int n = MIN(VECLEN,nlocal-ifirst);
+      int ingroup = 0;
+      for (int k = 0; k < n; k++)
+        if (mask[ifirst+k] & groupbit) ingroup = 1;
+      if (ingroup) eval_tree_block(code,values,ifirst,n,mask,groupbit);
+
+      int m = ifirst*stride;
+      if (sumflag == 0) {
+        for (int k = 0; k < n; k++) {
+          if (mask[ifirst+k] & groupbit) result[m] = values[k];
+          else result[m] = 0.0;
+          m += stride;
+        }
+      } else if (ingroup) {
+        for (int k = 0; k < n; k++) {
+          if (mask[ifirst+k] & groupbit) result[m] += values[k];
+          m += stride;
+        }
+      }
+    }
+
+  } else if (style[ivar] == ATOM) {
     if (sumflag == 0) {
       int m = 0;
       for (int i = 0; i < nlocal; i++) {
@@ -1315,8 +1369,21 @@ int Variable::compute_vector(int ivar, double **result)
   vecs[ivar].n = nlen;
   vecs[ivar].currentstep = update->ntimestep;
   double *vec = vecs[ivar].values;
-  for (int i = 0; i < nlen; i++)
-    vec[i] = eval_tree(tree,i);
+
+  std::vector<Tree *> code;
+  int depth = 0, maxdepth = 0;
+
+  if (flatten_tree(tree,code,depth,maxdepth)) {
+    std::vector<double> stack((std::size_t) maxdepth*VECLEN);
+    for (int ifirst = 0; ifirst < nlen; ifirst += VECLEN) {
+      int n = MIN(VECLEN,nlen-ifirst);
+      eval_tree_block(code,stack.data(),ifirst,n,nullptr,0);
+      for (int k = 0; k < n; k++) vec[ifirst+k] = stack[k];
+    }
+  } else {
+    for (int i = 0; i < nlen; i++)
+      vec[i] = eval_tree(tree,i);
+  }
 
   free_tree(tree);
   eval_in_progress[ivar] = 0;
@@ -1346,6 +1413,7 @@ void Variable::remove(int n)
   else for (int i = 0; i < num[n]; i++) delete[] data[n][i];
   delete[] data[n];
   delete reader[n];
+  delete program[n];
 
   for (int i = n+1; i < nvar; i++) {
     names[i-1] = names[i];
@@ -1356,6 +1424,7 @@ void Variable::remove(int n)
     reader[i-1] = reader[i];
     data[i-1] = data[i];
     dvalue[i-1] = dvalue[i];
+    program[i-1] = program[i];
 
     // copy VecVar struct from vecs[i] to vecs[i-1]
 
@@ -1366,6 +1435,7 @@ void Variable::remove(int n)
   data[nvar] = nullptr;
   reader[nvar] = nullptr;
   names[nvar] = nullptr;
+  program[nvar] = nullptr;
 }
 
 /* ----------------------------------------------------------------------
@@ -1397,6 +1467,9 @@ void Variable::grow()
     vecs[i].values = nullptr;
   }
 
+  program = (Program **) memory->srealloc(program,maxvar*sizeof(Program *),"var:program");
+  for (int i = old; i < maxvar; i++) program[i] = nullptr;
+
   memory->grow(eval_in_progress,maxvar,"var:eval_in_progress");
   for (int i = 0; i < maxvar; i++) eval_in_progress[i] = 0;
 }
@@ -1569,7 +1642,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
         // index1,index2 = int inside each bracket pair, possibly an atom ID
 
         int nbracket;
-        tagint index1,index2;
+        tagint index1 = 0, index2 = 0;
         if (str[i] != '[') nbracket = 0;
         else {
           nbracket = 1;
@@ -1588,72 +1661,11 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
 
         if ((ivar < 0) || (style[ivar] == EQUAL)) {
 
-          // c_ID = scalar from global scalar
-
-          if (lowercase && nbracket == 0) {
-
-            if (!compute->scalar_flag)
-              print_var_error(FLERR,"Mismatched compute in variable formula",ivar);
-            if (!compute->is_initialized())
-              print_var_error(FLERR,"Variable formula compute cannot be invoked before "
-                              "initialization by a run",ivar);
-            if (!(compute->invoked_flag & Compute::INVOKED_SCALAR)) {
-              compute->compute_scalar();
-              compute->invoked_flag |= Compute::INVOKED_SCALAR;
-            }
-
-            value1 = compute->scalar;
-            argstack[nargstack++] = value1;
-
-          // c_ID[i] = scalar from global vector
-
-          } else if (lowercase && nbracket == 1) {
-
-            if (!compute->vector_flag)
-              print_var_error(FLERR,"Mismatched compute in variable formula",ivar);
-            if (!compute->is_initialized())
-              print_var_error(FLERR,"Variable formula compute cannot be invoked before "
-                              "initialization by a run",ivar);
-            if (!(compute->invoked_flag & Compute::INVOKED_VECTOR)) {
-              compute->compute_vector();
-              compute->invoked_flag |= Compute::INVOKED_VECTOR;
-            }
-
-            // wait to check index1 until after compute invocation
-            // to allow for computes with size_vector_variable == 1
-
-            if (index1 > compute->size_vector)
-              print_var_error(FLERR,"Variable formula compute vector is accessed out-of-range"
-                              + utils::errorurl(20), ivar, 0);
-
-            value1 = compute->vector[index1-1];
-            argstack[nargstack++] = value1;
-
-          // c_ID[i][j] = scalar from global array
+          // c_ID, c_ID[i], c_ID[i][j] = scalar from global scalar, vector, or array
 
-          } else if (lowercase && nbracket == 2) {
+          if (lowercase) {
 
-            if (!compute->array_flag)
-              print_var_error(FLERR,"Mismatched compute in variable formula",ivar);
-            if (index2 > compute->size_array_cols)
-              print_var_error(FLERR,"Variable formula compute array is accessed out-of-range"
-                              + utils::errorurl(20), ivar, 0);
-            if (!compute->is_initialized())
-              print_var_error(FLERR,"Variable formula compute cannot be invoked before "
-                              "initialization by a run",ivar);
-            if (!(compute->invoked_flag & Compute::INVOKED_ARRAY)) {
-              compute->compute_array();
-              compute->invoked_flag |= Compute::INVOKED_ARRAY;
-            }
-
-            // wait to check index1 until after compute invocation
-            // to allow for computes with size_array_rows_variable == 1
-
-            if (index1 > compute->size_array_rows)
-              print_var_error(FLERR,"Variable formula compute array is accessed out-of-range"
-                              + utils::errorurl(20), ivar, 0);
-
-            value1 = compute->array[index1-1][index2-1];
+            value1 = compute_global(compute,nbracket,index1,index2,ivar);
             argstack[nargstack++] = value1;
 
           // C_ID[i] = scalar element of per-atom vector, note uppercase "C"
@@ -1854,7 +1866,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
         // index1,index2 = int inside each bracket pair, possibly an atom ID
 
         int nbracket;
-        tagint index1,index2;
+        tagint index1 = 0, index2 = 0;
         if (str[i] != '[') nbracket = 0;
         else {
           nbracket = 1;
@@ -1873,60 +1885,11 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
 
         if ((ivar < 0) || (style[ivar] == EQUAL)) {
 
-          // f_ID = scalar from global scalar
-
-          if (lowercase && nbracket == 0) {
-
-            if (!fix->scalar_flag)
-              print_var_error(FLERR,"Mismatched fix in variable formula",ivar);
-            if (update->whichflag > 0 && update->ntimestep % fix->global_freq)
-              print_var_error(FLERR,"Fix in variable not computed at a compatible time"
-                              + utils::errorurl(7), ivar);
-
-            value1 = fix->compute_scalar();
-            argstack[nargstack++] = value1;
-
-          // f_ID[i] = scalar from global vector
-
-          } else if (lowercase && nbracket == 1) {
-
-            if (!fix->vector_flag)
-              print_var_error(FLERR,"Mismatched fix in variable formula",ivar);
-            if (index1 > fix->size_vector && fix->size_vector_variable == 0)
-              print_var_error(FLERR,"Variable formula fix vector is accessed out-of-range"
-                              + utils::errorurl(20), ivar,0);
-            if (update->whichflag > 0 && update->ntimestep % fix->global_freq)
-              print_var_error(FLERR,"Fix in variable not computed at a compatible time"
-                              + utils::errorurl(7) ,ivar);
-
-            // if index exceeds variable vector length, use a zero value
-            // this can be useful if vector length is not known a priori
-
-            if (fix->size_vector_variable && index1 > fix->size_vector) value1 = 0.0;
-            else value1 = fix->compute_vector(index1-1);
-            argstack[nargstack++] = value1;
-
-          // f_ID[i][j] = scalar from global array
-
-          } else if (lowercase && nbracket == 2) {
-
-            if (!fix->array_flag)
-              print_var_error(FLERR,"Mismatched fix in variable formula",ivar);
-            if (index1 > fix->size_array_rows && fix->size_array_rows_variable == 0)
-              print_var_error(FLERR,"Variable formula fix array is accessed out-of-range"
-                              + utils::errorurl(20), ivar,0);
-            if (index2 > fix->size_array_cols)
-              print_var_error(FLERR,"Variable formula fix array is accessed out-of-range"
-                              + utils::errorurl(20), ivar,0);
-            if (update->whichflag > 0 && update->ntimestep % fix->global_freq)
-              print_var_error(FLERR,"Fix in variable not computed at a compatible time"
-                              + utils::errorurl(7), ivar);
+          // f_ID, f_ID[i], f_ID[i][j] = scalar from global scalar, vector, or array
 
-            // if index exceeds variable array rows, use a zero value
-            // this can be useful if array size is not known a priori
+          if (lowercase) {
 
-            if (fix->size_array_rows_variable && index1 > fix->size_array_rows) value1 = 0.0;
-            else value1 = fix->compute_array(index1-1,index2-1);
+            value1 = fix_global(fix,nbracket,index1,index2,ivar);
             argstack[nargstack++] = value1;
 
           // F_ID[i] = scalar element of per-atom vector, note uppercase "F"
@@ -2613,6 +2576,523 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
   }
 }
 
+/* ----------------------------------------------------------------------
+   evaluate an equal-style variable
+   use its compiled formula if possible, else parse the formula string
+------------------------------------------------------------------------- */
+
+double Variable::evaluate_equal(int ivar)
+{
+  if (!program[ivar]) program[ivar] = compile_equal(data[ivar][0]);
+  if (program[ivar]->valid) return eval_program(program[ivar],ivar);
+  return evaluate(data[ivar][0],nullptr,ivar);
+}
+
+/* ----------------------------------------------------------------------
+   one-time compilation of an equal-style formula into a Program
+   program is flagged invalid if formula uses features that are not
+     supported by compile_formula(), or has a syntax error, so that
+     it is parsed on every evaluation and errors are reported by evaluate()
+------------------------------------------------------------------------- */
+
+Variable::Program *Variable::compile_equal(const char *str)
+{
+  auto prog = new Program();
+  prog->valid = compile_formula(str,prog->code);
+  if (!prog->valid) {
+    prog->code.clear();
+    return prog;
+  }
+
+  // size of value stack = max # of values pushed and not yet consumed
+
+  int depth = 0;
+  int maxdepth = 0;
+  for (const auto &instr : prog->code) {
+    if ((instr.op == VALUE) || (instr.op >= THERMO_KEYWORD)) depth++;
+    else if (instr.op == TERNARY) depth -= 2;
+    else if ((instr.op < UNARY) || ((instr.op > NOT) && (instr.op <= XOR)) ||
+             (instr.op == ATAN2) || (instr.op == RAMP) || (instr.op == STAGGER)) depth--;
+    maxdepth = MAX(maxdepth,depth);
+  }
+  prog->stack.resize(maxdepth);
+  return prog;
+}
+
+/* ----------------------------------------------------------------------
+   compile formula string into postfix instructions appended to code
+   same syntax and operator precedence rules as evaluate()
+   supported: numbers, constants, thermo keywords, operators,
+     functions in compiled_functions, c_ID, c_ID[i], c_ID[i][j],
+     f_ID, f_ID[i], f_ID[i][j] with literal indices, v_name without index
+   return 1 if successful, 0 if formula cannot be compiled
+------------------------------------------------------------------------- */
+
+int Variable::compile_formula(const std::string &str, std::vector<Instr> &code)
+{
+  std::vector<int> opstack;
+  const std::size_t nlen = str.size();
+  std::size_t i = 0;
+  int op;
+  int expect = ARG;
+
+  // find matching paren for paren at position istart, return npos if none
+
+  auto matching_paren = [&](std::size_t istart) {
+    int ilevel = 0;
+    for (std::size_t j = istart+1; j < nlen; j++) {
+      if (str[j] == '(') ilevel++;
+      else if ((str[j] == ')') && ilevel) ilevel--;
+      else if (str[j] == ')') return j;
+    }
+    return std::string::npos;
+  };
+
+  while (true) {
+    char onechar = (i < nlen) ? str[i] : '\0';
+
+    // whitespace: just skip
+
+    if (isspace(onechar)) i++;
+
+    // parentheses: compile contents, which leaves one value on the stack
+
+    else if (onechar == '(') {
+      if (expect == OP) return 0;
+      expect = OP;
+
+      std::size_t istop = matching_paren(i);
+      if (istop == std::string::npos) return 0;
+      if (!compile_formula(str.substr(i+1,istop-i-1),code)) return 0;
+      i = istop+1;
+
+    // number
+
+    } else if (isdigit(onechar) || onechar == '.') {
+      if (expect == OP) return 0;
+      expect = OP;
+
+      std::size_t istart = i;
+      while (i < nlen && (isdigit(str[i]) || str[i] == '.')) i++;
+      if (i < nlen && (str[i] == 'e' || str[i] == 'E')) {
+        i++;
+        if (i < nlen && (str[i] == '+' || str[i] == '-')) i++;
+        while (i < nlen && isdigit(str[i])) i++;
+      }
+
+      Instr instr{VALUE, 0.0, 0, 0, 0, ""};
+      try {
+        instr.value = std::stod(str.substr(istart,i-istart));
+      } catch (std::exception &) {
+        return 0;
+      }
+      code.push_back(instr);
+
+    // word
+
+    } else if (isalpha(onechar)) {
+      if (expect == OP) return 0;
+      expect = OP;
+
+      std::size_t istart = i;
+      while (i < nlen && (isalnum(str[i]) || str[i] == '_')) i++;
+      std::string word = str.substr(istart,i-istart);
+
+      // c_ID and f_ID with up to two literal indices
+
+      if (utils::strmatch(word,"^[cf]_")) {
+        Instr instr{(word[0] == 'c') ? COMPUTE_GLOBAL : FIX_GLOBAL, 0.0, 0, 0, 0, word.substr(2)};
+        while ((instr.nbracket < 2) && (i < nlen) && (str[i] == '[')) {
+          std::size_t istop = str.find(']',i);
+          if (istop == std::string::npos) return 0;
+          std::string index = str.substr(i+1,istop-i-1);
+          if (!utils::is_integer(index) || (index[0] == '-') || (index[0] == '+')) return 0;
+          tagint value = utils::tnumeric(FLERR,index,false,lmp);
+          if (value <= 0) return 0;
+          if (instr.nbracket == 0) instr.index1 = value;
+          else instr.index2 = value;
+          instr.nbracket++;
+          i = istop+1;
+        }
+        code.push_back(instr);
+
+      // v_name of a variable with a scalar value
+
+      } else if (utils::strmatch(word,"^v_")) {
+        if ((i < nlen) && (str[i] == '[')) return 0;
+        code.push_back(Instr{VARIABLE_SCALAR, 0.0, 0, 0, 0, word.substr(2)});
+
+      // uppercase compute/fix, custom atom property, atom value
+
+      } else if (utils::strmatch(word,"^[CF]_") || utils::strmatch(word,"^[id]2?_") ||
+                 ((i < nlen) && (str[i] == '['))) {
+        return 0;
+
+      // math function with comma-separated args at paren level 0
+
+      } else if ((i < nlen) && (str[i] == '(')) {
+        auto func = compiled_functions.find(word);
+        if (func == compiled_functions.end()) return 0;
+
+        std::size_t istop = matching_paren(i);
+        if (istop == std::string::npos) return 0;
+
+        int narg = 0;
+        int ilevel = 0;
+        std::size_t iarg = i+1;
+        for (std::size_t j = i+1; j <= istop; j++) {
+          if (str[j] == '(') ilevel++;
+          else if ((str[j] == ')') && ilevel) ilevel--;
+          else if ((str[j] == ',' && !ilevel) || (j == istop)) {
+            if (++narg > func->second.second) return 0;
+            if (!compile_formula(str.substr(iarg,j-iarg),code)) return 0;
+            iarg = j+1;
+          }
+        }
+        if (narg != func->second.second) return 0;
+        code.push_back(Instr{func->second.first, 0.0, 0, 0, 0, ""});
+        i = istop+1;
+
+      // atom vector, constant, or thermo keyword
+
+      } else if (is_atom_vector(word.c_str())) {
+        return 0;
+      } else if (constants.find(word) != constants.end()) {
+        code.push_back(Instr{VALUE, constants[word], 0, 0, 0, ""});
+      } else {
+        code.push_back(Instr{THERMO_KEYWORD, 0.0, 0, 0, 0, word});
+      }
+
+    // math operator, including end-of-string
+
+    } else if (strchr("+-*/^<>=!&|%\0",onechar)) {
+      char nextchar = (i+1 < nlen) ? str[i+1] : '\0';
+      if (onechar == '+') op = ADD;
+      else if (onechar == '-') op = SUBTRACT;
+      else if (onechar == '*') op = MULTIPLY;
+      else if (onechar == '/') op = DIVIDE;
+      else if (onechar == '%') op = MODULO;
+      else if (onechar == '^') op = CARAT;
+      else if (onechar == '=') {
+        if (nextchar != '=') return 0;
+        op = EQ;
+        i++;
+      } else if (onechar == '!') {
+        if (nextchar == '=') {
+          op = NE;
+          i++;
+        } else op = NOT;
+      } else if (onechar == '<') {
+        if (nextchar != '=') op = LT;
+        else {
+          op = LE;
+          i++;
+        }
+      } else if (onechar == '>') {
+        if (nextchar != '=') op = GT;
+        else {
+          op = GE;
+          i++;
+        }
+      } else if (onechar == '&') {
+        if (nextchar != '&') return 0;
+        op = AND;
+        i++;
+      } else if (onechar == '|') {
+        if (nextchar == '|') op = OR;
+        else if (nextchar == '^') op = XOR;
+        else return 0;
+        i++;
+      } else op = DONE;
+
+      i++;
+
+      if (op == SUBTRACT && expect == ARG) {
+        opstack.push_back(UNARY);
+        continue;
+      }
+      if (op == NOT && expect == ARG) {
+        opstack.push_back(op);
+        continue;
+      }
+
+      if (expect == ARG) return 0;
+      expect = ARG;
+
+      // emit operators as deep as possible while respecting precedence
+
+      while (!opstack.empty() && precedence[opstack.back()] >= precedence[op]) {
+        code.push_back(Instr{opstack.back(), 0.0, 0, 0, 0, ""});
+        opstack.pop_back();
+      }
+
+      if (op == DONE) break;
+      opstack.push_back(op);
+
+    } else return 0;
+  }
+
+  if (!opstack.empty()) return 0;
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   evaluate a compiled equal-style formula
+   errors and results are the same as for evaluate() of the formula string
+------------------------------------------------------------------------- */
+
+double Variable::eval_program(Program *prog, int ivar)
+{
+  double *stack = prog->stack.data();
+  int n = 0;
+  double value1,value2;
+
+  for (const auto &instr : prog->code) {
+    switch (instr.op) {
+
+    case VALUE:
+      stack[n++] = instr.value;
+      break;
+
+    // references are looked up on every evaluation,
+    //   since computes, fixes, and variables can be deleted or replaced
+
+    case THERMO_KEYWORD:
+      if (domain->box_exist == 0)
+        print_var_error(FLERR,"Variable evaluation before simulation box is defined"
+                        + utils::errorurl(30),ivar);
+      if (output->thermo->evaluate_keyword(instr.id,&value1))
+        print_var_error(FLERR,fmt::format("Invalid thermo keyword '{}' in variable formula",
+                                          instr.id),ivar);
+      stack[n++] = value1;
+      break;
+
+    case COMPUTE_GLOBAL: {
+      if (domain->box_exist == 0)
+        print_var_error(FLERR,"Variable evaluation before simulation box is defined"
+                        + utils::errorurl(30),ivar);
+      Compute *compute = modify->get_compute_by_id(instr.id);
+      if (!compute)
+        print_var_error(FLERR,fmt::format("Invalid compute ID '{}' in variable formula",
+                                          instr.id),ivar);
+      stack[n++] = compute_global(compute,instr.nbracket,instr.index1,instr.index2,ivar);
+      break;
+    }
+
+    case FIX_GLOBAL: {
+      if (domain->box_exist == 0)
+        print_var_error(FLERR,"Variable evaluation before simulation box is defined"
+                        + utils::errorurl(30),ivar);
+      Fix *fix = modify->get_fix_by_id(instr.id);
+      if (!fix)
+        print_var_error(FLERR,fmt::format("Invalid fix ID '{}' in variable formula",
+                                          instr.id),ivar);
+      stack[n++] = fix_global(fix,instr.nbracket,instr.index1,instr.index2,ivar);
+      break;
+    }
+
+    case VARIABLE_SCALAR: {
+      int jvar = find(instr.id.c_str());
+      if (jvar < 0)
+        print_var_error(FLERR,fmt::format("Invalid variable reference v_{} in variable formula",
+                                          instr.id),jvar);
+      if (eval_in_progress[jvar])
+        print_var_error(FLERR,"has a circular dependency",jvar);
+
+      if (style[jvar] == INTERNAL) {
+        stack[n++] = dvalue[jvar];
+      } else if (style[jvar] == VECTOR) {
+        print_var_error(FLERR,"Vector-style variable in equal-style variable formula",jvar);
+      } else if (style[jvar] == ATOM) {
+        print_var_error(FLERR,"Atom-style variable in equal-style variable formula",jvar);
+      } else if (style[jvar] == ATOMFILE) {
+        print_var_error(FLERR,"Atomfile-style variable in equal-style variable formula",jvar);
+      } else {
+        char *var = retrieve(instr.id.c_str());
+        if (var == nullptr)
+          print_var_error(FLERR,"Invalid variable evaluation in variable formula",jvar);
+        if (!utils::is_double(var))
+          print_var_error(FLERR,"Non-numeric variable value in variable formula",jvar);
+        stack[n++] = std::stod(var);
+      }
+      break;
+    }
+
+    // operators
+
+    case ADD:
+      n--;
+      stack[n-1] += stack[n];
+      break;
+    case SUBTRACT:
+      n--;
+      stack[n-1] -= stack[n];
+      break;
+    case MULTIPLY:
+      n--;
+      stack[n-1] *= stack[n];
+      break;
+    case DIVIDE:
+      n--;
+      if (stack[n] == 0.0)
+        print_var_error(FLERR,"Divide by 0 in variable formula",ivar,0);
+      stack[n-1] /= stack[n];
+      break;
+    case MODULO:
+      n--;
+      if (stack[n] == 0.0)
+        print_var_error(FLERR,"Modulo 0 in variable formula",ivar,0);
+      stack[n-1] = fmod(stack[n-1],stack[n]);
+      break;
+    case CARAT:
+      n--;
+      if (stack[n] == 0.0)
+        stack[n-1] = 1.0;
+      else if ((stack[n-1] == 0.0) && (stack[n] < 0.0))
+        print_var_error(FLERR,"Invalid power expression in variable formula",ivar,0);
+      else stack[n-1] = pow(stack[n-1],stack[n]);
+      break;
+    case UNARY:
+      stack[n-1] = -stack[n-1];
+      break;
+    case NOT:
+      stack[n-1] = (stack[n-1] == 0.0) ? 1.0 : 0.0;
+      break;
+    case EQ:
+      n--;
+      stack[n-1] = (stack[n-1] == stack[n]) ? 1.0 : 0.0;
+      break;
+    case NE:
+      n--;
+      stack[n-1] = (stack[n-1] != stack[n]) ? 1.0 : 0.0;
+      break;
+    case LT:
+      n--;
+      stack[n-1] = (stack[n-1] < stack[n]) ? 1.0 : 0.0;
+      break;
+    case LE:
+      n--;
+      stack[n-1] = (stack[n-1] <= stack[n]) ? 1.0 : 0.0;
+      break;
+    case GT:
+      n--;
+      stack[n-1] = (stack[n-1] > stack[n]) ? 1.0 : 0.0;
+      break;
+    case GE:
+      n--;
+      stack[n-1] = (stack[n-1] >= stack[n]) ? 1.0 : 0.0;
+      break;
+    case AND:
+      n--;
+      stack[n-1] = (stack[n-1] != 0.0 && stack[n] != 0.0) ? 1.0 : 0.0;
+      break;
+    case OR:
+      n--;
+      stack[n-1] = (stack[n-1] != 0.0 || stack[n] != 0.0) ? 1.0 : 0.0;
+      break;
+    case XOR:
+      n--;
+      value1 = stack[n-1];
+      value2 = stack[n];
+      stack[n-1] = ((value1 == 0.0 && value2 != 0.0) ||
+                    (value1 != 0.0 && value2 == 0.0)) ? 1.0 : 0.0;
+      break;
+
+    // math functions
+
+    case SQRT:
+      if (stack[n-1] < 0.0)
+        print_var_error(FLERR,"Sqrt of negative value in variable formula",ivar,0);
+      stack[n-1] = sqrt(stack[n-1]);
+      break;
+    case EXP:
+      stack[n-1] = exp(stack[n-1]);
+      break;
+    case LN:
+      if (stack[n-1] <= 0.0)
+        print_var_error(FLERR,"Log of zero/negative value in variable formula",ivar,0);
+      stack[n-1] = log(stack[n-1]);
+      break;
+    case LOG:
+      if (stack[n-1] <= 0.0)
+        print_var_error(FLERR,"Log of zero/negative value in variable formula",ivar,0);
+      stack[n-1] = log10(stack[n-1]);
+      break;
+    case ABS:
+      stack[n-1] = fabs(stack[n-1]);
+      break;
+    case SIN:
+      stack[n-1] = sin(stack[n-1]);
+      break;
+    case COS:
+      stack[n-1] = cos(stack[n-1]);
+      break;
+    case TAN:
+      stack[n-1] = tan(stack[n-1]);
+      break;
+    case ASIN:
+      if (stack[n-1] < -1.0 || stack[n-1] > 1.0)
+        print_var_error(FLERR,"Arcsin of invalid value in variable formula",ivar,0);
+      stack[n-1] = asin(stack[n-1]);
+      break;
+    case ACOS:
+      if (stack[n-1] < -1.0 || stack[n-1] > 1.0)
+        print_var_error(FLERR,"Arccos of invalid value in variable formula",ivar,0);
+      stack[n-1] = acos(stack[n-1]);
+      break;
+    case ATAN:
+      stack[n-1] = atan(stack[n-1]);
+      break;
+    case ATAN2:
+      n--;
+      stack[n-1] = atan2(stack[n-1],stack[n]);
+      break;
+    case CEIL:
+      stack[n-1] = ceil(stack[n-1]);
+      break;
+    case FLOOR:
+      stack[n-1] = floor(stack[n-1]);
+      break;
+    case ROUND:
+      stack[n-1] = MYROUND(stack[n-1]);
+      break;
+    case SIGN:
+      stack[n-1] = (stack[n-1] >= 0.0) ? 1.0 : -1.0;
+      break;
+    case TERNARY:
+      n -= 2;
+      if (stack[n-1]) stack[n-1] = stack[n];
+      else stack[n-1] = stack[n+1];
+      break;
+
+    case RAMP:
+      n--;
+      if (update->whichflag != 0) {
+        double delta = update->ntimestep - update->beginstep;
+        if ((delta != 0.0) && (update->beginstep != update->endstep))
+          delta /= update->endstep - update->beginstep;
+        stack[n-1] += delta*(stack[n]-stack[n-1]);
+      }
+      break;
+
+    case STAGGER: {
+      n--;
+      auto ivalue1 = static_cast<bigint> (stack[n-1]);
+      auto ivalue2 = static_cast<bigint> (stack[n]);
+      if (ivalue1 <= 0 || ivalue2 <= 0 || ivalue1 <= ivalue2)
+        print_var_error(FLERR,"Invalid math function in variable formula",ivar);
+      bigint lower = update->ntimestep/ivalue1 * ivalue1;
+      bigint delta = update->ntimestep - lower;
+      if (delta < ivalue2) stack[n-1] = lower+ivalue2;
+      else stack[n-1] = lower+ivalue1;
+      break;
+    }
+    }
+  }
+
+  return stack[0];
+}
+
 /* ----------------------------------------------------------------------
    one-time collapse of an atom-style variable parse tree
    tree was created by one-time parsing of formula string via evaluate()
@@ -3539,6 +4019,387 @@ double Variable::eval_tree(Tree *tree, int i)
   return 0.0;
 }
 
+/* ----------------------------------------------------------------------
+   one-time conversion of a collapsed atom-style or vector-style parse tree
+     into a list of its nodes in postfix order for eval_tree_block()
+   depth = current size of value stack, maxdepth = max size needed
+   return 0 if tree has a node that eval_tree() must evaluate one atom at a time
+     e.g. random() and normal() where the order of calls matters
+     or && and || where the second operand may only be valid if the first is
+------------------------------------------------------------------------- */
+
+int Variable::flatten_tree(Tree *tree, std::vector<Tree *> &code, int &depth, int &maxdepth)
+{
+  switch (tree->type) {
+    case VALUE:
+    case ATOMARRAY:
+    case TYPEARRAY:
+    case INTARRAY:
+    case BIGINTARRAY:
+    case VECTORARRAY:
+    case GMASK:
+    case RMASK:
+    case GRMASK:
+      code.push_back(tree);
+      maxdepth = MAX(maxdepth,++depth);
+      return 1;
+
+    case UNARY:
+    case NOT:
+    case SQRT:
+    case EXP:
+    case LN:
+    case LOG:
+    case ABS:
+    case SIN:
+    case COS:
+    case TAN:
+    case ASIN:
+    case ACOS:
+    case ATAN:
+    case CEIL:
+    case FLOOR:
+    case ROUND:
+    case SIGN:
+      if (!flatten_tree(tree->first,code,depth,maxdepth)) return 0;
+      code.push_back(tree);
+      return 1;
+
+    case ADD:
+    case SUBTRACT:
+    case MULTIPLY:
+    case DIVIDE:
+    case MODULO:
+    case CARAT:
+    case EQ:
+    case NE:
+    case LT:
+    case LE:
+    case GT:
+    case GE:
+    case XOR:
+    case ATAN2:
+      if (!flatten_tree(tree->first,code,depth,maxdepth)) return 0;
+      if (!flatten_tree(tree->second,code,depth,maxdepth)) return 0;
+      code.push_back(tree);
+      depth--;
+      return 1;
+
+    case TERNARY:
+      if (!flatten_tree(tree->first,code,depth,maxdepth)) return 0;
+      if (!flatten_tree(tree->second,code,depth,maxdepth)) return 0;
+      if (!flatten_tree(tree->extra[0],code,depth,maxdepth)) return 0;
+      code.push_back(tree);
+      depth -= 2;
+      return 1;
+
+    default:
+      return 0;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   evaluate flattened tree for n atoms or vector elements starting at ifirst
+   stack = VECLEN values for each level of the value stack
+   result is returned in first VECLEN values of stack
+   inner loops over atoms are free of branches, so that they can be vectorized
+   math errors are only checked for atoms in group, as by eval_tree()
+     mask = nullptr for vector-style variables, to check all elements
+------------------------------------------------------------------------- */
+
+void Variable::eval_tree_block(const std::vector<Tree *> &code, double *stack, int ifirst, int n,
+                               int *mask, int groupbit)
+{
+  int k;
+  double *a, *b, *c;
+  int sp = 0;
+
+  auto active = [&](int k) {
+    return (mask == nullptr) || (mask[ifirst+k] & groupbit);
+  };
+
+  for (auto tree : code) {
+    switch (tree->type) {
+
+      // values pushed onto the stack
+
+      case VALUE:
+        a = stack + VECLEN*sp++;
+        for (k = 0; k < n; k++) a[k] = tree->value;
+        break;
+
+      case ATOMARRAY:
+      case VECTORARRAY: {
+        a = stack + VECLEN*sp++;
+        const int nstride = tree->nstride;
+        const double *array = tree->array + (bigint) ifirst*nstride;
+        if (nstride == 1)
+          for (k = 0; k < n; k++) a[k] = array[k];
+        else
+          for (k = 0; k < n; k++) a[k] = array[k*nstride];
+        break;
+      }
+
+      case TYPEARRAY: {
+        a = stack + VECLEN*sp++;
+        const int *type = atom->type + ifirst;
+        for (k = 0; k < n; k++) a[k] = tree->array[type[k]];
+        break;
+      }
+
+      case INTARRAY: {
+        a = stack + VECLEN*sp++;
+        const int nstride = tree->nstride;
+        const int *iarray = tree->iarray + (bigint) ifirst*nstride;
+        for (k = 0; k < n; k++) a[k] = (double) iarray[k*nstride];
+        break;
+      }
+
+      case BIGINTARRAY: {
+        a = stack + VECLEN*sp++;
+        const int nstride = tree->nstride;
+        const bigint *barray = tree->barray + (bigint) ifirst*nstride;
+        for (k = 0; k < n; k++) a[k] = (double) barray[k*nstride];
+        break;
+      }
+
+      case GMASK: {
+        a = stack + VECLEN*sp++;
+        const int *amask = atom->mask + ifirst;
+        for (k = 0; k < n; k++) a[k] = (amask[k] & tree->ivalue) ? 1.0 : 0.0;
+        break;
+      }
+
+      case RMASK:
+      case GRMASK: {
+        a = stack + VECLEN*sp++;
+        double **x = atom->x;
+        const int *amask = atom->mask;
+        for (k = 0; k < n; k++) {
+          int i = ifirst + k;
+          if ((tree->type == GRMASK) && !(amask[i] & tree->ivalue)) a[k] = 0.0;
+          else a[k] = tree->region->match(x[i][0],x[i][1],x[i][2]) ? 1.0 : 0.0;
+        }
+        break;
+      }
+
+      // operators with two args, result replaces first arg
+
+      case ADD:
+        b = stack + VECLEN*(--sp);
+        a = b - VECLEN;
+        for (k = 0; k < n; k++) a[k] += b[k];
+        break;
+
+      case SUBTRACT:
+        b = stack + VECLEN*(--sp);
+        a = b - VECLEN;
+        for (k = 0; k < n; k++) a[k] -= b[k];
+        break;
+
+      case MULTIPLY:
+        b = stack + VECLEN*(--sp);
+        a = b - VECLEN;
+        for (k = 0; k < n; k++) a[k] *= b[k];
+        break;
+
+      case DIVIDE:
+        b = stack + VECLEN*(--sp);
+        a = b - VECLEN;
+        for (k = 0; k < n; k++)
+          if ((b[k] == 0.0) && active(k)) error->one(FLERR,"Divide by 0 in variable formula");
+        for (k = 0; k < n; k++) a[k] /= b[k];
+        break;
+
+      case MODULO:
+        b = stack + VECLEN*(--sp);
+        a = b - VECLEN;
+        for (k = 0; k < n; k++)
+          if ((b[k] == 0.0) && active(k)) error->one(FLERR,"Modulo 0 in variable formula");
+        for (k = 0; k < n; k++) a[k] = fmod(a[k],b[k]);
+        break;
+
+      case CARAT:
+        b = stack + VECLEN*(--sp);
+        a = b - VECLEN;
+        for (k = 0; k < n; k++)
+          if ((b[k] == 0.0) && active(k)) error->one(FLERR,"Power by 0 in variable formula");
+        for (k = 0; k < n; k++) a[k] = pow(a[k],b[k]);
+        break;
+
+      case EQ:
+        b = stack + VECLEN*(--sp);
+        a = b - VECLEN;
+        for (k = 0; k < n; k++) a[k] = (a[k] == b[k]) ? 1.0 : 0.0;
+        break;
+
+      case NE:
+        b = stack + VECLEN*(--sp);
+        a = b - VECLEN;
+        for (k = 0; k < n; k++) a[k] = (a[k] != b[k]) ? 1.0 : 0.0;
+        break;
+
+      case LT:
+        b = stack + VECLEN*(--sp);
+        a = b - VECLEN;
+        for (k = 0; k < n; k++) a[k] = (a[k] < b[k]) ? 1.0 : 0.0;
+        break;
+
+      case LE:
+        b = stack + VECLEN*(--sp);
+        a = b - VECLEN;
+        for (k = 0; k < n; k++) a[k] = (a[k] <= b[k]) ? 1.0 : 0.0;
+        break;
+
+      case GT:
+        b = stack + VECLEN*(--sp);
+        a = b - VECLEN;
+        for (k = 0; k < n; k++) a[k] = (a[k] > b[k]) ? 1.0 : 0.0;
+        break;
+
+      case GE:
+        b = stack + VECLEN*(--sp);
+        a = b - VECLEN;
+        for (k = 0; k < n; k++) a[k] = (a[k] >= b[k]) ? 1.0 : 0.0;
+        break;
+
+      case AND:
+        b = stack + VECLEN*(--sp);
+        a = b - VECLEN;
+        for (k = 0; k < n; k++) a[k] = ((a[k] != 0.0) && (b[k] != 0.0)) ? 1.0 : 0.0;
+        break;
+
+      case OR:
+        b = stack + VECLEN*(--sp);
+        a = b - VECLEN;
+        for (k = 0; k < n; k++) a[k] = ((a[k] != 0.0) || (b[k] != 0.0)) ? 1.0 : 0.0;
+        break;
+
+      case XOR:
+        b = stack + VECLEN*(--sp);
+        a = b - VECLEN;
+        for (k = 0; k < n; k++) a[k] = ((a[k] == 0.0) != (b[k] == 0.0)) ? 1.0 : 0.0;
+        break;
+
+      case ATAN2:
+        b = stack + VECLEN*(--sp);
+        a = b - VECLEN;
+        for (k = 0; k < n; k++) a[k] = atan2(a[k],b[k]);
+        break;
+
+      case TERNARY:
+        sp -= 2;
+        a = stack + VECLEN*(sp-1);
+        b = a + VECLEN;
+        c = b + VECLEN;
+        for (k = 0; k < n; k++) a[k] = (a[k] != 0.0) ? b[k] : c[k];
+        break;
+
+      // operators and functions with one arg, result replaces arg
+
+      case UNARY:
+        a = stack + VECLEN*(sp-1);
+        for (k = 0; k < n; k++) a[k] = -a[k];
+        break;
+
+      case NOT:
+        a = stack + VECLEN*(sp-1);
+        for (k = 0; k < n; k++) a[k] = (a[k] == 0.0) ? 1.0 : 0.0;
+        break;
+
+      case SQRT:
+        a = stack + VECLEN*(sp-1);
+        for (k = 0; k < n; k++)
+          if ((a[k] < 0.0) && active(k))
+            error->one(FLERR,"Sqrt of negative value in variable formula");
+        for (k = 0; k < n; k++) a[k] = sqrt(a[k]);
+        break;
+
+      case EXP:
+        a = stack + VECLEN*(sp-1);
+        for (k = 0; k < n; k++) a[k] = exp(a[k]);
+        break;
+
+      case LN:
+        a = stack + VECLEN*(sp-1);
+        for (k = 0; k < n; k++)
+          if ((a[k] <= 0.0) && active(k))
+            error->one(FLERR,"Log of zero/negative value in variable formula");
+        for (k = 0; k < n; k++) a[k] = log(a[k]);
+        break;
+
+      case LOG:
+        a = stack + VECLEN*(sp-1);
+        for (k = 0; k < n; k++)
+          if ((a[k] <= 0.0) && active(k))
+            error->one(FLERR,"Log of zero/negative value in variable formula");
+        for (k = 0; k < n; k++) a[k] = log10(a[k]);
+        break;
+
+      case ABS:
+        a = stack + VECLEN*(sp-1);
+        for (k = 0; k < n; k++) a[k] = fabs(a[k]);
+        break;
+
+      case SIN:
+        a = stack + VECLEN*(sp-1);
+        for (k = 0; k < n; k++) a[k] = sin(a[k]);
+        break;
+
+      case COS:
+        a = stack + VECLEN*(sp-1);
+        for (k = 0; k < n; k++) a[k] = cos(a[k]);
+        break;
+
+      case TAN:
+        a = stack + VECLEN*(sp-1);
+        for (k = 0; k < n; k++) a[k] = tan(a[k]);
+        break;
+
+      case ASIN:
+        a = stack + VECLEN*(sp-1);
+        for (k = 0; k < n; k++)
+          if ((a[k] < -1.0 || a[k] > 1.0) && active(k))
+            error->one(FLERR,"Arcsin of invalid value in variable formula");
+        for (k = 0; k < n; k++) a[k] = asin(a[k]);
+        break;
+
+      case ACOS:
+        a = stack + VECLEN*(sp-1);
+        for (k = 0; k < n; k++)
+          if ((a[k] < -1.0 || a[k] > 1.0) && active(k))
+            error->one(FLERR,"Arccos of invalid value in variable formula");
+        for (k = 0; k < n; k++) a[k] = acos(a[k]);
+        break;
+
+      case ATAN:
+        a = stack + VECLEN*(sp-1);
+        for (k = 0; k < n; k++) a[k] = atan(a[k]);
+        break;
+
+      case CEIL:
+        a = stack + VECLEN*(sp-1);
+        for (k = 0; k < n; k++) a[k] = ceil(a[k]);
+        break;
+
+      case FLOOR:
+        a = stack + VECLEN*(sp-1);
+        for (k = 0; k < n; k++) a[k] = floor(a[k]);
+        break;
+
+      case ROUND:
+        a = stack + VECLEN*(sp-1);
+        for (k = 0; k < n; k++) a[k] = MYROUND(a[k]);
+        break;
+
+      case SIGN:
+        a = stack + VECLEN*(sp-1);
+        for (k = 0; k < n; k++) a[k] = (a[k] >= 0.0) ? 1.0 : -1.0;
+        break;
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    scan entire tree, find size of vectors for vector-style variable
    return N for consistent vector size
@@ -4977,6 +5838,142 @@ int Variable::feature_function(char *word, char *contents, Tree **tree, Tree **t
   return 1;
 }
 
+/* ----------------------------------------------------------------------
+   return a global scalar, vector element, or array element of a compute
+   nbracket = 0,1,2 for c_ID, c_ID[i], c_ID[i][j]
+   invoke the compute if not already done on this timestep
+------------------------------------------------------------------------- */
+
+double Variable::compute_global(Compute *compute, int nbracket, tagint index1, tagint index2,
+                                int ivar)
+{
+  // c_ID = scalar from global scalar
+
+  if (nbracket == 0) {
+
+    if (!compute->scalar_flag)
+      print_var_error(FLERR,"Mismatched compute in variable formula",ivar);
+    if (!compute->is_initialized())
+      print_var_error(FLERR,"Variable formula compute cannot be invoked before "
+                      "initialization by a run",ivar);
+    if (!(compute->invoked_flag & Compute::INVOKED_SCALAR)) {
+      compute->compute_scalar();
+      compute->invoked_flag |= Compute::INVOKED_SCALAR;
+    }
+
+    return compute->scalar;
+  }
+
+  // c_ID[i] = scalar from global vector
+
+  if (nbracket == 1) {
+
+    if (!compute->vector_flag)
+      print_var_error(FLERR,"Mismatched compute in variable formula",ivar);
+    if (!compute->is_initialized())
+      print_var_error(FLERR,"Variable formula compute cannot be invoked before "
+                      "initialization by a run",ivar);
+    if (!(compute->invoked_flag & Compute::INVOKED_VECTOR)) {
+      compute->compute_vector();
+      compute->invoked_flag |= Compute::INVOKED_VECTOR;
+    }
+
+    // wait to check index1 until after compute invocation
+    // to allow for computes with size_vector_variable == 1
+
+    if (index1 > compute->size_vector)
+      print_var_error(FLERR,"Variable formula compute vector is accessed out-of-range"
+                      + utils::errorurl(20), ivar, 0);
+
+    return compute->vector[index1-1];
+  }
+
+  // c_ID[i][j] = scalar from global array
+
+  if (!compute->array_flag)
+    print_var_error(FLERR,"Mismatched compute in variable formula",ivar);
+  if (index2 > compute->size_array_cols)
+    print_var_error(FLERR,"Variable formula compute array is accessed out-of-range"
+                    + utils::errorurl(20), ivar, 0);
+  if (!compute->is_initialized())
+    print_var_error(FLERR,"Variable formula compute cannot be invoked before "
+                    "initialization by a run",ivar);
+  if (!(compute->invoked_flag & Compute::INVOKED_ARRAY)) {
+    compute->compute_array();
+    compute->invoked_flag |= Compute::INVOKED_ARRAY;
+  }
+
+  // wait to check index1 until after compute invocation
+  // to allow for computes with size_array_rows_variable == 1
+
+  if (index1 > compute->size_array_rows)
+    print_var_error(FLERR,"Variable formula compute array is accessed out-of-range"
+                    + utils::errorurl(20), ivar, 0);
+
+  return compute->array[index1-1][index2-1];
+}
+
+/* ----------------------------------------------------------------------
+   return a global scalar, vector element, or array element of a fix
+   nbracket = 0,1,2 for f_ID, f_ID[i], f_ID[i][j]
+------------------------------------------------------------------------- */
+
+double Variable::fix_global(Fix *fix, int nbracket, tagint index1, tagint index2, int ivar)
+{
+  // f_ID = scalar from global scalar
+
+  if (nbracket == 0) {
+
+    if (!fix->scalar_flag)
+      print_var_error(FLERR,"Mismatched fix in variable formula",ivar);
+    if (update->whichflag > 0 && update->ntimestep % fix->global_freq)
+      print_var_error(FLERR,"Fix in variable not computed at a compatible time"
+                      + utils::errorurl(7), ivar);
+
+    return fix->compute_scalar();
+  }
+
+  // f_ID[i] = scalar from global vector
+
+  if (nbracket == 1) {
+
+    if (!fix->vector_flag)
+      print_var_error(FLERR,"Mismatched fix in variable formula",ivar);
+    if (index1 > fix->size_vector && fix->size_vector_variable == 0)
+      print_var_error(FLERR,"Variable formula fix vector is accessed out-of-range"
+                      + utils::errorurl(20), ivar,0);
+    if (update->whichflag > 0 && update->ntimestep % fix->global_freq)
+      print_var_error(FLERR,"Fix in variable not computed at a compatible time"
+                      + utils::errorurl(7) ,ivar);
+
+    // if index exceeds variable vector length, use a zero value
+    // this can be useful if vector length is not known a priori
+
+    if (fix->size_vector_variable && index1 > fix->size_vector) return 0.0;
+    return fix->compute_vector(index1-1);
+  }
+
+  // f_ID[i][j] = scalar from global array
+
+  if (!fix->array_flag)
+    print_var_error(FLERR,"Mismatched fix in variable formula",ivar);
+  if (index1 > fix->size_array_rows && fix->size_array_rows_variable == 0)
+    print_var_error(FLERR,"Variable formula fix array is accessed out-of-range"
+                    + utils::errorurl(20), ivar,0);
+  if (index2 > fix->size_array_cols)
+    print_var_error(FLERR,"Variable formula fix array is accessed out-of-range"
+                    + utils::errorurl(20), ivar,0);
+  if (update->whichflag > 0 && update->ntimestep % fix->global_freq)
+    print_var_error(FLERR,"Fix in variable not computed at a compatible time"
+                    + utils::errorurl(7), ivar);
+
+  // if index exceeds variable array rows, use a zero value
+  // this can be useful if array size is not known a priori
+
+  if (fix->size_array_rows_variable && index1 > fix->size_array_rows) return 0.0;
+  return fix->compute_array(index1-1,index2-1);
+}
+
 /* ----------------------------------------------------------------------
    extract a global value from a per-atom quantity in a formula
    flag = 0 -> word is an atom vector
@@ -5105,7 +6102,7 @@ void Variable::custom2global(int *ivector, double *dvector, int nstride, tagint
      id,mass,type,mol,radius,q,x,y,z,vx,vy,vz,fx,fy,fz
 ------------------------------------------------------------------------- */
 
-int Variable::is_atom_vector(char *word)
+int Variable::is_atom_vector(const char *word)
 {
   if (strcmp(word,"id") == 0) return 1;
   if (strcmp(word,"mass") == 0) return 1;
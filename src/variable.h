@@ -130,15 +130,43 @@ class Variable : protected Pointers {
     }
   };
 
+  // compiled equal-style formula
+  // instructions are stored in postfix order and evaluated with a value stack
+  // references to computes, fixes, variables and thermo keywords are looked up by name
+
+  struct Instr {
+    int op;                   // operation, math function, or type of reference
+    double value;             // constant value
+    int nbracket;             // # of indices of compute or fix reference
+    tagint index1, index2;    // indices of compute or fix reference
+    std::string id;           // compute/fix ID, variable name, or thermo keyword
+  };
+
+  struct Program {
+    int valid;                    // 1 if formula was compiled, 0 if it must be parsed
+    std::vector<Instr> code;      // instructions in postfix order
+    std::vector<double> stack;    // value stack, sized for max depth
+  };
+
+  Program **program;    // compiled formula of equal-style vars, nullptr if not yet tried
+
   int compute_python(int);
   void remove(int);
   void grow();
   void copy(int, char **, char **);
   double evaluate(char *, Tree **, int);
+  double evaluate_equal(int);
+  Program *compile_equal(const char *);
+  int compile_formula(const std::string &, std::vector<Instr> &);
+  double eval_program(Program *, int);
+  double compute_global(class Compute *, int, tagint, tagint, int);
+  double fix_global(class Fix *, int, tagint, tagint, int);
   double collapse_tree(Tree *);
   double eval_tree(Tree *, int);
   int size_tree_vector(Tree *);
   int compare_tree_vector(int, int);
+  int flatten_tree(Tree *, std::vector<Tree *> &, int &, int &);
+  void eval_tree_block(const std::vector<Tree *> &, double *, int, int, int *, int);
   void free_tree(Tree *);
   int find_matching_paren(char *, int, char *&, int);
   int math_function(char *, char *, Tree **, Tree **, int &, double *, int &, int);
@@ -149,7 +177,7 @@ class Variable : protected Pointers {
   int feature_function(char *, char *, Tree **, Tree **, int &, double *, int &, int);
   void peratom2global(int, char *, double *, int, tagint, Tree **, Tree **, int &, double *, int &);
   void custom2global(int *, double *, int, tagint, Tree **, Tree **, int &, double *, int &);
-  int is_atom_vector(char *);
+  int is_atom_vector(const char *);
   void atom_vector(char *, Tree **, Tree **, int &);
   int parse_args(char *, char **);
   void parse_vector(int, char *);
@@ -34,13 +34,20 @@
 #include "update.h"
 
 #include <cstring>
+#include <exception>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 
 using namespace LAMMPS_NS;
 
+static constexpr int NTUNE = 10;    // # of steps timed per mode by concurrent select
+
 /* ---------------------------------------------------------------------- */
 
 Verlet::Verlet(LAMMPS *lmp, int narg, char **arg) :
-  Integrate(lmp, narg, arg) {}
+  Integrate(lmp, narg, arg), concurrent(0), tune_count(0), omp_levels(-1), tune_time{0.0, 0.0} {}
 
 /* ----------------------------------------------------------------------
    initialization before run
@@ -84,6 +91,36 @@ void Verlet::init()
   // orthogonal vs triclinic simulation box
 
   triclinic = domain->triclinic;
+
+  // concurrent kspace and pair computation
+  // kspace grid work runs on the MPI master thread while the pair style
+  //   uses the remaining OpenMP threads, so neither may communicate
+  //   during that time and the kspace style must support the split
+
+  concurrent = 0;
+  tune_count = 0;
+  tune_time[0] = tune_time[1] = 0.0;
+
+  KSpace *kspace = force->kspace;
+  if (kspace && kspace->concurrent_flag) {
+    std::string reason;
+#if defined(_OPENMP)
+    Pair *pair = force->pair;
+    if (!kspace->split_enable)
+      reason = fmt::format("kspace style {} does not support it", force->kspace_style);
+    else if (pair && (pair->comm_forward || pair->comm_reverse || pair->comm_reverse_off))
+      reason = fmt::format("pair style {} communicates during compute", force->pair_style);
+    else if (neighbor->overlap_pair)
+      reason = "it is incompatible with comm_modify overlap";
+    else if (triclinic)
+      reason = "it is not supported for triclinic boxes";
+#else
+    reason = "LAMMPS was compiled without OpenMP support";
+#endif
+    if (reason.empty()) concurrent = kspace->concurrent_flag;
+    else if (comm->me == 0)
+      error->warning(FLERR, "Ignoring kspace_modify concurrent because {}", reason);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -107,6 +144,7 @@ void Verlet::setup(int flag)
     error->all(FLERR,"KOKKOS package requires run_style verlet/kk");
 
   update->setupflag = 1;
+  setup_concurrent();
 
   // setup domain, communication and neighboring
   // acquire ghosts
@@ -170,6 +208,7 @@ void Verlet::setup(int flag)
 void Verlet::setup_minimal(int flag)
 {
   update->setupflag = 1;
+  setup_concurrent();
 
   // setup domain, communication and neighboring
   // acquire ghosts
@@ -239,6 +278,9 @@ void Verlet::run(int n)
   int n_pre_reverse = modify->n_pre_reverse;
   int n_post_force_any = modify->n_post_force_any;
   int n_end_of_step = modify->n_end_of_step;
+  int overlap = neighbor->overlap_pair;
+  int split;
+  double tstart = 0.0;
 
   if (atom->sortfreq > 0) sortflag = 1;
   else sortflag = 0;
@@ -251,6 +293,7 @@ void Verlet::run(int n)
 
     ntimestep = ++update->ntimestep;
     ev_set(ntimestep);
+    timer->trace_begin("Step","step","step",ntimestep);
 
     // initial time integration
 
@@ -263,10 +306,17 @@ void Verlet::run(int n)
 
     nflag = neighbor->decide();
 
+    // with overlap, forward comm is completed during the pair computation
+
     if (nflag == 0) {
       timer->stamp();
-      comm->forward_comm();
+      if (overlap) comm->forward_comm_begin();
+      else comm->forward_comm();
       timer->stamp(Timer::COMM);
+      if (neighbor->nprune) {
+        neighbor->prune();
+        timer->stamp(Timer::NEIGH);
+      }
     } else {
       if (n_pre_exchange) {
         timer->stamp();
@@ -312,8 +362,25 @@ void Verlet::run(int n)
       timer->stamp(Timer::MODIFY);
     }
 
-    if (pair_compute_flag) {
-      force->pair->compute(eflag,vflag);
+    // with concurrent kspace, the kspace grid work is done alongside the pair
+    // and only the per-atom kspace forces are computed after the bonded terms
+    // concurrent select alternates between both modes until it picks the faster
+
+    split = kspace_compute_flag &&
+      ((concurrent == 1) || ((concurrent == 2) && (tune_count % 2)));
+    if (concurrent == 2) tstart = platform::walltime();
+
+    if (split) {
+      force_concurrent(eflag,vflag);
+      timer->stamp(Timer::PAIR);
+    } else if (pair_compute_flag) {
+      if (overlap && nflag == 0) {
+        force->pair->compute_overlap(eflag,vflag,0);
+        timer->stamp(Timer::PAIR);
+        comm->forward_comm_end();
+        timer->stamp(Timer::COMM);
+        force->pair->compute_overlap(eflag,vflag,1);
+      } else force->pair->compute(eflag,vflag);
       timer->stamp(Timer::PAIR);
     }
 
@@ -326,10 +393,14 @@ void Verlet::run(int n)
     }
 
     if (kspace_compute_flag) {
-      force->kspace->compute(eflag,vflag);
+      if (split) force->kspace->compute_force();
+      else force->kspace->compute(eflag,vflag);
       timer->stamp(Timer::KSPACE);
     }
 
+    if (concurrent == 2 && kspace_compute_flag)
+      tune_concurrent(split,platform::walltime() - tstart);
+
     if (n_pre_reverse) {
       modify->pre_reverse(eflag,vflag);
       timer->stamp(Timer::MODIFY);
@@ -356,6 +427,7 @@ void Verlet::run(int n)
       output->write(ntimestep);
       timer->stamp(Timer::OUTPUT);
     }
+    timer->trace_end();
   }
 }
 
@@ -363,11 +435,109 @@ void Verlet::run(int n)
 
 void Verlet::cleanup()
 {
+  // restore OpenMP nesting setting changed in setup()
+
+#if defined(_OPENMP)
+  if (omp_levels >= 0) omp_set_max_active_levels(omp_levels);
+#endif
+  omp_levels = -1;
+
+  neighbor->cleanup();
   modify->post_run();
   domain->box_too_small_check();
   update->update_time();
 }
 
+/* ----------------------------------------------------------------------
+   concurrent kspace needs a nested parallel region for the pair style
+   the previous OpenMP setting is restored in cleanup()
+------------------------------------------------------------------------- */
+
+void Verlet::setup_concurrent()
+{
+#if defined(_OPENMP)
+  if (concurrent && (omp_levels < 0) && (omp_get_max_active_levels() < 2)) {
+    omp_levels = omp_get_max_active_levels();
+    omp_set_max_active_levels(2);
+  }
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   compute pair forces concurrently with the kspace grid operations
+   kspace runs on the master thread, so it may use MPI as usual
+   kspace uses kspace->concurrent_nthreads threads, pair uses the others
+   pair must not communicate
+------------------------------------------------------------------------- */
+
+void Verlet::force_concurrent(int eflag, int vflag)
+{
+#if defined(_OPENMP)
+  KSpace *kspace = force->kspace;
+  const int nthreads = comm->nthreads;
+  const int nkspace = MAX(1, MIN(kspace->concurrent_nthreads, nthreads - 1));
+  const int npair = MAX(1, nthreads - nkspace);
+  std::exception_ptr kspace_error, pair_error;
+
+  // OPENMP package styles partition their work by comm->nthreads
+  // threaded kspace styles use the per-thread data after that of the pair style
+
+  comm->nthreads = npair;
+  kspace->concurrent_tid = (npair + nkspace <= nthreads) ? npair : 0;
+
+#pragma omp parallel num_threads(2) default(shared)
+  {
+    const int tid = omp_get_thread_num();
+    const int nteam = omp_get_num_threads();
+
+    if (tid == 0) {
+      try {
+        omp_set_num_threads(nkspace);
+        kspace->compute_grid(eflag,vflag);
+      } catch (...) {
+        kspace_error = std::current_exception();
+      }
+    }
+
+    if ((tid == 1) || (nteam == 1)) {
+      try {
+        omp_set_num_threads(npair);
+        if (pair_compute_flag) force->pair->compute(eflag,vflag);
+      } catch (...) {
+        pair_error = std::current_exception();
+      }
+    }
+  }
+
+  comm->nthreads = nthreads;
+  kspace->concurrent_tid = 0;
+  if (kspace_error) std::rethrow_exception(kspace_error);
+  if (pair_error) std::rethrow_exception(pair_error);
+#else
+  if (pair_compute_flag) force->pair->compute(eflag,vflag);
+  force->kspace->compute_grid(eflag,vflag);
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   accumulate force time for concurrent select and pick the faster mode
+   once both have been timed for NTUNE steps
+------------------------------------------------------------------------- */
+
+void Verlet::tune_concurrent(int split, double delta)
+{
+  tune_time[split] += delta;
+  if (++tune_count < 2 * NTUNE) return;
+
+  double all[2];
+  MPI_Allreduce(tune_time, all, 2, MPI_DOUBLE, MPI_MAX, world);
+  concurrent = (all[1] < all[0]) ? 1 : 0;
+
+  if (comm->me == 0)
+    utils::logmesg(lmp, "Concurrent kspace: {} ({:.6g} vs {:.6g} secs per {} steps)\n",
+                   concurrent ? "enabled" : "disabled", all[1], all[0], NTUNE);
+}
+
 /* ----------------------------------------------------------------------
    clear force on own & ghost atoms
    clear other arrays as needed
@@ -37,6 +37,15 @@ class Verlet : public Integrate {
  protected:
   int triclinic;    // 0 if domain is orthog, 1 if triclinic
   int torqueflag, extraflag;
+
+  int concurrent;          // 0 = serial, 1 = concurrent kspace/pair, 2 = select
+  int tune_count;          // # of steps timed so far by concurrent select
+  int omp_levels;          // OpenMP max active levels before run, -1 if unchanged
+  double tune_time[2];     // accumulated force time w/o and w/ concurrency
+
+  void setup_concurrent();
+  void force_concurrent(int, int);
+  void tune_concurrent(int, double);
 };
 
 }    // namespace LAMMPS_NS
@@ -48,6 +48,7 @@ WriteRestart::WriteRestart(LAMMPS *lmp) : Command(lmp)
   MPI_Comm_rank(world,&me);
   MPI_Comm_size(world,&nprocs);
   multiproc = 0;
+  mpiioflag = 0;
   noinit = 0;
   fp = nullptr;
 }
@@ -73,8 +74,8 @@ void WriteRestart::command(int narg, char **arg)
 
   if (strchr(arg[0],'%')) multiproc = nprocs;
   else multiproc = 0;
-  if (utils::strmatch(arg[0],"\\.mpiio$"))
-    error->all(FLERR,"MPI-IO files are no longer supported by LAMMPS");
+  if (multiproc && utils::strmatch(arg[0],"\\.mpiio$"))
+    error->all(FLERR,"Cannot use % and .mpiio in the same restart file name");
 
   // setup output style and process optional args
   // also called by Output class for periodic restart files
@@ -208,6 +209,12 @@ void WriteRestart::write(const std::string &file)
     error->all(FLERR,"Atom count is inconsistent: {} vs {}, cannot write restart file",
                natoms, atom->natoms);
 
+  // a .mpiio suffix selects a single file with atom data written via MPI-IO
+
+  mpiioflag = utils::strmatch(file,"\\.mpiio$") ? 1 : 0;
+  if (multiproc && mpiioflag)
+    error->all(FLERR,"Cannot use % and .mpiio in the same restart file name");
+
   // open single restart file or base file for multiproc case
 
   if (me == 0) {
@@ -283,6 +290,20 @@ void WriteRestart::write(const std::string &file)
     }
   }
 
+  // if MPI-IO output:
+  //   close file after header, atom data starts at the header size
+
+  bigint headersize = 0;
+  if (mpiioflag) {
+    if (me == 0) {
+      if (ferror(fp)) io_error = 1;
+      headersize = ftell(fp);
+      fclose(fp);
+      fp = nullptr;
+    }
+    MPI_Bcast(&headersize,1,MPI_LMP_BIGINT,0,world);
+  }
+
   // pack my atom data into buf
 
   AtomVec *avec = atom->avec;
@@ -343,9 +364,32 @@ void WriteRestart::write(const std::string &file)
   // ping each proc in my cluster, receive its data, write data to file
   // else wait for ping from fileproc, send my data to fileproc
 
+  // output of a single file via MPI-IO
+  // each proc writes its chunk at its offset in proc order, collectively
+  // last proc writes magic string after last chunk
+
   int tmp,recv_size;
 
-  if (filewriter) {
+  if (mpiioflag) {
+    bigint nbytes = (bigint) send_size * sizeof(double);
+    bigint offset;
+    MPI_Scan(&nbytes,&offset,1,MPI_LMP_BIGINT,MPI_SUM,world);
+    offset += headersize - nbytes;
+
+    MPI_File fh;
+    int err = MPI_File_open(world,file.c_str(),MPI_MODE_WRONLY,MPI_INFO_NULL,&fh);
+    if (err != MPI_SUCCESS)
+      error->one(FLERR,"Cannot open restart file {} for MPI-IO",file);
+    err = MPI_File_write_at_all(fh,offset,buf,send_size,MPI_DOUBLE,MPI_STATUS_IGNORE);
+    if (err != MPI_SUCCESS) io_error = 1;
+    if (me == nprocs-1) {
+      const char magic[] = MAGIC_STRING;
+      err = MPI_File_write_at(fh,offset+nbytes,magic,strlen(magic)+1,MPI_CHAR,MPI_STATUS_IGNORE);
+      if (err != MPI_SUCCESS) io_error = 1;
+    }
+    MPI_File_close(&fh);
+
+  } else if (filewriter) {
     MPI_Status status;
     MPI_Request request;
     for (int iproc = 0; iproc < nclusterprocs; iproc++) {
@@ -549,10 +593,23 @@ void WriteRestart::force_fields()
    all procs call this method, only proc 0 writes to file
 ------------------------------------------------------------------------- */
 
-void WriteRestart::file_layout(int /*send_size*/)
+void WriteRestart::file_layout(int send_size)
 {
   if (me == 0) write_int(MULTIPROC,multiproc);
 
+  // for MPI-IO output, proc 0 writes size of each proc's chunk of atom data
+
+  if (mpiioflag) {
+    int *all_send_sizes = nullptr;
+    if (me == 0) {
+      write_int(MPIIO,mpiioflag);
+      memory->create(all_send_sizes,nprocs,"write_restart:all_send_sizes");
+    }
+    MPI_Gather(&send_size,1,MPI_INT,all_send_sizes,1,MPI_INT,0,world);
+    if (me == 0) fwrite(all_send_sizes,sizeof(int),nprocs,fp);
+    memory->destroy(all_send_sizes);
+  }
+
   // -1 flag signals end of file layout info
 
   if (me == 0) {
@@ -43,6 +43,7 @@ class WriteRestart : public Command {
   int filewriter;       // 1 if this proc writes a file, else 0
   int fileproc;         // ID of proc in my cluster who writes to file
   int icluster;         // which cluster I am in
+  int mpiioflag;        // 1 if all procs write atoms to a single file via MPI-IO
 
   void header();
   void type_arrays();
@@ -162,6 +162,8 @@ extern void   lammps_addstep_compute_all(void *handle, void *nstep);
 extern void   lammps_gather_atoms(void *, const char *, int, int, void *);
 extern void   lammps_gather_atoms_concat(void *, const char *, int, int, void *);
 extern void   lammps_gather_atoms_subset(void *, const char *, int, int, int, int *, void *);
+extern void   lammps_gather_atoms_root(void *, const char *, int, int, void *);
+extern void   lammps_gather_atoms_subset_root(void *, const char *, int, int, int, int *, void *);
 extern void   lammps_scatter_atoms(void *, const char *, int, int, void *);
 extern void   lammps_scatter_atoms_subset(void *, const char *, int, int, int, int *, void *);
 extern void   lammps_gather_bonds(void *handle, void *data);
@@ -360,6 +362,8 @@ extern void   lammps_addstep_compute_all(void *handle, void *nstep);
 extern void   lammps_gather_atoms(void *, const char *, int, int, void *);
 extern void   lammps_gather_atoms_concat(void *, const char *, int, int, void *);
 extern void   lammps_gather_atoms_subset(void *, const char *, int, int, int, int *, void *);
+extern void   lammps_gather_atoms_root(void *, const char *, int, int, void *);
+extern void   lammps_gather_atoms_subset_root(void *, const char *, int, int, int, int *, void *);
 extern void   lammps_scatter_atoms(void *, const char *, int, int, void *);
 extern void   lammps_scatter_atoms_subset(void *, const char *, int, int, int, int *, void *);
 extern void   lammps_gather_bonds(void *handle, void *data);
@@ -285,6 +285,56 @@ TEST_F(MPITest, gather)
     delete[] x;
 }
 
+TEST_F(MPITest, gather_atoms_root)
+{
+    auto natoms = (int64_t)lammps_get_natoms(lmp);
+    ASSERT_EQ(natoms, 32);
+    int me = lammps_extract_setting(lmp, "world_rank");
+
+    // reference data from the all-ranks variant
+    auto *x_all    = new double[natoms * 3];
+    auto *type_all = new int[natoms];
+    lammps_gather_atoms(lmp, "x", 1, 3, x_all);
+    lammps_gather_atoms(lmp, "type", 0, 1, type_all);
+
+    // only rank 0 needs a destination buffer
+    double *x_root = nullptr;
+    int *type_root = nullptr;
+    if (me == 0) {
+        x_root    = new double[natoms * 3];
+        type_root = new int[natoms];
+    }
+    lammps_gather_atoms_root(lmp, "x", 1, 3, x_root);
+    lammps_gather_atoms_root(lmp, "type", 0, 1, type_root);
+
+    if (me == 0) {
+        for (int64_t i = 0; i < 3 * natoms; i++)
+            EXPECT_DOUBLE_EQ(x_root[i], x_all[i]);
+        for (int64_t i = 0; i < natoms; i++)
+            EXPECT_EQ(type_root[i], type_all[i]);
+    }
+
+    // subset in reverse order of atom IDs
+    int ids[5] = {31, 17, 9, 2, 1};
+    double *x_sub = nullptr;
+    if (me == 0) x_sub = new double[5 * 3];
+    lammps_gather_atoms_subset_root(lmp, "x", 1, 3, 5, ids, x_sub);
+
+    if (me == 0) {
+        for (int i = 0; i < 5; i++) {
+            EXPECT_DOUBLE_EQ(x_sub[3 * i], x_all[3 * (ids[i] - 1)]);
+            EXPECT_DOUBLE_EQ(x_sub[3 * i + 1], x_all[3 * (ids[i] - 1) + 1]);
+            EXPECT_DOUBLE_EQ(x_sub[3 * i + 2], x_all[3 * (ids[i] - 1) + 2]);
+        }
+    }
+
+    delete[] x_all;
+    delete[] type_all;
+    delete[] x_root;
+    delete[] type_root;
+    delete[] x_sub;
+}
+
 TEST_F(MPITest, scatter)
 {
     int *p_nlocal  = (int *)lammps_extract_global(lmp, "nlocal");
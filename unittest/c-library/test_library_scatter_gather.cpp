@@ -368,3 +368,68 @@ TEST_F(GatherProperties, gather_impropers_newton_off)
     delete[] impropers;
 #undef CHECK_IMPROPERS
 };
+
+#if !defined(LAMMPS_BIGBIG)
+TEST_F(GatherProperties, gather_atoms_root)
+{
+    if (!lammps_has_style(lmp, "atom", "full")) GTEST_SKIP();
+    std::string input = path_join(INPUT_DIR, "in.fourmol");
+    if (!verbose) ::testing::internal::CaptureStdout();
+    lammps_file(lmp, input.c_str());
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    int natoms = (int)lammps_get_natoms(lmp);
+    EXPECT_EQ(natoms, 29);
+
+    auto *x_all  = new double[3 * natoms];
+    auto *x_root = new double[3 * natoms];
+    auto *q_all  = new double[natoms];
+    auto *q_root = new double[natoms];
+    auto *m_all  = new int[natoms];
+    auto *m_root = new int[natoms];
+    lammps_gather_atoms(lmp, "x", 1, 3, x_all);
+    lammps_gather_atoms_root(lmp, "x", 1, 3, x_root);
+    lammps_gather_atoms(lmp, "q", 1, 1, q_all);
+    lammps_gather_atoms_root(lmp, "q", 1, 1, q_root);
+    lammps_gather_atoms(lmp, "molecule", 0, 1, m_all);
+    lammps_gather_atoms_root(lmp, "molecule", 0, 1, m_root);
+    EXPECT_EQ(lammps_has_error(lmp), 0);
+
+    for (int i = 0; i < 3 * natoms; ++i)
+        EXPECT_DOUBLE_EQ(x_root[i], x_all[i]);
+    for (int i = 0; i < natoms; ++i) {
+        EXPECT_DOUBLE_EQ(q_root[i], q_all[i]);
+        EXPECT_EQ(m_root[i], m_all[i]);
+    }
+
+    // subset with repeated and reordered atom IDs
+    int ids[4]     = {29, 3, 3, 10};
+    auto *x_subset = new double[3 * 4];
+    auto *x_sroot  = new double[3 * 4];
+    lammps_gather_atoms_subset(lmp, "x", 1, 3, 4, ids, x_subset);
+    lammps_gather_atoms_subset_root(lmp, "x", 1, 3, 4, ids, x_sroot);
+    EXPECT_EQ(lammps_has_error(lmp), 0);
+    for (int i = 0; i < 3 * 4; ++i)
+        EXPECT_DOUBLE_EQ(x_sroot[i], x_subset[i]);
+
+    // invalid arguments set an error
+    char errbuf[1024];
+    lammps_gather_atoms_root(lmp, "x", 1, 3, nullptr);
+    EXPECT_EQ(lammps_has_error(lmp), 1);
+    lammps_get_last_error_message(lmp, errbuf, 1024);
+    EXPECT_THAT(errbuf, HasSubstr("data must not be NULL"));
+    lammps_gather_atoms_root(lmp, "xxx", 1, 3, x_root);
+    EXPECT_EQ(lammps_has_error(lmp), 1);
+    lammps_get_last_error_message(lmp, errbuf, 1024);
+    EXPECT_THAT(errbuf, HasSubstr("unknown property xxx"));
+
+    delete[] x_all;
+    delete[] x_root;
+    delete[] q_all;
+    delete[] q_root;
+    delete[] m_all;
+    delete[] m_root;
+    delete[] x_subset;
+    delete[] x_sroot;
+}
+#endif
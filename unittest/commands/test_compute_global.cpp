@@ -12,6 +12,7 @@
 ------------------------------------------------------------------------- */
 
 #include "../testing/core.h"
+#include "group.h"
 #include "info.h"
 #include "input.h"
 #include "lammps.h"
@@ -20,8 +21,10 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include <cmath>
 #include <cstdio>
 #include <mpi.h>
+#include <vector>
 
 // whether to print verbose output (i.e. not capturing LAMMPS screen output).
 bool verbose = false;
@@ -295,6 +298,82 @@ TEST_F(ComputeGlobalTest, Reduction)
     EXPECT_DOUBLE_EQ(rep[3], max[0]);
 }
 
+TEST_F(ComputeGlobalTest, CombinedReduction)
+{
+    if (lammps_get_natoms(lmp) == 0.0) GTEST_SKIP();
+
+    // fix ave/time is invoked first and sums the partial results of all
+    // computes that support it with a single reduction for fix and thermo
+
+    BEGIN_HIDE_OUTPUT();
+    command("pair_style lj/cut/coul/cut 10.0");
+    command("pair_coeff * * 0.01 3.0");
+    command("bond_style harmonic");
+    command("bond_coeff * 100.0 1.5");
+
+    command("compute ke1 all ke");
+    command("compute ke2 allwater ke");
+    command("compute pe1 all pe");
+    command("compute pr1 all pressure thermo_temp");
+    command("compute sum allwater reduce sum vx vy vz");
+    command("compute abs allwater reduce sumabs vx vy vz");
+    command("compute avea allwater reduce aveabs vx vy vz");
+    command("compute sq all reduce sumsq vx vy vz");
+    command("fix ave all ave/time 1 1 1 c_ke1 c_ke2 c_pe1 c_pr1 c_thermo_temp "
+            "c_sum[*] c_abs[*] c_avea[*] c_sq[*]");
+    command("thermo_style custom c_ke1 c_ke2 c_pe1 c_pr1 c_sum[*] c_abs[*] c_avea[*] c_sq[*]");
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+
+    // same values as with a separate reduction per compute
+
+    std::vector<double> ave(17);
+    for (int i = 0; i < (int)ave.size(); ++i) {
+        auto *val = (double *)lammps_extract_fix(lmp, "ave", LMP_STYLE_GLOBAL, LMP_TYPE_VECTOR, i, 0);
+        ave[i]    = *val;
+        lammps_free(val);
+    }
+    EXPECT_DOUBLE_EQ(ave[0], 2.3405256449146168);
+    EXPECT_DOUBLE_EQ(ave[1], 1.192924237073665);
+    EXPECT_DOUBLE_EQ(ave[2], 24155.155261642241);
+    EXPECT_NEAR(ave[3], 1956948.4735454607, 0.000000005);
+    EXPECT_DOUBLE_EQ(ave[0], get_scalar("ke1"));
+    EXPECT_DOUBLE_EQ(ave[3], get_scalar("pr1"));
+
+    // reference sums over the per-atom velocities
+
+    auto **v     = (double **)lammps_extract_atom(lmp, "v");
+    auto *mask   = (int *)lammps_extract_atom(lmp, "mask");
+    const int nlocal = *(int *)lammps_extract_global(lmp, "nlocal");
+    const int groupbit = lmp->group->bitmask[lmp->group->find("allwater")];
+    double sum[3] = {0.0, 0.0, 0.0}, sumabs[3] = {0.0, 0.0, 0.0}, sumsq[3] = {0.0, 0.0, 0.0};
+    int count = 0;
+    for (int i = 0; i < nlocal; ++i) {
+        for (int k = 0; k < 3; ++k) sumsq[k] += v[i][k] * v[i][k];
+        if (!(mask[i] & groupbit)) continue;
+        ++count;
+        for (int k = 0; k < 3; ++k) {
+            sum[k] += v[i][k];
+            sumabs[k] += fabs(v[i][k]);
+        }
+    }
+
+    auto *vsum  = get_vector("sum");
+    auto *vabs  = get_vector("abs");
+    auto *vavea = get_vector("avea");
+    auto *vsq   = get_vector("sq");
+    for (int k = 0; k < 3; ++k) {
+        EXPECT_NEAR(vsum[k], sum[k], 1.0e-14);
+        EXPECT_NEAR(vabs[k], sumabs[k], 1.0e-14);
+        EXPECT_NEAR(vavea[k], sumabs[k] / count, 1.0e-14);
+        EXPECT_NEAR(vsq[k], sumsq[k], 1.0e-14);
+        EXPECT_DOUBLE_EQ(ave[5 + k], vsum[k]);
+        EXPECT_DOUBLE_EQ(ave[8 + k], vabs[k]);
+        EXPECT_DOUBLE_EQ(ave[11 + k], vavea[k]);
+        EXPECT_DOUBLE_EQ(ave[14 + k], vsq[k]);
+    }
+}
+
 TEST_F(ComputeGlobalTest, Counts)
 {
     if (lammps_get_natoms(lmp) == 0.0) GTEST_SKIP();
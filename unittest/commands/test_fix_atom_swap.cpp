@@ -0,0 +1,138 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "../testing/core.h"
+#include "atom.h"
+#include "fix.h"
+#include "info.h"
+#include "lammps.h"
+#include "modify.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <mpi.h>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+namespace LAMMPS_NS {
+
+class FixAtomSwapTest : public LAMMPSTest {
+protected:
+    void SetUp() override
+    {
+        testbinary = "FixAtomSwapTest";
+        LAMMPSTest::SetUp();
+        if (!Info::has_package("MC")) GTEST_SKIP();
+        BEGIN_HIDE_OUTPUT();
+        command("units lj");
+        command("atom_modify map array");
+        command("lattice fcc 0.8442");
+        command("region box block 0 6 0 6 0 6");
+        command("create_box 2 box");
+        command("create_atoms 1 box");
+        command("set group all type/ratio 2 0.5 12345");
+        command("mass * 1.0");
+        command("pair_style lj/cut 2.5");
+        command("pair_coeff 1 1 1.0 1.0");
+        command("pair_coeff 2 2 1.0 1.1");
+        command("pair_coeff 1 2 1.2 1.05");
+        END_HIDE_OUTPUT();
+    }
+
+    int count_type(int itype)
+    {
+        int n = 0;
+        for (int i = 0; i < lmp->atom->nlocal; ++i)
+            if (lmp->atom->type[i] == itype) ++n;
+        return n;
+    }
+};
+
+TEST_F(FixAtomSwapTest, parallel)
+{
+    const int n1 = count_type(1);
+    const int n2 = count_type(2);
+
+    BEGIN_HIDE_OUTPUT();
+    command("fix 1 all atom/swap 1 100 29494 1.0 parallel yes types 1 2");
+    command("run 5 post no");
+    END_HIDE_OUTPUT();
+
+    // swaps are attempted and accepted and conserve the number of atoms per type
+
+    auto *fix = lmp->modify->get_fix_by_id("1");
+    EXPECT_GT(fix->compute_vector(0), 0.0);
+    EXPECT_GT(fix->compute_vector(1), 0.0);
+    EXPECT_LT(fix->compute_vector(1), fix->compute_vector(0));
+    EXPECT_EQ(count_type(1), n1);
+    EXPECT_EQ(count_type(2), n2);
+}
+
+TEST_F(FixAtomSwapTest, parallel_exclude)
+{
+    // group exclusions are not changed by swaps
+
+    BEGIN_HIDE_OUTPUT();
+    command("region half block 0 3 INF INF INF INF");
+    command("group half region half");
+    command("neigh_modify exclude group half half");
+    command("fix 1 all atom/swap 1 100 29494 1.0 parallel yes types 1 2");
+    command("run 2 post no");
+    END_HIDE_OUTPUT();
+    EXPECT_GT(lmp->modify->get_fix_by_id("1")->compute_vector(0), 0.0);
+
+    // type exclusions would have to follow the swapped atom types
+
+    BEGIN_HIDE_OUTPUT();
+    command("neigh_modify exclude none");
+    command("neigh_modify exclude type 1 2");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Fix atom/swap parallel yes cannot be used with neigh_modify exclude "
+                 "type.*",
+                 command("run 0 post no"););
+
+    // the serial algorithm uses the total energy and supports them
+
+    BEGIN_HIDE_OUTPUT();
+    command("unfix 1");
+    command("fix 1 all atom/swap 1 10 29494 1.0 types 1 2");
+    command("run 2 post no");
+    END_HIDE_OUTPUT();
+    EXPECT_GT(lmp->modify->get_fix_by_id("1")->compute_vector(0), 0.0);
+}
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -0,0 +1,167 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "../testing/core.h"
+#include "atom.h"
+#include "fix.h"
+#include "info.h"
+#include "lammps.h"
+#include "modify.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstring>
+#include <mpi.h>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+namespace LAMMPS_NS {
+using ::testing::ContainsRegex;
+
+class FixGCMCTest : public LAMMPSTest {
+protected:
+    void SetUp() override
+    {
+        testbinary = "FixGCMCTest";
+        LAMMPSTest::SetUp();
+        if (!Info::has_package("MC") || !Info::has_package("KSPACE")) GTEST_SKIP();
+    }
+
+    // dilute charged LJ gas of type 1 and fixed counter charges of type 2
+    void create_system(const std::string &pair_style, const std::string &pair_coeff)
+    {
+        command("units lj");
+        command("atom_style charge");
+        command("atom_modify map array");
+        command("lattice sc 0.3");
+        command("region box block 0 4 0 4 0 4");
+        command("create_box 2 box");
+        command("create_atoms 2 box");
+        command("set group all type/ratio 1 0.5 12345");
+        command("set type 1 charge 0.5");
+        command("set type 2 charge -0.5");
+        command("mass * 1.0");
+        command("pair_style " + pair_style);
+        command(pair_coeff);
+        command("kspace_style ewald 1.0e-6");
+        command("thermo 5");
+    }
+
+    // run atomic exchanges and return the number of insertion and deletion
+    // attempts and successes, the number of atoms and the potential energy
+    std::vector<double> run_gcmc(const std::string &mode)
+    {
+        BEGIN_HIDE_OUTPUT();
+        command("clear");
+        create_system("lj/cut/coul/long 2.5", "pair_coeff * * 1.0 1.0");
+        command("group gas type 1");
+        command("fix 1 gas gcmc 1 20 0 1 29494 2.0 -1.0 0.5 charge 0.5 " + mode);
+        command("variable pe equal pe");
+        command("run 20 post no");
+        END_HIDE_OUTPUT();
+
+        std::vector<double> data;
+        auto *fix = lmp->modify->get_fix_by_id("1");
+        for (int i = 2; i < 6; ++i) data.push_back(fix->compute_vector(i));
+        data.push_back(lmp->atom->natoms);
+        data.push_back(get_variable_value("pe"));
+        return data;
+    }
+};
+
+TEST_F(FixGCMCTest, incremental_ewald)
+{
+    const auto full = run_gcmc("full_energy");
+    const auto incr = run_gcmc("incremental");
+    ASSERT_EQ(full.size(), incr.size());
+
+    // there must be both accepted and rejected exchanges
+
+    EXPECT_GT(full[1], 0.0);
+    EXPECT_GT(full[3], 0.0);
+    EXPECT_LT(full[1], full[0]);
+    EXPECT_LT(full[3], full[2]);
+
+    // the same trial moves are accepted and lead to the same energy
+
+    for (int i = 0; i < 5; ++i)
+        EXPECT_EQ(incr[i], full[i]);
+    EXPECT_NEAR(incr[5], full[5], 1.0e-8 * fabs(full[5]));
+}
+
+TEST_F(FixGCMCTest, incremental_hybrid)
+{
+    BEGIN_HIDE_OUTPUT();
+    create_system("hybrid/overlay lj/cut 2.5 coul/long 2.5",
+                  "pair_coeff * * lj/cut 1.0 1.0");
+    command("pair_coeff * * coul/long");
+    command("group gas type 1");
+    command("fix 1 gas gcmc 1 20 0 1 29494 2.0 -1.0 0.5 charge 0.5 incremental");
+    END_HIDE_OUTPUT();
+
+    // hybrid pair styles use full energies as without the incremental keyword
+
+    BEGIN_CAPTURE_OUTPUT();
+    command("run 0 post no");
+    auto output = END_CAPTURE_OUTPUT();
+    ASSERT_THAT(output, ContainsRegex("WARNING: Fix gcmc using full_energy option instead of "
+                                      "incremental for pair style hybrid/overlay"));
+}
+
+TEST_F(FixGCMCTest, incremental_errors)
+{
+    BEGIN_HIDE_OUTPUT();
+    create_system("lj/cut/coul/long 2.5", "pair_coeff * * 1.0 1.0");
+    command("group gas type 1");
+    command("fix 1 gas gcmc 1 20 0 1 29494 2.0 -1.0 0.5 incremental full_energy");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Fix gcmc keywords full_energy and incremental cannot be used "
+                 "together.*",
+                 command("run 0 post no"););
+
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    create_system("lj/cut/coul/long 2.5", "pair_coeff * * 1.0 1.0");
+    command("group gas type 1");
+    command("kspace_style pppm 1.0e-4");
+    command("fix 1 gas gcmc 1 20 0 1 29494 2.0 -1.0 0.5 incremental");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Fix gcmc incremental is not supported by kspace style pppm.*",
+                 command("run 0 post no"););
+}
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -0,0 +1,173 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "../testing/core.h"
+#include "atom.h"
+#include "force.h"
+#include "info.h"
+#include "lammps.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mpi.h>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+namespace LAMMPS_NS {
+using ::testing::ContainsRegex;
+using ::testing::Not;
+
+class KSpaceModifyTest : public LAMMPSTest {
+protected:
+    void SetUp() override
+    {
+        testbinary = "KSpaceModifyTest";
+        LAMMPSTest::SetUp();
+    }
+
+    // charge neutral LJ system with displaced atoms
+    void create_system()
+    {
+        command("units lj");
+        command("atom_style charge");
+        command("atom_modify map array");
+        command("lattice sc 0.8");
+        command("region box block 0 5 0 5 0 5");
+        command("create_box 2 box");
+        command("create_atoms 1 box");
+        command("set group all type/ratio 2 0.5 12345");
+        command("set type 1 charge 1.0");
+        command("set type 2 charge -1.0");
+        command("displace_atoms all random 0.1 0.1 0.1 87287");
+        command("mass * 1.0");
+        command("velocity all create 1.0 4928459 loop geom");
+        command("pair_style lj/charmm/coul/long 2.0 2.5");
+        command("pair_coeff * * 1.0 1.0");
+        command("kspace_style pppm 1.0e-4");
+        command("fix 1 all nve");
+        command("thermo 5");
+    }
+
+    // run the system and return pe, pressure and forces sorted by atom ID
+    // the second element is the screen output of the run
+    std::pair<std::vector<double>, std::string> run_system(const std::string &package,
+                                                           const std::string &kspace_modify)
+    {
+        BEGIN_HIDE_OUTPUT();
+        command("clear");
+        if (!package.empty()) {
+            command(package);
+            command("suffix omp");
+        }
+        create_system();
+        if (!kspace_modify.empty()) command(kspace_modify);
+        command("variable pe equal pe");
+        command("variable press equal press");
+        END_HIDE_OUTPUT();
+
+        BEGIN_CAPTURE_OUTPUT();
+        command("run 10 post no");
+        auto output = END_CAPTURE_OUTPUT();
+
+        std::vector<double> data;
+        data.push_back(get_variable_value("pe"));
+        data.push_back(get_variable_value("press"));
+        auto *atom = lmp->atom;
+        for (int tag = 1; tag <= atom->natoms; ++tag) {
+            const int i = atom->map(tag);
+            for (int k = 0; k < 3; ++k)
+                data.push_back(atom->f[i][k]);
+        }
+        return {data, output};
+    }
+
+    static void compare(const std::vector<double> &test, const std::vector<double> &ref)
+    {
+        ASSERT_EQ(test.size(), ref.size());
+        for (std::size_t i = 0; i < ref.size(); ++i)
+            EXPECT_NEAR(test[i], ref[i], 1.0e-10 * std::max(1.0, fabs(ref[i])));
+    }
+};
+
+TEST_F(KSpaceModifyTest, concurrent)
+{
+    const auto ref  = run_system("", "");
+    const auto conc = run_system("", "kspace_modify concurrent yes");
+    if (Info::has_accelerator_feature("OPENMP", "api", "openmp"))
+        ASSERT_THAT(conc.second, Not(ContainsRegex("Ignoring kspace_modify concurrent")));
+    compare(conc.first, ref.first);
+}
+
+TEST_F(KSpaceModifyTest, concurrent_omp)
+{
+    if (!Info::has_package("OPENMP")) GTEST_SKIP();
+    if (!Info::has_accelerator_feature("OPENMP", "api", "openmp")) GTEST_SKIP();
+
+    // the default split with one thread for pppm/omp and two for the pair style
+
+    const auto ref  = run_system("package omp 3", "");
+    auto conc = run_system("package omp 3", "kspace_modify concurrent yes");
+    ASSERT_STREQ(lmp->force->kspace_style, "pppm/omp");
+    ASSERT_THAT(conc.second, Not(ContainsRegex("Ignoring kspace_modify concurrent")));
+    compare(conc.first, ref.first);
+
+    // two threads for pppm/omp and one for the pair style
+
+    conc = run_system("package omp 3", "kspace_modify concurrent yes concurrent/threads 2");
+    ASSERT_THAT(conc.second, Not(ContainsRegex("Ignoring kspace_modify concurrent")));
+    compare(conc.first, ref.first);
+
+    // more threads than available leaves one for the pair style
+
+    conc = run_system("package omp 2", "kspace_modify concurrent yes concurrent/threads 4");
+    compare(conc.first, ref.first);
+}
+
+TEST_F(KSpaceModifyTest, concurrent_errors)
+{
+    BEGIN_HIDE_OUTPUT();
+    create_system();
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Invalid kspace_modify concurrent/threads value: 0.*",
+                 command("kspace_modify concurrent/threads 0"););
+    TEST_FAILURE(".*ERROR: Illegal kspace_modify command.*",
+                 command("kspace_modify concurrent/threads"););
+}
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -0,0 +1,142 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "../testing/core.h"
+#include "info.h"
+#include "input.h"
+#include "lammps.h"
+#include "min.h"
+#include "update.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstring>
+#include <mpi.h>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+namespace LAMMPS_NS {
+using ::testing::StrEq;
+
+class MinimizeTest : public LAMMPSTest {
+protected:
+    void SetUp() override
+    {
+        testbinary = "MinimizeTest";
+        LAMMPSTest::SetUp();
+        HIDE_OUTPUT([&] {
+            create_system();
+        });
+    }
+
+    // perturbed fcc crystal so that all minimizers start from the same state
+    void create_system()
+    {
+        command("units lj");
+        command("lattice fcc 0.8442");
+        command("region box block 0 3 0 3 0 3");
+        command("create_box 1 box");
+        command("create_atoms 1 box");
+        command("mass 1 1.0");
+        command("pair_style lj/cut 2.5");
+        command("pair_coeff 1 1 1.0 1.0 2.5");
+        command("displace_atoms all random 0.1 0.1 0.1 87287 units box");
+        command("thermo 100");
+    }
+
+    // minimize from a freshly created system and return the final energy
+    double minimize(const std::string &style, const std::string &modify = "")
+    {
+        BEGIN_HIDE_OUTPUT();
+        command("clear");
+        create_system();
+        command("min_style " + style);
+        if (!modify.empty()) command("min_modify " + modify);
+        command("minimize 0.0 1.0e-8 1000 10000");
+        END_HIDE_OUTPUT();
+        return lmp->update->minimize->efinal;
+    }
+};
+
+TEST_F(MinimizeTest, lbfgs)
+{
+    const double ecg = minimize("cg");
+    EXPECT_LT(lmp->update->minimize->fnorm2_final, 1.0e-8);
+
+    const double elbfgs = minimize("lbfgs");
+    ASSERT_THAT(lmp->update->minimize_style, StrEq("lbfgs"));
+    EXPECT_LT(lmp->update->minimize->fnorm2_final, 1.0e-8);
+    EXPECT_NEAR(elbfgs, ecg, 1.0e-8 * fabs(ecg));
+}
+
+TEST_F(MinimizeTest, lbfgs_history)
+{
+    const double eref = minimize("lbfgs");
+
+    // short histories wrap around and overwrite the oldest correction pair
+
+    for (const auto &depth : {"1", "2", "5"}) {
+        const double e = minimize("lbfgs", std::string("history ") + depth);
+        EXPECT_LT(lmp->update->minimize->fnorm2_final, 1.0e-8);
+        EXPECT_NEAR(e, eref, 1.0e-8 * fabs(eref));
+    }
+}
+
+TEST_F(MinimizeTest, lbfgs_box_relax)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("min_style lbfgs");
+    command("fix 1 all box/relax iso 0.0 vmax 0.001");
+    command("minimize 0.0 1.0e-8 1000 10000");
+    command("variable press equal press");
+    END_HIDE_OUTPUT();
+    EXPECT_NEAR(get_variable_value("press"), 0.0, 1.0e-3);
+}
+
+TEST_F(MinimizeTest, lbfgs_errors)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("min_style lbfgs");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Illegal min_modify history command: missing argument.*",
+                 command("min_modify history"););
+    TEST_FAILURE(".*ERROR: Illegal min_modify history value: 0.*",
+                 command("min_modify history 0"););
+    TEST_FAILURE(".*ERROR: Expected integer parameter instead of 'xxx'.*",
+                 command("min_modify history xxx"););
+}
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
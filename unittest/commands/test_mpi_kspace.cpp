@@ -0,0 +1,207 @@
+// unit tests for PPPM options that only have an effect with multiple MPI processes
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "exceptions.h"
+#include "fmt/format.h"
+#include "force.h"
+#include "info.h"
+#include "input.h"
+#include "kspace.h"
+#include "lammps.h"
+#include "output.h"
+#include "platform.h"
+#include "thermo.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+using ::testing::ContainsRegex;
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+namespace LAMMPS_NS {
+
+class MPIKSpaceTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp            = nullptr;
+    int me                 = 0;
+
+    void SetUp() override
+    {
+        int nprocs;
+        MPI_Comm_rank(MPI_COMM_WORLD, &me);
+        MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+        if (nprocs != 2) GTEST_SKIP() << "requires 2 MPI processes";
+        if (!Info::has_package("KSPACE")) GTEST_SKIP() << "requires KSPACE package";
+
+        LAMMPS::argv args = {testbinary, "-log", "none", "-echo", "none", "-nocite"};
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(args, MPI_COMM_WORLD);
+        InitSystem();
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // charge neutral LJ system with displaced atoms
+
+    virtual void InitSystem()
+    {
+        command("units           lj");
+        command("atom_style      charge");
+        command("atom_modify     map yes");
+        command("lattice         sc 0.8");
+        command("region          box block 0 6 0 6 0 6");
+        command("create_box      2 box");
+        command("create_atoms    1 box");
+        command("set             group all type/ratio 2 0.5 12345");
+        command("set             type 1 charge 1.0");
+        command("set             type 2 charge -1.0");
+        command("displace_atoms  all random 0.1 0.1 0.1 87287");
+        command("mass            * 1.0");
+        command("pair_style      lj/cut/coul/long 2.5");
+        command("pair_coeff      * * 1.0 1.0");
+        command("kspace_style    pppm 1.0e-5");
+    }
+
+    void TearDown() override
+    {
+        if (!lmp) return;
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // run 0 and return the screen output of rank 0
+
+    std::string run0()
+    {
+        ::testing::internal::CaptureStdout();
+        command("run 0 post no");
+        auto output = ::testing::internal::GetCapturedStdout();
+        if (verbose) std::cout << output;
+        return output;
+    }
+
+    // forces ordered by atom ID followed by the potential energy
+
+    std::vector<double> forces_and_energy()
+    {
+        const auto natoms = lmp->atom->natoms;
+        std::vector<double> one(3 * natoms + 1, 0.0), all(3 * natoms + 1, 0.0);
+        for (int i = 0; i < lmp->atom->nlocal; ++i)
+            for (int k = 0; k < 3; ++k) one[3 * (lmp->atom->tag[i] - 1) + k] = lmp->atom->f[i][k];
+        MPI_Allreduce(one.data(), all.data(), one.size(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        lmp->output->thermo->evaluate_keyword("pe", &all.back());
+        return all;
+    }
+
+    static void compare(const std::vector<double> &test, const std::vector<double> &ref)
+    {
+        ASSERT_EQ(test.size(), ref.size());
+        for (std::size_t i = 0; i < ref.size(); ++i)
+            EXPECT_NEAR(test[i], ref[i], 1.0e-12 * std::max(1.0, std::fabs(ref[i])));
+    }
+
+    static std::vector<std::string> read_entries(const std::string &file)
+    {
+        std::vector<std::string> entries;
+        std::ifstream in(file);
+        for (std::string line; std::getline(in, line);)
+            if (!utils::strmatch(line, "^#")) entries.push_back(line);
+        return entries;
+    }
+};
+
+TEST_F(MPIKSpaceTest, fft_tune)
+{
+    const std::string wisdom = "pppm_fft_wisdom.txt";
+    if (me == 0) platform::unlink(wisdom);
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    run0();
+    const auto ref = forces_and_energy();
+
+    // the tuned layout gives the same result and is appended to the wisdom file
+
+    command("kspace_modify fft/tune yes fft/wisdom " + wisdom);
+    auto output = run0();
+    if (me == 0) EXPECT_THAT(output, HasSubstr("FFT autotune: layout"));
+    compare(forces_and_energy(), ref);
+
+    // a new run with the same grid reuses the result without tuning
+
+    output = run0();
+    if (me == 0) EXPECT_THAT(output, HasSubstr("from previous autotune"));
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    auto entries = read_entries(wisdom);
+    ASSERT_EQ(entries.size(), 1);
+    auto words = utils::split_words(entries[0]);
+    ASSERT_EQ(words.size(), 10);
+    EXPECT_EQ(words[3], "2");
+    EXPECT_EQ(std::stoi(words[6]) * std::stoi(words[7]), 2);
+
+    // a new kspace style reads the layout back from the wisdom file
+    // replace it with the layout that is not the default, so that one is used
+
+    const int npey = (words[6] == "1") ? 2 : 1;
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (me == 0) {
+        std::ofstream out(wisdom, std::ios::app);
+        out << fmt::format("{} {} {} {} {} {} {} {} 1 0.0\n", words[0], words[1], words[2],
+                           words[3], words[4], words[5], npey, 2 / npey);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    command("kspace_style pppm 1.0e-5");
+    command("kspace_modify fft/tune yes fft/wisdom " + wisdom);
+    output = run0();
+    if (me == 0) {
+        EXPECT_THAT(output, ContainsRegex(fmt::format(
+                                "FFT layout {}x{} with collective remap from wisdom file", npey,
+                                2 / npey)));
+        EXPECT_THAT(output, Not(HasSubstr("FFT autotune: layout")));
+    }
+    compare(forces_and_energy(), ref);
+    EXPECT_EQ(read_entries(wisdom).size(), 2);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (me == 0) platform::unlink(wisdom);
+}
+
+TEST_F(MPIKSpaceTest, fft_tune_unsupported)
+{
+    if (!Info(lmp).has_style("kspace", "pppm/dipole")) GTEST_SKIP();
+
+    // pppm/dipole has its own init() which does not tune the FFT layout
+
+    command("kspace_style pppm/dipole 1.0e-5");
+    ::testing::internal::CaptureStdout();
+    std::string mesg;
+    try {
+        command("kspace_modify fft/tune yes");
+    } catch (LAMMPSException &e) {
+        mesg = e.what();
+    }
+    ::testing::internal::GetCapturedStdout();
+    EXPECT_THAT(mesg, HasSubstr("Kspace style pppm/dipole does not support kspace_modify fft/tune"));
+
+    command("kspace_modify fft/tune no");
+    EXPECT_EQ(lmp->force->kspace->fft_tune_flag, 0);
+}
+} // namespace LAMMPS_NS
@@ -0,0 +1,197 @@
+// unit tests for commands that distribute work across multiple partitions
+
+#define LAMMPS_LIB_MPI 1
+#include "fmt/format.h"
+#include "input.h"
+#include "lammps.h"
+#include "platform.h"
+#include "universe.h"
+#include "utils.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+using ::testing::ElementsAre;
+using ::testing::StartsWith;
+
+namespace LAMMPS_NS {
+
+class MPIPartitionTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp            = nullptr;
+    int me                 = 0;
+
+    // two partitions with one processor each
+
+    void SetUp() override
+    {
+        int nprocs;
+        MPI_Comm_rank(MPI_COMM_WORLD, &me);
+        MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+        if (nprocs != 2) GTEST_SKIP() << "requires 2 MPI processes";
+
+        LAMMPS::argv args = {testbinary, "-partition", "2x1",  "-in",  "none",   "-log",
+                             "none",     "-screen",    "none", "-echo", "none", "-nocite"};
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(args, MPI_COMM_WORLD);
+        InitSystem();
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    virtual void InitSystem()
+    {
+        command("units           lj");
+        command("atom_style      atomic");
+        command("atom_modify     map yes");
+        command("lattice         fcc 0.8442");
+        command("region          box block 0 3 0 3 0 3");
+        command("create_box      1 box");
+        command("create_atoms    1 box");
+        command("mass            1 1.0");
+        command("velocity        all create 3.0 87287 loop geom");
+        command("pair_style      lj/cut 2.5");
+        command("pair_coeff      1 1 1.0 1.0 2.5");
+        command("neighbor        0.3 bin");
+        command("neigh_modify    every 1 delay 0 check yes");
+    }
+
+    void TearDown() override
+    {
+        if (!lmp) return;
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // timesteps of the data lines in a fix ave/time output file
+
+    static std::vector<int> read_steps(const std::string &file)
+    {
+        std::vector<int> steps;
+        std::ifstream in(file);
+        for (std::string line; std::getline(in, line);) {
+            if (utils::strmatch(line, "^#")) continue;
+            steps.push_back(utils::inumeric(FLERR, utils::split_words(line)[0], false, nullptr));
+        }
+        return steps;
+    }
+
+    static std::vector<std::string> read_lines(const std::string &file)
+    {
+        std::vector<std::string> lines;
+        std::ifstream in(file);
+        for (std::string line; std::getline(in, line);) lines.push_back(line);
+        return lines;
+    }
+};
+
+TEST_F(MPIPartitionTest, rerun_split)
+{
+    const int iworld = lmp->universe->iworld;
+    ASSERT_EQ(lmp->universe->nworlds, 2);
+
+    // the first partition writes a trajectory with 11 snapshots
+
+    const std::string dump_file = "dump.mpi_partitions.melt";
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("fix 1 all nve");
+    command("partition yes 1 dump 1 all atom 10 " + dump_file);
+    command("run 100 post no");
+    command("partition yes 1 undump 1");
+    command("unfix 1");
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    // split rerun: per partition output and output merged across partitions
+    // the fixes must be defined before the first rerun step to sample all snapshots
+
+    command("reset_timestep 0");
+    const std::string split_file = fmt::format("ave.split.{}.dat", iworld);
+    command("fix split all ave/time 1 1 1 c_thermo_pe c_thermo_press file " + split_file);
+    command("fix ave all ave/time 1 1 1 c_thermo_pe c_thermo_press file ave.merged.dat "
+            "universe yes");
+    command("rerun " + dump_file + " split yes dump x y z");
+    command("unfix split");
+    command("unfix ave");
+
+    // reference rerun of all snapshots on each partition
+
+    const std::string ref_file = fmt::format("ave.ref.{}.dat", iworld);
+    command("reset_timestep 0");
+    command("fix ave all ave/time 1 1 1 c_thermo_pe c_thermo_press file " + ref_file);
+    command("rerun " + dump_file + " dump x y z");
+    command("unfix ave");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    // partition I processes snapshots I, I+2, I+4, ...
+
+    if (iworld == 0)
+        EXPECT_THAT(read_steps(split_file), ElementsAre(0, 20, 40, 60, 80, 100));
+    else
+        EXPECT_THAT(read_steps(split_file), ElementsAre(10, 30, 50, 70, 90));
+    EXPECT_EQ(read_steps(ref_file).size(), 11);
+
+    // the merged output is the same as the output of a rerun of all snapshots,
+    // which is written by the first partition only
+
+    if (iworld == 0) {
+        auto merged = read_lines("ave.merged.dat");
+        auto ref    = read_lines(ref_file);
+        ASSERT_EQ(merged.size(), ref.size());
+        EXPECT_THAT(merged[0], StartsWith("# Time-averaged data for fix ave"));
+        for (std::size_t i = 0; i < ref.size(); ++i)
+            EXPECT_EQ(merged[i], ref[i]);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    platform::unlink(split_file);
+    platform::unlink(ref_file);
+    if (me == 0) {
+        platform::unlink(dump_file);
+        platform::unlink("ave.merged.dat");
+    }
+}
+
+TEST_F(MPIPartitionTest, rerun_split_two_runs)
+{
+    const int iworld = lmp->universe->iworld;
+
+    // merged output of multiple reruns is appended in order
+
+    const std::string dump_file = "dump.mpi_partitions_two.melt";
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("fix 1 all nve");
+    command("partition yes 1 dump 1 all atom 10 " + dump_file);
+    command("run 50 post no");
+    command("partition yes 1 undump 1");
+    command("unfix 1");
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    command("reset_timestep 0");
+    command("fix ave all ave/time 1 1 1 c_thermo_pe file ave.merged2.dat universe yes");
+    command("rerun " + dump_file + " first 0 last 20 split yes dump x y z");
+    command("rerun " + dump_file + " first 30 last 50 split yes dump x y z");
+    command("unfix ave");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    if (iworld == 0) EXPECT_THAT(read_steps("ave.merged2.dat"), ElementsAre(0, 10, 20, 30, 40, 50));
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    if (me == 0) {
+        platform::unlink(dump_file);
+        platform::unlink("ave.merged2.dat");
+    }
+}
+} // namespace LAMMPS_NS
@@ -0,0 +1,214 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "../testing/core.h"
+#include "atom.h"
+#include "info.h"
+#include "input.h"
+#include "lammps.h"
+#include "neighbor.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mpi.h>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+namespace LAMMPS_NS {
+using ::testing::ContainsRegex;
+
+class NeighborTest : public LAMMPSTest {
+protected:
+    void SetUp() override
+    {
+        testbinary = "NeighborTest";
+        LAMMPSTest::SetUp();
+    }
+
+    // hot LJ fluid, so that neighbor lists are rebuilt frequently
+    void create_system(const std::string &skin)
+    {
+        command("units lj");
+        command("atom_modify map array");
+        command("lattice fcc 0.8442");
+        command("region box block 0 6 0 6 0 6");
+        command("create_box 1 box");
+        command("create_atoms 1 box");
+        command("mass 1 1.0");
+        command("velocity all create 3.0 87287 loop geom");
+        command("pair_style lj/cut 2.5");
+        command("pair_coeff 1 1 1.0 1.0 2.5");
+        command("neighbor " + skin + " bin");
+        command("fix 1 all nve");
+        command("thermo 100");
+    }
+
+    // run a hot LJ fluid and return pe, pressure and positions sorted by atom ID
+    std::vector<double> run_fluid(const std::string &neigh_modify, bool omp = false)
+    {
+        BEGIN_HIDE_OUTPUT();
+        command("clear");
+        if (omp) {
+            command("package omp 2");
+            command("suffix omp");
+        }
+        create_system("1.0");
+        command("neigh_modify every 1 delay 0 check yes " + neigh_modify);
+        command("variable pe equal pe");
+        command("variable press equal press");
+        command("run 200");
+        END_HIDE_OUTPUT();
+
+        std::vector<double> data;
+        data.push_back(get_variable_value("pe"));
+        data.push_back(get_variable_value("press"));
+        auto *atom = lmp->atom;
+        for (int tag = 1; tag <= atom->natoms; ++tag) {
+            const int i = atom->map(tag);
+            for (int k = 0; k < 3; ++k)
+                data.push_back(atom->x[i][k]);
+        }
+        return data;
+    }
+};
+
+TEST_F(NeighborTest, auto_restore)
+{
+    BEGIN_HIDE_OUTPUT();
+    create_system("0.2");
+    command("neigh_modify every 1 delay 0 check yes auto yes tolerance 0.0");
+    END_HIDE_OUTPUT();
+
+    // the check interval is always tuned, since builds are more than 2 steps apart
+
+    BEGIN_CAPTURE_OUTPUT();
+    command("run 300");
+    auto output = END_CAPTURE_OUTPUT();
+    ASSERT_THAT(output, ContainsRegex("Neighbor auto tuning on step [0-9]+: skin = "));
+    ASSERT_THAT(output, ContainsRegex("Neighbor auto tuning: restoring skin = 0.2, every = 1"));
+
+    // the input settings are restored after the run
+
+    EXPECT_DOUBLE_EQ(lmp->neighbor->skin, 0.2);
+    EXPECT_EQ(lmp->neighbor->every, 1);
+    EXPECT_DOUBLE_EQ(lmp->neighbor->cutneighmax, 2.7);
+
+    // changed settings between runs are the new reference
+
+    BEGIN_HIDE_OUTPUT();
+    command("neighbor 0.25 bin");
+    command("neigh_modify every 2");
+    command("run 300");
+    END_HIDE_OUTPUT();
+    EXPECT_DOUBLE_EQ(lmp->neighbor->skin, 0.25);
+    EXPECT_EQ(lmp->neighbor->every, 2);
+
+    // without auto tuning nothing is changed or reported
+
+    BEGIN_HIDE_OUTPUT();
+    command("neigh_modify auto no");
+    END_HIDE_OUTPUT();
+    BEGIN_CAPTURE_OUTPUT();
+    command("run 100");
+    output = END_CAPTURE_OUTPUT();
+    ASSERT_THAT(output, Not(ContainsRegex("Neighbor auto tuning")));
+    EXPECT_DOUBLE_EQ(lmp->neighbor->skin, 0.25);
+    EXPECT_EQ(lmp->neighbor->every, 2);
+}
+
+TEST_F(NeighborTest, auto_errors)
+{
+    BEGIN_HIDE_OUTPUT();
+    create_system("0.3");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Illegal neigh_modify auto command: missing argument.*",
+                 command("neigh_modify auto"););
+    TEST_FAILURE(".*ERROR: Invalid neigh_modify tolerance argument: 1.*",
+                 command("neigh_modify tolerance 1.0"););
+
+    BEGIN_HIDE_OUTPUT();
+    command("neigh_modify auto yes check no");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Neigh_modify auto requires neigh_modify check yes.*",
+                 command("run 0 post no"););
+}
+
+TEST_F(NeighborTest, prune)
+{
+    const auto ref = run_fluid("prune no");
+    EXPECT_EQ(lmp->neighbor->nprune, 0);
+
+    // pruned lists only drop pairs outside the force cutoff, so results are identical
+
+    const auto pruned = run_fluid("prune 0.3");
+    EXPECT_EQ(lmp->neighbor->nprune, 1);
+    EXPECT_GT(lmp->neighbor->nprunecalls, 0);
+    ASSERT_EQ(pruned.size(), ref.size());
+    for (std::size_t i = 0; i < ref.size(); ++i)
+        EXPECT_NEAR(pruned[i], ref[i], 1.0e-10 * std::max(1.0, fabs(ref[i])));
+
+    // a buffer that is not smaller than the skin disables pruning
+
+    BEGIN_HIDE_OUTPUT();
+    command("neigh_modify prune 1.0");
+    END_HIDE_OUTPUT();
+    BEGIN_CAPTURE_OUTPUT();
+    command("run 0 post no");
+    auto output = END_CAPTURE_OUTPUT();
+    ASSERT_THAT(output, ContainsRegex("WARNING: Neigh_modify prune buffer 1 is not smaller "
+                                      "than skin 1, lists will not be pruned"));
+    EXPECT_EQ(lmp->neighbor->nprune, 0);
+}
+
+TEST_F(NeighborTest, prune_omp)
+{
+    if (!Info::has_package("OPENMP")) GTEST_SKIP();
+
+    // OPENMP neighbor lists use one page per thread, pruned lists use the first
+
+    const auto ref    = run_fluid("prune no", true);
+    const auto pruned = run_fluid("prune 0.3", true);
+    EXPECT_EQ(lmp->neighbor->nprune, 1);
+    EXPECT_GT(lmp->neighbor->nprunecalls, 0);
+    ASSERT_EQ(pruned.size(), ref.size());
+    for (std::size_t i = 0; i < ref.size(); ++i)
+        EXPECT_NEAR(pruned[i], ref[i], 1.0e-10 * std::max(1.0, fabs(ref[i])));
+}
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
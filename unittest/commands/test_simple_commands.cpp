@@ -13,6 +13,7 @@
 
 #include "lammps.h"
 
+#include "atom.h"
 #include "citeme.h"
 #include "comm.h"
 #include "force.h"
@@ -29,11 +30,13 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include <cmath>
 #include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <mpi.h>
+#include <vector>
 
 // whether to print verbose output (i.e. not capturing LAMMPS screen output).
 bool verbose = false;
@@ -50,6 +53,63 @@ TEST_F(SimpleCommandsTest, UnknownCommand)
     TEST_FAILURE(".*ERROR: Unknown command.*", command("XXX one two"););
 }
 
+TEST_F(SimpleCommandsTest, AtomModifySortOrder)
+{
+    // run the same trajectory with each sort order and return the final
+    // positions indexed by atom ID and the atom IDs in storage order
+
+    auto run = [&](const std::string &order, std::vector<double> &pos, std::vector<int> &tags) {
+        BEGIN_HIDE_OUTPUT();
+        command("clear");
+        command("units lj");
+        command("atom_modify map array sort 5 0.0 sort/order " + order);
+        command("lattice fcc 0.8442");
+        command("region box block 0 6 0 6 0 6");
+        command("create_box 1 box");
+        command("create_atoms 1 box");
+        command("mass 1 1.0");
+        command("velocity all create 3.0 87287 loop geom");
+        command("pair_style lj/cut 2.5");
+        command("pair_coeff 1 1 1.0 1.0 2.5");
+        command("fix 1 all nve");
+        command("run 20 post no");
+        END_HIDE_OUTPUT();
+
+        const int nlocal = lmp->atom->nlocal;
+        pos.resize(3 * nlocal);
+        tags.resize(nlocal);
+        for (int i = 0; i < nlocal; ++i) {
+            const int m = lmp->atom->tag[i] - 1;
+            for (int k = 0; k < 3; ++k)
+                pos[3 * m + k] = lmp->atom->x[i][k];
+            tags[i] = lmp->atom->tag[i];
+        }
+        return get_variable_value("pe");
+    };
+
+    std::vector<double> xyzpos, pos;
+    std::vector<int> xyztags, tags;
+    BEGIN_HIDE_OUTPUT();
+    command("variable pe equal pe");
+    END_HIDE_OUTPUT();
+    const double xyzpe = run("xyz", xyzpos, xyztags);
+
+    for (const auto &order : {"morton", "hilbert"}) {
+        const double pe = run(order, pos, tags);
+        EXPECT_NEAR(pe, xyzpe, 1.0e-10 * fabs(xyzpe)) << "order: " << order;
+        ASSERT_EQ(pos.size(), xyzpos.size());
+        for (std::size_t i = 0; i < pos.size(); ++i)
+            EXPECT_NEAR(pos[i], xyzpos[i], 1.0e-10) << "order: " << order;
+        // same atoms, but stored in a different order
+        EXPECT_NE(tags, xyztags) << "order: " << order;
+    }
+
+    TEST_FAILURE(".*ERROR: Illegal atom_modify sort/order argument xxx.*",
+                 command("atom_modify sort/order xxx"););
+    TEST_FAILURE(".*ERROR: Illegal atom_modify sort/order command: missing argument.*",
+                 command("atom_modify sort/order"););
+}
+
 TEST_F(SimpleCommandsTest, Echo)
 {
     ASSERT_EQ(lmp->input->echo_screen, 1);
@@ -0,0 +1,186 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "../testing/core.h"
+#include "json.h"
+#include "lammps.h"
+#include "platform.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mpi.h>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+namespace LAMMPS_NS {
+using ::testing::ContainsRegex;
+
+class TimerTest : public LAMMPSTest {
+protected:
+    void SetUp() override
+    {
+        testbinary = "TimerTest";
+        LAMMPSTest::SetUp();
+        BEGIN_HIDE_OUTPUT();
+        command("units lj");
+        command("lattice fcc 0.8442");
+        command("region box block 0 4 0 4 0 4");
+        command("create_box 1 box");
+        command("create_atoms 1 box");
+        command("mass 1 1.0");
+        command("velocity all create 3.0 87287 loop geom");
+        command("pair_style lj/cut 2.5");
+        command("pair_coeff 1 1 1.0 1.0 2.5");
+        command("neighbor 0.3 bin");
+        command("neigh_modify every 1 delay 0 check no");
+        command("fix 1 all nve");
+        command("thermo 5");
+        END_HIDE_OUTPUT();
+    }
+
+    void TearDown() override
+    {
+        LAMMPSTest::TearDown();
+        platform::unlink("timer_trace.json");
+    }
+};
+
+// a trace event with start and end time in microseconds
+
+struct Span {
+    std::string name, cat;
+    double start, stop;
+};
+
+// check that the complete events of one thread track are properly nested:
+// each event must end before the enclosing event ends or start after it ended.
+// time stamps are rounded to 1ns, so allow for some slack.
+
+static void check_nesting(std::vector<Span> spans)
+{
+    constexpr double slack = 0.002;
+    std::sort(spans.begin(), spans.end(), [](const Span &a, const Span &b) {
+        return (a.start < b.start) || ((a.start == b.start) && (a.stop > b.stop));
+    });
+    std::vector<Span> stack;
+    for (const auto &span : spans) {
+        while (!stack.empty() && (stack.back().stop <= span.start + slack)) stack.pop_back();
+        if (!stack.empty())
+            EXPECT_LE(span.stop, stack.back().stop + slack)
+                << span.name << " crosses the end of " << stack.back().name;
+        stack.push_back(span);
+    }
+}
+
+TEST_F(TimerTest, trace)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("timer normal");
+    command("timer trace timer_trace.json");
+    command("run 20");
+    command("timer trace off");
+    END_HIDE_OUTPUT();
+
+    std::ifstream in("timer_trace.json");
+    ASSERT_TRUE(in.good());
+    json trace;
+    ASSERT_NO_THROW(trace = json::parse(in));
+    ASSERT_TRUE(trace.is_array());
+
+    std::map<std::string, std::string> threads;
+    std::map<int, std::vector<Span>> tracks;
+    bool has_process = false;
+    for (const auto &event : trace) {
+        ASSERT_TRUE(event.contains("ph"));
+        ASSERT_EQ(event["pid"], 0);
+        if (event["ph"] == "M") {
+            if (event["name"] == "process_name") {
+                has_process = true;
+                EXPECT_EQ(event["args"]["name"], "MPI rank 0");
+            } else if (event["name"] == "thread_name") {
+                threads[std::to_string(event["tid"].get<int>())] = event["args"]["name"];
+            }
+        } else {
+            ASSERT_EQ(event["ph"], "X");
+            const double ts = event["ts"];
+            const double dur = event["dur"];
+            EXPECT_GE(dur, 0.0);
+            tracks[event["tid"].get<int>()].push_back({event["name"], event["cat"], ts, ts + dur});
+        }
+    }
+    EXPECT_TRUE(has_process);
+    EXPECT_EQ(threads["0"], "spans");
+    EXPECT_EQ(threads["1"], "timer categories");
+    ASSERT_EQ(tracks.size(), 2);
+
+    // steps and fix calls are nested spans on the first track
+
+    int nstep = 0, nfix = 0;
+    for (const auto &span : tracks[0]) {
+        EXPECT_NE(span.cat, "timer");
+        if (span.name == "Step") ++nstep;
+        if (span.name == "1") ++nfix;
+    }
+    EXPECT_EQ(nstep, 20);
+    EXPECT_GT(nfix, 0);
+    check_nesting(tracks[0]);
+
+    // timer categories are consecutive intervals on the second track
+
+    int npair = 0;
+    for (const auto &span : tracks[1]) {
+        EXPECT_EQ(span.cat, "timer");
+        if (span.name == "Pair") ++npair;
+    }
+    EXPECT_GE(npair, 20);
+    check_nesting(tracks[1]);
+    for (std::size_t i = 1; i < tracks[1].size(); ++i)
+        EXPECT_GE(tracks[1][i].start + 0.002, tracks[1][i - 1].stop);
+}
+
+TEST_F(TimerTest, trace_errors)
+{
+    TEST_FAILURE(".*ERROR: Illegal timer trace command: missing argument.*",
+                 command("timer trace"););
+    TEST_FAILURE(".*ERROR on proc 0: Cannot open timer trace file /no/such/dir/trace.json.*",
+                 command("timer trace /no/such/dir/trace.json"););
+}
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -26,6 +26,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include <cmath>
 #include <cstring>
 #include <vector>
 
@@ -59,6 +60,8 @@ protected:
         LAMMPSTest::TearDown();
         platform::unlink("test_variable.file");
         platform::unlink("test_variable.atomfile");
+        platform::unlink("tmp.lammps.variable");
+        platform::unlink("tmp.lammps.variable.lock");
     }
 
     void atomic_system()
@@ -461,6 +464,139 @@ TEST_F(VariableTest, Functions)
         command("print \"$(extract_setting(nprocs))\""););
 }
 
+TEST_F(VariableTest, CompiledEqual)
+{
+    atomic_system();
+
+    // equal-style variables are compiled on first use, immediate
+    // evaluation of the same formula string always uses the parser
+
+    const std::vector<std::string> formulas = {
+        "1+2*3^2-4/5",
+        "-2^2+2^3^2-(-3)",
+        "!0+(3>2)+(2<=2)+(1==1)*(1!=2)+(1&&0)+(0||1)+(1|^1)+(2>=3)+(2<3)",
+        "10%3+sqrt(16)+exp(0.5)+ln(2)+log(10)+abs(-3)",
+        "sin(PI/3)+cos(0.3)+tan(0.2)+asin(0.5)+acos(0.5)+atan(1)+atan2(1,2)",
+        "ceil(2.3)+floor(-2.3)+round(2.5)+ternary(1,2,3)+ternary(0,2,3)",
+        "step*dt+time+atoms+vol+lx*ly-lz",
+        "ramp(0,10)+stagger(10,2)",
+        "v_one*v_two+v_three/v_two-v_int",
+        "c_thermo_temp+c_thermo_press[2]+c_cm[1]+c_cm[3]",
+        "f_ave+f_vec[2]",
+    };
+
+    BEGIN_HIDE_OUTPUT();
+    command("variable one    index     1.5");
+    command("variable two    equal     2.0*v_one");
+    command("variable three  equal     v_two^2");
+    command("variable int    internal  0.25");
+    command("compute cm all com");
+    command("fix ave all ave/time 1 1 1 c_thermo_temp");
+    command("fix vec all ave/time 1 1 1 c_cm[1] c_cm[3]");
+    command("run 0 post no");
+    for (std::size_t i = 0; i < formulas.size(); ++i)
+        command(fmt::format("variable f{} equal {}", i, formulas[i]));
+    END_HIDE_OUTPUT();
+
+    for (std::size_t i = 0; i < formulas.size(); ++i) {
+        const int ivar        = variable->find(fmt::format("f{}", i).c_str());
+        const double compiled = variable->compute_equal(ivar);
+        const double parsed   = variable->compute_equal(formulas[i]);
+        EXPECT_DOUBLE_EQ(compiled, parsed) << "formula: " << formulas[i];
+        // second evaluation reuses the compiled program
+        EXPECT_DOUBLE_EQ(variable->compute_equal(ivar), parsed);
+    }
+
+    // references are resolved by name on each evaluation
+
+    ASSERT_DOUBLE_EQ(variable->compute_equal("v_three"), 9.0);
+    BEGIN_HIDE_OUTPUT();
+    command("variable two delete");
+    command("variable two equal 4.0");
+    END_HIDE_OUTPUT();
+    ASSERT_DOUBLE_EQ(variable->compute_equal("v_three"), 16.0);
+
+    BEGIN_HIDE_OUTPUT();
+    command("variable two delete");
+    command("unfix ave");
+    command("uncompute cm");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Invalid variable reference v_two in variable formula.*",
+                 command("print \"${three}\""););
+    TEST_FAILURE(".*ERROR: Variable f9: Invalid compute ID 'cm' in variable formula.*",
+                 command("print \"${f9}\""););
+    TEST_FAILURE(".*ERROR: Variable f10: Invalid fix ID 'ave' in variable formula.*",
+                 command("print \"${f10}\""););
+}
+
+TEST_F(VariableTest, AtomBlocks)
+{
+    // more atoms than the block size of the atom-style evaluation
+
+    BEGIN_HIDE_OUTPUT();
+    command("units real");
+    command("lattice sc 1.0 origin 0.125 0.125 0.125");
+    command("region box block 0 6 0 6 0 6");
+    command("create_box 2 box");
+    command("create_atoms 1 box");
+    command("mass * 1.0");
+    command("region left block 0.0 2.0 INF INF INF INF");
+    command("set region left type 2");
+    command("group left region left");
+    command("variable scale equal 0.5");
+    command("variable f1 atom x*y-0.5*z+(id%7)+(type==2)*3.0+sqrt(id)+atan2(y,x+1.0)");
+    command("variable f2 atom v_scale*v_f1^2-ternary(x>2.0,1.0,-1.0)+abs(z-3.0)");
+    END_HIDE_OUTPUT();
+
+    const int nlocal = lmp->atom->nlocal;
+    ASSERT_EQ(nlocal, 216);
+    const auto x    = lmp->atom->x;
+    const auto tag  = lmp->atom->tag;
+    const auto type = lmp->atom->type;
+    const auto mask = lmp->atom->mask;
+    const int groupbit = group->bitmask[group->find("left")];
+
+    std::vector<double> f1(nlocal), f2(nlocal), f2left(nlocal), f2sum(3 * nlocal, 1.0);
+    variable->compute_atom(variable->find("f1"), 0, f1.data(), 1, 0);
+    variable->compute_atom(variable->find("f2"), 0, f2.data(), 1, 0);
+    variable->compute_atom(variable->find("f2"), group->find("left"), f2left.data(), 1, 0);
+    variable->compute_atom(variable->find("f2"), 0, f2sum.data(), 3, 1);
+
+    for (int i = 0; i < nlocal; ++i) {
+        const double ref1 = x[i][0] * x[i][1] - 0.5 * x[i][2] + (tag[i] % 7) +
+            (type[i] == 2) * 3.0 + sqrt((double)tag[i]) + atan2(x[i][1], x[i][0] + 1.0);
+        const double ref2 =
+            0.5 * ref1 * ref1 - ((x[i][0] > 2.0) ? 1.0 : -1.0) + fabs(x[i][2] - 3.0);
+        EXPECT_NEAR(f1[i], ref1, 1.0e-12 * fabs(ref1));
+        EXPECT_NEAR(f2[i], ref2, 1.0e-12 * fabs(ref2));
+        if (mask[i] & groupbit)
+            EXPECT_DOUBLE_EQ(f2left[i], f2[i]);
+        else
+            EXPECT_DOUBLE_EQ(f2left[i], 0.0);
+        EXPECT_DOUBLE_EQ(f2sum[3 * i], 1.0 + f2[i]);
+        EXPECT_DOUBLE_EQ(f2sum[3 * i + 1], 1.0);
+    }
+
+    // the second operand of && and || is only evaluated where it is needed
+
+    BEGIN_HIDE_OUTPUT();
+    command("variable g1 atom (x>1.0)&&(ln(x-1.0)>0.5)");
+    command("variable g2 atom (x<1.0)||(sqrt(x-1.0)>1.0)");
+    command("variable g3 atom (x>0.125)&&(1.0/(x-0.125)>0.5)");
+    END_HIDE_OUTPUT();
+
+    std::vector<double> g1(nlocal), g2(nlocal), g3(nlocal);
+    variable->compute_atom(variable->find("g1"), 0, g1.data(), 1, 0);
+    variable->compute_atom(variable->find("g2"), 0, g2.data(), 1, 0);
+    variable->compute_atom(variable->find("g3"), 0, g3.data(), 1, 0);
+
+    for (int i = 0; i < nlocal; ++i) {
+        EXPECT_DOUBLE_EQ(g1[i], ((x[i][0] > 1.0) && (log(x[i][0] - 1.0) > 0.5)) ? 1.0 : 0.0);
+        EXPECT_DOUBLE_EQ(g2[i], ((x[i][0] < 1.0) || (sqrt(x[i][0] - 1.0) > 1.0)) ? 1.0 : 0.0);
+        EXPECT_DOUBLE_EQ(g3[i], ((x[i][0] > 0.125) && (1.0 / (x[i][0] - 0.125) > 0.5)) ? 1.0 : 0.0);
+    }
+}
+
 TEST_F(VariableTest, IfCommand)
 {
     BEGIN_HIDE_OUTPUT();
@@ -549,6 +549,81 @@ TEST(BondStyle, omp)
     if (!verbose) ::testing::internal::GetCapturedStdout();
 };
 
+TEST(BondStyle, omp_color)
+{
+    if (!LAMMPS::is_installed_pkg("OPENMP")) GTEST_SKIP();
+    if (test_config.skip_tests.count(test_info_->name())) GTEST_SKIP();
+    if (test_config.skip_tests.count("omp")) GTEST_SKIP();
+
+    // styles with spatial coloring write directly to the shared force array,
+    // all other /omp styles must still give the same results in this mode
+
+    LAMMPS::argv args = {"BondStyle", "-log",  "none", "-echo", "screen", "-nocite", "-pk",
+                         "omp",       "4",     "color", "yes",  "-sf",    "omp"};
+
+    ::testing::internal::CaptureStdout();
+    LAMMPS *lmp = nullptr;
+    try {
+        lmp = init_lammps(args, test_config, true);
+    } catch (std::exception &e) {
+        std::string output = ::testing::internal::GetCapturedStdout();
+        if (verbose) std::cout << output;
+        FAIL() << e.what();
+    }
+    std::string output = ::testing::internal::GetCapturedStdout();
+    if (verbose) std::cout << output;
+
+    if (!lmp) GTEST_SKIP();
+
+    // abort if running in parallel and not all atoms are local
+    const int nlocal = lmp->atom->nlocal;
+    ASSERT_EQ(lmp->atom->natoms, nlocal);
+
+    // relax error a bit for OPENMP package
+    double epsilon = 5.0 * test_config.epsilon;
+
+    ErrorStats stats;
+    auto *bond = lmp->force->bond;
+
+    for (int newton = 1; newton >= 0; --newton) {
+        const std::string mode = newton ? " (newton on)" : " (newton off)";
+        if (!newton) {
+            if (!verbose) ::testing::internal::CaptureStdout();
+            cleanup_lammps(lmp, test_config);
+            try {
+                lmp = init_lammps(args, test_config, false);
+            } catch (std::exception &e) {
+                if (!verbose) ::testing::internal::GetCapturedStdout();
+                FAIL() << e.what();
+            }
+            if (!verbose) ::testing::internal::GetCapturedStdout();
+            bond = lmp->force->bond;
+        }
+
+        EXPECT_FORCES("init_forces" + mode, lmp->atom, test_config.init_forces, epsilon);
+        EXPECT_STRESS("init_stress" + mode, bond->virial, test_config.init_stress, 10 * epsilon);
+
+        stats.reset();
+        EXPECT_FP_LE_WITH_EPS(bond->energy, test_config.init_energy, epsilon);
+        if (print_stats) std::cerr << "init_energy stats" << mode << ": " << stats << std::endl;
+
+        if (!verbose) ::testing::internal::CaptureStdout();
+        run_lammps(lmp);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+
+        EXPECT_FORCES("run_forces" + mode, lmp->atom, test_config.run_forces, 10 * epsilon);
+        EXPECT_STRESS("run_stress" + mode, bond->virial, test_config.run_stress, 10 * epsilon);
+
+        stats.reset();
+        EXPECT_FP_LE_WITH_EPS(bond->energy, test_config.run_energy, epsilon);
+        if (print_stats) std::cerr << "run_energy  stats" << mode << ": " << stats << std::endl;
+    }
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    cleanup_lammps(lmp, test_config);
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+};
+
 TEST(BondStyle, kokkos_omp)
 {
     if (!LAMMPS::is_installed_pkg("KOKKOS")) GTEST_SKIP();
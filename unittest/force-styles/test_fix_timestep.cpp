@@ -440,10 +440,11 @@ TEST(FixTimestep, plain)
     }
 
     // rigid fixes need work to test properly with r-RESPA.
-    // fix nve/limit cannot work with r-RESPA
+    // fix nve/limit and fix lincs cannot work with r-RESPA
     ifix = lmp->modify->get_fix_by_id("test");
     if (ifix && !utils::strmatch(ifix->style, "^rigid") &&
-        !utils::strmatch(ifix->style, "^nve/limit") && !utils::strmatch(ifix->style, "^recenter")) {
+        !utils::strmatch(ifix->style, "^nve/limit") && !utils::strmatch(ifix->style, "^recenter") &&
+        !utils::strmatch(ifix->style, "^lincs")) {
         if (!verbose) ::testing::internal::CaptureStdout();
         cleanup_lammps(lmp, test_config);
         delete lmp;
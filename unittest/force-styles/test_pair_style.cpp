@@ -646,6 +646,89 @@ TEST(PairStyle, omp)
     if (!verbose) ::testing::internal::GetCapturedStdout();
 };
 
+TEST(PairStyle, omp_color)
+{
+    if (!LAMMPS::is_installed_pkg("OPENMP")) GTEST_SKIP();
+    if (test_config.skip_tests.count(test_info_->name())) GTEST_SKIP();
+    if (test_config.skip_tests.count("omp")) GTEST_SKIP();
+    if (utils::strmatch(test_config.pair_style, "^dpd")) GTEST_SKIP();
+
+    // styles with spatial coloring write directly to the shared force array,
+    // all other /omp styles must still give the same results in this mode
+
+    LAMMPS::argv args = {"PairStyle", "-log",  "none", "-echo", "screen", "-nocite", "-pk",
+                         "omp",       "4",     "color", "yes",  "-sf",    "omp"};
+
+    ::testing::internal::CaptureStdout();
+    LAMMPS *lmp = nullptr;
+    try {
+        lmp = init_lammps(args, test_config, true);
+    } catch (std::exception &e) {
+        std::string output = ::testing::internal::GetCapturedStdout();
+        if (verbose) std::cout << output;
+        FAIL() << e.what();
+    }
+    std::string output = ::testing::internal::GetCapturedStdout();
+    if (verbose) std::cout << output;
+
+    if (!lmp) GTEST_SKIP();
+
+    // abort if running in parallel and not all atoms are local
+    const int nlocal = lmp->atom->nlocal;
+    ASSERT_EQ(lmp->atom->natoms, nlocal);
+
+    // relax error a bit for OPENMP package
+    double epsilon = 5.0 * test_config.epsilon;
+    // relax test precision when using pppm and single precision FFTs
+#if defined(FFT_SINGLE)
+    if (lmp->force->kspace && lmp->force->kspace->compute_flag)
+        if (utils::strmatch(lmp->force->kspace_style, "^pppm")) epsilon *= 2.0e8;
+#endif
+    auto *pair = lmp->force->pair;
+    ErrorStats stats;
+
+    for (int newton = 1; newton >= 0; --newton) {
+        const std::string mode = newton ? " (newton on)" : " (newton off)";
+        if (!newton) {
+            if (lmp->force->newton_pair != 0) break;
+            if (!verbose) ::testing::internal::CaptureStdout();
+            cleanup_lammps(lmp, test_config);
+            try {
+                lmp = init_lammps(args, test_config, false);
+            } catch (std::exception &e) {
+                if (!verbose) ::testing::internal::GetCapturedStdout();
+                FAIL() << e.what();
+            }
+            if (!verbose) ::testing::internal::GetCapturedStdout();
+            pair = lmp->force->pair;
+        }
+
+        EXPECT_FORCES("init_forces" + mode, lmp->atom, test_config.init_forces, epsilon);
+        EXPECT_STRESS("init_stress" + mode, pair->virial, test_config.init_stress, 10 * epsilon);
+
+        stats.reset();
+        EXPECT_FP_LE_WITH_EPS(pair->eng_vdwl, test_config.init_vdwl, epsilon);
+        EXPECT_FP_LE_WITH_EPS(pair->eng_coul, test_config.init_coul, epsilon);
+        if (print_stats) std::cerr << "init_energy stats" << mode << ": " << stats << std::endl;
+
+        if (!verbose) ::testing::internal::CaptureStdout();
+        run_lammps(lmp);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+
+        EXPECT_FORCES("run_forces" + mode, lmp->atom, test_config.run_forces, 5 * epsilon);
+        EXPECT_STRESS("run_stress" + mode, pair->virial, test_config.run_stress, 10 * epsilon);
+
+        stats.reset();
+        EXPECT_FP_LE_WITH_EPS(pair->eng_vdwl, test_config.run_vdwl, epsilon);
+        EXPECT_FP_LE_WITH_EPS(pair->eng_coul, test_config.run_coul, epsilon);
+        if (print_stats) std::cerr << "run_energy  stats" << mode << ": " << stats << std::endl;
+    }
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    cleanup_lammps(lmp, test_config);
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+};
+
 TEST(PairStyle, kokkos_omp)
 {
     if (!LAMMPS::is_installed_pkg("KOKKOS")) GTEST_SKIP();
@@ -954,6 +954,97 @@ TEST_F(DumpAtomTest, header)
     ASSERT_EQ(values.size(), 0);
     delete_file(dump_file);
 }
+
+TEST_F(DumpAtomTest, mpiio_run1plus1)
+{
+    auto serial_file = dump_filename("serial_run1plus1");
+    auto mpiio_file  = dump_filename("mpiio_run1plus1");
+    HIDE_OUTPUT([&] {
+        command("fix 1 all nve");
+        command("dump id0 all atom 1 " + serial_file);
+        command("dump id1 all atom 1 " + mpiio_file);
+        command("dump_modify id0 sort id format line \"%d %d %20.15g %20.15g %20.15g\"");
+        command("dump_modify id1 sort id format line \"%d %d %20.15g %20.15g %20.15g\" io mpiio");
+        command("run 1 post no");
+        command("run 1 pre no post no");
+        command("undump id0");
+        command("undump id1");
+    });
+    double pe_2, pe_rerun;
+    lmp->output->thermo->evaluate_keyword("pe", &pe_2);
+
+    // headers and atoms of both snapshots are written in the same order as serial output
+
+    ASSERT_FILE_EXISTS(mpiio_file);
+    ASSERT_EQ(count_lines(mpiio_file), 123);
+    ASSERT_FILE_EQUAL(serial_file, mpiio_file);
+
+    // the file can be read back
+
+    HIDE_OUTPUT([&] {
+        command(fmt::format("rerun {} first 2 last 2 every 1 post no dump x y z", mpiio_file));
+    });
+    lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+    ASSERT_DOUBLE_EQ(pe_2, pe_rerun);
+
+    // appending to the file adds snapshots after the existing ones
+
+    HIDE_OUTPUT([&] {
+        command("dump id1 all atom 1 " + mpiio_file);
+        command("dump_modify id1 sort id append yes io mpiio");
+        command("run 0 post no");
+        command("undump id1");
+    });
+    ASSERT_EQ(count_lines(mpiio_file), 164);
+    delete_file(serial_file);
+    delete_file(mpiio_file);
+}
+
+TEST_F(DumpAtomTest, mpiio_multi_file_run1)
+{
+    auto dump_file = dump_filename("mpiio_run1_*");
+    generate_dump(dump_file, "io mpiio", 1);
+    close_dump();
+
+    auto run1_0 = dump_filename("mpiio_run1_0");
+    auto run1_1 = dump_filename("mpiio_run1_1");
+    ASSERT_FILE_EXISTS(run1_0);
+    ASSERT_FILE_EXISTS(run1_1);
+    ASSERT_EQ(count_lines(run1_0), 41);
+    ASSERT_EQ(count_lines(run1_1), 41);
+    delete_file(run1_0);
+    delete_file(run1_1);
+}
+
+TEST_F(DumpAtomTest, mpiio_invalid)
+{
+    auto dump_file = dump_filename("mpiio_invalid");
+    BEGIN_HIDE_OUTPUT();
+    command("dump id all atom 1 " + dump_file);
+    command("dump_modify id buffer no io mpiio");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Dump id requires dump_modify buffer yes for MPI-IO.*",
+                 command("run 0 post no"););
+    TEST_FAILURE(".*ERROR: Unknown dump_modify io argument: xxx.*",
+                 command("dump_modify id io xxx"););
+
+    BEGIN_HIDE_OUTPUT();
+    command("dump_modify id buffer yes");
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Cannot change dump_modify io after dump file is opened.*",
+                 command("dump_modify id io serial"););
+    close_dump();
+    delete_file(dump_file);
+
+    dump_file = dump_filename("mpiio_invalid_p%");
+    BEGIN_HIDE_OUTPUT();
+    command("dump id all atom 1 " + dump_file);
+    command("dump_modify id io mpiio");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Dump id cannot use MPI-IO with one file per processor.*",
+                 command("run 0 post no"););
+}
 } // namespace LAMMPS_NS
 
 int main(int argc, char **argv)
@@ -14,6 +14,7 @@
 #include "../testing/utils.h"
 #include "compressed_dump_test.h"
 #include "fmt/format.h"
+#include "platform.h"
 #include "utils.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -417,3 +418,100 @@ TEST_F(DumpAtomCompressTest, compressed_modify_clevel_run0)
     delete_file(compressed_file);
     delete_file(converted_file);
 }
+
+TEST_F(DumpAtomCompressTest, compressed_modify_async_run1)
+{
+    if (!COMPRESS_EXECUTABLE) GTEST_SKIP();
+
+    const auto *base_name = "modify_async_run1.melt";
+    auto text_file        = text_dump_filename(base_name);
+    auto compressed_file  = compressed_dump_filename(base_name);
+
+    generate_text_and_compressed_dump(text_file, compressed_file, "", "", "", "async yes", 1);
+
+    TearDown();
+
+    ASSERT_FILE_EXISTS(text_file);
+    ASSERT_FILE_EXISTS(compressed_file);
+
+    auto converted_file = convert_compressed_to_text(compressed_file);
+
+    ASSERT_THAT(converted_file, Eq(converted_dump_filename(base_name)));
+    ASSERT_FILE_EXISTS(converted_file);
+    ASSERT_FILE_EQUAL(text_file, converted_file);
+    delete_file(text_file);
+    delete_file(compressed_file);
+    delete_file(converted_file);
+}
+
+TEST_F(DumpAtomCompressTest, compressed_modify_async_multi_block)
+{
+    if (!COMPRESS_EXECUTABLE) GTEST_SKIP();
+
+    // enough output for several blocks of the background writer per run,
+    // so the caller has to wait for the background thread
+
+    BEGIN_HIDE_OUTPUT();
+    command("replicate 16 16 16");
+    END_HIDE_OUTPUT();
+
+    const auto *base_name = "modify_async_multi_block.melt";
+    auto text_file        = text_dump_filename(base_name);
+    auto compressed_file  = compressed_dump_filename(base_name);
+
+    generate_text_and_compressed_dump(text_file, compressed_file, "", "", "",
+                                      "async yes compression_level 1", 2);
+    BEGIN_HIDE_OUTPUT();
+    command("run 2 pre no");
+    END_HIDE_OUTPUT();
+
+    TearDown();
+
+    ASSERT_FILE_EXISTS(text_file);
+    ASSERT_FILE_EXISTS(compressed_file);
+
+    auto converted_file = convert_compressed_to_text(compressed_file);
+
+    ASSERT_FILE_EXISTS(converted_file);
+    ASSERT_EQ(count_lines(converted_file), 5 * (131072 + 9));
+    ASSERT_FILE_EQUAL(text_file, converted_file);
+    delete_file(text_file);
+    delete_file(compressed_file);
+    delete_file(converted_file);
+}
+
+TEST_F(DumpAtomCompressTest, compressed_modify_async_error)
+{
+    if (!LAMMPS_NS::platform::file_is_readable("/dev/full")) GTEST_SKIP();
+
+    // errors of the background thread are reported as errors in the calling thread
+
+    auto compressed_file = compressed_dump_filename("modify_async_error.melt");
+    BEGIN_HIDE_OUTPUT();
+    command("shell ln -sf /dev/full " + compressed_file);
+    command(fmt::format("dump id1 all {} 1 {}", compression_style, compressed_file));
+    command("dump_modify id1 async yes");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR on proc 0: .*", command("run 2 post no"););
+    delete_file(compressed_file);
+}
+
+TEST_F(DumpAtomCompressTest, compressed_modify_async_open)
+{
+    if (compression_style != "atom/gz") GTEST_SKIP();
+
+    BEGIN_HIDE_OUTPUT();
+    command(fmt::format("dump id1 all {} 1 {}", compression_style,
+                        compressed_dump_filename("modify_async_open.melt")));
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+
+    TEST_FAILURE(".*ERROR on proc 0: Illegal dump_modify command: Async mode can not be "
+                 "changed while file is open.*",
+                 command("dump_modify id1 async yes"););
+
+    BEGIN_HIDE_OUTPUT();
+    command("undump id1");
+    END_HIDE_OUTPUT();
+    delete_file(compressed_dump_filename("modify_async_open.melt"));
+}
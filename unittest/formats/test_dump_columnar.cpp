@@ -0,0 +1,201 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "../testing/core.h"
+#include "../testing/systems/melt.h"
+#include "../testing/utils.h"
+#include "dump_columnar.h"
+#include "fmt/format.h"
+#include "output.h"
+#include "thermo.h"
+#include "utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using ::testing::ContainsRegex;
+using ::testing::Not;
+
+bool verbose = false;
+
+namespace LAMMPS_NS {
+
+class DumpColumnarTest : public MeltTest {
+public:
+    std::string dump_filename(const std::string &ident)
+    {
+        return fmt::format("dump_columnar_{}.melt.bin", ident);
+    }
+
+    // return # of frames in the index at the end of the file, -1 if there is no valid index
+
+    bigint index_frames(const std::string &file)
+    {
+        const int nmagic   = strlen(DumpColumnar::INDEX_MAGIC);
+        const int ntrailer = 2 * sizeof(bigint) + nmagic;
+        bigint nframes     = -1;
+        bigint start       = -1;
+        std::string magic(nmagic, '\0');
+
+        std::ifstream in(file, std::ios::binary | std::ios::ate);
+        const bigint size = in.tellg();
+        if (size < ntrailer) return -1;
+        in.seekg(size - ntrailer);
+        in.read((char *)&nframes, sizeof(bigint));
+        in.read((char *)&start, sizeof(bigint));
+        in.read(&magic[0], nmagic);
+        if (!in || (magic != DumpColumnar::INDEX_MAGIC)) return -1;
+        if (start + nframes * 2 * (bigint)sizeof(bigint) + ntrailer != size) return -1;
+        return nframes;
+    }
+
+    double rerun_pe(const std::string &file, bigint step, std::string &output)
+    {
+        BEGIN_CAPTURE_OUTPUT();
+        command(fmt::format("rerun {} first {} last {} every 1 post no dump x y z vx vy vz "
+                            "format columnar",
+                            file, step, step));
+        output = END_CAPTURE_OUTPUT();
+        double pe;
+        lmp->output->thermo->evaluate_keyword("pe", &pe);
+        return pe;
+    }
+};
+
+TEST_F(DumpColumnarTest, run2plus2)
+{
+    auto dump_file = dump_filename("run2plus2");
+    double pe_2, pe_4;
+
+    // the index is written at the end of each run, not after every frame
+
+    BEGIN_HIDE_OUTPUT();
+    command("fix 1 all nve");
+    command(fmt::format("dump id all columnar 1 {} id type x y z vx vy vz", dump_file));
+    command("run 2 post no");
+    END_HIDE_OUTPUT();
+    lmp->output->thermo->evaluate_keyword("pe", &pe_2);
+    ASSERT_FILE_EXISTS(dump_file);
+    ASSERT_EQ(index_frames(dump_file), 3);
+
+    BEGIN_HIDE_OUTPUT();
+    command("run 2 pre no post no");
+    END_HIDE_OUTPUT();
+    lmp->output->thermo->evaluate_keyword("pe", &pe_4);
+    ASSERT_EQ(index_frames(dump_file), 5);
+
+    BEGIN_HIDE_OUTPUT();
+    command("undump id");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(index_frames(dump_file), 5);
+
+    // read frames back through the index
+
+    std::string output;
+    ASSERT_NEAR(rerun_pe(dump_file, 4, output), pe_4, 1.0e-12);
+    ASSERT_THAT(output, Not(ContainsRegex("no valid index")));
+    ASSERT_NEAR(rerun_pe(dump_file, 2, output), pe_2, 1.0e-12);
+    ASSERT_THAT(output, Not(ContainsRegex("no valid index")));
+    delete_file(dump_file);
+}
+
+TEST_F(DumpColumnarTest, missing_index)
+{
+    auto dump_file = dump_filename("missing_index");
+    double pe_1;
+
+    BEGIN_HIDE_OUTPUT();
+    command("fix 1 all nve");
+    command(fmt::format("dump id all columnar 1 {} id type x y z vx vy vz", dump_file));
+    command("run 1 post no");
+    command("undump id");
+    END_HIDE_OUTPUT();
+    lmp->output->thermo->evaluate_keyword("pe", &pe_1);
+    ASSERT_EQ(index_frames(dump_file), 2);
+
+    // remove the index, so the frames have to be scanned
+
+    std::vector<char> data;
+    {
+        std::ifstream in(dump_file, std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    data.resize(data.size() - 2 * 2 * sizeof(bigint) - 2 * sizeof(bigint) -
+                strlen(DumpColumnar::INDEX_MAGIC));
+    {
+        std::ofstream out(dump_file, std::ios::binary | std::ios::trunc);
+        out.write(data.data(), data.size());
+    }
+    ASSERT_EQ(index_frames(dump_file), -1);
+
+    std::string output;
+    ASSERT_NEAR(rerun_pe(dump_file, 1, output), pe_1, 1.0e-12);
+    ASSERT_THAT(output, ContainsRegex("WARNING: Columnar dump file has no valid index"));
+    delete_file(dump_file);
+}
+
+TEST_F(DumpColumnarTest, multi_file_run1)
+{
+    auto dump_file = dump_filename("run1_*");
+    double pe_1;
+
+    BEGIN_HIDE_OUTPUT();
+    command("fix 1 all nve");
+    command(fmt::format("dump id all columnar 1 {} id type x y z vx vy vz", dump_file));
+    command("run 1 post no");
+    END_HIDE_OUTPUT();
+    lmp->output->thermo->evaluate_keyword("pe", &pe_1);
+
+    // each file is closed after its frame, so it has its own index
+
+    auto run1_0 = dump_filename("run1_0");
+    auto run1_1 = dump_filename("run1_1");
+    ASSERT_FILE_EXISTS(run1_0);
+    ASSERT_FILE_EXISTS(run1_1);
+    ASSERT_EQ(index_frames(run1_0), 1);
+    ASSERT_EQ(index_frames(run1_1), 1);
+
+    std::string output;
+    ASSERT_NEAR(rerun_pe(run1_1, 1, output), pe_1, 1.0e-12);
+    ASSERT_THAT(output, Not(ContainsRegex("no valid index")));
+    delete_file(run1_0);
+    delete_file(run1_1);
+}
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
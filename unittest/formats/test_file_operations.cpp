@@ -391,6 +391,98 @@ TEST_F(FileOperationsTest, write_restart)
     delete_file("triclinic.restart");
 }
 
+TEST_F(FileOperationsTest, write_restart_mpiio)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("region box block -2 2 -2 2 -2 2");
+    command("create_box 2 box");
+    command("create_atoms 1 single 0.0 0.0 0.0");
+    command("create_atoms 2 single 1.0 -0.5 0.25");
+    command("create_atoms 1 single -1.5 1.5 1.0");
+    command("mass * 1.0");
+    command("velocity all set 0.1 0.2 0.3");
+    command("reset_timestep 333");
+    command("comm_modify cutoff 0.2");
+    command("run 0 post no");
+    command("write_restart test.mpiio");
+    command("write_restart test.mpiio.restart");
+    END_HIDE_OUTPUT();
+
+    ASSERT_FILE_EXISTS("test.mpiio");
+    ASSERT_FILE_EXISTS("test.mpiio.restart");
+    TEST_FAILURE(".*ERROR: Cannot use % and .mpiio in the same restart file name.*",
+                 command("write_restart multi-%.mpiio"););
+
+    for (const auto &file : {"test.mpiio", "test.mpiio.restart"}) {
+        BEGIN_HIDE_OUTPUT();
+        command("clear");
+        command(std::string("read_restart ") + file);
+        END_HIDE_OUTPUT();
+        ASSERT_EQ(lmp->atom->natoms, 3);
+        ASSERT_EQ(lmp->update->ntimestep, 333);
+
+        auto *tag  = lmp->atom->tag;
+        auto *type = lmp->atom->type;
+        auto **x   = lmp->atom->x;
+        auto **v   = lmp->atom->v;
+        for (int i = 0; i < lmp->atom->nlocal; ++i) {
+            EXPECT_DOUBLE_EQ(v[i][0], 0.1);
+            EXPECT_DOUBLE_EQ(v[i][1], 0.2);
+            EXPECT_DOUBLE_EQ(v[i][2], 0.3);
+            if (tag[i] == 2) {
+                EXPECT_EQ(type[i], 2);
+                EXPECT_DOUBLE_EQ(x[i][0], 1.0);
+                EXPECT_DOUBLE_EQ(x[i][1], -0.5);
+                EXPECT_DOUBLE_EQ(x[i][2], 0.25);
+            } else if (tag[i] == 3) {
+                EXPECT_EQ(type[i], 1);
+                EXPECT_DOUBLE_EQ(x[i][0], -1.5);
+                EXPECT_DOUBLE_EQ(x[i][1], 1.5);
+                EXPECT_DOUBLE_EQ(x[i][2], 1.0);
+            }
+        }
+    }
+
+    // clean up
+    delete_file("test.mpiio");
+    delete_file("test.mpiio.restart");
+}
+
+TEST_F(FileOperationsTest, write_restart_mpiio_mismatch)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("region box block -2 2 -2 2 -2 2");
+    command("create_box 1 box");
+    command("create_atoms 1 single 0.0 0.0 0.0");
+    command("mass 1 1.0");
+    command("write_restart test.mpiio");
+    command("write_restart test.restart");
+    END_HIDE_OUTPUT();
+
+    ASSERT_FILE_EXISTS("test.mpiio");
+    ASSERT_FILE_EXISTS("test.restart");
+
+    // only a name ending in .mpiio selects the MPI-IO format, so reading
+    // each file under the other name must fail on the file layout check
+
+    rename("test.restart", "test2.mpiio");
+    rename("test.mpiio", "test2.restart");
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Restart file is not a MPI-IO file.*",
+                 command("read_restart test2.mpiio"););
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Restart file is a MPI-IO file.*",
+                 command("read_restart test2.restart"););
+
+    // clean up
+    delete_file("test2.mpiio");
+    delete_file("test2.restart");
+}
+
 TEST_F(FileOperationsTest, write_data)
 {
     BEGIN_HIDE_OUTPUT();
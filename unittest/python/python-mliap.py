@@ -0,0 +1,231 @@
+import os,shutil,tempfile,unittest
+from lammps import lammps, LMP_STYLE_ATOM, LMP_TYPE_VECTOR
+
+try:
+    import numpy
+    NUMPY_INSTALLED = True
+except ImportError:
+    NUMPY_INSTALLED = False
+
+has_mliappy=False
+try:
+    machine=None
+    if 'LAMMPS_MACHINE_NAME' in os.environ:
+        machine=os.environ['LAMMPS_MACHINE_NAME']
+    lmp=lammps(name=machine, cmdargs=['-nocite', '-log', 'none', '-screen', 'none'])
+    if lmp.has_package('ML-IAP') and lmp.has_package('ML-SNAP') and lmp.has_package('PYTHON'):
+        import lammps.mliap as mliap
+        mliap.activate_mliappy(lmp)
+        has_mliappy = True
+    lmp.close()
+except:
+    pass
+
+# 5 bispectrum components for twojmax 2
+NDESC=5
+
+descriptor_file = """
+rcutfac 4.0
+twojmax 2
+nelems 1
+elems Ta
+radelems 0.5
+welems 1
+rfac0 0.99363
+rmin0 0
+bzeroflag 0
+"""
+
+# linear model with zero offset and unit coefficients
+model_file = "1 {}\n0.0\n".format(NDESC+1) + NDESC * "1.0\n"
+
+if has_mliappy:
+    from lammps.mliap.mliap_unified_abc import MLIAPUnified
+
+    class UnifiedProbe(MLIAPUnified):
+        """Unified model that records the numpy views passed to it"""
+
+        def __init__(self):
+            super().__init__(None, ["Ta"], 2, 3, 2.0)
+            self.bases = []
+            self.nlistatoms = []
+            self.descriptors = []
+            self.betas = []
+
+        def compute_descriptors(self, data):
+            # written in place into the LAMMPS buffer
+            desc = data.descriptors
+            desc[:, 0] = data.iatoms + 1.0
+            desc[:, 1] = 2.0
+
+        def compute_gradients(self, data):
+            views = [data.descriptors, data.betas, data.eatoms, data.graddesc]
+            self.bases.append([None if v is None else v.base for v in views])
+            self.nlistatoms.append(data.nlistatoms)
+            # a new view reads back what was written before
+            self.descriptors.append(data.descriptors.copy())
+
+            # a view with the same start but different shape must be copied
+            betas = data.betas
+            betas[:, 0] = 1.0
+            betas[:, 1] = 2.0
+            data.betas = betas[:, 0:1]
+            self.betas.append(data.betas.copy())
+
+            data.eatoms[:] = 0.25 * data.descriptors[:, 1]
+            data.energy = float(numpy.sum(data.eatoms))
+
+        def compute_forces(self, data):
+            pass
+
+    class ModelProbe:
+        """Python model reproducing the linear model with unit coefficients"""
+
+        n_params = NDESC + 1
+        n_elements = 1
+        n_descriptors = NDESC
+
+        def __init__(self):
+            self.bases = []
+
+        def __call__(self, elems, descriptors, beta, energy):
+            self.bases.append([v.base for v in (elems, descriptors, beta, energy)])
+            beta[:] = 1.0
+            energy[:] = numpy.sum(descriptors, axis=1)
+
+@unittest.skipIf(not (NUMPY_INSTALLED and has_mliappy), "numpy or ML-IAP python coupling is not available")
+class PythonMLIAP(unittest.TestCase):
+    def setUp(self):
+        machine = None
+        if 'LAMMPS_MACHINE_NAME' in os.environ:
+            machine=os.environ['LAMMPS_MACHINE_NAME']
+        self.lmp=lammps(name=machine, cmdargs=['-nocite', '-log', 'none', '-echo', 'screen'])
+        mliap.activate_mliappy(self.lmp)
+        self.dir = tempfile.mkdtemp()
+        self.descriptor = os.path.join(self.dir, 'probe.mliap.descriptor')
+        self.model = os.path.join(self.dir, 'probe.mliap.model')
+        with open(self.descriptor, 'w') as f:
+            f.write(descriptor_file)
+        with open(self.model, 'w') as f:
+            f.write(model_file)
+
+    def tearDown(self):
+        self.lmp.close()
+        del self.lmp
+        shutil.rmtree(self.dir)
+
+    def create_system(self):
+        self.lmp.commands_string("""
+            units metal
+            atom_modify map array
+            lattice bcc 3.316
+            region box block 0 3 0 3 0 3
+            create_box 1 box
+            create_atoms 1 box
+            displace_atoms all random 0.1 0.1 0.1 87287
+            mass 1 180.88
+        """)
+
+    def run_and_extract(self, nsteps):
+        self.lmp.commands_string("""
+            compute pea all pe/atom
+            compute sumpe all reduce sum c_pea
+            thermo_style custom step pe c_sumpe
+            thermo 1
+            run {} post no
+        """.format(nsteps))
+        nlocal = self.lmp.extract_global("nlocal")
+        order = numpy.argsort(self.lmp.numpy.extract_atom("id")[:nlocal])
+        f = numpy.array(self.lmp.numpy.extract_atom("f")[:nlocal][order])
+        pea = self.lmp.numpy.extract_compute("pea", LMP_STYLE_ATOM, LMP_TYPE_VECTOR)
+        pea = numpy.array(pea[:nlocal][order])
+        pe = self.lmp.get_thermo("pe")
+        self.lmp.command("uncompute pea")
+        self.lmp.command("uncompute sumpe")
+        return pe, pea, f
+
+    def testUnifiedViews(self):
+        self.create_system()
+        probe = UnifiedProbe()
+        mliap.load_unified(probe)
+        self.lmp.commands_string("""
+            pair_style mliap unified EXISTS
+            pair_coeff * * Ta
+        """)
+
+        # the views of the allocated buffers are reused in every step
+
+        pe, pea, f = self.run_and_extract(2)
+        self.assertEqual(len(probe.bases), 3)
+        natoms = self.lmp.get_natoms()
+        for bases in probe.bases[1:]:
+            for view, first in zip(bases, probe.bases[0]):
+                self.assertIs(view, first)
+        self.assertIsNotNone(probe.bases[0][0])
+
+        # writes to the views reach the LAMMPS arrays
+
+        for desc, betas in zip(probe.descriptors, probe.betas):
+            self.assertTrue(numpy.array_equal(numpy.sort(desc[:, 0]), numpy.arange(1.0, natoms + 1.0)))
+            self.assertTrue(numpy.all(desc[:, 1] == 2.0))
+            self.assertTrue(numpy.all(betas == 1.0))
+        self.assertTrue(numpy.allclose(pea, 0.5))
+        self.assertAlmostEqual(pe, 0.5 * natoms)
+
+        # the views are rebuilt after the buffers are reallocated
+
+        self.lmp.command("replicate 2 1 1")
+        pe, pea, f = self.run_and_extract(0)
+        self.assertEqual(probe.nlistatoms[-1], 2 * natoms)
+        for view, first in zip(probe.bases[-1], probe.bases[0]):
+            if first is not None:
+                self.assertIsNot(view, first)
+        self.assertTrue(numpy.array_equal(numpy.sort(probe.descriptors[-1][:, 0]),
+                                          numpy.arange(1.0, 2 * natoms + 1.0)))
+        self.assertTrue(numpy.allclose(pea, 0.5))
+        self.assertAlmostEqual(pe, natoms)
+
+    def testModelViews(self):
+        self.create_system()
+        self.lmp.commands_string("""
+            pair_style mliap model linear {} descriptor sna {}
+            pair_coeff * * Ta
+        """.format(self.model, self.descriptor))
+        ref = [self.run_and_extract(0)]
+        self.lmp.command("replicate 2 1 1")
+        ref.append(self.run_and_extract(0))
+
+        self.lmp.command("clear")
+        self.create_system()
+        probe = ModelProbe()
+        self.lmp.commands_string("""
+            pair_style mliap model mliappy LATER descriptor sna {}
+            pair_coeff * * Ta
+        """.format(self.descriptor))
+        mliap.load_model(probe)
+
+        # views are reused and writes to beta and energy match the linear model
+
+        test = [self.run_and_extract(2)]
+        self.assertEqual(len(probe.bases), 3)
+        for bases in probe.bases[1:]:
+            for view, first in zip(bases, probe.bases[0]):
+                self.assertIs(view, first)
+
+        # the views are rebuilt after the buffers are reallocated
+
+        self.lmp.command("replicate 2 1 1")
+        test.append(self.run_and_extract(0))
+        for view, first in zip(probe.bases[-1], probe.bases[0]):
+            self.assertIsNot(view, first)
+
+        for (pe, pea, f), (rpe, rpea, rf) in zip(test, ref):
+            self.assertNotEqual(rpe, 0.0)
+            self.assertAlmostEqual(pe, rpe, delta=1.0e-10 * abs(rpe))
+            self.assertTrue(numpy.allclose(pea, rpea, rtol=1.0e-10, atol=0.0))
+            self.assertTrue(numpy.allclose(f, rf, rtol=1.0e-10, atol=1.0e-12))
+            self.assertGreater(numpy.max(numpy.abs(rf)), 0.0)
+
+##############################
+if __name__ == "__main__":
+    unittest.main()
@@ -9,7 +9,7 @@ try:
     machine=None
     if 'LAMMPS_MACHINE_NAME' in os.environ:
         machine=os.environ['LAMMPS_MACHINE_NAME']
-    lmp=lammps(name=machine)
+    lmp=lammps(name=machine, cmdargs=['-nocite', '-log', 'none'])
     has_manybody = lmp.has_style("pair","sw")
     lmp.close()
 except:
@@ -20,7 +20,7 @@ try:
     machine=None
     if 'LAMMPS_MACHINE_NAME' in os.environ:
         machine=os.environ['LAMMPS_MACHINE_NAME']
-    lmp=lammps(name=machine)
+    lmp=lammps(name=machine, cmdargs=['-nocite', '-log', 'none'])
     has_full = lmp.has_style("atom","full")
     lmp.close()
 except:
@@ -740,5 +740,37 @@ class PythonNumpy(unittest.TestCase):
         self.assertEqual(a[0], x[0]*x[0]+x[1]*x[1]+x[2]*x[2])
         self.assertEqual(a[1], x[3]*x[3]+x[4]*x[4]+x[5]*x[5])
 
+    def test_gather_atoms_root(self):
+        self.lmp.command("units lj")
+        self.lmp.command("atom_style atomic")
+        self.lmp.command("atom_modify map array")
+        self.lmp.command("region box block 0 2 0 2 0 2")
+        self.lmp.command("create_box 2 box")
+        self.lmp.command("create_atoms 1 single 1.0 1.0 1.0")
+        self.lmp.command("create_atoms 2 single 1.5 0.5 1.0")
+        self.lmp.command("create_atoms 1 single 0.5 1.5 0.25")
+
+        x = self.lmp.numpy.gather_atoms_root("x", 1, 3)
+        self.assertEqual(x.shape, (3, 3))
+        self.assertEqual(x.tolist(), [[1.0, 1.0, 1.0], [1.5, 0.5, 1.0], [0.5, 1.5, 0.25]])
+
+        types = self.lmp.numpy.gather_atoms_root("type", 0, 1)
+        self.assertEqual(types.shape, (3,))
+        self.assertEqual(types.tolist(), [1, 2, 1])
+
+        # reuse a destination array
+        out = numpy.zeros(9, dtype=numpy.double)
+        x = self.lmp.numpy.gather_atoms_root("x", 1, 3, out)
+        self.assertIs(x, out)
+        self.assertEqual(out.tolist(), [1.0, 1.0, 1.0, 1.5, 0.5, 1.0, 0.5, 1.5, 0.25])
+
+        xsub = self.lmp.numpy.gather_atoms_subset_root("x", 1, 3, [3, 1])
+        self.assertEqual(xsub.tolist(), [[0.5, 1.5, 0.25], [1.0, 1.0, 1.0]])
+
+        with self.assertRaises(ValueError):
+            self.lmp.numpy.gather_atoms_root("x", 1, 3, numpy.zeros(8, dtype=numpy.double))
+        with self.assertRaises(ValueError):
+            self.lmp.numpy.gather_atoms_root("x", 1, 3, numpy.zeros(9, dtype=numpy.intc))
+
 if __name__ == "__main__":
     unittest.main()
@@ -1,13 +1,14 @@
 
 import sys,os,unittest
 from lammps import lammps
+from ctypes import c_int
 
 has_full=False
 try:
     machine=None
     if 'LAMMPS_MACHINE_NAME' in os.environ:
         machine=os.environ['LAMMPS_MACHINE_NAME']
-    lmp=lammps(name=machine)
+    lmp=lammps(name=machine, cmdargs=['-nocite', '-log', 'none'])
     has_full = lmp.has_style("atom","full")
     lmp.close()
 except:
@@ -237,6 +238,31 @@ class PythonGather(unittest.TestCase):
             count += self.checkImproper(impropers[5*i:5*i+5], 2, 8, 6, 10, 9)
         self.assertEqual(count,2)
 
+    @unittest.skipIf(not has_full, "Gather_atoms_root test")
+    def testGatherAtomsRoot(self):
+        """Test gather_atoms_root() and gather_atoms_subset_root()"""
+        self.lmp.file("in.fourmol")
+        natoms = self.lmp.get_natoms()
+        self.assertEqual(natoms, 29)
+
+        x = self.lmp.gather_atoms("x", 1, 3)
+        xroot = self.lmp.gather_atoms_root("x", 1, 3)
+        self.assertEqual(len(xroot), 3*natoms)
+        for i in range(3*natoms):
+            self.assertEqual(xroot[i], x[i])
+
+        types = self.lmp.gather_atoms("type", 0, 1)
+        troot = self.lmp.gather_atoms_root("type", 0, 1)
+        self.assertEqual(list(troot), list(types))
+
+        ids = (c_int*3)(29, 1, 10)
+        xsub = self.lmp.gather_atoms_subset("x", 1, 3, 3, ids)
+        xsroot = self.lmp.gather_atoms_subset_root("x", 1, 3, 3, ids)
+        self.assertEqual(list(xsroot), list(xsub))
+
+        with self.assertRaises(Exception):
+            self.lmp.gather_atoms_root("xxx", 1, 3)
+
 ##############################
 if __name__ == "__main__":
     unittest.main()